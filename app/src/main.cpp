@@ -3,6 +3,7 @@
 #define _USE_MATH_DEFINES
 #include "math.h"
 #include <iostream>
+#include <cstdlib>
 #include <time.h>
 
 #include <ctime>
@@ -10,208 +11,281 @@
 using namespace std;
 using namespace rohdeschwarz::mosaik::dataimportexport;
 
-int iqx2iqtar(int argc, const char* argv[])
+bool parseFileType(const string& name, FileType& fileType)
 {
-  bool readChannels = false;
-  if (argc != 2)
+  static const map<string, FileType> types = {
+    { "iqtar", FileType::Iqtar },
+    { "iqw", FileType::IQW },
+    { "iqx", FileType::IQX },
+    { "wv", FileType::WV },
+    { "aid", FileType::AID },
+    { "csv", FileType::Csv },
+    { "mat4", FileType::Matlab4 },
+    { "mat73", FileType::Matlab73 } };
+
+  auto it = types.find(name);
+  if (it == types.end())
   {
-    printf("call %s <iqx-file>\n", argv[0]);
-    exit(1);
+    return false;
   }
-  Iqx inIqx(argv[1]);
 
-  vector<string> arrayNames;
-  int ret = inIqx.readOpen(arrayNames);
-  if (ret != ErrorCodes::Success)
+  fileType = it->second;
+  return true;
+}
+
+bool fileTypeFromExtension(const string& filename, FileType& fileType)
+{
+  static const vector<pair<string, FileType>> extensions = {
+    { ".iq.tar", FileType::Iqtar },
+    { ".iqw", FileType::IQW },
+    { ".iqx", FileType::IQX },
+    { ".wv", FileType::WV },
+    { ".aid", FileType::AID },
+    { ".csv", FileType::Csv },
+    { ".mat", FileType::Matlab73 } };
+
+  for (const auto& extension : extensions)
   {
-    printf("file open %s failed\n", argv[1]);
-    exit(1);
+    if (filename.size() >= extension.first.size() && filename.compare(filename.size() - extension.first.size(), extension.first.size(), extension.first) == 0)
+    {
+      fileType = extension.second;
+      return true;
+    }
   }
 
-  vector<ChannelInfo> channels;
-  map<string, string> metadata;
-  ret = inIqx.getMetadata(channels, metadata);
-  if (ret != ErrorCodes::Success)
+  return false;
+}
+
+int convertFile(const string& inFile, FileType inType, const string& outFile, FileType outType, size_t chunkSize, size_t queueSize, const string& precision)
+{
+  FormatConverter converter(inFile, inType, outFile, outType);
+  if (chunkSize > 0 && converter.setChunkSize(chunkSize) != ErrorCodes::Success)
   {
-    printf("get metadata failed\n");
-    exit(1);
+    printf("invalid chunk size\n");
+    return 1;
   }
-  if (channels.size() != 1)
+  if (queueSize > 0 && converter.setQueueSize(queueSize) != ErrorCodes::Success)
   {
-    printf("Unexpected number of channels read from file\n");
-    exit(1);
+    printf("invalid queue size\n");
+    return 1;
   }
-
-  string outIqtarStr = argv[1];
-  outIqtarStr = outIqtarStr + ".iq.tar";
-  IqTar iqtar(outIqtarStr);
-  string applicationName = argv[1];
-  if (metadata.find("ApplicationName") != metadata.end())
+  if (precision == "float32")
   {
-    applicationName = metadata.at("ApplicationName");
-    std::cout << "ApplicationName: " << applicationName << "\n";
+    converter.setDataType(IqDataType::Float32);
   }
-  ret = iqtar.writeOpen(IqDataFormat::Complex, 1, "iqx to iqtar conversion", applicationName, channels, &metadata);
+  else if (precision == "float64")
+  {
+    converter.setDataType(IqDataType::Float64);
+  }
+
+  std::cout << "converting " << inFile << " to " << outFile << "\n";
+  int ret = converter.convert();
   if (ret != ErrorCodes::Success)
   {
-    printf("iq.tar file open for write failed\n");
-    exit(1);
+    printf("conversion failed with error code %d\n", ret);
+    return 1;
   }
-  size_t read = 0;
-  size_t offset = 0;
-  size_t toRead = channels[0].getSamples();
 
-  std::cout << toRead / 1E6 << " MSamples\n";
-  std::cout << "writing iq.tar file\n";
-  while (toRead > 0)
+  std::cout << converter.getSamplesConverted() / 1E6 << " MSamples converted in " << converter.getElapsedSeconds() << " s, "
+    << converter.getMegabytesPerSecond() << " MB/s\n";
+  return 0;
+}
+
+int convert(int argc, const char* argv[])
+{
+  const char* usage = "call %s convert <input-file> <output-file> [--format iqtar|iqw|iqx|wv|aid|csv|mat4|mat73] "
+    "[--input-format <format>] [--chunk-size <samples>] [--queue-size <chunks>] [--precision float32|float64]\n";
+
+  vector<string> files;
+  string format;
+  string inputFormat;
+  string precision;
+  size_t chunkSize = 0;
+  size_t queueSize = 0;
+  for (int i = 2; i < argc; ++i)
   {
-    size_t readNow = toRead;
-    if (readNow > (size_t)1E7) readNow = (size_t)1E7;
-    if (readChannels)
+    const string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--format" && hasValue)
     {
-      vector<float> valuesIQ;
-      ret = inIqx.readChannel(channels[0].getChannelName(), valuesIQ, readNow, read);
-      if (ret != ErrorCodes::Success)
-      {
-        printf("iqx read channel failed\n");
-        exit(1);
-      }
-      vector<vector<float>> writeChan;
-      writeChan.push_back(valuesIQ);
-      ret = iqtar.appendChannels(writeChan);
-      if (ret != ErrorCodes::Success)
-      {
-        printf("iqtar append channel failed\n");
-        exit(1);
-      }
+      format = argv[++i];
+    }
+    else if (arg == "--input-format" && hasValue)
+    {
+      inputFormat = argv[++i];
+    }
+    else if (arg == "--chunk-size" && hasValue)
+    {
+      chunkSize = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+    }
+    else if (arg == "--queue-size" && hasValue)
+    {
+      queueSize = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+    }
+    else if (arg == "--precision" && hasValue)
+    {
+      precision = argv[++i];
+    }
+    else if (arg.compare(0, 2, "--") != 0)
+    {
+      files.push_back(arg);
     }
     else
     {
-      vector<float> valuesI;
-      vector<float> valuesQ;
-      ret = inIqx.readArray(channels[0].getChannelName() + "_I", valuesI, readNow, read);
-      if (ret != ErrorCodes::Success)
-      {
-        printf("iqx read array failed\n");
-        exit(1);
-      }
-      ret = inIqx.readArray(channels[0].getChannelName() + "_Q", valuesQ, readNow, read);
-      if (ret != ErrorCodes::Success)
-      {
-        printf("iqx read array failed\n");
-        exit(1);
-      }
-      vector<vector<float>> writeArrays;
-      writeArrays.push_back(valuesI);
-      writeArrays.push_back(valuesQ);
-      ret = iqtar.appendArrays(writeArrays);
-      if (ret != ErrorCodes::Success)
-      {
-        printf("iqtar append arrays failed\n");
-        exit(1);
-      }
-
+      printf(usage, argv[0]);
+      return 1;
     }
-    toRead -= readNow;
-    offset += readNow;
-    read += readNow;
-    std::cout << "\r" << read / 1E6 << " MSamples converted";
   }
 
-  inIqx.close();
-  std::cout << "\nclosing iq.tar file\n";
-
-  iqtar.close();
-  std::cout << "done\n";
-  return 0;
-}
-
-int wv2iqtar(int argc, const char* argv[])
-{
-  if (argc != 2)
+  if (files.size() != 2 || (false == precision.empty() && precision != "float32" && precision != "float64"))
   {
-    printf("call %s <wv-file>\n", argv[0]);
-    exit(1);
+    printf(usage, argv[0]);
+    return 1;
   }
-  Wv inWv(argv[1]);
 
-  vector<string> arrayNames;
-  int ret = inWv.readOpen(arrayNames);
-  if (ret != ErrorCodes::Success)
+  FileType inType;
+  FileType outType;
+  bool valid = inputFormat.empty() ? fileTypeFromExtension(files[0], inType) : parseFileType(inputFormat, inType);
+  if (false == valid)
   {
-    printf("file open %s failed\n", argv[1]);
-    exit(1);
+    printf("unknown format of input file %s, use --input-format\n", files[0].c_str());
+    return 1;
   }
 
-  vector<ChannelInfo> channels;
-  map<string, string> metadata;
-  ret = inWv.getMetadata(channels, metadata);
-  if (ret != ErrorCodes::Success)
+  valid = format.empty() ? fileTypeFromExtension(files[1], outType) : parseFileType(format, outType);
+  if (false == valid)
   {
-    printf("get metadata failed\n");
-    exit(1);
+    printf("unknown format of output file %s, use --format\n", files[1].c_str());
+    return 1;
   }
-  if (channels.size() != 1)
+
+  return convertFile(files[0], inType, files[1], outType, chunkSize, queueSize, precision);
+}
+
+int batch(int argc, const char* argv[])
+{
+  const char* usage = "call %s batch <output-dir> <input-file-or-pattern>... [--format iqtar|iqw|iqx|wv|aid|csv|mat4|mat73] "
+    "[--input-format <format>] [--threads <n>] [--max-memory <MB>] [--max-temp-files <n>] [--chunk-size <samples>]\n";
+
+  vector<string> args;
+  string format = "iqtar";
+  string inputFormat;
+  size_t nofThreads = 0;
+  uint64_t maxMemory = 0;
+  size_t maxTempFiles = 0;
+  size_t chunkSize = 0;
+  for (int i = 2; i < argc; ++i)
   {
-    printf("Unexpected number of channels read from file\n");
-    exit(1);
+    const string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--format" && hasValue)
+    {
+      format = argv[++i];
+    }
+    else if (arg == "--input-format" && hasValue)
+    {
+      inputFormat = argv[++i];
+    }
+    else if (arg == "--threads" && hasValue)
+    {
+      nofThreads = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+    }
+    else if (arg == "--max-memory" && hasValue)
+    {
+      maxMemory = strtoull(argv[++i], nullptr, 10) * 1000000;
+    }
+    else if (arg == "--max-temp-files" && hasValue)
+    {
+      maxTempFiles = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+    }
+    else if (arg == "--chunk-size" && hasValue)
+    {
+      chunkSize = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+    }
+    else if (arg.compare(0, 2, "--") != 0)
+    {
+      args.push_back(arg);
+    }
+    else
+    {
+      printf(usage, argv[0]);
+      return 1;
+    }
   }
 
-  std::cout << channels.size() << " Channels\n";
-  std::cout << channels[0].getSamples() << " Samples\n";
-
-  string outIqtarStr = argv[1];
-  outIqtarStr = outIqtarStr + ".iq.tar";
-  IqTar iqtar(outIqtarStr);
-  string applicationName = argv[1];
-  if (metadata.find("ApplicationName") != metadata.end())
+  FileType outType;
+  if (args.size() < 2 || false == parseFileType(format, outType))
   {
-    applicationName = metadata.at("ApplicationName");
-    std::cout << "ApplicationName: " << applicationName << "\n";
+    printf(usage, argv[0]);
+    return 1;
   }
-  ret = iqtar.writeOpen(IqDataFormat::Complex, 1, "wv to iqtar conversion", applicationName, channels, &metadata);
-  if (ret != ErrorCodes::Success)
+
+  BatchConverter converter(outType, args[0]);
+  converter.setNofThreads(nofThreads);
+  if ((maxMemory > 0 && converter.setMaxBufferMemory(maxMemory) != ErrorCodes::Success)
+    || (maxTempFiles > 0 && converter.setMaxTempFiles(maxTempFiles) != ErrorCodes::Success)
+    || (chunkSize > 0 && converter.setChunkSize(chunkSize) != ErrorCodes::Success))
   {
-    printf("iq.tar file open for write failed\n");
-    exit(1);
+    printf(usage, argv[0]);
+    return 1;
   }
-  size_t read = 0;
-  size_t offset = 0;
-  size_t toRead = channels[0].getSamples();
 
-  std::cout << toRead / 1E6 << " MSamples\n";
-  std::cout << "writing iq.tar file\n";
-  while (toRead > 0)
+  for (size_t i = 1; i < args.size(); ++i)
   {
-    size_t readNow = toRead;
-    if (readNow > (size_t)1E7) readNow = (size_t)1E7;
-    vector<float> valuesIQ;
-    ret = inWv.readChannel(channels[0].getChannelName(), valuesIQ, readNow, read);
-    if (ret != ErrorCodes::Success)
+    FileType inType;
+    bool valid = inputFormat.empty() ? fileTypeFromExtension(args[i], inType) : parseFileType(inputFormat, inType);
+    if (false == valid)
     {
-      printf("wv read channel failed\n");
-      exit(1);
+      printf("unknown format of input file %s, use --input-format\n", args[i].c_str());
+      return 1;
     }
-    vector<vector<float>> writeChan;
-    writeChan.push_back(valuesIQ);
-    ret = iqtar.appendChannels(writeChan);
-    if (ret != ErrorCodes::Success)
+
+    if (converter.addFiles(args[i], inType) != ErrorCodes::Success)
     {
-      printf("iqtar append channel failed\n");
-      exit(1);
+      printf("no file found for %s\n", args[i].c_str());
+      return 1;
     }
-    toRead -= readNow;
-    offset += readNow;
-    read += readNow;
-    std::cout << "\r" << read / 1E6 << " MSamples converted";
   }
 
-  inWv.close();
-  std::cout << "\nclosing iq.tar file\n";
+  std::cout << "converting " << converter.getNofFiles() << " files to " << args[0] << "\n";
+  int ret = converter.convert();
+  for (size_t i = 0; i < converter.getNofFiles(); ++i)
+  {
+    if (converter.getResult(i) != ErrorCodes::Success)
+    {
+      printf("%s failed with error code %d\n", converter.getInputFilename(i).c_str(), converter.getResult(i));
+    }
+  }
 
-  iqtar.close();
-  std::cout << "done\n";
-  return 0;
+  std::cout << converter.getBytesConverted() / 1E6 << " MB converted in " << converter.getElapsedSeconds() << " s, "
+    << converter.getMegabytesPerSecond() << " MB/s\n";
+  return (ret == ErrorCodes::Success) ? 0 : 1;
+}
+
+int iqx2iqtar(int argc, const char* argv[])
+{
+  if (argc != 2)
+  {
+    printf("call %s <iqx-file>\n", argv[0]);
+    exit(1);
+  }
+
+  string outIqtarStr = argv[1];
+  outIqtarStr = outIqtarStr + ".iq.tar";
+  return convertFile(argv[1], FileType::IQX, outIqtarStr, FileType::Iqtar, 0, 0, "float32");
+}
+
+int wv2iqtar(int argc, const char* argv[])
+{
+  if (argc != 2)
+  {
+    printf("call %s <wv-file>\n", argv[0]);
+    exit(1);
+  }
+
+  string outIqtarStr = argv[1];
+  outIqtarStr = outIqtarStr + ".iq.tar";
+  return convertFile(argv[1], FileType::WV, outIqtarStr, FileType::Iqtar, 0, 0, "float32");
 }
 
 int wvinfo(int argc, const char* argv[])
@@ -320,6 +394,16 @@ int main( int argc, const char* argv[] )
 #endif
 
 #if 1
+  if (argc > 1 && string(argv[1]) == "convert")
+  {
+    return convert(argc, argv);
+  }
+
+  if (argc > 1 && string(argv[1]) == "batch")
+  {
+    return batch(argc, argv);
+  }
+
   iqx2iqtar(argc, argv);
   //wv2iqtar(argc, argv);
 
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include "iqbitconverter.h"
+
+#include <cstdint>
+#include <vector>
+
+using IQW::IqBitConverter;
+
+namespace
+{
+  // state.range(0): number of DIGIQ words, state.range(1): IqBitConverter::SimdLevel
+  void applyLevel(benchmark::State& state)
+  {
+    if (!IqBitConverter::setSimdLevel(static_cast<IqBitConverter::SimdLevel>(state.range(1))))
+    {
+      state.SkipWithError("instruction set not supported by the cpu");
+    }
+  }
+
+  // throughput in bytes of 12 bit data
+  void setThroughput(benchmark::State& state)
+  {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * DIGIQ_WORD_SIZE);
+  }
+
+  void BM_Conv12to16(benchmark::State& state)
+  {
+    applyLevel(state);
+    const size_t words = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> data12(words * DIGIQ_WORD_SIZE, 0x5A);
+    std::vector<uint16_t> data16(words * SAMPLES_REAL12_PER_DIGIQ_WORD);
+
+    for (auto _ : state)
+    {
+      IqBitConverter::conv12to16(data12.data(), data16.data(), data12.size());
+      benchmark::DoNotOptimize(data16.data());
+    }
+    setThroughput(state);
+    IqBitConverter::setSimdLevel(IqBitConverter::getSupportedSimdLevel());
+  }
+
+  void BM_Conv16to12(benchmark::State& state)
+  {
+    applyLevel(state);
+    const size_t words = static_cast<size_t>(state.range(0));
+    std::vector<uint16_t> data16(words * SAMPLES_REAL12_PER_DIGIQ_WORD, 0x5A50);
+    std::vector<uint8_t> data12(words * DIGIQ_WORD_SIZE);
+
+    for (auto _ : state)
+    {
+      IqBitConverter::conv16to12(data16.data(), data12.data(), data16.size() * sizeof(uint16_t));
+      benchmark::DoNotOptimize(data12.data());
+    }
+    setThroughput(state);
+    IqBitConverter::setSimdLevel(IqBitConverter::getSupportedSimdLevel());
+  }
+
+  // 4096 words (128 KB) stay in the cache, so that the conversion and not the memory bandwidth is measured
+  void bitConverterArgs(benchmark::internal::Benchmark* b)
+  {
+    for (int level = IqBitConverter::SimdNone; level <= IqBitConverter::SimdAvx512Vbmi; ++level)
+    {
+      b->Args({ 4096, level });
+      b->Args({ 131072, level });
+    }
+    b->ArgNames({ "words", "simd" });
+  }
+}
+
+BENCHMARK(BM_Conv12to16)->Apply(bitConverterArgs);
+BENCHMARK(BM_Conv16to12)->Apply(bitConverterArgs);
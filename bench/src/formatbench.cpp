@@ -0,0 +1,314 @@
+#include <benchmark/benchmark.h>
+
+#include "dataimportexport.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace rohdeschwarz::mosaik::dataimportexport;
+
+// Throughput of writing, closing and reading each file type with synthetic I/Q data.
+// Run with --benchmark_out=<file> --benchmark_out_format=json to track the results across releases.
+// The environment variables DAIBENCH_SAMPLES (samples per channel, default 262144) and DAIBENCH_DIR
+// (directory of the files written, default current directory) change the setup.
+namespace
+{
+  enum class Operation
+  {
+    Write,
+    Close,
+    ReadSequential,
+    ReadRandom
+  };
+
+  struct Config
+  {
+    Operation operation;
+    FileType fileType;
+    IqDataFormat format;
+    size_t nofChannels;
+
+    // iq.tar only
+    bool preview;
+
+    // iq.tar: data file size unknown in advance, IQW: non-interleaved data order
+    bool tempFile;
+  };
+
+  // number of samples per channel and call of appendChannels() or readChannel()
+  const size_t ChunkSize = 65536;
+
+  size_t getNofSamples()
+  {
+    const char* samples = std::getenv("DAIBENCH_SAMPLES");
+    return (samples != nullptr) ? static_cast<size_t>(std::strtoull(samples, nullptr, 10)) : 262144;
+  }
+
+  std::string getFilename(FileType fileType)
+  {
+    const char* dir = std::getenv("DAIBENCH_DIR");
+    return std::string(dir != nullptr ? dir : ".") + "/daibench." + FileTypeService::getFileExtension(fileType);
+  }
+
+  size_t getValuesPerSample(IqDataFormat format)
+  {
+    return (format == IqDataFormat::Real) ? 1 : 2;
+  }
+
+  // readChannel() of IQX, WV and AID counts I/Q pairs, the other file types count values
+  size_t getReadChannelCount(const Config& config, size_t nofSamples)
+  {
+    if (config.fileType == FileType::IQX || config.fileType == FileType::WV || config.fileType == FileType::AID)
+    {
+      return nofSamples;
+    }
+
+    return getValuesPerSample(config.format) * nofSamples;
+  }
+
+  template<typename T>
+  IqDataType getDataType()
+  {
+    return (sizeof(T) == sizeof(double)) ? IqDataType::Float64 : IqDataType::Float32;
+  }
+
+  template<typename T>
+  int writeOpen(const Config& config, IDataImportExport& file, size_t nofSamples)
+  {
+    IqTar* iqtar = dynamic_cast<IqTar*>(&file);
+    if (iqtar != nullptr)
+    {
+      iqtar->setPreviewEnabled(config.preview);
+      if (false == config.tempFile)
+      {
+        iqtar->disableTempFile(nofSamples, config.nofChannels, config.format, getDataType<T>());
+      }
+    }
+
+    Iqw* iqw = dynamic_cast<Iqw*>(&file);
+    if (iqw != nullptr)
+    {
+      iqw->setDataOrder(config.tempFile ? IqDataOrder::IIIQQQ : IqDataOrder::IQIQIQ);
+    }
+
+    std::vector<ChannelInfo> channelInfos;
+    for (size_t ch = 0; ch < config.nofChannels; ++ch)
+    {
+      channelInfos.push_back(ChannelInfo("Channel" + std::to_string(ch + 1), 10e6, 1e9 + ch * 1e6));
+    }
+
+    return file.writeOpen(config.format, config.nofChannels * getValuesPerSample(config.format), "daibench", "synthetic data", channelInfos);
+  }
+
+  // writes the file, the durations of writing and closing are returned separately
+  template<typename T>
+  int writeFile(const Config& config, const std::string& filename, size_t nofSamples, double& writeSeconds, double& closeSeconds)
+  {
+    const size_t valuesPerSample = getValuesPerSample(config.format);
+
+    // one chunk of a sine per channel, appended repeatedly
+    std::vector<std::vector<T>> chunk(config.nofChannels, std::vector<T>(valuesPerSample * ChunkSize));
+    for (size_t ch = 0; ch < config.nofChannels; ++ch)
+    {
+      for (size_t i = 0; i < chunk[ch].size(); ++i)
+      {
+        chunk[ch][i] = static_cast<T>(std::sin(0.001 * (ch + 1) * i));
+      }
+    }
+
+    std::vector<T*> values;
+    for (auto& channel : chunk)
+    {
+      values.push_back(channel.data());
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<IDataImportExport> file(FileTypeService::create(filename, config.fileType));
+    if (file == nullptr)
+    {
+      return ErrorCodes::InvalidDataFormat;
+    }
+
+    int ret = writeOpen<T>(config, *file, nofSamples);
+    for (size_t written = 0; ret == ErrorCodes::Success && written < nofSamples; written += ChunkSize)
+    {
+      const size_t n = std::min(ChunkSize, nofSamples - written);
+      ret = file->appendChannels(values, std::vector<size_t>(config.nofChannels, valuesPerSample * n));
+    }
+
+    const auto written = std::chrono::steady_clock::now();
+    int closeRet = file->close();
+    const auto closed = std::chrono::steady_clock::now();
+
+    writeSeconds = std::chrono::duration<double>(written - start).count();
+    closeSeconds = std::chrono::duration<double>(closed - written).count();
+    return (ret != ErrorCodes::Success) ? ret : closeRet;
+  }
+
+  // reads all channels in chunks, at increasing or random offsets
+  template<typename T>
+  int readFile(const Config& config, const std::string& filename, size_t nofSamples, std::vector<T>& buffer, std::mt19937& random)
+  {
+    std::unique_ptr<IDataImportExport> file(FileTypeService::create(filename, config.fileType));
+    if (file == nullptr)
+    {
+      return ErrorCodes::InvalidDataFormat;
+    }
+
+    std::vector<std::string> arrayNames;
+    int ret = file->readOpen(arrayNames);
+
+    std::vector<ChannelInfo> channelInfos;
+    std::map<std::string, std::string> metadata;
+    if (ret == ErrorCodes::Success)
+    {
+      ret = file->getMetadata(channelInfos, metadata);
+    }
+
+    const size_t nofChunks = (nofSamples + ChunkSize - 1) / ChunkSize;
+    std::uniform_int_distribution<size_t> chunks(0, nofChunks - 1);
+    for (size_t i = 0; ret == ErrorCodes::Success && i < nofChunks; ++i)
+    {
+      const size_t chunk = (config.operation == Operation::ReadRandom) ? chunks(random) : i;
+      const size_t n = std::min(ChunkSize, nofSamples - chunk * ChunkSize);
+      for (size_t ch = 0; ret == ErrorCodes::Success && ch < channelInfos.size(); ++ch)
+      {
+        ret = file->readChannel(channelInfos[ch].getChannelName(), buffer.data(), getReadChannelCount(config, n), chunk * ChunkSize);
+      }
+    }
+
+    file->close();
+    return ret;
+  }
+
+  template<typename T>
+  void runBenchmark(benchmark::State& state, Config config)
+  {
+    const size_t nofSamples = getNofSamples();
+    const std::string filename = getFilename(config.fileType);
+    const bool read = config.operation == Operation::ReadSequential || config.operation == Operation::ReadRandom;
+
+    double writeSeconds = 0;
+    double closeSeconds = 0;
+    if (read && writeFile<T>(config, filename, nofSamples, writeSeconds, closeSeconds) != ErrorCodes::Success)
+    {
+      state.SkipWithError("writing the file is not supported");
+      std::remove(filename.c_str());
+      return;
+    }
+
+    std::vector<T> buffer(getValuesPerSample(config.format) * ChunkSize);
+    std::mt19937 random(42);
+    for (auto _ : state)
+    {
+      int ret = ErrorCodes::Success;
+      if (read)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        ret = readFile<T>(config, filename, nofSamples, buffer, random);
+        state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      }
+      else
+      {
+        ret = writeFile<T>(config, filename, nofSamples, writeSeconds, closeSeconds);
+        state.SetIterationTime(config.operation == Operation::Write ? writeSeconds : closeSeconds);
+        std::remove(filename.c_str());
+      }
+
+      if (ret != ErrorCodes::Success)
+      {
+        state.SkipWithError(read ? "reading the file failed" : "writing the file is not supported");
+        break;
+      }
+    }
+
+    if (read)
+    {
+      std::remove(filename.c_str());
+    }
+
+    const int64_t bytes = static_cast<int64_t>(nofSamples * config.nofChannels * getValuesPerSample(config.format) * sizeof(T));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * bytes);
+    state.counters["samples"] = static_cast<double>(nofSamples);
+  }
+
+  std::string getName(const Config& config, bool isDouble)
+  {
+    const char* operations[] = { "Write", "Close", "ReadSequential", "ReadRandom" };
+    std::string name = std::string("BM_") + operations[static_cast<int>(config.operation)] + "/"
+      + FileTypeService::getFileExtension(config.fileType) + (config.fileType == FileType::Matlab4 ? "4" : (config.fileType == FileType::Matlab73 ? "73" : ""))
+      + (isDouble ? "/double" : "/float")
+      + (config.format == IqDataFormat::Real ? "/real" : "/complex")
+      + "/channels:" + std::to_string(config.nofChannels);
+
+    if (config.fileType == FileType::Iqtar)
+    {
+      name += std::string("/preview:") + (config.preview ? "on" : "off");
+    }
+
+    if (config.fileType == FileType::Iqtar || config.fileType == FileType::IQW)
+    {
+      name += std::string("/tempfile:") + (config.tempFile ? "on" : "off");
+    }
+
+    return name;
+  }
+
+  void registerBenchmarks(const Config& config)
+  {
+    benchmark::RegisterBenchmark(getName(config, false).c_str(), runBenchmark<float>, config)->UseManualTime()->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark(getName(config, true).c_str(), runBenchmark<double>, config)->UseManualTime()->Unit(benchmark::kMillisecond);
+  }
+
+  // registers all combinations supported by the file types
+  bool registerAll()
+  {
+    const Operation operations[] = { Operation::Write, Operation::Close, Operation::ReadSequential, Operation::ReadRandom };
+    for (Operation operation : operations)
+    {
+      for (FileType fileType : FileTypeService::getPossibleFileFormats())
+      {
+        // IQW, IQX, WV and AID store one complex channel
+        const bool multiChannel = fileType == FileType::Iqtar || fileType == FileType::Csv || fileType == FileType::Matlab4 || fileType == FileType::Matlab73;
+        for (IqDataFormat format : { IqDataFormat::Complex, IqDataFormat::Real })
+        {
+          if (format == IqDataFormat::Real && false == multiChannel)
+          {
+            continue;
+          }
+
+          for (size_t nofChannels : { 1, 2, 4, 8, 16 })
+          {
+            if (nofChannels > 1 && false == multiChannel)
+            {
+              break;
+            }
+
+            const bool previewOptions[] = { true, false };
+            const bool tempFileOptions[] = { true, false };
+            const size_t nofPreviewOptions = (fileType == FileType::Iqtar) ? 2 : 1;
+            const size_t nofTempFileOptions = (fileType == FileType::Iqtar || fileType == FileType::IQW) ? 2 : 1;
+            for (size_t p = 0; p < nofPreviewOptions; ++p)
+            {
+              for (size_t t = 0; t < nofTempFileOptions; ++t)
+              {
+                Config config = { operation, fileType, format, nofChannels, previewOptions[p] && fileType == FileType::Iqtar, tempFileOptions[t] };
+                registerBenchmarks(config);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    return true;
+  }
+
+  const bool registered = registerAll();
+}
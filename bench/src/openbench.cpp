@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include "dataimportexport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rohdeschwarz::mosaik::dataimportexport;
+
+// Opening and closing small iq.tar files from several threads, like the workers of an ingest service.
+// Every thread uses its own file, so the number of files opened or written per second scales with
+// the number of threads unless the library serializes the threads.
+// The environment variable DAIBENCH_DIR sets the directory of the files written.
+namespace
+{
+  // number of complex samples per file, small enough that the tar headers dominate
+  const size_t NofSamples = 1024;
+
+  // distinguishes the files of the threads
+  std::atomic<int> fileIndex(0);
+
+  std::string getFilename()
+  {
+    const char* dir = std::getenv("DAIBENCH_DIR");
+    return std::string(dir != nullptr ? dir : ".") + "/daibench_open" + std::to_string(fileIndex++) + ".iq.tar";
+  }
+
+  // writes values as I and Q of one complex channel
+  int writeFile(const std::string& filename, const std::vector<float>& values)
+  {
+    IqTar file(filename);
+    file.disableTempFile(NofSamples, 1, IqDataFormat::Complex, IqDataType::Float32);
+
+    std::vector<ChannelInfo> channelInfos(1, ChannelInfo("Channel1", 10e6, 1e9));
+    int ret = file.writeOpen(IqDataFormat::Complex, 2, "daibench", "synthetic data", channelInfos);
+    if (ret == ErrorCodes::Success)
+    {
+      ret = file.appendArrays(std::vector<std::vector<float>>(2, values));
+    }
+
+    const int closeRet = file.close();
+    return (ret != ErrorCodes::Success) ? ret : closeRet;
+  }
+
+  int readFile(const std::string& filename)
+  {
+    IqTar file(filename);
+
+    std::vector<std::string> arrayNames;
+    int ret = file.readOpen(arrayNames);
+
+    std::vector<ChannelInfo> channelInfos;
+    std::map<std::string, std::string> metadata;
+    if (ret == ErrorCodes::Success)
+    {
+      ret = file.getMetadata(channelInfos, metadata);
+    }
+
+    file.close();
+    return ret;
+  }
+
+  // readOpen(), getMetadata() and close() of an existing file
+  void BM_OpenParallel(benchmark::State& state)
+  {
+    const std::string filename = getFilename();
+    if (writeFile(filename, std::vector<float>(NofSamples, 0.5f)) != ErrorCodes::Success)
+    {
+      state.SkipWithError("writing the file failed");
+      std::remove(filename.c_str());
+      return;
+    }
+
+    for (auto _ : state)
+    {
+      if (readFile(filename) != ErrorCodes::Success)
+      {
+        state.SkipWithError("reading the file failed");
+        break;
+      }
+    }
+
+    std::remove(filename.c_str());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  }
+
+  // writeOpen(), appendArrays() and close(), which writes the tar headers of data, xml and xslt file
+  void BM_WriteCloseParallel(benchmark::State& state)
+  {
+    const std::string filename = getFilename();
+    const std::vector<float> values(NofSamples, 0.5f);
+    for (auto _ : state)
+    {
+      if (writeFile(filename, values) != ErrorCodes::Success)
+      {
+        state.SkipWithError("writing the file failed");
+        break;
+      }
+    }
+
+    std::remove(filename.c_str());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  }
+
+  bool registerAll()
+  {
+    const int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    benchmark::RegisterBenchmark("BM_OpenParallel/iq.tar", BM_OpenParallel)->ThreadRange(1, maxThreads)->UseRealTime()->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark("BM_WriteCloseParallel/iq.tar", BM_WriteCloseParallel)->ThreadRange(1, maxThreads)->UseRealTime()->Unit(benchmark::kMicrosecond);
+    return true;
+  }
+
+  const bool registered = registerAll();
+}
@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+
+#include "TypesExtended.h"
+#include "replacement.h"
+
+#include <vector>
+
+namespace
+{
+  // state.range(0): number of values, state.range(1): SimdLevel
+  void applyLevel(benchmark::State& state)
+  {
+    const SimdLevel requested = static_cast<SimdLevel>(state.range(1));
+    if (SetSimdLevel(requested) != requested)
+    {
+      state.SkipWithError("instruction set not supported by the cpu");
+    }
+  }
+
+  void setThroughput(benchmark::State& state, size_t bytesPerValue)
+  {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * static_cast<int64_t>(bytesPerValue));
+  }
+
+  void BM_ConvertMulC_int16(benchmark::State& state)
+  {
+    applyLevel(state);
+    const int len = static_cast<int>(state.range(0));
+    std::vector<int16_t> src(len);
+    std::vector<float> dst(len);
+    for (int i = 0; i < len; ++i)
+    {
+      src[i] = static_cast<int16_t>(i * 31);
+    }
+
+    for (auto _ : state)
+    {
+      ConvertMulC_int16_t_float(src.data(), 1.0f / 32768.0f, dst.data(), len);
+      benchmark::DoNotOptimize(dst.data());
+    }
+    setThroughput(state, sizeof(int16_t));
+  }
+
+  // the two pass variant used by the AID reader before the fused kernel
+  void BM_Convert_MulC_int16(benchmark::State& state)
+  {
+    applyLevel(state);
+    const int len = static_cast<int>(state.range(0));
+    std::vector<int16_t> src(len);
+    std::vector<float> dst(len);
+    for (int i = 0; i < len; ++i)
+    {
+      src[i] = static_cast<int16_t>(i * 31);
+    }
+
+    for (auto _ : state)
+    {
+      Convert_int16_t_float(src.data(), dst.data(), len);
+      MulC_float(1.0f / 32768.0f, dst.data(), len);
+      benchmark::DoNotOptimize(dst.data());
+    }
+    setThroughput(state, sizeof(int16_t));
+  }
+
+  void BM_ConvertMulC_int32(benchmark::State& state)
+  {
+    applyLevel(state);
+    const int len = static_cast<int>(state.range(0));
+    std::vector<int32_t> src(len);
+    std::vector<float> dst(len);
+    for (int i = 0; i < len; ++i)
+    {
+      src[i] = i * 65537;
+    }
+
+    for (auto _ : state)
+    {
+      ConvertMulC_int32_t_float(src.data(), 1.0f / 2147483648.0f, dst.data(), len);
+      benchmark::DoNotOptimize(dst.data());
+    }
+    setThroughput(state, sizeof(int32_t));
+  }
+
+  void BM_MulC_float(benchmark::State& state)
+  {
+    applyLevel(state);
+    const int len = static_cast<int>(state.range(0));
+    std::vector<float> src(len, 0.5f);
+    std::vector<float> dst(len);
+
+    for (auto _ : state)
+    {
+      MulC_float(src.data(), 0.25f, dst.data(), len);
+      benchmark::DoNotOptimize(dst.data());
+    }
+    setThroughput(state, sizeof(float));
+  }
+
+  void BM_CplxToReal(benchmark::State& state)
+  {
+    applyLevel(state);
+    const int len = static_cast<int>(state.range(0));
+    std::vector<floatc> src(len);
+    std::vector<float> re(len);
+    std::vector<float> im(len);
+
+    for (auto _ : state)
+    {
+      CplxToReal_floatc(src.data(), re.data(), im.data(), len);
+      benchmark::DoNotOptimize(re.data());
+      benchmark::DoNotOptimize(im.data());
+    }
+    setThroughput(state, sizeof(floatc));
+  }
+
+  void BM_RealToCplx(benchmark::State& state)
+  {
+    applyLevel(state);
+    const int len = static_cast<int>(state.range(0));
+    std::vector<float> re(len, 1.0f);
+    std::vector<float> im(len, -1.0f);
+    std::vector<floatc> dst(len);
+
+    for (auto _ : state)
+    {
+      RealToCplx_float(re.data(), im.data(), dst.data(), len);
+      benchmark::DoNotOptimize(dst.data());
+    }
+    setThroughput(state, sizeof(floatc));
+  }
+
+  // 131072 values is the AID block size used by the writer
+  void kernelArgs(benchmark::internal::Benchmark* b)
+  {
+    for (int level = SimdNone; level <= SimdAvx2; ++level)
+    {
+      b->Args({ 4096, level });
+      b->Args({ 131072, level });
+    }
+    b->ArgNames({ "values", "simd" });
+  }
+}
+
+BENCHMARK(BM_ConvertMulC_int16)->Apply(kernelArgs);
+BENCHMARK(BM_Convert_MulC_int16)->Apply(kernelArgs);
+BENCHMARK(BM_ConvertMulC_int32)->Apply(kernelArgs);
+BENCHMARK(BM_MulC_float)->Apply(kernelArgs);
+BENCHMARK(BM_CplxToReal)->Apply(kernelArgs);
+BENCHMARK(BM_RealToCplx)->Apply(kernelArgs);
@@ -116,6 +116,16 @@ namespace AmlabFiles
         @return Error status */
     eStatus read(ContainerType& a_Data, uint32 a_elements, bool& a_rDataInfoChanged);
 
+    /*! Read a number of samples as stored in the file, without conversion to volts.
+        The samples are stored as interleaved I/Q values in the memory of the container.
+        @param a_Data       Container, used as memory for the values
+        @param a_elements   Number of samples to read
+        @param a_valueSize  Size of the values, 2 = int16 or 4 = int32
+        @param a_rScale     The out parameter returns the factor converting the values to volts
+        @return Error status, ekUnsupportedFileFormat if the samples cannot be stored as values of
+                the size and ekInvalidParameters if the scale changes within the samples */
+    eStatus readRaw(ContainerType& a_Data, uint32 a_elements, uint32 a_valueSize, float& a_rScale);
+
     /*! Set the observer interface
         The observer interface IIQObserver providing a method to ask
         the observer of continuing to read after changes of attributes
@@ -127,6 +137,15 @@ namespace AmlabFiles
         @param a_samplesForTimestamp  Time delta to watch changes of timestamps */
     void setAttributesChangeObserver(IIQObserver* a_pObserver, uint32 a_observerAttributes, uint32 a_samplesForTimestamp);
 
+    /*! Enable or disable the frame index sidecar file (<filename>.zfidx).
+        On open the file is scanned once to build an index of all frames.
+        If enabled, a valid sidecar file is used instead of scanning the file
+        and a newly built index is stored into the sidecar file. A sidecar file
+        is valid if it matches the size and the modification time of the file.
+        These setting have only effect on closed mode(isOpen() == fales).
+        @param a_enabled true = use the sidecar file */
+    void setFrameIndexFileEnabled(bool a_enabled);
+
     /*! Return the number of samples containing within the file */
     uint64 getNumberOfSamples() const;
 
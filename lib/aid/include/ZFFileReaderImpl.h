@@ -24,6 +24,8 @@
 #include "rs_gx40x_global_ifdata_header_if_defs.h"
 #include "rs_gx40x_global_frame_types_if_defs.h"
 #include "IIQObserver.h"
+#include "memory_mapped_file.hpp"
+#include <vector>
 
 namespace AmlabFiles
 {
@@ -39,6 +41,17 @@ namespace AmlabFiles
   /*! Size of frame header in bytes */
   const int32 c_sizeofZFFrameHeader  = sizeof(typFRH_FRAMEHEADER);
 
+  /*! Entry of the frame offset index, one per valid IF data frame */
+  struct ZFFrameIndexEntry
+  {
+    int64  offset;          /*!< File offset of the frame header */
+    uint64 firstSample;     /*!< Index of the first sample of the frame within the file */
+    uint64 sampleCounter;   /*!< Sample counter of the data header (0 without extended data header) */
+    uint64 timestamp;       /*!< Timestamp of the data header [microsecs] */
+    uint32 samples;         /*!< Number of samples within the frame */
+    uint32 frameLength;     /*!< Frame length in 32 bit words */
+  };
+
   /* CLASS DECLARATION *********************************************/
   /*!
    * @brief   The class CZFFileReaderImpl provide a implementation
@@ -96,6 +109,13 @@ namespace AmlabFiles
 
     /* BEGIN IIQSource-Interface */
     eStatus read(ContainerType& a_Data, uint32 a_elements, bool& a_rDataInfoChanged);
+    /*! Read a number of samples as stored in the file, without conversion to volts.
+        The samples are stored as interleaved I/Q values of a_valueSize bytes (2 = int16, 4 = int32)
+        in the memory of a_Data, a_Data.getSize() returns the number of samples read.
+        @param a_rScale Factor converting the values to volts
+        @return Error status, ekUnsupportedFileFormat if the samples cannot be stored as values of the size
+                and ekInvalidParameters if the scale changes within the samples */
+    eStatus readRaw(ContainerType& a_Data, uint32 a_elements, uint32 a_valueSize, float& a_rScale);
 
     void setAttributesChangeObserver(IIQObserver* a_pObserver, uint32 a_observerAttributes, uint32 a_samplesForTimestamp);
 
@@ -121,25 +141,45 @@ namespace AmlabFiles
     uint64 getGoldenSampleTimestampNS() const;
     /* END IIQSource-Interface */
 
+    /*! Enable or disable the frame index sidecar file (<filename>.zfidx).
+        If enabled, a valid sidecar is loaded on open instead of scanning the file
+        and a newly built index is stored next to the file.
+        These setting have only effect on closed mode(isOpen() == false). */
+    void setFrameIndexFileEnabled(bool a_enabled);
+
   private:
     bool    readFrame(int64 a_frameOffset, ContainerType* a_pData = NULL, uint32 a_samplesToRead = 0, uint64 a_starSampleIndex = 0);
     bool    readZFFrameFromFile(int64 a_offset);
+    bool    readZFFrameFromMapping(int64 a_offset);
+    bool    readFromFile(int64 a_offset, void* a_pBuffer, size_t a_size);
     eStatus readProperties();
-    bool    adjustData(uint8* a_pSource, uint8* a_pDestination, uint64 a_bytesToRead, uint32 a_statusword);
+    bool    buildFrameIndex();
+    bool    readFrameIndexHeaders(int64 a_offset, typFRH_FRAMEHEADER& a_rFrameHeader, typIFD_IFDATAHEADER_EX& a_rDataHeader);
+    int64   findNextMagicWord(int64 a_offset);
+    bool    loadFrameIndex();
+    void    storeFrameIndex() const;
+    size_t  findFrameIndex(uint64 a_sampleIndex) const;
+    bool    adjustData(const uint8* a_pSource, uint8* a_pDestination, uint64 a_bytesToRead, uint32 a_statusword);
+    bool    adjustRawData(const uint8* a_pSource, uint8* a_pDestination, uint64 a_bytesToRead, uint32 a_statusword);
+    float   getScaleFactor(uint32 a_statusword) const;
     uint64  getStopIndex() const;
 
     //lint -save -e826 -e1763
-    inline typFRH_FRAMEHEADER* frameHeader() const
+    inline const typFRH_FRAMEHEADER* frameHeader() const
     {
-      return reinterpret_cast<typFRH_FRAMEHEADER*>(m_pZFData);
+      return reinterpret_cast<const typFRH_FRAMEHEADER*>(m_pFrame);
     }
     //lint -restore
     //lint -save -e826 -e1763
-    inline typIFD_IFDATAHEADER_EX* dataHeader() const
+    inline const typIFD_IFDATAHEADER_EX* dataHeader() const
     {
-      return reinterpret_cast<typIFD_IFDATAHEADER_EX*>(m_pZFData + c_sizeofZFFrameHeader);
+      return reinterpret_cast<const typIFD_IFDATAHEADER_EX*>(m_pFrame + c_sizeofZFFrameHeader);
     }
     //lint -restore
+    inline bool isMapped() const
+    {
+      return m_mappedFile.data() != 0;
+    }
     inline bool isDataHeaderEx() const
     {
       return frameHeader()->uintDataHeaderLength >= (c_sizeofZFDataHeaderEx / c_sizeof_uint32);
@@ -169,6 +209,7 @@ namespace AmlabFiles
     FILE*         m_pZFFile;
     bool          m_fileOpened;
     int64         m_fileSize;
+    int64         m_fileModificationTime;
     eEndian       m_endian;
 
     typFRH_FRAMEHEADER      m_ZFFrameHeader;
@@ -186,6 +227,12 @@ namespace AmlabFiles
     uint8*        m_pZFData;
     uint32        m_ZFDataLength;
 
+    memory_mapped_file::read_only_mmf m_mappedFile;
+    const uint8*  m_pFrame;       // current frame, either within the mapping or m_pZFData
+
+    std::vector<ZFFrameIndexEntry> m_frameIndex;
+    bool          m_frameIndexFileEnabled;
+
     uint64        m_currentSampleIndex;
     uint64        m_startSampleIndex;
     uint64        m_stopSampleIndex;
@@ -197,6 +244,11 @@ namespace AmlabFiles
     uint32                    m_samplesForTimestamp;
     uint64                    m_timestampDelta;
 
+    uint32        m_rawValueSize;   // value size of readRaw(), 0 while reading volts
+    float         m_rawScale;       // scale of the samples read by readRaw()
+    bool          m_rawScaleValid;
+    eStatus       m_rawStatus;      // reason adjustRawData() failed
+
     std::wstring  m_strErrorMsg;
     eStatus       m_eStatus;
   };
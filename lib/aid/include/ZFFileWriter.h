@@ -90,11 +90,20 @@ namespace AmlabFiles
         @param a_flushOnClose Flag to flush on file close */
     void setFlushOnClose(bool a_flushOnClose);
 
+    /*! Enable or disable writing the assembled frames by a background thread.
+        These setting have only effect on closed mode(isOpen() == fales).
+        @param a_asyncWrite true = frames are written by a background thread */
+    void setAsyncWrite(bool a_asyncWrite);
+
     /*! Set the type of data carried in the frames.
         These setting have only effect on closed mode(isOpen() == fales).
         @param a_eFrameType The frame type */
     void setFrameType(uint32 a_eFrameType);
 
+    /*! Return the size of one sample in the file, as defined by the frame type.
+        @return Sample size in bytes */
+    uint32 getSampleSize() const;
+
     /*! Set the number of samples per data block an the number of data blocks.
         These setting have only effect on closed mode(isOpen() == fales).
         @param a_samplesPerBlock Number of samples per data block
@@ -23,6 +23,11 @@
 //lint -restore
 #include "rs_gx40x_global_ifdata_header_if_defs.h"
 #include "rs_gx40x_global_frame_types_if_defs.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace AmlabFiles
 {
@@ -33,6 +38,8 @@ namespace AmlabFiles
 
   /*! Default recip gain - used from ZFFileWriter as well */
   const uint16 c_recipGain           = 0xffff;
+  /*! Maximum number of assembled frames waiting for the background writer */
+  const uint32 c_asyncWriteFramesMax = 4;
 
   /* CLASS DECLARATION *********************************************/
   /*!
@@ -106,6 +113,11 @@ namespace AmlabFiles
         @param a_sampleCounter The sample counter */
     void setSampleCounter(uint64 a_sampleCounter);
 
+    /*! Enable or disable writing the assembled frames by a background thread.
+        These setting have only effect on closed mode(isOpen() == false).
+        @param a_asyncWrite true = frames are written by a background thread */
+    void setAsyncWrite(bool a_asyncWrite);
+
     /*! Return the signal sample rate in samples per second */
     uint32 getSampleRate() const;
     /*! Return the size of a sample in bytes */
@@ -116,8 +128,11 @@ namespace AmlabFiles
     uint64 getSampleCounter() const;
 
   private:
-    void    writeFrame(const uint8* a_data, uint32 a_elements);
-    void    flush();
+    bool    writeFrame(const uint8* a_data, uint32 a_elements);
+    bool    writeFrameBuffer();
+    void    asyncWriteLoop();
+    void    stopAsyncWrite();
+    bool    flush();
     bool    convert(const float* a_src, uint8* a_dest, int32 a_elements) const;
     CZFFileWriterImpl& operator<<(const typFRH_FRAMEHEADER& a_frameHeader);
     CZFFileWriterImpl& operator<<(const char* const a_pDataHeader);
@@ -142,6 +157,17 @@ namespace AmlabFiles
     typIFD_IFDATAHEADER_EX  m_ZFDataHeader;
     uint16                  m_recipGain;
 
+    std::vector<uint8>      m_frameBuffer;      // assembly buffer of one complete frame
+
+    bool                              m_asyncWrite;
+    std::thread                       m_asyncWriteThread;
+    std::mutex                        m_asyncWriteMutex;
+    std::condition_variable           m_asyncWriteCondition;
+    std::deque<std::vector<uint8> >   m_pendingFrames;    // assembled frames to be written
+    std::vector<std::vector<uint8> >  m_freeFrames;       // written frames for reuse
+    bool                              m_asyncWriteStop;
+    bool                              m_asyncWriteError;
+
     std::wstring  m_strErrorMsg;
     eStatus       m_eStatus;
   };
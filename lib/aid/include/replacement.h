@@ -13,11 +13,26 @@ typedef int RoundMode;
 
 char * ippGetStatusString(Status ipps);
 
+/* Instruction set used by the kernels below. The best level supported by the cpu is selected at runtime. */
+enum SimdLevel
+{
+  SimdNone = 0,
+  SimdSse2 = 1,
+  SimdAvx2 = 2
+};
+/* returns the instruction set in use */
+SimdLevel GetSimdLevel();
+/* restricts the instruction set (e.g. to compare with the scalar kernels), returns the level in use */
+SimdLevel SetSimdLevel(SimdLevel level);
+
 Status SwapBytes_uint32_t(uint32_t* pSrcDst, int len);
 Status Convert_int16_t_float(const int16_t* pSrc, float* pDst, int len);
 Status Convert_int32_t_float(const int32_t* pSrc, float* pDst, int len);
 Status MulC_float(float val, float* pSrcDst, int len);
 Status MulC_float(const float* pSrc, float val, float* pDst, int len);
+/* fused Convert + MulC: pDst[i] = (float)pSrc[i] * val in a single pass */
+Status ConvertMulC_int16_t_float(const int16_t* pSrc, float val, float* pDst, int len);
+Status ConvertMulC_int32_t_float(const int32_t* pSrc, float val, float* pDst, int len);
 Status RealToCplx_float(const float* pSrcRe, const float* pSrcIm, floatc* pDst, int len);
 Status CplxToReal_floatc(const floatc* pSrc, float* pDstRe, float* pDstIm, int len);
 
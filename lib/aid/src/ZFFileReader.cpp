@@ -124,6 +124,11 @@ namespace AmlabFiles
     return m_pImpl->read(a_Data, a_elements, a_rDataInfoChanged);
   }
 
+  eStatus CZFFileReader::readRaw(ContainerType& a_Data, uint32 a_elements, uint32 a_valueSize, float& a_rScale)
+  {
+    return m_pImpl->readRaw(a_Data, a_elements, a_valueSize, a_rScale);
+  }
+
   eStatus CZFFileReader::setReadMarker(uint64 a_startSampleIndex, uint64 a_stopSampleIndex)
   {
     if (!isOpen())
@@ -275,6 +280,11 @@ namespace AmlabFiles
     m_pImpl->setAttributesChangeObserver(a_pObserver,a_observerAttributes, a_samplesForTimestamp);
   }
 
+  void CZFFileReader::setFrameIndexFileEnabled(bool a_enabled)
+  {
+    m_pImpl->setFrameIndexFileEnabled(a_enabled);
+  }
+
 }
 
 /**********************************************************************************/
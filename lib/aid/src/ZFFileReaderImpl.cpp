@@ -15,12 +15,14 @@
 */
 
 /* INCLUDE FILES ******************************************************************/
+#include <algorithm>
 #include <cstring>
 #include "ErrCtrl.h"
 #include "ZFFileReaderImpl.h"
 #include "replacement.h"
 #include <iostream>
 #include <sstream>
+#include <sys/stat.h>
 #ifndef _WIN32
 #include <cmath>
 #endif
@@ -47,6 +49,66 @@ namespace AmlabFiles
 
   const uint32  c_samplesForTimestamp = 10;
 
+  /*! Frame index sidecar file: extension, magic and version */
+  const wchar_t c_frameIndexFileExtension[] = L".zfidx";
+  const char    c_frameIndexFileMagic[8]    = { 'Z', 'F', 'I', 'D', 'X', 0, 0, 0 };
+  const uint32  c_frameIndexFileVersion     = 2;
+  /*! Buffer size used for the magic word search */
+  const uint32  c_syncBufferSize            = 0x100000;
+
+  /*! Header of the frame index sidecar file */
+  struct ZFFrameIndexFileHeader
+  {
+    char   magic[8];
+    uint32 version;
+    uint32 entrySize;
+    int64  fileSize;
+    int64  modificationTime;
+    int64  firstFrameHeaderPos;
+    uint32 frameType;
+    uint32 reserved;
+    uint64 entries;
+  };
+
+  static FILE* openFile(const std::wstring& a_strFilename, bool a_write)
+  {
+    FILE* l_pFile = 0;
+#ifdef _WIN32
+    if (::_wfopen_s(&l_pFile, a_strFilename.c_str(), a_write ? L"wb" : L"rb") != 0)
+    {
+      return 0;
+    }
+#else
+    const std::string s( a_strFilename.begin(), a_strFilename.end() );
+    l_pFile = fopen(s.c_str(), a_write ? "wb" : "rb");
+#endif
+    return l_pFile;
+  }
+
+  /*! Return the modification time of an open file [nanosecs], 0 if not available */
+  static int64 getModificationTime(FILE* a_pFile)
+  {
+#ifdef _WIN32
+    struct _stat64 l_stat;
+    if (::_fstat64(::_fileno(a_pFile), &l_stat) != 0)
+    {
+      return 0;
+    }
+    return (int64)l_stat.st_mtime * 1000000000LL;
+#else
+    struct stat l_stat;
+    if (::fstat(::fileno(a_pFile), &l_stat) != 0)
+    {
+      return 0;
+    }
+#ifdef __APPLE__
+    return (int64)l_stat.st_mtimespec.tv_sec * 1000000000LL + l_stat.st_mtimespec.tv_nsec;
+#else
+    return (int64)l_stat.st_mtim.tv_sec * 1000000000LL + l_stat.st_mtim.tv_nsec;
+#endif
+#endif
+  }
+
   /* --- PUBLIC METHODS --- */
 
   CZFFileReaderImpl::CZFFileReaderImpl()
@@ -54,12 +116,17 @@ namespace AmlabFiles
     , m_pZFFile(0)
     , m_fileOpened(false)
     , m_fileSize(0)
+    , m_fileModificationTime(0)
     , m_endian(ekUnknownEndian)
     , m_firstFrameHeaderPos(0)
     , m_dataHeader(false)
     , m_frameHeaderPos(-1)
     , m_frameCount(0)
     , m_pZFData(0)
+    , m_mappedFile()
+    , m_pFrame(0)
+    , m_frameIndex()
+    , m_frameIndexFileEnabled(false)
     , m_currentSampleIndex(0)
     , m_startSampleIndex(0)
     , m_stopSampleIndex(_UI64_MAX)
@@ -68,6 +135,10 @@ namespace AmlabFiles
     , m_observerAttributes(0)
     , m_samplesForTimestamp(c_samplesForTimestamp)
     , m_timestampDelta(0)
+    , m_rawValueSize(0)
+    , m_rawScale(0.0F)
+    , m_rawScaleValid(false)
+    , m_rawStatus(ekNoError)
     , m_strErrorMsg()
     , m_eStatus(ekNoError)
   {
@@ -87,6 +158,7 @@ namespace AmlabFiles
 
     m_ZFDataLength = c_sizeofZFFrameHeader + c_sizeofZFDataHeaderEx;
     m_pZFData = new uint8[m_ZFDataLength];
+    m_pFrame  = m_pZFData;
   }
 
   CZFFileReaderImpl::CZFFileReaderImpl(const std::wstring& a_strFilename)
@@ -94,12 +166,17 @@ namespace AmlabFiles
     , m_pZFFile(0)
     , m_fileOpened(false)
     , m_fileSize(0)
+    , m_fileModificationTime(0)
     , m_endian(ekUnknownEndian)
     , m_firstFrameHeaderPos(0)
     , m_dataHeader(false)
     , m_frameHeaderPos(-1)
     , m_frameCount(0)
     , m_pZFData(0)
+    , m_mappedFile()
+    , m_pFrame(0)
+    , m_frameIndex()
+    , m_frameIndexFileEnabled(false)
     , m_currentSampleIndex(0)
     , m_startSampleIndex(0)
     , m_stopSampleIndex(_UI64_MAX)
@@ -108,6 +185,10 @@ namespace AmlabFiles
     , m_observerAttributes(0)
     , m_samplesForTimestamp(c_samplesForTimestamp)
     , m_timestampDelta(0)
+    , m_rawValueSize(0)
+    , m_rawScale(0.0F)
+    , m_rawScaleValid(false)
+    , m_rawStatus(ekNoError)
     , m_strErrorMsg()
     , m_eStatus(ekNoError)
   {
@@ -127,10 +208,12 @@ namespace AmlabFiles
 
     m_ZFDataLength = c_sizeofZFFrameHeader + c_sizeofZFDataHeaderEx;
     m_pZFData = new uint8[m_ZFDataLength];
+    m_pFrame  = m_pZFData;
   }
 
   CZFFileReaderImpl::~CZFFileReaderImpl()
   {
+    m_mappedFile.close();
     if (m_pZFFile != 0)
     {
       ::fclose(m_pZFFile);
@@ -172,6 +255,22 @@ namespace AmlabFiles
     (void)::_fseeki64(m_pZFFile,0LL,SEEK_END);
     m_fileSize = ::_ftelli64(m_pZFFile);
     (void)::_fseeki64(m_pZFFile,0LL,SEEK_SET);
+    m_fileModificationTime = getModificationTime(m_pZFFile);
+
+    // map the whole file, frames are parsed and converted in place.
+    // Without a mapping (e.g. no address space left) the frames are read by fread.
+    if (m_fileSize > 0 && (uint64)m_fileSize <= (uint64)((size_t)-1))
+    {
+#ifdef _WIN32
+      m_mappedFile.open(m_strFilename.c_str(), true);
+#else
+      m_mappedFile.open(s.c_str(), true);
+#endif
+      if (!isMapped())
+      {
+        m_mappedFile.close();
+      }
+    }
 
     // check first frame
     if (!readFrame(0LL))
@@ -216,11 +315,21 @@ namespace AmlabFiles
 
     (void)reset();
 
+    if (isMapped())
+    {
+      // keep the headers of the current frame, the mapping is released
+      memcpy(m_pZFData, m_pFrame, c_sizeofZFFrameHeader + c_sizeofZFDataHeaderEx);
+      m_pFrame = m_pZFData;
+    }
+    m_mappedFile.close();
+
     if (m_pZFFile != 0)
     {
       ::fclose(m_pZFFile);
       m_pZFFile = 0;
     }
+    m_frameIndex.clear();
+    m_frameCount = 0;
 
     return ekNoError;
   }
@@ -514,6 +623,14 @@ namespace AmlabFiles
     }
   }
 
+  void CZFFileReaderImpl::setFrameIndexFileEnabled(bool a_enabled)
+  {
+    if (!isOpen())
+    {
+      m_frameIndexFileEnabled = a_enabled;
+    }
+  }
+
   //lint -save -e668
   /* METHOD ***********************************************************/
   /*!
@@ -572,16 +689,13 @@ namespace AmlabFiles
       l_samplesToRead = (uint32) ((l_stopIndex - m_currentSampleIndex) + 1);
       //lint -restore
     }
-    uint32 l_sampleSize   = getSampleSize();
-    uint64 l_blockSize    = m_ZFDataHeader.uintDatablockLength;
-           l_blockSize   *= m_ZFDataHeader.uintDatablockCount;
-           l_blockSize   *= c_sizeof_uint32;
-    uint64 l_frame        = m_currentSampleIndex * l_sampleSize;
-           l_frame       /= l_blockSize;
-    uint64 l_readIndex    = ((m_currentSampleIndex*l_sampleSize) % l_blockSize)/l_sampleSize;
-    //lint -save -e713 -e737
-    int64  l_frameOffset  = m_firstFrameHeaderPos + (l_frame * m_ZFFrameHeader.uintFrameLength * c_sizeof_uint32);
-    //lint -restore
+    // Frame ueber den Index suchen
+    size_t l_indexPos     = findFrameIndex(m_currentSampleIndex);
+    if (l_indexPos >= m_frameIndex.size())
+    {
+      return ekEndOfFile;
+    }
+    uint64 l_readIndex    = m_currentSampleIndex - m_frameIndex[l_indexPos].firstSample;
 
     // Daten einlesen
     do 
@@ -589,7 +703,7 @@ namespace AmlabFiles
       uint64 l_currentSampleIndex = m_currentSampleIndex;
 
       // Samples aus einem frame einlesen
-      if (!readFrame(l_frameOffset, &a_Data, l_samplesToRead - a_Data.getSize(), l_readIndex))
+      if (!readFrame(m_frameIndex[l_indexPos].offset, &a_Data, l_samplesToRead - a_Data.getSize(), l_readIndex))
       {
         return setLastError(ekReadFileError, L"Error reading data.");
       }
@@ -607,14 +721,53 @@ namespace AmlabFiles
       m_dataInfoChanged = false;
 
       // Falls notwendig, Samples aus n�chsten Frame einlesen
-      l_frameOffset += ((int64)frameHeader()->uintFrameLength * c_sizeof_uint32);
+      l_indexPos++;
       l_readIndex    = 0;
-    } while (a_Data.getSize() < l_samplesToRead);
+    } while (a_Data.getSize() < l_samplesToRead && l_indexPos < m_frameIndex.size());
 
     return ekNoError;
   }
   //lint -restore
 
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Read a number of samples as stored in the file
+  *
+  *         The samples are read like read() does, but adjustRawData()
+  *         copies the values instead of converting them to volts.
+  *
+  * @param a_Data       Container, used as memory for the values
+  * @param a_elements   Number of samples to read
+  * @param a_valueSize  Size of the values, 2 = int16, 4 = int32
+  * @param a_rScale     Factor converting the values to volts
+  *
+  * @return Error status
+  *
+  * @see adjustRawData()
+  *********************************************************************/
+  eStatus CZFFileReaderImpl::readRaw(ContainerType& a_Data, uint32 a_elements, uint32 a_valueSize, float& a_rScale)
+  {
+    if (a_valueSize != (uint32)c_sizeof_uint16 && a_valueSize != (uint32)c_sizeof_uint32)
+    {
+      return ekInvalidParameters;
+    }
+
+    // two values need at most the memory of one complex float sample
+    m_rawValueSize  = a_valueSize;
+    m_rawScaleValid = false;
+    m_rawStatus     = ekNoError;
+    bool l_dataInfoChanged = false;
+    eStatus l_status = read(a_Data, a_elements, l_dataInfoChanged);
+    m_rawValueSize  = 0;
+
+    if (m_rawStatus != ekNoError)
+    {
+      return m_rawStatus;
+    }
+    a_rScale = m_rawScale;
+    return l_status;
+  }
+
   /* --- PRIVATE METHODS --- */
 
   /* METHOD ***********************************************************/
@@ -644,6 +797,10 @@ namespace AmlabFiles
     {
       return true;
     }
+    if (isMapped() && m_endian != ekBigEndian && readZFFrameFromMapping(a_offset))
+    {
+      return true;
+    }
     int64 l_startPos = ::_ftelli64(m_pZFFile);
     if (m_dataHeader && m_frameHeaderPos == l_startPos)
     {
@@ -660,6 +817,7 @@ namespace AmlabFiles
 
     m_dataHeader     = false;
     m_frameHeaderPos = a_offset;
+    m_pFrame         = m_pZFData;
     //lint -save -e668
     if (::fread(reinterpret_cast<char*>(m_pZFData), 1, c_sizeofZFFrameHeader, m_pZFFile) != c_sizeofZFFrameHeader)
     //lint -restore
@@ -671,7 +829,7 @@ namespace AmlabFiles
     }
 
     // check the magic word
-    typFRH_FRAMEHEADER* l_pZFHeader = frameHeader();
+    typFRH_FRAMEHEADER* l_pZFHeader = reinterpret_cast<typFRH_FRAMEHEADER*>(m_pZFData);
     if (m_endian == ekUnknownEndian)
     {
       if (l_pZFHeader->uintMagicWord != kFRH_MAGIC_WORD)
@@ -730,7 +888,7 @@ namespace AmlabFiles
       }
     }
 
-    typIFD_IFDATAHEADER_EX* l_pDataHeader = dataHeader();
+    typIFD_IFDATAHEADER_EX* l_pDataHeader = reinterpret_cast<typIFD_IFDATAHEADER_EX*>(m_pZFData + c_sizeofZFFrameHeader);
     if (m_endian == ekBigEndian)
     {
       //lint -save -e713
@@ -750,7 +908,7 @@ namespace AmlabFiles
     if (m_ZFDataLength < l_pZFHeader->uintFrameLength * c_sizeof_uint32)
     {
       realloc();
-      l_pZFHeader = frameHeader();
+      l_pZFHeader = reinterpret_cast<typFRH_FRAMEHEADER*>(m_pZFData);
     }
 
     getChangedAttributs();
@@ -777,6 +935,78 @@ namespace AmlabFiles
     return true;
   }
 
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Use the frame at the given offset directly from the file mapping
+  *
+  *         The frame and data header are checked in the same way as in
+  *         readZFFrameFromFile(), but nothing is copied. The headers are
+  *         accessed in place and adjustData() converts the samples directly
+  *         from the mapping into the container.
+  *         Big endian files, incomplete and invalid frames are left to
+  *         readZFFrameFromFile().
+  *
+  * @param a_offset   File offset of frame
+  *
+  * @return true = ok, false = no complete little endian IF data frame
+  *********************************************************************/
+  bool CZFFileReaderImpl::readZFFrameFromMapping(int64 a_offset)
+  {
+    // the headers are always accessed with the size of the extended data header
+    if (a_offset < 0 || a_offset + c_sizeofZFFrameHeader + c_sizeofZFDataHeaderEx > m_fileSize)
+    {
+      return false;
+    }
+
+    //lint -save -e826
+    const uint8* l_pFrame = reinterpret_cast<const uint8*>(m_mappedFile.data()) + a_offset;
+    const typFRH_FRAMEHEADER*     l_pZFHeader   = reinterpret_cast<const typFRH_FRAMEHEADER*>(l_pFrame);
+    const typIFD_IFDATAHEADER_EX* l_pDataHeader = reinterpret_cast<const typIFD_IFDATAHEADER_EX*>(l_pFrame + c_sizeofZFFrameHeader);
+    //lint -restore
+    if (l_pZFHeader->uintMagicWord != kFRH_MAGIC_WORD)
+    {
+      return false;
+    }
+
+    bool l_bIsJumboFrame = ((l_pZFHeader->uintStatusword & kFRH_STATUSWORD__LENGTH_MAX_EX_FLAG) == kFRH_STATUSWORD__LENGTH_MAX_EX_FLAG);
+
+    // Plausibility check, the frame has to be complete
+    if (  (!l_bIsJumboFrame && (l_pZFHeader->uintFrameLength > kFRH_FRAME_LENGTH_MAX))
+        || l_pZFHeader->uintDataHeaderLength > (l_pZFHeader->uintFrameLength - c_sizeofZFFrameHeader / c_sizeof_uint32)
+        || a_offset + (int64)l_pZFHeader->uintFrameLength * c_sizeof_uint32 > m_fileSize)
+    {
+      return false;
+    }
+
+    // Check if it is a IF-Frame at all
+    if (  l_pZFHeader->uintFrameType != ekFRH_DATASTREAM__IFDATA_32RE_32IM_FIX && 
+          l_pZFHeader->uintFrameType != ekFRH_DATASTREAM__IFDATA_16RE_16IM_FIX && 
+          l_pZFHeader->uintFrameType != ekFRH_DATASTREAM__IFDATA_16RE_16RE_FIX && 
+          l_pZFHeader->uintFrameType != ekFRH_DATASTREAM__IFDATA_32RE_32IM_FIX_RESCALED && 
+          l_pZFHeader->uintFrameType != ekFRH_DATASTREAM__IFDATA_32RE_32IM_FLOAT_RESCALED )
+      return false;
+
+    if(   l_pDataHeader->uintDatablockLength == 0
+       || l_pDataHeader->uintDatablockCount  == 0
+       || (!l_bIsJumboFrame && (l_pDataHeader->uintDatablockLength > (kFRH_FRAME_LENGTH_MAX * 2))))
+    {
+      return false;
+    }
+
+    memcpy(&m_prevFrameHeader,frameHeader(), c_sizeofZFFrameHeader);
+    memcpy(&m_prevDataHeader, dataHeader(),  c_sizeofZFDataHeaderEx);
+
+    m_endian         = ekLittleEndian;
+    m_frameHeaderPos = a_offset;
+    m_pFrame         = l_pFrame;
+
+    getChangedAttributs();
+
+    m_dataHeader = true;
+
+    return true;
+  }
+
   bool CZFFileReaderImpl::syncToNextZFData()
   {
     if (m_pZFFile == 0)
@@ -846,87 +1076,35 @@ namespace AmlabFiles
 
   /* METHOD ***********************************************************/
   /*!
-  * @brief  Read the last frame to initialize the properties.
+  * @brief  Build the frame index and read the last frame to initialize the properties.
   * 
-  *         Um den letzten Frame zu ermitteln wird wie folgt vorgegangen:
-  *         Ausgehend von Dateigr�sse, Position des ersten Frames und
-  *         der Framel�nge in Bytes wird die max. Anzahl Frames und
-  *         die Position des letzten Frames ermittelt.
-  *         Nun wird die Position (Fileoffset) des letzten g�ltigen Frames
-  *         ermittelt.
+  *         The frame index is loaded from the sidecar file (if enabled and
+  *         valid) or built by a single forward scan over all frame headers.
+  *         The last indexed frame provides the last frame and data header.
+  *         Changes of the frame size and gaps between frames are covered by
+  *         the index, there is no need to guess frame positions anymore.
   * 
   * @return Error status
   *
-  * @see readZFFrameFromFile()
+  * @see buildFrameIndex()
   *********************************************************************/
   eStatus CZFFileReaderImpl::readProperties()
   {
-    // Frame count
-    int64 l_framLengthInByte = (int64)m_ZFFrameHeader.uintFrameLength * c_sizeof_uint32;
-    m_frameCount = (m_fileSize - m_frameHeaderPos) / l_framLengthInByte;
-    // last frame
-    int64 l_lastFrameOffset = m_frameHeaderPos + (m_frameCount - 1) * l_framLengthInByte;
-
-    // Gibt es einen letzten Frame, der kleiner ist als die errechnete Framl�nge in Bytes?
-    int64 l_dataHeaderLength = isDataHeaderEx() ? c_sizeofZFDataHeaderEx : c_sizeofZFDataHeader;
-    int64 l_lastFramLengthInByte = (m_fileSize - m_frameHeaderPos) % l_framLengthInByte;
-    if (l_lastFramLengthInByte > c_sizeofZFFrameHeader + l_dataHeaderLength)
-    {
-      m_frameCount++;
-      l_lastFrameOffset += l_framLengthInByte;
-    }
-
-    // FileAnalyzer - improve the loading of continuous recordings
-    /* - the problem is that at the assumed search locations for a frame header there is nothing for a huge amount of
-         frames (the file was 59GB) - because after 2% of the file there was a 4K section that shifted the whole frame offset.
-         And so no magic word was found searching backwards 58GB. Takes a long time!
-       - the problem does not only occur for looped recordings, it may also occur when there are
-         changes in the frame size - you won't find a magic word at the given position and you search until the end
-         of the first contiguous section.
-
-       Solution: limit the backwards search for the last frame to 
-         - 10.000 frames for very big files > 100.000 frames 
-         - 50% of the frames for smaller files
-         -> use the first frame information as last frame information - this may result in a wrong number of samples
-            and a slightly wrong duration but we don't have any other chance.
-    */
-    int64 l_initialMaxFrameCount = m_frameCount;
-    int64 l_maxFramesCheck = l_initialMaxFrameCount < 100000 ? (int64) (0.5 * l_initialMaxFrameCount) : 10000;
-    bool   l_validLastFrame = true;
-
-    while (m_frameCount)
-    {
-      if (!readFrame(l_lastFrameOffset))
+    if (!m_frameIndexFileEnabled || !loadFrameIndex())
+    {
+      if (!buildFrameIndex())
       {
-        m_frameCount--;
-        l_lastFrameOffset -= l_framLengthInByte;
+        return setLastError(ekInvalidFileHeader, L"No valid frame found.");
       }
-      else
+      if (m_frameIndexFileEnabled)
       {
-        const typFRH_FRAMEHEADER* l_pZFFrameHeader = frameHeader();
-        if (l_pZFFrameHeader->uintFrameType != m_ZFFrameHeader.uintFrameType )
-        {
-          m_frameCount--;
-          l_lastFrameOffset -= l_framLengthInByte;
-        }
-        else
-        {
-          break;
-        }
-      }
-
-      // RTC Defect#147654: FileAnalyzer - improve the loading of continuous recordings
-      if ( l_initialMaxFrameCount - m_frameCount > l_maxFramesCheck )
-      {
-        l_validLastFrame = false;
-        memcpy(&m_lastZFFrameHeader, &m_ZFFrameHeader, c_sizeofZFFrameHeader);
-        memset(&m_lastZFDataHeader,  0,                c_sizeofZFDataHeaderEx);
-        memcpy(&m_lastZFDataHeader,  &m_ZFDataHeader,  c_sizeofZFDataHeaderEx);
-        break;
+        storeFrameIndex();
       }
     }
+    m_frameCount = (int64)m_frameIndex.size();
 
-    if ( l_validLastFrame )
+    // last frame
+    if (readFrame(m_frameIndex.back().offset))
     {
       // Frame header
       memcpy(&m_lastZFFrameHeader, frameHeader(), c_sizeofZFFrameHeader);
@@ -934,6 +1112,12 @@ namespace AmlabFiles
       memset(&m_lastZFDataHeader, 0,            c_sizeofZFDataHeaderEx);
       memcpy(&m_lastZFDataHeader, dataHeader(), c_sizeofZFDataHeaderEx);
     }
+    else
+    {
+      memcpy(&m_lastZFFrameHeader, &m_ZFFrameHeader, c_sizeofZFFrameHeader);
+      memset(&m_lastZFDataHeader,  0,                c_sizeofZFDataHeaderEx);
+      memcpy(&m_lastZFDataHeader,  &m_ZFDataHeader,  c_sizeofZFDataHeaderEx);
+    }
 
     if (!isDataHeaderEx())
     {
@@ -953,6 +1137,355 @@ namespace AmlabFiles
     return ekNoError;
   }
 
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Build the frame offset index by a forward scan of the file
+  *
+  *         Starting at the first frame only the frame and data headers
+  *         are read, the payload is skipped. Invalid data between frames
+  *         is skipped by a buffered search for the next magic word.
+  *         Only frames of the same type as the first frame are indexed.
+  *
+  * @return true = at least one frame indexed, false = error
+  *********************************************************************/
+  bool CZFFileReaderImpl::buildFrameIndex()
+  {
+    m_frameIndex.clear();
+
+    uint32 l_sampleSize = getSampleSize();
+    if (l_sampleSize == 0)
+    {
+      return false;
+    }
+
+    typFRH_FRAMEHEADER     l_frameHeader;
+    typIFD_IFDATAHEADER_EX l_dataHeader;
+    uint64 l_firstSample = 0;
+    int64  l_offset      = m_firstFrameHeaderPos;
+
+    while (l_offset >= 0 && l_offset + c_sizeofZFFrameHeader <= m_fileSize)
+    {
+      if (!readFrameIndexHeaders(l_offset, l_frameHeader, l_dataHeader))
+      {
+        l_offset = findNextMagicWord(l_offset + 1);
+        continue;
+      }
+
+      int64 l_frameLengthInByte = (int64)l_frameHeader.uintFrameLength * c_sizeof_uint32;
+      if (l_offset + l_frameLengthInByte > m_fileSize)
+      {
+        // incomplete last frame
+        break;
+      }
+
+      if (l_frameHeader.uintFrameType == m_ZFFrameHeader.uintFrameType)
+      {
+        ZFFrameIndexEntry l_entry;
+        uint64 l_dataSize     = l_dataHeader.uintDatablockLength;
+               l_dataSize    *= l_dataHeader.uintDatablockCount;
+               l_dataSize    *= c_sizeof_uint32;
+        l_entry.offset        = l_offset;
+        l_entry.firstSample   = l_firstSample;
+        l_entry.sampleCounter = 0;
+        if (l_frameHeader.uintDataHeaderLength >= (c_sizeofZFDataHeaderEx / c_sizeof_uint32))
+        {
+          l_entry.sampleCounter   = l_dataHeader.uintSampleCounter_High;
+          l_entry.sampleCounter <<= 32;
+          l_entry.sampleCounter  |= l_dataHeader.uintSampleCounter_Low;
+        }
+        l_entry.timestamp     = l_dataHeader.bigtimeTimeStamp.structTimeInTwoWords.uintTime_HiOrderBits;
+        l_entry.timestamp   <<= 32;
+        l_entry.timestamp    |= l_dataHeader.bigtimeTimeStamp.structTimeInTwoWords.uintTime_LoOrderBits;
+        //lint -save -e712
+        l_entry.samples       = (uint32)(l_dataSize / l_sampleSize);
+        //lint -restore
+        l_entry.frameLength   = l_frameHeader.uintFrameLength;
+        m_frameIndex.push_back(l_entry);
+        l_firstSample += l_entry.samples;
+      }
+      l_offset += l_frameLengthInByte;
+    }
+
+    return !m_frameIndex.empty();
+  }
+
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Read and check frame and data header at the given offset
+  *
+  *         The headers are converted to little endian and checked in
+  *         the same way as in readZFFrameFromFile(). The frame data is
+  *         not read.
+  *
+  * @param a_offset         File offset of frame
+  * @param a_rFrameHeader   The out parameter contains the frame header
+  * @param a_rDataHeader    The out parameter contains the data header
+  *
+  * @return true = valid IF data frame, false = no valid frame
+  *********************************************************************/
+  bool CZFFileReaderImpl::readFrameIndexHeaders(int64 a_offset, typFRH_FRAMEHEADER& a_rFrameHeader, typIFD_IFDATAHEADER_EX& a_rDataHeader)
+  {
+    if (!readFromFile(a_offset, &a_rFrameHeader, c_sizeofZFFrameHeader))
+    {
+      return false;
+    }
+
+    if (m_endian == ekBigEndian && a_rFrameHeader.uintMagicWord == kFRH_MAGIC_WORD_BE)
+    {
+      (void)SwapBytes_uint32_t(reinterpret_cast<uint32_t*>(&a_rFrameHeader), c_sizeofZFFrameHeader / c_sizeof_uint32);
+    }
+    else if (m_endian == ekBigEndian || a_rFrameHeader.uintMagicWord != kFRH_MAGIC_WORD)
+    {
+      return false;
+    }
+
+    bool l_bIsJumboFrame = ((a_rFrameHeader.uintStatusword & kFRH_STATUSWORD__LENGTH_MAX_EX_FLAG) == kFRH_STATUSWORD__LENGTH_MAX_EX_FLAG);
+    uint64 l_headerSize  = c_sizeofZFFrameHeader + (uint64)a_rFrameHeader.uintDataHeaderLength * c_sizeof_uint32;
+
+    // Plausibility check
+    if (   (!l_bIsJumboFrame && (a_rFrameHeader.uintFrameLength > kFRH_FRAME_LENGTH_MAX))
+        || a_rFrameHeader.uintDataHeaderLength < (c_sizeofZFDataHeader / c_sizeof_uint32)
+        || l_headerSize > (uint64)a_rFrameHeader.uintFrameLength * c_sizeof_uint32)
+    {
+      return false;
+    }
+
+    // Check if it is a IF-Frame at all
+    if (  a_rFrameHeader.uintFrameType != ekFRH_DATASTREAM__IFDATA_32RE_32IM_FIX && 
+          a_rFrameHeader.uintFrameType != ekFRH_DATASTREAM__IFDATA_16RE_16IM_FIX && 
+          a_rFrameHeader.uintFrameType != ekFRH_DATASTREAM__IFDATA_16RE_16RE_FIX && 
+          a_rFrameHeader.uintFrameType != ekFRH_DATASTREAM__IFDATA_32RE_32IM_FIX_RESCALED && 
+          a_rFrameHeader.uintFrameType != ekFRH_DATASTREAM__IFDATA_32RE_32IM_FLOAT_RESCALED )
+      return false;
+
+    // reading data-header, additional data header parts are skipped
+    uint32 l_dataHeaderSize = __min(a_rFrameHeader.uintDataHeaderLength * c_sizeof_uint32, (uint32)c_sizeofZFDataHeaderEx);
+    memset(&a_rDataHeader, 0, c_sizeofZFDataHeaderEx);
+    if (!readFromFile(a_offset + c_sizeofZFFrameHeader, &a_rDataHeader, l_dataHeaderSize))
+    {
+      return false;
+    }
+    if (m_endian == ekBigEndian)
+    {
+      //lint -save -e713
+      (void)SwapBytes_uint32_t(reinterpret_cast<uint32_t*>(&a_rDataHeader), l_dataHeaderSize / c_sizeof_uint32);
+      //lint -restore
+    }
+
+    // data blocks (statusword + data) must fit into the frame
+    uint64 l_dataSize  = (uint64)a_rDataHeader.uintDatablockLength + 1;
+           l_dataSize *= a_rDataHeader.uintDatablockCount;
+           l_dataSize *= c_sizeof_uint32;
+    if(   a_rDataHeader.uintDatablockLength == 0
+       || a_rDataHeader.uintDatablockCount  == 0
+       || (!l_bIsJumboFrame && (a_rDataHeader.uintDatablockLength > (kFRH_FRAME_LENGTH_MAX * 2)))
+       || l_headerSize + l_dataSize > (uint64)a_rFrameHeader.uintFrameLength * c_sizeof_uint32)
+    {
+      return false;
+    }
+    return true;
+  }
+
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Search the next magic word starting at the given offset
+  *
+  *         The file is read in blocks of c_syncBufferSize bytes and the
+  *         first byte of the magic word is located with memchr().
+  *
+  * @param a_offset   File offset to start the search
+  *
+  * @return File offset of the next magic word, -1 if not found
+  *********************************************************************/
+  int64 CZFFileReaderImpl::findNextMagicWord(int64 a_offset)
+  {
+    uint32 l_magicWord = (m_endian == ekBigEndian) ? (uint32)kFRH_MAGIC_WORD_BE : (uint32)kFRH_MAGIC_WORD;
+    uint8  l_magic[c_sizeof_uint32];
+    memcpy(l_magic, &l_magicWord, c_sizeof_uint32);
+
+    std::vector<uint8> l_buffer;
+    while (a_offset + c_sizeof_uint32 <= m_fileSize)
+    {
+      const uint8* l_pBegin = 0;
+      size_t       l_read   = 0;
+      if (isMapped())
+      {
+        // search the rest of the file at once
+        l_pBegin = reinterpret_cast<const uint8*>(m_mappedFile.data()) + a_offset;
+        l_read   = (size_t)(m_fileSize - a_offset);
+      }
+      else
+      {
+        l_buffer.resize(c_syncBufferSize);
+        (void)::_fseeki64(m_pZFFile,a_offset,SEEK_SET);
+        l_read   = ::fread(reinterpret_cast<char*>(&l_buffer[0]), 1, l_buffer.size(), m_pZFFile);
+        l_pBegin = &l_buffer[0];
+      }
+      if (l_read < c_sizeof_uint32)
+      {
+        break;
+      }
+
+      const uint8* l_pEnd   = l_pBegin + l_read - (c_sizeof_uint32 - 1);
+      const uint8* l_pData  = l_pBegin;
+      while (l_pData < l_pEnd)
+      {
+        l_pData = static_cast<const uint8*>(memchr(l_pData, l_magic[0], l_pEnd - l_pData));
+        if (l_pData == 0)
+        {
+          break;
+        }
+        if (memcmp(l_pData, l_magic, c_sizeof_uint32) == 0)
+        {
+          return a_offset + (l_pData - l_pBegin);
+        }
+        l_pData++;
+      }
+      // the next block overlaps the last bytes of this block
+      a_offset += (int64)(l_pEnd - l_pBegin);
+    }
+    return -1;
+  }
+
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Read bytes at the given offset from the mapping or the file
+  *
+  * @param a_offset   File offset
+  * @param a_pBuffer  Destination buffer
+  * @param a_size     Number of bytes to read
+  *
+  * @return true = all bytes read, false = error
+  *********************************************************************/
+  bool CZFFileReaderImpl::readFromFile(int64 a_offset, void* a_pBuffer, size_t a_size)
+  {
+    if (a_offset < 0 || a_offset + (int64)a_size > m_fileSize)
+    {
+      return false;
+    }
+    if (isMapped())
+    {
+      memcpy(a_pBuffer, m_mappedFile.data() + a_offset, a_size);
+      return true;
+    }
+    (void)::_fseeki64(m_pZFFile,a_offset,SEEK_SET);
+    return ::fread(a_pBuffer, 1, a_size, m_pZFFile) == a_size;
+  }
+
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Load the frame index from the sidecar file
+  *
+  *         The sidecar is only accepted if it matches the size and the
+  *         modification time of the file, the position of the first frame
+  *         and the frame type. A file rewritten with the same size is
+  *         therefore indexed again.
+  *
+  * @return true = frame index loaded, false = no valid sidecar
+  *********************************************************************/
+  bool CZFFileReaderImpl::loadFrameIndex()
+  {
+    FILE* l_pFile = openFile(m_strFilename + c_frameIndexFileExtension, false);
+    if (l_pFile == 0)
+    {
+      return false;
+    }
+
+    bool l_valid = false;
+    ZFFrameIndexFileHeader l_header;
+    if (   ::fread(&l_header, 1, sizeof(l_header), l_pFile) == sizeof(l_header)
+        && memcmp(l_header.magic, c_frameIndexFileMagic, sizeof(l_header.magic)) == 0
+        && l_header.version             == c_frameIndexFileVersion
+        && l_header.entrySize           == sizeof(ZFFrameIndexEntry)
+        && l_header.fileSize            == m_fileSize
+        && l_header.modificationTime    == m_fileModificationTime
+        && l_header.firstFrameHeaderPos == m_firstFrameHeaderPos
+        && l_header.frameType           == m_ZFFrameHeader.uintFrameType
+        && l_header.entries > 0
+        && l_header.entries <= (uint64)m_fileSize / c_sizeofZFFrameHeader)
+    {
+      m_frameIndex.resize((size_t)l_header.entries);
+      l_valid = ::fread(&m_frameIndex[0], sizeof(ZFFrameIndexEntry), m_frameIndex.size(), l_pFile) == m_frameIndex.size();
+
+      // the entries have to be in ascending order and within the file
+      uint64 l_firstSample = 0;
+      for (size_t i = 0; l_valid && i < m_frameIndex.size(); ++i)
+      {
+        const ZFFrameIndexEntry& l_entry = m_frameIndex[i];
+        l_valid =    l_entry.firstSample == l_firstSample
+                  && (i == 0 || l_entry.offset > m_frameIndex[i-1].offset)
+                  && l_entry.offset + (int64)l_entry.frameLength * c_sizeof_uint32 <= m_fileSize;
+        l_firstSample += l_entry.samples;
+      }
+    }
+    ::fclose(l_pFile);
+
+    if (!l_valid)
+    {
+      m_frameIndex.clear();
+    }
+    return l_valid;
+  }
+
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Store the frame index into the sidecar file
+  *
+  *         Errors are ignored, e.g. if the directory is read-only.
+  *********************************************************************/
+  void CZFFileReaderImpl::storeFrameIndex() const
+  {
+    if (m_frameIndex.empty())
+    {
+      return;
+    }
+
+    FILE* l_pFile = openFile(m_strFilename + c_frameIndexFileExtension, true);
+    if (l_pFile == 0)
+    {
+      return;
+    }
+
+    ZFFrameIndexFileHeader l_header;
+    memset(&l_header, 0, sizeof(l_header));
+    memcpy(l_header.magic, c_frameIndexFileMagic, sizeof(l_header.magic));
+    l_header.version             = c_frameIndexFileVersion;
+    l_header.entrySize           = sizeof(ZFFrameIndexEntry);
+    l_header.fileSize            = m_fileSize;
+    l_header.modificationTime    = m_fileModificationTime;
+    l_header.firstFrameHeaderPos = m_firstFrameHeaderPos;
+    l_header.frameType           = m_ZFFrameHeader.uintFrameType;
+    l_header.entries             = m_frameIndex.size();
+
+    (void)::fwrite(&l_header, 1, sizeof(l_header), l_pFile);
+    (void)::fwrite(&m_frameIndex[0], sizeof(ZFFrameIndexEntry), m_frameIndex.size(), l_pFile);
+    ::fclose(l_pFile);
+  }
+
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Return the position of the frame containing the sample
+  *
+  * @param a_sampleIndex  Index of the sample within the file
+  *
+  * @return Position within the frame index, size of the index if not found
+  *********************************************************************/
+  size_t CZFFileReaderImpl::findFrameIndex(uint64 a_sampleIndex) const
+  {
+    std::vector<ZFFrameIndexEntry>::const_iterator l_it = std::upper_bound(m_frameIndex.begin(), m_frameIndex.end(), a_sampleIndex,
+      [](uint64 a_index, const ZFFrameIndexEntry& a_entry) { return a_index < a_entry.firstSample; });
+    if (l_it == m_frameIndex.begin())
+    {
+      return m_frameIndex.size();
+    }
+    --l_it;
+    if (a_sampleIndex >= l_it->firstSample + l_it->samples)
+    {
+      return m_frameIndex.size();
+    }
+    return (size_t)(l_it - m_frameIndex.begin());
+  }
+
   //lint -save -e826
   /* METHOD ***********************************************************/
   /*!
@@ -988,12 +1521,13 @@ namespace AmlabFiles
     {
       // Daten aus Datenblock in Array einlesen
       uint32 l_sampleSize = getSampleSize();
-      uint32 l_outFactor  = (c_sizeof_uint32 * 2)/l_sampleSize;
+      uint32 l_outSize    = m_rawValueSize ? m_rawValueSize * 2 : c_sizeof_uint32 * 2;
+      uint32 l_outFactor  = l_outSize/l_sampleSize;
       uint32 l_blockSize  = dataHeader()->uintDatablockLength * c_sizeof_uint32;
       uint64 l_blockIndex = (a_starSampleIndex * l_sampleSize) / l_blockSize;
       a_starSampleIndex  -= (l_blockSize/l_sampleSize)*l_blockIndex;
 
-      uint8* l_pBuffer = reinterpret_cast<uint8*>(dataHeader());
+      const uint8* l_pBuffer = reinterpret_cast<const uint8*>(dataHeader());
       l_pBuffer += frameHeader()->uintDataHeaderLength * c_sizeof_uint32;
       //lint -save -e776
       l_pBuffer += l_blockIndex * (l_blockSize + c_sizeof_uint32);
@@ -1003,14 +1537,16 @@ namespace AmlabFiles
       uint64 l_toReadBytes = (uint64)a_samplesToRead * l_sampleSize;
       do
       {
-        uint32 l_statusword = reinterpret_cast<typIFD_DATABLOCK*>(l_pBuffer)->datablockheaderDatablockHeader.uintStatusword;
+        uint32 l_statusword = reinterpret_cast<const typIFD_DATABLOCK*>(l_pBuffer)->datablockheaderDatablockHeader.uintStatusword;
         l_pBuffer += c_sizeof_uint32;
 
         uint64 l_readOffset = a_starSampleIndex * l_sampleSize;
         uint64 l_readLeft   = (uint64)dataHeader()->uintDatablockLength * c_sizeof_uint32 - l_readOffset;
         uint64 l_readBytes  = __min(l_toReadBytes, l_readLeft);
 
-        if (!adjustData(l_pBuffer + l_readOffset, l_pDstData, l_readBytes, l_statusword))
+        bool l_adjusted = m_rawValueSize ? adjustRawData(l_pBuffer + l_readOffset, l_pDstData, l_readBytes, l_statusword)
+                                         : adjustData(l_pBuffer + l_readOffset, l_pDstData, l_readBytes, l_statusword);
+        if (!l_adjusted)
         {
           return false;
         }
@@ -1048,15 +1584,11 @@ namespace AmlabFiles
   * @param a_bytesToRead    Number of samples to trnasfer
   * @param a_statusword     Statusword with the reciprocal gain correction value
   *********************************************************************/
-  bool CZFFileReaderImpl::adjustData(uint8* a_pSource, uint8* a_pDestination, uint64 a_bytesToRead, uint32 a_statusword)
+  bool CZFFileReaderImpl::adjustData(const uint8* a_pSource, uint8* a_pDestination, uint64 a_bytesToRead, uint32 a_statusword)
   {
     Status l_status = StsNoErr;
     float* l_pfDestination = reinterpret_cast<float*>(a_pDestination);
-
-    //*** Rescale of AntennaVoltageReference [dBmicroV] to a voltage value [V]
-    float fAntennaVoltageRef = c_fMicroVolt2Volt * powf(10.0F, static_cast<float>(dataHeader()->intAntennaVoltageRef) * 0.005F);
-    float fRecipGain         = static_cast<float>(a_statusword>>16) * kf16BitReciMax;
-    float fFactor            = fRecipGain * fAntennaVoltageRef;
+    float fFactor          = getScaleFactor(a_statusword);
 
     switch( m_ZFFrameHeader.uintFrameType )
     { //***************************************************************************
@@ -1065,9 +1597,7 @@ namespace AmlabFiles
         //lint -save -e712
         int32 l_size = (int32) (a_bytesToRead / c_sizeof_uint16);
         //lint -restore
-        l_status = Convert_int16_t_float(reinterpret_cast<int16*>(a_pSource), l_pfDestination, l_size);
-        if(l_status == StsNoErr)
-          l_status = MulC_float(kfSHORTMAX * fFactor, l_pfDestination, l_size);
+        l_status = ConvertMulC_int16_t_float(reinterpret_cast<const int16*>(a_pSource), kfSHORTMAX * fFactor, l_pfDestination, l_size);
         break;
       }
 
@@ -1077,7 +1607,7 @@ namespace AmlabFiles
         //lint -save -e712
         int32 l_size = (int32) (a_bytesToRead / c_sizeof_uint32);
         //lint -restore
-        l_status = MulC_float(reinterpret_cast<float*>(a_pSource), fFactor, l_pfDestination, l_size);
+        l_status = MulC_float(reinterpret_cast<const float*>(a_pSource), fFactor, l_pfDestination, l_size);
         break;
       } 
 
@@ -1087,9 +1617,7 @@ namespace AmlabFiles
         //lint -save -e712
         int32 l_size = (int32) (a_bytesToRead / c_sizeof_uint32);
         //lint -restore
-        l_status = Convert_int32_t_float(reinterpret_cast<int32*>(a_pSource), l_pfDestination, l_size);
-        if(l_status == StsNoErr)   
-          l_status = MulC_float(kf31BitReciMax * fFactor, l_pfDestination, l_size);
+        l_status = ConvertMulC_int32_t_float(reinterpret_cast<const int32*>(a_pSource), kf31BitReciMax * fFactor, l_pfDestination, l_size);
         break;
       }
 
@@ -1099,9 +1627,7 @@ namespace AmlabFiles
         //lint -save -e712
         int32 l_size = (int32) (a_bytesToRead / c_sizeof_uint32);
         //lint -restore
-        l_status = Convert_int32_t_float(reinterpret_cast<int32*>(a_pSource), l_pfDestination, l_size);
-        if(l_status == StsNoErr)   
-          l_status = MulC_float(kf31BitReciMax * fFactor, l_pfDestination, l_size);
+        l_status = ConvertMulC_int32_t_float(reinterpret_cast<const int32*>(a_pSource), kf31BitReciMax * fFactor, l_pfDestination, l_size);
         break;
       }
 
@@ -1112,7 +1638,7 @@ namespace AmlabFiles
         //lint -save -e712
         int32 l_size      = (int32) a_bytesToRead / 2;
         //lint -restore
-        int16* l_pSource  = reinterpret_cast<int16*>(a_pSource);
+        const int16* l_pSource  = reinterpret_cast<const int16*>(a_pSource);
         for (int32 ulCounter = 0; ulCounter < l_size; ulCounter++)
         {
           l_pfDestination[ulCounter * 2    ] = kfSHORTMAX * fFactor * static_cast<float>(l_pSource[ulCounter]);
@@ -1140,6 +1666,121 @@ namespace AmlabFiles
   }
   //lint -restore
 
+  //lint -save -e826
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Copy a number of samples from source-buffer into container
+  *         without conversion to volts
+  *
+  *         The values are copied as int16 or int32, 16 bit values are
+  *         widened to 32 bit if required. The scale must be the same
+  *         for all samples read.
+  *
+  * @param a_pSource        Source buffer
+  * @param a_pDestination   Container memory for the values
+  * @param a_bytesToRead    Number of bytes to transfer
+  * @param a_statusword     Statusword with the reciprocal gain correction value
+  *
+  * @see readRaw()
+  *********************************************************************/
+  bool CZFFileReaderImpl::adjustRawData(const uint8* a_pSource, uint8* a_pDestination, uint64 a_bytesToRead, uint32 a_statusword)
+  {
+    float fFactor = getScaleFactor(a_statusword);
+    float fScale  = 0.0F;
+
+    switch( m_ZFFrameHeader.uintFrameType )
+    {
+      case ekFRH_DATASTREAM__IFDATA_16RE_16IM_FIX:
+      case ekFRH_DATASTREAM__IFDATA_16RE_16RE_FIX:
+      {
+        fScale = kfSHORTMAX * fFactor;
+        break;
+      }
+
+      case ekFRH_DATASTREAM__IFDATA_32RE_32IM_FIX:
+      case ekFRH_DATASTREAM__IFDATA_32RE_32IM_FIX_RESCALED:
+      {
+        if (m_rawValueSize < (uint32)c_sizeof_uint32)
+        {
+          m_rawStatus = ekUnsupportedFileFormat;
+          return false;
+        }
+        fScale = kf31BitReciMax * fFactor;
+        break;
+      }
+
+      default:
+      {
+        m_rawStatus = ekUnsupportedFileFormat;
+        return false;
+      }
+    }
+
+    // a single scale is returned, so the gain must not change within the samples read
+    if (m_rawScaleValid && fScale != m_rawScale)
+    {
+      m_rawStatus = ekInvalidParameters;
+      return false;
+    }
+    m_rawScale      = fScale;
+    m_rawScaleValid = true;
+
+    if (m_ZFFrameHeader.uintFrameType == (uint32)ekFRH_DATASTREAM__IFDATA_32RE_32IM_FIX
+        || m_ZFFrameHeader.uintFrameType == (uint32)ekFRH_DATASTREAM__IFDATA_32RE_32IM_FIX_RESCALED
+        || (m_rawValueSize == (uint32)c_sizeof_uint16 && m_ZFFrameHeader.uintFrameType == (uint32)ekFRH_DATASTREAM__IFDATA_16RE_16IM_FIX))
+    {
+      memcpy(a_pDestination, a_pSource, (size_t)a_bytesToRead);
+      return true;
+    }
+
+    // 16 bit values widened to 32 bit, real-valued samples get a Q value of 0
+    const bool   l_real    = m_ZFFrameHeader.uintFrameType == (uint32)ekFRH_DATASTREAM__IFDATA_16RE_16RE_FIX;
+    const int16* l_pSource = reinterpret_cast<const int16*>(a_pSource);
+    const size_t l_size    = (size_t)(a_bytesToRead / c_sizeof_uint16);
+    if (m_rawValueSize == (uint32)c_sizeof_uint16)
+    {
+      int16* l_pDestination = reinterpret_cast<int16*>(a_pDestination);
+      for (size_t i = 0; i < l_size; i++)
+      {
+        l_pDestination[i * 2    ] = l_pSource[i];
+        l_pDestination[i * 2 + 1] = 0;
+      }
+    }
+    else
+    {
+      int32* l_pDestination = reinterpret_cast<int32*>(a_pDestination);
+      for (size_t i = 0; i < l_size; i++)
+      {
+        if (l_real)
+        {
+          l_pDestination[i * 2    ] = l_pSource[i];
+          l_pDestination[i * 2 + 1] = 0;
+        }
+        else
+        {
+          l_pDestination[i] = l_pSource[i];
+        }
+      }
+    }
+    return true;
+  }
+  //lint -restore
+
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Return the factor converting the samples of a data block
+  *         to volts, apart from the scaling of the sample format
+  *
+  * @param a_statusword     Statusword with the reciprocal gain correction value
+  *********************************************************************/
+  float CZFFileReaderImpl::getScaleFactor(uint32 a_statusword) const
+  {
+    //*** Rescale of AntennaVoltageReference [dBmicroV] to a voltage value [V]
+    float fAntennaVoltageRef = c_fMicroVolt2Volt * powf(10.0F, static_cast<float>(dataHeader()->intAntennaVoltageRef) * 0.005F);
+    float fRecipGain         = static_cast<float>(a_statusword>>16) * kf16BitReciMax;
+    return fRecipGain * fAntennaVoltageRef;
+  }
+
   void CZFFileReaderImpl::realloc()
   {
     typFRH_FRAMEHEADER l_ZFFrameHeader;
@@ -1154,6 +1795,7 @@ namespace AmlabFiles
 
     m_pZFData = new uint8[m_ZFDataLength];
     memcpy(m_pZFData, l_pZFData, l_ZFDataLength);
+    m_pFrame  = m_pZFData;
 
     delete[] l_pZFData;
   }
@@ -1181,19 +1823,10 @@ namespace AmlabFiles
 
   uint64 CZFFileReaderImpl::getNumberOfSamples() const
   {
-    if (getSampleSize() == 0 || m_frameCount <= 0)
+    if (getSampleSize() == 0 || m_frameIndex.empty())
       return 0;
 
-    uint64 l_blockSize       = m_ZFDataHeader.uintDatablockLength;
-           l_blockSize      *= m_ZFDataHeader.uintDatablockCount;
-           l_blockSize      *= c_sizeof_uint32;
-    uint64 l_dataSizeInByte  = l_blockSize * (uint64)(m_frameCount-1);
-           l_blockSize       = m_lastZFDataHeader.uintDatablockLength;
-           l_blockSize      *= m_lastZFDataHeader.uintDatablockCount;
-           l_blockSize      *= c_sizeof_uint32;
-           l_dataSizeInByte += l_blockSize;
-
-    return l_dataSizeInByte / getSampleSize();
+    return m_frameIndex.back().firstSample + m_frameIndex.back().samples;
   }
 
 }
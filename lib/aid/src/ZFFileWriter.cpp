@@ -91,6 +91,11 @@ namespace AmlabFiles
     m_pImpl->m_flushOnClose = a_flushOnClose;
   }
 
+  void CZFFileWriter::setAsyncWrite( bool a_asyncWrite )
+  {
+    m_pImpl->setAsyncWrite(a_asyncWrite);
+  }
+
   eStatus CZFFileWriter::getLastError( std::wstring& a_strErrorMsg )
   {
     return m_pImpl->getLastError(a_strErrorMsg);
@@ -106,6 +111,11 @@ namespace AmlabFiles
     m_pImpl->setFrameType(a_eFrameType);
   }
 
+  uint32 CZFFileWriter::getSampleSize() const
+  {
+    return m_pImpl->getSampleSize();
+  }
+
   void CZFFileWriter::setCenterFrequency( uint64 a_centerFrequency )
   {
     if (!isOpen())
@@ -49,6 +49,15 @@ namespace AmlabFiles
     , m_pZFData(0)
     , m_bufferSamplesMax(0)
     , m_bufferSamples(0)
+    , m_frameBuffer()
+    , m_asyncWrite(false)
+    , m_asyncWriteThread()
+    , m_asyncWriteMutex()
+    , m_asyncWriteCondition()
+    , m_pendingFrames()
+    , m_freeFrames()
+    , m_asyncWriteStop(false)
+    , m_asyncWriteError(false)
     , m_strErrorMsg()
     , m_eStatus(ekNoError)
   {
@@ -80,6 +89,15 @@ namespace AmlabFiles
     , m_pZFData(0)
     , m_bufferSamplesMax(0)
     , m_bufferSamples(0)
+    , m_frameBuffer()
+    , m_asyncWrite(false)
+    , m_asyncWriteThread()
+    , m_asyncWriteMutex()
+    , m_asyncWriteCondition()
+    , m_pendingFrames()
+    , m_freeFrames()
+    , m_asyncWriteStop(false)
+    , m_asyncWriteError(false)
     , m_strErrorMsg()
     , m_eStatus(ekNoError)
   {
@@ -105,6 +123,7 @@ namespace AmlabFiles
 
   CZFFileWriterImpl::~CZFFileWriterImpl()
   {
+    stopAsyncWrite();
     if (m_pZFFile != 0)
     {
       ::fclose(m_pZFFile);
@@ -167,6 +186,15 @@ namespace AmlabFiles
     m_pZFData = new uint8[l_bufferSize];
 
     setFrameLength();
+    m_frameBuffer.clear();
+    m_frameBuffer.reserve(m_ZFFrameHeader.uintFrameLength * c_sizeof_uint32);
+
+    if (m_asyncWrite)
+    {
+      m_asyncWriteStop   = false;
+      m_asyncWriteError  = false;
+      m_asyncWriteThread = std::thread(&CZFFileWriterImpl::asyncWriteLoop, this);
+    }
 
     return ekNoError;
   }
@@ -176,9 +204,15 @@ namespace AmlabFiles
     if (!isOpen())    // File not opened
       return ekFileNotOpen;
 
-    flush();
+    bool l_flushed = flush();
+    // waits until all pending frames are written
+    stopAsyncWrite();
 
     eStatus l_eRetValue = ekNoError;
+    if (!l_flushed || m_asyncWriteError)
+    {
+      l_eRetValue = setLastError(ekWriteFileError, L"Error writing frame.");
+    }
     if (m_pZFFile != 0)
     {
       if (::fclose(m_pZFFile))
@@ -249,8 +283,11 @@ namespace AmlabFiles
       if (m_bufferSamples == m_bufferSamplesMax)
       {
         uint32 l_u32Dwords = (m_bufferSamples * l_sampleSize) / c_sizeof_uint32;
-        writeFrame(m_pZFData, l_u32Dwords);
         m_bufferSamples = 0;
+        if (!writeFrame(m_pZFData, l_u32Dwords))
+        {
+          return setLastError(ekWriteFileError, L"Error writing frame.");
+        }
       }
     }
 
@@ -277,6 +314,14 @@ namespace AmlabFiles
     }
   }
 
+  void CZFFileWriterImpl::setAsyncWrite( bool a_asyncWrite )
+  {
+    if (!isOpen())
+    {
+      m_asyncWrite = a_asyncWrite;
+    }
+  }
+
   void CZFFileWriterImpl::setSampleCounter( uint64 a_sampleCounter )
   {
     m_ZFDataHeader.uintSampleCounter_High = static_cast<uint32>((a_sampleCounter & 0xFFFFFFFF00000000)>>32);
@@ -421,17 +466,22 @@ namespace AmlabFiles
   * @brief  Write a complete frame with samples to file
   *
   *         Ein vollst�ndiger Frame (Frame header, data header, data blocks)
-  *         wird data block by data block in die Datei geschrieben.
+  *         wird im Frame-Puffer zusammengesetzt und mit einem Aufruf
+  *         geschrieben (writeFrameBuffer()).
   *         Nach dem Schreiben werden Timestamp und Samplecounter angepasst.
   *
   * @param a_data             Buffer with samples
   * @param a_elements         Number of samples to write
   *
+  * @return true = ok, false = error
   *********************************************************************/
-  void CZFFileWriterImpl::writeFrame( const uint8* a_data, uint32 a_elements )
+  bool CZFFileWriterImpl::writeFrame( const uint8* a_data, uint32 a_elements )
   {
     if (0 == a_elements)
-      return;
+      return true;
+
+    m_frameBuffer.clear();
+    m_frameBuffer.reserve(m_ZFFrameHeader.uintFrameLength * c_sizeof_uint32);
 
     *this << m_ZFFrameHeader;
 
@@ -458,16 +508,20 @@ namespace AmlabFiles
     const uint32* l_pu32Data = (const uint32 *)a_data;
     for (uint32 i = 0; i < m_ZFDataHeader.uintDatablockCount; i++)
     {
-      ::fwrite(reinterpret_cast<const char*>(&l_dataBlockStatusword), 1, c_sizeof_uint32, m_pZFFile);
+      const uint8* l_pStatusword = reinterpret_cast<const uint8*>(&l_dataBlockStatusword);
+      m_frameBuffer.insert(m_frameBuffer.end(), l_pStatusword, l_pStatusword + c_sizeof_uint32);
       if (a_elements < m_ZFDataHeader.uintDatablockLength)
       {
         l_datablockSize = a_elements;
       }
-      ::fwrite(reinterpret_cast<const char*>(l_pu32Data), 1, l_datablockSize * c_sizeof_uint32, m_pZFFile);
+      const uint8* l_pBlock = reinterpret_cast<const uint8*>(l_pu32Data);
+      m_frameBuffer.insert(m_frameBuffer.end(), l_pBlock, l_pBlock + l_datablockSize * c_sizeof_uint32);
       l_pu32Data += m_ZFDataHeader.uintDatablockLength;
       a_elements -= l_datablockSize;
     }
 
+    bool l_written = writeFrameBuffer();
+
     // increase timestamp
     //lint -save -e647
     uint64 l_sampleFrameCount = (m_ZFDataHeader.uintDatablockLength * m_ZFDataHeader.uintDatablockCount * c_sizeof_uint32) / getSampleSize();
@@ -489,37 +543,131 @@ namespace AmlabFiles
     l_timestamp += (1000000u * l_sampleFrameCount) / getSampleRate();
     setTimestamp(l_timestamp);
 #endif
+
+    return l_written;
   }
   //lint -restore
 
-  void CZFFileWriterImpl::flush()
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Write the assembled frame
+  *
+  *         Without background thread the frame is written by a single
+  *         fwrite() call. Otherwise the frame buffer is passed to the
+  *         background thread and a written buffer is reused for the next
+  *         frame. If c_asyncWriteFramesMax frames are pending, the call
+  *         blocks until the background thread has written one of them.
+  *
+  * @return true = ok, false = error (of this or a previous frame)
+  *********************************************************************/
+  bool CZFFileWriterImpl::writeFrameBuffer()
+  {
+    if (!m_asyncWriteThread.joinable())
+    {
+      return ::fwrite(m_frameBuffer.data(), 1, m_frameBuffer.size(), m_pZFFile) == m_frameBuffer.size();
+    }
+
+    std::unique_lock<std::mutex> l_lock(m_asyncWriteMutex);
+    m_asyncWriteCondition.wait(l_lock, [this] { return m_pendingFrames.size() < c_asyncWriteFramesMax || m_asyncWriteError; });
+    if (m_asyncWriteError)
+    {
+      return false;
+    }
+    m_pendingFrames.push_back(std::vector<uint8>());
+    m_pendingFrames.back().swap(m_frameBuffer);
+    if (!m_freeFrames.empty())
+    {
+      m_frameBuffer.swap(m_freeFrames.back());
+      m_freeFrames.pop_back();
+    }
+    l_lock.unlock();
+    m_asyncWriteCondition.notify_all();
+    return true;
+  }
+
+  /* METHOD ***********************************************************/
+  /*!
+  * @brief  Background thread writing the pending frames
+  *
+  *         The thread ends if it is stopped and all pending frames are
+  *         written. After an error the pending frames are discarded.
+  *********************************************************************/
+  void CZFFileWriterImpl::asyncWriteLoop()
+  {
+    std::unique_lock<std::mutex> l_lock(m_asyncWriteMutex);
+    for (;;)
+    {
+      m_asyncWriteCondition.wait(l_lock, [this] { return !m_pendingFrames.empty() || m_asyncWriteStop; });
+      if (m_pendingFrames.empty())
+      {
+        break;
+      }
+
+      std::vector<uint8> l_frame;
+      l_frame.swap(m_pendingFrames.front());
+      m_pendingFrames.pop_front();
+      bool l_error = m_asyncWriteError;
+      l_lock.unlock();
+
+      if (!l_error)
+      {
+        l_error = ::fwrite(l_frame.data(), 1, l_frame.size(), m_pZFFile) != l_frame.size();
+      }
+
+      l_lock.lock();
+      m_asyncWriteError = l_error;
+      m_freeFrames.push_back(std::vector<uint8>());
+      m_freeFrames.back().swap(l_frame);
+      m_asyncWriteCondition.notify_all();
+    }
+  }
+
+  void CZFFileWriterImpl::stopAsyncWrite()
+  {
+    if (m_asyncWriteThread.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> l_lock(m_asyncWriteMutex);
+        m_asyncWriteStop = true;
+      }
+      m_asyncWriteCondition.notify_all();
+      m_asyncWriteThread.join();
+    }
+    m_pendingFrames.clear();
+    m_freeFrames.clear();
+  }
+
+  bool CZFFileWriterImpl::flush()
   {
     if(m_flushOnClose && m_bufferSamples > 0)
     {
       m_ZFDataHeader.uintDatablockLength = (m_bufferSamples * getSampleSize()) / c_sizeof_uint32;
       m_ZFDataHeader.uintDatablockCount  = 1;
       setFrameLength();
-      writeFrame(m_pZFData, m_ZFDataHeader.uintDatablockLength);
+      return writeFrame(m_pZFData, m_ZFDataHeader.uintDatablockLength);
     }
+    return true;
   }
 
-  //lint -save -e668
+  // the headers are appended to the frame buffer
   CZFFileWriterImpl& CZFFileWriterImpl::operator<<( const typFRH_FRAMEHEADER& a_frameHeader )
   {
-    ::fwrite(reinterpret_cast<const char*>(&a_frameHeader), 1, c_sizeofFrameHeader, m_pZFFile);
+    const uint8* l_pData = reinterpret_cast<const uint8*>(&a_frameHeader);
+    m_frameBuffer.insert(m_frameBuffer.end(), l_pData, l_pData + c_sizeofFrameHeader);
     return (*this);
   }
   CZFFileWriterImpl& CZFFileWriterImpl::operator<<( const char* const a_pDataHeader )
   {
-    ::fwrite(a_pDataHeader, 1, c_sizeofZFDataHeader, m_pZFFile);
+    const uint8* l_pData = reinterpret_cast<const uint8*>(a_pDataHeader);
+    m_frameBuffer.insert(m_frameBuffer.end(), l_pData, l_pData + c_sizeofZFDataHeader);
     return (*this);
   }
   CZFFileWriterImpl& CZFFileWriterImpl::operator<<( const typIFD_IFDATAHEADER_EX* const a_pDataHeader )
   {
-    ::fwrite(reinterpret_cast<const char*>(a_pDataHeader), 1, c_sizeofZFDataHeaderEx, m_pZFFile);
+    const uint8* l_pData = reinterpret_cast<const uint8*>(a_pDataHeader);
+    m_frameBuffer.insert(m_frameBuffer.end(), l_pData, l_pData + c_sizeofZFDataHeaderEx);
     return (*this);
   }
-  //lint -restore
 
   //lint -save -e826
   bool CZFFileWriterImpl::convert(const float* a_src, uint8* a_dest, int32 a_elements) const
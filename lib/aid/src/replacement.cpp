@@ -17,9 +17,269 @@
 #include "TypesExtended.h"
 #include "replacement.h"
 
+#include <atomic>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define REPLACEMENT_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define REPLACEMENT_TARGET_SSE2
+#define REPLACEMENT_TARGET_AVX2
+#else
+#define REPLACEMENT_TARGET_SSE2 __attribute__((target("sse2")))
+#define REPLACEMENT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
 const char* DefaultStatus = "no error";
 const char* ErrorStatus = "unknown error";
 
+namespace
+{
+  // ---------------------------------------------------------------------------------------------
+  // runtime dispatch
+  // ---------------------------------------------------------------------------------------------
+
+  SimdLevel detectSimdLevel()
+  {
+#ifdef REPLACEMENT_X86
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    // AVX2 requires os support for the ymm registers (osxsave + xcr0)
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && (_xgetbv(0) & 0x6) == 0x6)
+    {
+      __cpuidex(info, 7, 0);
+      avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const bool sse2 = __builtin_cpu_supports("sse2");
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2)
+    {
+      return SimdAvx2;
+    }
+    if (sse2)
+    {
+      return SimdSse2;
+    }
+#endif
+    return SimdNone;
+  }
+
+  const SimdLevel g_simdLevelMax = detectSimdLevel();
+  std::atomic<int> g_simdLevel(g_simdLevelMax);
+
+  inline SimdLevel simdLevel()
+  {
+    return static_cast<SimdLevel>(g_simdLevel.load(std::memory_order_relaxed));
+  }
+
+#ifdef REPLACEMENT_X86
+  // ---------------------------------------------------------------------------------------------
+  // SSE2 kernels, each returns the number of processed elements. The rest is done by the scalar loop.
+  // ---------------------------------------------------------------------------------------------
+
+  REPLACEMENT_TARGET_SSE2 int convertMulCInt16Sse2(const int16_t* pSrc, float val, float* pDst, int len)
+  {
+    const __m128 scale = _mm_set1_ps(val);
+    int i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+      // sign extension: move to the upper half and shift back
+      __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+      __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+      _mm_storeu_ps(pDst + i,     _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+      _mm_storeu_ps(pDst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    return i;
+  }
+
+  REPLACEMENT_TARGET_SSE2 int convertMulCInt32Sse2(const int32_t* pSrc, float val, float* pDst, int len)
+  {
+    const __m128 scale = _mm_set1_ps(val);
+    int i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+      __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i + 4));
+      _mm_storeu_ps(pDst + i,     _mm_mul_ps(_mm_cvtepi32_ps(a), scale));
+      _mm_storeu_ps(pDst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(b), scale));
+    }
+    return i;
+  }
+
+  REPLACEMENT_TARGET_SSE2 int mulCSse2(const float* pSrc, float val, float* pDst, int len)
+  {
+    const __m128 scale = _mm_set1_ps(val);
+    int i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+      _mm_storeu_ps(pDst + i,     _mm_mul_ps(_mm_loadu_ps(pSrc + i), scale));
+      _mm_storeu_ps(pDst + i + 4, _mm_mul_ps(_mm_loadu_ps(pSrc + i + 4), scale));
+    }
+    return i;
+  }
+
+  REPLACEMENT_TARGET_SSE2 int realToCplxSse2(const float* pSrcRe, const float* pSrcIm, floatc* pDst, int len)
+  {
+    float* pOut = reinterpret_cast<float*>(pDst);
+    int i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+      __m128 re = _mm_loadu_ps(pSrcRe + i);
+      __m128 im = _mm_loadu_ps(pSrcIm + i);
+      _mm_storeu_ps(pOut + 2 * i,     _mm_unpacklo_ps(re, im));
+      _mm_storeu_ps(pOut + 2 * i + 4, _mm_unpackhi_ps(re, im));
+    }
+    return i;
+  }
+
+  REPLACEMENT_TARGET_SSE2 int cplxToRealSse2(const floatc* pSrc, float* pDstRe, float* pDstIm, int len)
+  {
+    const float* pIn = reinterpret_cast<const float*>(pSrc);
+    int i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+      __m128 a = _mm_loadu_ps(pIn + 2 * i);
+      __m128 b = _mm_loadu_ps(pIn + 2 * i + 4);
+      _mm_storeu_ps(pDstRe + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+      _mm_storeu_ps(pDstIm + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    return i;
+  }
+
+  // ---------------------------------------------------------------------------------------------
+  // AVX2 kernels
+  // ---------------------------------------------------------------------------------------------
+
+  REPLACEMENT_TARGET_AVX2 int convertMulCInt16Avx2(const int16_t* pSrc, float val, float* pDst, int len)
+  {
+    const __m256 scale = _mm256_set1_ps(val);
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+      __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i)));
+      __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i + 8)));
+      _mm256_storeu_ps(pDst + i,     _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+      _mm256_storeu_ps(pDst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+    }
+    return i;
+  }
+
+  REPLACEMENT_TARGET_AVX2 int convertMulCInt32Avx2(const int32_t* pSrc, float val, float* pDst, int len)
+  {
+    const __m256 scale = _mm256_set1_ps(val);
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i));
+      __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i + 8));
+      _mm256_storeu_ps(pDst + i,     _mm256_mul_ps(_mm256_cvtepi32_ps(a), scale));
+      _mm256_storeu_ps(pDst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(b), scale));
+    }
+    return i;
+  }
+
+  REPLACEMENT_TARGET_AVX2 int mulCAvx2(const float* pSrc, float val, float* pDst, int len)
+  {
+    const __m256 scale = _mm256_set1_ps(val);
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+      _mm256_storeu_ps(pDst + i,     _mm256_mul_ps(_mm256_loadu_ps(pSrc + i), scale));
+      _mm256_storeu_ps(pDst + i + 8, _mm256_mul_ps(_mm256_loadu_ps(pSrc + i + 8), scale));
+    }
+    return i;
+  }
+#endif
+
+  // the vector kernels process a prefix of the data, the scalar loops the rest
+  int convertMulCInt16(const int16_t* pSrc, float val, float* pDst, int len)
+  {
+#ifdef REPLACEMENT_X86
+    switch (simdLevel())
+    {
+    case SimdAvx2: return convertMulCInt16Avx2(pSrc, val, pDst, len);
+    case SimdSse2: return convertMulCInt16Sse2(pSrc, val, pDst, len);
+    default: break;
+    }
+#endif
+    return 0;
+  }
+
+  int convertMulCInt32(const int32_t* pSrc, float val, float* pDst, int len)
+  {
+#ifdef REPLACEMENT_X86
+    switch (simdLevel())
+    {
+    case SimdAvx2: return convertMulCInt32Avx2(pSrc, val, pDst, len);
+    case SimdSse2: return convertMulCInt32Sse2(pSrc, val, pDst, len);
+    default: break;
+    }
+#endif
+    return 0;
+  }
+
+  int mulC(const float* pSrc, float val, float* pDst, int len)
+  {
+#ifdef REPLACEMENT_X86
+    switch (simdLevel())
+    {
+    case SimdAvx2: return mulCAvx2(pSrc, val, pDst, len);
+    case SimdSse2: return mulCSse2(pSrc, val, pDst, len);
+    default: break;
+    }
+#endif
+    return 0;
+  }
+
+  int realToCplx(const float* pSrcRe, const float* pSrcIm, floatc* pDst, int len)
+  {
+#ifdef REPLACEMENT_X86
+    if (simdLevel() >= SimdSse2)
+    {
+      return realToCplxSse2(pSrcRe, pSrcIm, pDst, len);
+    }
+#endif
+    return 0;
+  }
+
+  int cplxToReal(const floatc* pSrc, float* pDstRe, float* pDstIm, int len)
+  {
+#ifdef REPLACEMENT_X86
+    if (simdLevel() >= SimdSse2)
+    {
+      return cplxToRealSse2(pSrc, pDstRe, pDstIm, len);
+    }
+#endif
+    return 0;
+  }
+}
+
+SimdLevel GetSimdLevel()
+{
+  return simdLevel();
+}
+
+SimdLevel SetSimdLevel(SimdLevel level)
+{
+  if (level > g_simdLevelMax)
+  {
+    level = g_simdLevelMax;
+  }
+  g_simdLevel.store(level, std::memory_order_relaxed);
+  return level;
+}
 
 char* ippGetStatusString(Status ipps)
 {
@@ -50,7 +310,7 @@ Status SwapBytes_uint32_t(uint32_t* pSrcDst, int len)
 
 Status Convert_int16_t_float(const int16_t* pSrc, float* pDst, int len)
 {
-  for (int i = 0; i < len; i++)
+  for (int i = convertMulCInt16(pSrc, 1.0f, pDst, len); i < len; i++)
   {
     pDst[i] = (float)pSrc[i];
   }
@@ -59,7 +319,7 @@ Status Convert_int16_t_float(const int16_t* pSrc, float* pDst, int len)
 
 Status Convert_int32_t_float(const int32_t * pSrc, float * pDst, int len)
 {
-  for (int i = 0; i < len; i++)
+  for (int i = convertMulCInt32(pSrc, 1.0f, pDst, len); i < len; i++)
   {
     pDst[i] = (float) pSrc[i];
   }
@@ -68,7 +328,7 @@ Status Convert_int32_t_float(const int32_t * pSrc, float * pDst, int len)
 
 Status MulC_float(float val, float * pSrcDst, int len)
 {
-  for (int i = 0; i < len; i++)
+  for (int i = mulC(pSrcDst, val, pSrcDst, len); i < len; i++)
   {
     pSrcDst[i] *= val;
   }
@@ -77,17 +337,34 @@ Status MulC_float(float val, float * pSrcDst, int len)
 
 Status MulC_float(const float * pSrc, float val, float * pDst, int len)
 {
-  for (int i = 0; i < len; i++)
+  for (int i = mulC(pSrc, val, pDst, len); i < len; i++)
   {
     pDst[i] = pSrc[i] * val;
   }
   return StsNoErr;
 }
 
+Status ConvertMulC_int16_t_float(const int16_t* pSrc, float val, float* pDst, int len)
+{
+  for (int i = convertMulCInt16(pSrc, val, pDst, len); i < len; i++)
+  {
+    pDst[i] = (float)pSrc[i] * val;
+  }
+  return StsNoErr;
+}
+
+Status ConvertMulC_int32_t_float(const int32_t* pSrc, float val, float* pDst, int len)
+{
+  for (int i = convertMulCInt32(pSrc, val, pDst, len); i < len; i++)
+  {
+    pDst[i] = (float)pSrc[i] * val;
+  }
+  return StsNoErr;
+}
 
 Status RealToCplx_float(const float* pSrcRe, const float* pSrcIm, floatc* pDst, int len)
 {
-  for (int i = 0; i < len; i++)
+  for (int i = realToCplx(pSrcRe, pSrcIm, pDst, len); i < len; i++)
   {
     pDst[i].re = pSrcRe[i];
     pDst[i].im = pSrcIm[i];
@@ -97,7 +374,7 @@ Status RealToCplx_float(const float* pSrcRe, const float* pSrcIm, floatc* pDst,
 
 Status CplxToReal_floatc(const floatc* pSrc, float* pDstRe, float* pDstIm, int len) 
 {
-  for (int i = 0; i < len; i++)
+  for (int i = cplxToReal(pSrc, pDstRe, pDstIm, len); i < len; i++)
   {
     pDstRe[i] = pSrc[i].re;
     pDstIm[i] = pSrc[i].im;
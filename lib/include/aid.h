@@ -129,6 +129,65 @@ public:
   /// @brief append channels
   int appendChannels(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes) override;
 
+  void setStatisticsEnabled(bool enabled) override;
+
+  IoStatistics getStatistics() const override;
+
+  /** @brief Set the frame layout used to write the file. Must be called before writeOpen().
+  * Each frame is assembled in memory and written with a single call, so larger frames
+  * reduce the number of write calls while smaller frames reduce the memory footprint.
+  * @param [in]  samplesPerBlock Number of i/q samples per data block. Default is 131072.
+  * @param [in]  blocksPerFrame Number of data blocks per frame. Default is 1.
+  * @returns ErrorCodes.Success (=0) if the settings are valid, ErrorCodes::WriterAlreadyInitialized if the
+  * file is already open for writing or ErrorCodes::InconsistentInputData if the frame exceeds the maximum
+  * AID frame length.
+  */ int setFrameSettings(size_t samplesPerBlock, size_t blocksPerFrame);
+
+  /** @brief Write the assembled frames by a background thread, so that the conversion of the next
+  * frame overlaps with the file I/O. Must be called before writeOpen(). Disabled by default.
+  * @param [in]  asyncWrite True to enable the background thread.
+  * @returns ErrorCodes.Success (=0) or ErrorCodes::WriterAlreadyInitialized if the file is already open for writing.
+  */ int setAsyncWrite(bool asyncWrite);
+
+  /** @brief Store the frame index of the file in a sidecar file "<filename>.zfidx". Must be called before readOpen().
+  * readOpen() scans the headers of all frames once to build the frame index. If enabled, the index is loaded
+  * from the sidecar file instead, and a newly built index is stored into it. The sidecar file is only used if
+  * it matches the size and the modification time of the file. Disabled by default.
+  * @param [in]  enabled True to use the sidecar file.
+  * @returns ErrorCodes.Success (=0) or ErrorCodes::ReaderAlreadyInitialized if the file is already open for reading.
+  */ int setFrameIndexFileEnabled(bool enabled);
+
+  /** @brief Read the I or Q values of an array as stored in the file, without conversion to floating point.
+  * Frames with 16 bit values can be read as int16 or int32, frames with 32 bit integer values as int32.
+  * The Q values of real-valued frames are 0. Multiplying the values with scale results in the values
+  * returned by readArray() with float or double values.
+  * @param [in]  arrayName Name of the array.
+  * @param [out] values Preallocated buffer for nofValues values.
+  * @param [in]  nofValues Number of values to read.
+  * @param [out] scale Factor converting the values to volts, including the gain and antenna voltage reference.
+  * @param [in]  offset Index of the first value to read.
+  * @returns ErrorCodes.Success (=0), ErrorCodes::WrongDataType if the values are stored as floating point or
+  * do not fit into int16, ErrorCodes::InconsistentInputData if the gain changes within the values read, so
+  * that there is no single scale, or another error code.
+  */ int readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset = 0);
+
+  /// @brief read the I or Q values of an array as stored in the file into int32 values, see readArray()
+  int readArray(const std::string& arrayName, int32_t* values, size_t nofValues, double& scale, size_t offset = 0);
+
+  /** @brief Read the IQ values of a channel as stored in the file, without conversion to floating point.
+  * The values are interleaved as in readChannel() with float or double values, see readArray() for the
+  * supported frames and the scale.
+  * @param [in]  channelName Name of the channel.
+  * @param [out] values Preallocated buffer for 2 * nofValues values.
+  * @param [in]  nofValues Number of IQ pairs to read.
+  * @param [out] scale Factor converting the values to volts.
+  * @param [in]  offset Index of the first IQ pair to read.
+  * @returns ErrorCodes.Success (=0) or an error code, see readArray().
+  */ int readChannel(const std::string& channelName, int16_t* values, size_t nofValues, double& scale, size_t offset = 0);
+
+  /// @brief read the IQ values of a channel as stored in the file into int32 values, see readChannel()
+  int readChannel(const std::string& channelName, int32_t* values, size_t nofValues, double& scale, size_t offset = 0);
+
 private:
   /// pointer to implementation class
   AidImpl* m_pimpl;
@@ -95,6 +95,20 @@ namespace rohdeschwarz
 				  int appendChannels(const std::vector<std::vector<double> >& iqdata);
 				  /// @brief append channels
 				  int appendChannels(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes);
+				  /// @brief set number of samples per data block and data blocks per frame for writing
+				  int setFrameSettings(size_t samplesPerBlock, size_t blocksPerFrame);
+				  /// @brief enable the background thread writing the frames
+				  int setAsyncWrite(bool asyncWrite);
+				  /// @brief enable the frame index sidecar file used by readOpen()
+				  int setFrameIndexFileEnabled(bool enabled);
+				  /// @brief read I or Q values as stored in the file
+				  int readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset);
+				  /// @brief read I or Q values as stored in the file
+				  int readArray(const std::string& arrayName, int32_t* values, size_t nofValues, double& scale, size_t offset);
+				  /// @brief read interleaved IQ values as stored in the file
+				  int readChannel(const std::string& channelName, int16_t* values, size_t nofValues, double& scale, size_t offset);
+				  /// @brief read interleaved IQ values as stored in the file
+				  int readChannel(const std::string& channelName, int32_t* values, size_t nofValues, double& scale, size_t offset);
 
 			private:
 
@@ -116,9 +130,23 @@ namespace rohdeschwarz
 				/// reset data when open is called
 				void resetData();
 
-        /// read data from aid file
+        /// read data from aid file, the last decoded block is reused for the same offset and count
         int readAid(size_t nofValues, size_t offset);
 
+        /// read values as stored in the aid file into m_rawArr
+        int readAidRaw(size_t nofValues, size_t offset, uint32_t valueSize, double& scale);
+
+        /// copy the I or Q values of m_rawArr
+        template<typename T>
+        int readArrayRaw(const std::string& arrayName, T* values, size_t nofValues, double& scale, size_t offset);
+
+        /// copy the interleaved IQ values of m_rawArr
+        template<typename T>
+        int readChannelRaw(T* values, size_t nofValues, double& scale, size_t offset);
+
+        /// write the samples of m_cArr to the aid file
+        int writeAid();
+
 
 				/// file name
 				const std::string m_filename;
@@ -142,6 +170,20 @@ namespace rohdeschwarz
         CZFFileReader m_reader;
         CZFFileWriter m_writer;
         CArrayComplex m_cArr;
+        /// offset of the decoded block in m_cArr
+        size_t m_cArrOffset;
+        /// number of samples of the decoded block in m_cArr
+        size_t m_cArrValues;
+        /// indicates if m_cArr holds a decoded block
+        bool m_cArrValid;
+        /// memory of the values read as stored in the file, see readAidRaw()
+        CArrayComplex m_rawArr;
+        /// number of samples per data block for writing
+        uint32 m_samplesPerBlock;
+        /// number of data blocks per frame for writing
+        uint32 m_blocksPerFrame;
+        /// frames are written by a background thread
+        bool m_asyncWrite;
       };
 		}
 	}
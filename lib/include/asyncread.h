@@ -0,0 +1,91 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      asyncread.h
+*
+* @brief     This is the header file of class AsyncRead.
+*
+* @details   Types and settings of the asynchronous read functions, e.g. Iqw::readChannelAsync().
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+#include <functional>
+
+#include "exportdecl.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+      * @brief Called once when an asynchronous read has completed. The argument is ErrorCodes::Success if all values
+      * have been read, otherwise an error code. The callback is called on an internal thread of the library, or before
+      * the read function returns if no values are requested. It should return quickly, as it delays the completion of
+      * other reads, and must not close the file object the read was started on.
+      */
+      typedef std::function<void(int errorCode)> AsyncReadCallback;
+
+      /**
+      * @brief The I/O backends of asynchronous reads.
+      */
+      enum class AsyncReadBackend
+      {
+        /** @brief Linux io_uring with registered buffers. Reads are completed by one internal thread. */
+        IoUring,
+
+        /** @brief Positional reads on a pool with one thread per hardware thread. Available on all platforms. */
+        ThreadPool
+      };
+
+      /**
+      * @brief Settings of the asynchronous reads, which are shared by all file objects.
+      *
+      * Asynchronous reads are supported by the formats storing I/Q data at offsets that can be computed from the
+      * header, i.e. iq.tar, IQW and WV, and by IQX files with 16 bit streams, whose frames are located with the cue index.
+      * They are started with readArrayAsync() and readChannelAsync() of the file objects, which validate the parameters,
+      * compute the byte ranges to read and return without waiting for the data. Any number of reads may be pending, for
+      * one or many files. Values are converted like by the synchronous read functions. The bytes read asynchronously are
+      * counted by IoStatistics when they arrive, the time spent waiting for them is not.
+      */
+      class AsyncRead final
+      {
+      public:
+        /**
+          @brief Selects the backend of all asynchronous reads started afterwards. Waits until the reads started
+          on the previous backend have completed. By default io_uring is used if supported by the system.
+          @param [in]  backend The backend to use. If io_uring is selected, but not supported by the system,
+          the thread pool is used.
+          @returns Returns ErrorCodes::Success if the specified backend is used, otherwise ErrorCodes::InternalError.
+        */MOSAIK_MODULE static int setBackend(AsyncReadBackend backend);
+
+        /**
+          @returns Returns the backend used for asynchronous reads.
+        */MOSAIK_MODULE static AsyncReadBackend getBackend();
+
+      private:
+        /** @brief Private constructor, class is static. */
+        AsyncRead();
+      };
+    }
+  }
+}
@@ -0,0 +1,210 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      asyncreadservice.h
+*
+* @brief     This is the header file of classes AsyncReadService and AsyncFile.
+*
+* @details   Executes the asynchronous reads of all file objects, see AsyncRead.
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "asyncread.h"
+#include "statisticscollector.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+      * @brief Binary type of the values stored in a file.
+      */
+      enum class RawValueType
+      {
+        Int16,
+        Float32,
+        Float64
+      };
+
+      /**
+      * @brief Values of a file copied to the destination of an asynchronous read. The values are copied in groups
+      * of groupSize consecutive values, e.g. 1 for an I array or 2 for interleaved I/Q pairs. Consecutive groups
+      * are srcStride values apart in the file and destStride values apart in the destination. A group must not
+      * be larger than srcStride and the I/O buffers, i.e. large contiguous ranges are described by groups of one value.
+      */
+      struct RawSegment
+      {
+        RawSegment(uint64_t fileOffset, size_t nofGroups, size_t groupSize, size_t srcStride, size_t destIndex, size_t destStride) :
+          fileOffset(fileOffset),
+          nofGroups(nofGroups),
+          groupSize(groupSize),
+          srcStride(srcStride),
+          destIndex(destIndex),
+          destStride(destStride)
+        {
+        }
+
+        /** @brief Position of the first value in the file in bytes. */
+        uint64_t fileOffset;
+
+        /** @brief Number of groups to copy. */
+        size_t nofGroups;
+
+        /** @brief Number of consecutive values per group. */
+        size_t groupSize;
+
+        /** @brief Distance of consecutive groups in the file, in values. */
+        size_t srcStride;
+
+        /** @brief Index of the first value in the destination. */
+        size_t destIndex;
+
+        /** @brief Distance of consecutive groups in the destination, in values. */
+        size_t destStride;
+      };
+
+      /**
+      * @brief File opened for asynchronous reads. Each pending read holds a reference, so the descriptor stays
+      * valid until the last read has completed, even if the file object has been closed.
+      */
+      class AsyncFile final
+      {
+      public:
+        /**
+          @brief Opens the specified file for reading.
+          @param [in]  filename Name of the file, UTF-8 encoded.
+          @returns Returns the file or nullptr if the file cannot be opened.
+        */static std::shared_ptr<AsyncFile> open(const std::string& filename);
+
+        /** @brief Destructor. Closes the descriptor. */
+        ~AsyncFile();
+
+        /** @returns Returns the file descriptor. */
+        int getFd() const;
+
+        /** @brief Counts a read started. */
+        void beginRead();
+
+        /** @brief Counts a read completed, i.e. its callback has returned. */
+        void endRead();
+
+        /** @brief Waits until all reads started have completed. */
+        void wait();
+
+      private:
+        /** @brief Constructor. Takes ownership of the descriptor. */
+        explicit AsyncFile(int fd);
+
+        /** @brief Private copy constructor. */
+        AsyncFile(const AsyncFile&);
+
+        /** @brief Private assignment operator.*/
+        AsyncFile& operator=(const AsyncFile&);
+
+        /** @brief The file descriptor. */
+        const int fd_;
+
+        /** @brief Protects pending_. */
+        std::mutex mutex_;
+
+        /** @brief Signaled if all reads have completed. */
+        std::condition_variable idle_;
+
+        /** @brief Number of reads started, but not completed. */
+        size_t pending_;
+      };
+
+      class AsyncReadBackendBase;
+
+      /**
+      * @brief Executes the asynchronous reads of all file objects on the selected backend. Reads are split into
+      * chunks of the size of the I/O buffers, which are read into the buffers and then converted to the destination.
+      */
+      class AsyncReadService final
+      {
+      public:
+        /** @returns Returns the service, which is created on first use. */
+        static AsyncReadService& instance();
+
+        /** @copydoc AsyncRead::setBackend() */
+        int setBackend(AsyncReadBackend backend);
+
+        /** @copydoc AsyncRead::getBackend() */
+        AsyncReadBackend getBackend();
+
+        /**
+          @brief Starts an asynchronous read.
+          @tparam T Type of the destination values, float or double.
+          @param [in,out]  file The file read from. Opened if it is nullptr.
+          @param [in]  filename Name of the file, UTF-8 encoded.
+          @param [in]  type Binary type of the values in the file.
+          @param [in]  scale The values read are multiplied with scale.
+          @param [in]  segments The values to read. The destination must be large enough for all segments.
+          @param [out]  values The destination of the values.
+          @param [in]  callback Called once when all segments have been read. If no values are read, the callback is called before this function returns.
+          @param [in]  statistics Counts the bytes read when the chunks complete, before the callback is called. Must stay valid
+          until the file has been closed with close(), nullptr if not counted.
+          @returns Returns ErrorCodes::Success if the read has been started, otherwise ErrorCodes::FileOpenError and the callback is not called.
+        */template<typename T>
+        int read(std::shared_ptr<AsyncFile>& file, const std::string& filename, RawValueType type, double scale, const std::vector<RawSegment>& segments, T* values, AsyncReadCallback callback, StatisticsCollector* statistics)
+        {
+          return this->submit(file, filename, type, scale, segments, values, sizeof(T) == sizeof(double), callback, statistics);
+        }
+
+        /**
+          @brief Waits until all reads of a file have completed and releases the file.
+          @param [in,out]  file The file. Reset to nullptr.
+        */static void close(std::shared_ptr<AsyncFile>& file);
+
+      private:
+        /** @brief Private constructor, use instance(). */
+        AsyncReadService();
+
+        /** @brief Private copy constructor. */
+        AsyncReadService(const AsyncReadService&);
+
+        /** @brief Private assignment operator.*/
+        AsyncReadService& operator=(const AsyncReadService&);
+
+        /** @brief Untyped implementation of read(). */
+        int submit(std::shared_ptr<AsyncFile>& file, const std::string& filename, RawValueType type, double scale, const std::vector<RawSegment>& segments, void* values, bool isDouble, AsyncReadCallback callback, StatisticsCollector* statistics);
+
+        /** @returns Returns the backend, created on first use. */
+        std::shared_ptr<AsyncReadBackendBase> getBackendInstance();
+
+        /** @brief Protects backend_. */
+        std::mutex mutex_;
+
+        /** @brief The backend new reads are submitted to. */
+        std::shared_ptr<AsyncReadBackendBase> backend_;
+      };
+    }
+  }
+}
@@ -0,0 +1,184 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      batchconverter.h
+*
+* @brief     This is the header file of class BatchConverter.
+*
+* @details   Converts many I/Q data files to one file type in parallel.
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "exportdecl.h"
+#include "enums.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+      * @brief Converts a batch of I/Q data files to one file type, see also FormatConverter.
+      *
+      * All files are converted by one work-stealing thread pool, sized to the number of cores by default.
+      * Files are scheduled largest first. Files with more samples than the split size are read as ranges
+      * of chunks, which are read and converted by idle workers in parallel while the file's own task appends
+      * them to the output file in order. Hence, the end of a batch is not dominated by a single large file.
+      *
+      * The total memory of the chunk buffers and the total number of temporary files of the output files
+      * in progress are limited, a file waits until enough memory and temporary files are available.
+      * The input file is opened before, since its metadata determines the memory and temporary files needed,
+      * so the number of open input files is limited by the number of threads, not by these budgets.
+      */
+      class MOSAIK_MODULE BatchConverter
+      {
+      public:
+        /**
+          @brief Constructor. Initializes a new instance writing files of the specified type.
+          @param [in]  outputType File type of the files to be written.
+          @param [in]  outputDirectory Directory of the files to be written, UTF-8 encoded. The output filename
+          is the input filename with the extension of the output file type.
+        */BatchConverter(FileType outputType, const std::string& outputDirectory);
+
+        /** @brief Destructor. */
+        ~BatchConverter();
+
+        /**
+          @brief Adds a file to the batch.
+          @param [in]  inputFilename Name of the file to be read, UTF-8 encoded.
+          @param [in]  inputType File type of the file to be read.
+          @returns Returns ErrorCodes::Success (=0) if the file has been added. If the file is not accessible,
+          ErrorCodes::FileNotFound is returned.
+        */int addFile(const std::string& inputFilename, FileType inputType);
+
+        /**
+          @brief Adds all files matching the specified pattern to the batch.
+          @param [in]  pattern Path with wildcards '*' and '?' in the filename, e.g. "/data/rec_??.iqx", UTF-8 encoded.
+          @param [in]  inputType File type of the files to be read.
+          @returns Returns ErrorCodes::Success (=0) if at least one file has been added. If no file matches the pattern,
+          ErrorCodes::FileNotFound is returned.
+        */int addFiles(const std::string& pattern, FileType inputType);
+
+        /**
+          @brief Sets the number of worker threads. Default is 0, i.e. one worker per hardware thread.
+          Must be set before convert() is called.
+          @param [in]  nofThreads Number of workers.
+        */void setNofThreads(size_t nofThreads);
+
+        /**
+          @brief Sets the maximum memory of all chunk buffers in bytes. Default is 268435456 (256 MB).
+          Must be set before convert() is called.
+          @param [in]  nofBytes Maximum memory in bytes.
+          @returns Returns ErrorCodes::Success (=0) if the limit has been set. If nofBytes is 0, ErrorCodes::InvalidArraySize
+          is returned.
+        */int setMaxBufferMemory(uint64_t nofBytes);
+
+        /**
+          @brief Sets the maximum number of temporary files that are open at once. Output files that require more temporary
+          files than the limit are written one at a time. Default is 64. Must be set before convert() is called.
+          @param [in]  nofFiles Maximum number of temporary files.
+          @returns Returns ErrorCodes::Success (=0) if the limit has been set. If nofFiles is 0, ErrorCodes::InvalidArraySize
+          is returned.
+        */int setMaxTempFiles(size_t nofFiles);
+
+        /**
+          @brief Sets the number of samples per channel that are read, converted and written at once. Default is 262144.
+          Must be set before convert() is called.
+          @param [in]  nofSamples Number of samples (I/Q pairs for complex data) per channel and chunk.
+          @returns Returns ErrorCodes::Success (=0) if the chunk size has been set. If nofSamples is 0, ErrorCodes::InvalidArraySize
+          is returned.
+        */int setChunkSize(size_t nofSamples);
+
+        /**
+          @brief Sets the number of samples per channel above which a file is read as ranges in parallel. Default is 16777216.
+          Must be set before convert() is called.
+          @param [in]  nofSamples Number of samples per channel.
+        */void setSplitSize(uint64_t nofSamples);
+
+        /**
+          @brief Sets the precision of the I/Q values passed from the input to the output files, see FormatConverter::setDataType().
+          Must be set before convert() is called.
+          @param [in]  dataType Precision of the values.
+        */void setDataType(IqDataType dataType);
+
+        /**
+          @brief Converts all files of the batch. The call returns when all output files have been closed. The result of each
+          file is available from getResult().
+          @returns Returns ErrorCodes::Success (=0) if all files have been converted. Otherwise the error code of the first
+          failed file is returned.
+        */int convert();
+
+        /**
+          @returns Returns the number of files in the batch.
+        */size_t getNofFiles() const;
+
+        /**
+          @param [in]  index Index of the file, in the order the files have been added.
+          @returns Returns the name of the input file.
+        */std::string getInputFilename(size_t index) const;
+
+        /**
+          @param [in]  index Index of the file, in the order the files have been added.
+          @returns Returns the name of the output file.
+        */std::string getOutputFilename(size_t index) const;
+
+        /**
+          @param [in]  index Index of the file, in the order the files have been added.
+          @returns Returns ErrorCodes::Success (=0) if the file has been converted by the last call of convert(),
+          otherwise the error code of the failed operation.
+        */int getResult(size_t index) const;
+
+        /**
+          @returns Returns the number of bytes of I/Q values passed from the input to the output files by the
+          last call of convert().
+        */uint64_t getBytesConverted() const;
+
+        /**
+          @returns Returns the duration of the last call of convert() in seconds.
+        */double getElapsedSeconds() const;
+
+        /**
+          @returns Returns the throughput of the last call of convert() in MB/s (10^6 bytes per second).
+        */double getMegabytesPerSecond() const;
+
+      private:
+        /** @brief Private default constructor. */
+        BatchConverter();
+
+        /** @brief Private copy constructor. */
+        BatchConverter(const BatchConverter&);
+
+        /** @brief Private assignment operator.*/
+        BatchConverter& operator=(const BatchConverter&);
+
+        /** @brief Private implementation */
+        class Impl;
+
+        /** @brief Private implementation */
+        Impl* pimpl;
+      };
+    }
+  }
+}
@@ -0,0 +1,261 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      batchconverterpimpl.h
+*
+* @brief     This is the header file of class BatchConverter::Impl.
+*
+* @details   This class contains the implementation of BatchConverter.
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "batchconverter.h"
+#include "formatconverterpimpl.h"
+#include "filetypeservice.h"
+#include "workstealingpool.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+      * @brief Private implementation of class BatchConverter.
+      */
+      class BatchConverter::Impl
+      {
+      public:
+        /** @copydoc BatchConverter::BatchConverter() */
+        Impl(FileType outputType, const std::string& outputDirectory);
+
+        /** @copydoc BatchConverter::addFile() */
+        int addFile(const std::string& inputFilename, FileType inputType);
+
+        /** @copydoc BatchConverter::addFiles() */
+        int addFiles(const std::string& pattern, FileType inputType);
+
+        /** @copydoc BatchConverter::setNofThreads() */
+        void setNofThreads(size_t nofThreads);
+
+        /** @copydoc BatchConverter::setMaxBufferMemory() */
+        int setMaxBufferMemory(uint64_t nofBytes);
+
+        /** @copydoc BatchConverter::setMaxTempFiles() */
+        int setMaxTempFiles(size_t nofFiles);
+
+        /** @copydoc BatchConverter::setChunkSize() */
+        int setChunkSize(size_t nofSamples);
+
+        /** @copydoc BatchConverter::setSplitSize() */
+        void setSplitSize(uint64_t nofSamples);
+
+        /** @copydoc BatchConverter::setDataType() */
+        void setDataType(IqDataType dataType);
+
+        /** @copydoc BatchConverter::convert() */
+        int convert();
+
+        /** @copydoc BatchConverter::getNofFiles() */
+        size_t getNofFiles() const;
+
+        /** @copydoc BatchConverter::getInputFilename() */
+        std::string getInputFilename(size_t index) const;
+
+        /** @copydoc BatchConverter::getOutputFilename() */
+        std::string getOutputFilename(size_t index) const;
+
+        /** @copydoc BatchConverter::getResult() */
+        int getResult(size_t index) const;
+
+        /** @copydoc BatchConverter::getBytesConverted() */
+        uint64_t getBytesConverted() const;
+
+        /** @copydoc BatchConverter::getElapsedSeconds() */
+        double getElapsedSeconds() const;
+
+        /** @copydoc BatchConverter::getMegabytesPerSecond() */
+        double getMegabytesPerSecond() const;
+
+      private:
+        /** @brief A file of the batch. */
+        struct Job
+        {
+          std::string inputFilename;
+          FileType inputType;
+          std::string outputFilename;
+          int result;
+          uint64_t bytesConverted;
+        };
+
+        /**
+        * @brief Counting limit of a resource shared by all files, e.g. bytes of buffer memory.
+        */
+        class Budget
+        {
+        public:
+          explicit Budget(uint64_t capacity) : capacity_(capacity), used_(0) {}
+
+          /** @brief Waits until the amount is available. Amounts larger than the capacity are limited to the capacity. */
+          uint64_t acquire(uint64_t amount)
+          {
+            amount = std::min(amount, this->capacity_);
+            std::unique_lock<std::mutex> lock(this->mutex_);
+            this->condition_.wait(lock, [this, amount] { return this->used_ + amount <= this->capacity_; });
+            this->used_ += amount;
+            return amount;
+          }
+
+          /** @brief Returns an amount taken by acquire(). */
+          void release(uint64_t amount)
+          {
+            {
+              std::lock_guard<std::mutex> lock(this->mutex_);
+              this->used_ -= amount;
+            }
+            this->condition_.notify_all();
+          }
+
+        private:
+          const uint64_t capacity_;
+          uint64_t used_;
+          std::mutex mutex_;
+          std::condition_variable condition_;
+        };
+
+        /**
+        * @brief State of one file that is read as ranges of chunks. Range r is stored in slot r % slots.size().
+        */
+        template<typename T>
+        struct RangeState
+        {
+          std::mutex mutex;
+          std::condition_variable condition;
+
+          /** @brief Chunk buffers, one per range in flight. */
+          std::vector<FormatConverter::Impl::Chunk<T>> slots;
+
+          /** @brief TRUE if the range of a slot has been read and converted. */
+          std::vector<bool> ready;
+
+          /** @brief Readers not in use. Each range is read by one reader, readers are not thread safe. */
+          std::vector<std::unique_ptr<IDataImportExport>> readers;
+
+          /** @brief Number of ranges of the file. */
+          uint64_t nofRanges;
+
+          /** @brief Next range not yet claimed by a reading task. */
+          uint64_t nextRange;
+
+          /** @brief Number of ranges written. */
+          uint64_t written;
+
+          /** @brief Number of ranges claimed, but not yet read. */
+          size_t reading;
+
+          /** @brief TRUE if the file has been written or failed, no more ranges are claimed. */
+          bool finished;
+
+          /** @brief Error code of the first failed range. */
+          int error;
+        };
+
+        /**
+          @brief Converts one file. Called by a worker of the pool.
+          @param [in]  pool The pool, used to read ranges of large files in parallel.
+          @param [in]  memory Budget of buffer memory.
+          @param [in]  tempFiles Budget of temporary files.
+          @param [in,out]  job The file.
+          @returns Returns ErrorCodes::Success (=0) or the error code of the failed operation.
+        */int convertFile(WorkStealingPool& pool, Budget& memory, Budget& tempFiles, Job& job);
+
+        /**
+          @brief Reads the input file of a conversion as ranges of chunks, converts them and appends them to the output file in order.
+          @tparam T Precision of the values - float or double.
+          @param [in]  pool The pool, used to read up to nofSlots ranges in parallel.
+          @param [in]  converter The converter of the file, used to create additional readers.
+          @param [in]  conversion The opened files.
+          @param [in]  chunkSize Number of samples per channel and range.
+          @param [in]  nofSlots Number of ranges in flight.
+          @param [out]  bytesConverted Number of bytes passed from the input to the output file.
+          @returns Returns ErrorCodes::Success (=0) or the error code of the first failed range.
+        */template<typename T>
+        int runRanges(WorkStealingPool& pool, const FormatConverter::Impl& converter, FormatConverter::Impl::Conversion& conversion, size_t chunkSize, size_t nofSlots, uint64_t& bytesConverted);
+
+        /**
+          @brief Claims and reads the next range, if any. Called by range tasks and by the writing task.
+          Range tasks may run after the file has been finished, converter and conversion are only accessed if a range is claimed.
+          @param [in]  state State of the file.
+          @param [in]  converter The converter of the file, used to create additional readers.
+          @param [in]  conversion The opened files.
+          @param [in]  chunkSize Number of samples per channel and range.
+          @returns Returns TRUE if a range has been read or failed, FALSE if no range could be claimed.
+        */template<typename T>
+        static bool readNextRange(RangeState<T>& state, const FormatConverter::Impl* converter, const FormatConverter::Impl::Conversion* conversion, size_t chunkSize);
+
+        /**
+          @param [in]  conversion A conversion prepared by FormatConverter::Impl::openInput().
+          @returns Returns the number of temporary files the output file of the conversion requires while it is written.
+        */size_t getNofTempFiles(const FormatConverter::Impl::Conversion& conversion) const;
+
+        /** @brief File type of the files to be written. */
+        const FileType outputType_;
+
+        /** @brief Directory of the files to be written. */
+        const std::string outputDirectory_;
+
+        /** @brief The files of the batch. */
+        std::vector<Job> jobs_;
+
+        /** @brief Number of workers, 0 for one per hardware thread. */
+        size_t nofThreads_;
+
+        /** @brief Maximum memory of all chunk buffers in bytes. */
+        uint64_t maxBufferMemory_;
+
+        /** @brief Maximum number of temporary files open at once. */
+        size_t maxTempFiles_;
+
+        /** @brief Number of samples per channel and chunk. */
+        size_t chunkSize_;
+
+        /** @brief Number of samples per channel above which a file is read as ranges in parallel. */
+        uint64_t splitSize_;
+
+        /** @brief Precision of the values passed through the pipeline. */
+        IqDataType dataType_;
+
+        /** @brief TRUE if the precision has been set by setDataType(), otherwise it is taken from the input files. */
+        bool dataTypeSet_;
+
+        /** @brief Duration of the last conversion in seconds. */
+        double elapsedSeconds_;
+      };
+    }
+  }
+}
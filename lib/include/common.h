@@ -160,12 +160,9 @@ namespace rohdeschwarz
         {
           try
           {
-            Common::localeLock_.lock();
+            // codecvt_utf8 does not depend on the locale
             std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
-            auto ret = converter.from_bytes(utf8Src.data());
-            Common::localeLock_.unlock();
-
-            return ret;
+            return converter.from_bytes(utf8Src.data());
           }
           catch (...)
           {
@@ -182,10 +179,7 @@ namespace rohdeschwarz
         {
           try
           {
-            Common::localeLock_.lock();
             std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
-            Common::localeLock_.unlock();
-
             return converter.to_bytes(utf16Src.data());
           }
           catch (...)
@@ -677,10 +671,6 @@ namespace rohdeschwarz
 
           return r;
         }
-
-        /** @brief Protects setlocale function, e.g. used in libarchive functions and utf8-conversion.
-        Setlocale is not thread-safe, but will probably be removed in libarchive version 4.
-        */static std::mutex localeLock_;
       };
     }
   }
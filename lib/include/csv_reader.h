@@ -35,6 +35,8 @@
 #include <map>
 
 #include "ianalyzecontent.h"
+#include "statisticscollector.h"
+#include "tracescope.h"
 #include "daiexception.h"
 #include "common.h"
 #include "errorcodes.h"
@@ -58,7 +60,8 @@ namespace rohdeschwarz
           Be aware that the filename cannot be changed after construction.
           @param [in]  filename Name of the file to be read or to be written.
           @param [in]  updateContent Provides callback methods to process meta data found in file.
-        */CsvReader(const std::string& filename, IAnalyzeContent& updateContent);
+          @param [in]  statistics I/O statistics updated by this reader.
+        */CsvReader(const std::string& filename, IAnalyzeContent& updateContent, StatisticsCollector& statistics);
 
         /* @copydoc IqCsv::~Csv() */
         ~CsvReader();
@@ -110,6 +113,7 @@ namespace rohdeschwarz
         */template<typename T>
         void readArray(const std::string& arrayName, T* values, size_t nofValues, size_t offset)
         {
+          DAIEX_TRACE_SCOPE("CsvReader::readArray");
           // check if array name exists in file
           if (false == this->containsArray(arrayName))
           {
@@ -134,6 +138,7 @@ namespace rohdeschwarz
           // at this position.
           std::fill(values, values + nofValues, std::numeric_limits<T>::quiet_NaN());
 
+          StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Conversion);
           std::fstream stream;
           try
           {
@@ -201,6 +206,7 @@ namespace rohdeschwarz
         */template<typename T>
         void readChannel(const std::string& channelName, T* values, size_t nofValues, size_t offset)
         {
+          DAIEX_TRACE_SCOPE("CsvReader::readChannel");
           // construct array name if this is a real-valued array
           std::string arrayName;
           if (this->dataFormat_ == IqDataFormat::Real)
@@ -253,6 +259,7 @@ namespace rohdeschwarz
           // at this position.
           std::fill(values, values + nofValues, std::numeric_limits<T>::quiet_NaN());
 
+          StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Conversion);
           std::fstream stream;
           try
           {
@@ -350,6 +357,7 @@ namespace rohdeschwarz
           // at this position.
           std::fill(values, values + nofValues, std::numeric_limits<T>::quiet_NaN());
           
+          StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Conversion);
           std::fstream stream;
           try
           {
@@ -463,7 +471,7 @@ namespace rohdeschwarz
           @param [in]  stream Stream to be used to open the file.
           @returns Returns the size of the BOM mask found in bytes. If no BOM was found,
           zero is returned.
-        */static size_t openStreamIgnoreBom(const std::string& filename, std::fstream& stream);
+        */size_t openStreamIgnoreBom(const std::string& filename, std::fstream& stream);
 
         /**
           @brief Opens a stream using filename_ and sets the cursor position to the end the 
@@ -534,6 +542,9 @@ namespace rohdeschwarz
         /** @brief Callback functions that process meta data found in file.  Called by analyzeContent(). */
         IAnalyzeContent* updateContent_;
 
+        /** @brief I/O statistics updated by this reader. */
+        StatisticsCollector* statistics_;
+
         /** @brief Set true, if analyseContent() was called and the file was parsed successfully. */
         bool initialized_;
 
@@ -38,6 +38,11 @@
 #include "aid.h"
 
 #include "filetypeservice.h"
+#include "formatconverter.h"
+#include "batchconverter.h"
+#include "iostatistics.h"
+#include "trace.h"
+#include "asyncread.h"
 #include "settings.h"
 #include "errorcodes.h"
 #include "enums.h"
@@ -36,6 +36,7 @@
 #include "daiexception.h"
 #include "errorcodes.h"
 #include "channelinfo.h"
+#include "statisticscollector.h"
 
 namespace rohdeschwarz
 {
@@ -71,6 +72,12 @@ namespace rohdeschwarz
           @param [in]  timestamp The time to be saved to file.
         */virtual void setTimestamp(const time_t timestamp);
 
+        /** @copydoc IDataImportExport::setStatisticsEnabled() */
+        virtual void setStatisticsEnabled(bool enabled);
+
+        /** @copydoc IDataImportExport::getStatistics() */
+        virtual IoStatistics getStatistics() const;
+
         /**
           @brief Guarantees that all channels of the vector have unique names.
           @param [in]  channelInfos Vector of ChannelInfo() objects.
@@ -203,6 +210,9 @@ namespace rohdeschwarz
         /** @brief Timestamp saved with metadata. **/
         time_t timestamp_;
 
+        /** @brief I/O statistics, updated by the file format implementations. **/
+        StatisticsCollector statistics_;
+
       private:
         /** @brief Private default constructor. */
         DataImportExportBase();
@@ -38,6 +38,26 @@ namespace rohdeschwarz
   {
     namespace dataimportexport
     {
+      /**
+      * @brief Confidence of the file type found by FileTypeService::detect().
+      */
+      enum class DetectionConfidence
+      {
+        /** @brief The content does not match any of the supported file types. */
+        Unknown,
+
+        /** @brief The file type has no signature, but the content is consistent with it, e.g. IQW files of
+        * interleaved float32 values or tar archives with an invalid header. */
+        Low,
+
+        /** @brief A signature has been found, but the file may not contain the data expected by the reader,
+        * e.g. tar archives without iq.tar members, text files without CSV header or MAT files of version 5. */
+        Medium,
+
+        /** @brief The signature and the header of the file type have been found. */
+        High
+      };
+
       /**
       * @brief This class provides information about supported file formats on the current machine.
       **/
@@ -53,6 +73,29 @@ namespace rohdeschwarz
           @returns Returns an interface pointer to the created object.
         */MOSAIK_MODULE static IDataImportExport* create(const std::string& filename, FileType fileType);
 
+        /**
+          @brief Determines the type of an existing file from its content. Only the first 4 KB of the file are read,
+          which contain the signatures of all supported file types, i.e. the tar header and name of the first member,
+          the IQX sync words, the ZF frame magic word of AID files, the WV tag '{TYPE:', the header of MAT files
+          and the byte order mark or creation identifier of CSV files. IQW files have no signature and are reported
+          with low confidence if the content matches none of the other types.
+          MAT files of version 5 (saved by MATLAB v6 and v7) are reported as FileType::Matlab4 with medium confidence,
+          as all versions are read by the same reader.
+          @param [in]  filename Path to the I/Q data file; UTF-8 encoded.
+          @param [out]  fileType The detected file type. Not modified if the confidence is DetectionConfidence::Unknown.
+          @param [out]  confidence The confidence of the detected file type.
+          @returns Returns ErrorCodes::Success if the file has been read, ErrorCodes::FileNotFound if the file does not exist
+          or ErrorCodes::FileOpenError if the file cannot be read.
+        */MOSAIK_MODULE static int detect(const std::string& filename, FileType& fileType, DetectionConfidence& confidence);
+
+        /**
+          @brief Factory method. Determines the file type of an existing file with detect() and creates an object
+          of this type, see create(). The caller of this method takes care of memory management.
+          @param [in]  filename Path to the I/Q data file; UTF-8 encoded.
+          @returns Returns an interface pointer to the created object or nullptr if the file cannot be read or
+          its type is unknown.
+        */MOSAIK_MODULE static IDataImportExport* createAuto(const std::string& filename);
+
         /**
           @brief Gets the file types that are supported by this library.
           @returns A vector containing the possible file types.
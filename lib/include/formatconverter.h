@@ -0,0 +1,151 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      formatconverter.h
+*
+* @brief     This is the header file of class FormatConverter.
+*
+* @details   Converts I/Q data files between any of the supported file formats.
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "exportdecl.h"
+#include "enums.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+      * @brief Converts an I/Q data file of any file type supported by FileTypeService to any other supported file type.
+      *
+      * The conversion runs as a pipeline of three stages that work concurrently on different chunks of the I/Q record:
+      * - a reader thread reads a chunk of all channels from the input file,
+      * - a conversion stage adapts the data format, if the output file type does not support the data format of the
+      *   input file (e.g. real or polar data are converted to complex data for IQW or IQX files),
+      * - the writer appends the chunk to the output file.
+      *
+      * The stages are connected by bounded queues of pooled buffers, i.e. memory consumption is limited to
+      * queue size * chunk size samples per channel and no buffers are allocated while data is converted.
+      * If the output is an iq.tar file, the size of the output is known in advance and temporary files are disabled,
+      * so reading the input file and writing the output file overlap.
+      *
+      * Meta data, channel information and the timestamp of the input file are copied to the output file.
+      */
+      class MOSAIK_MODULE FormatConverter
+      {
+      public:
+        /**
+          @brief Constructor. Initializes a new instance with the specified files.
+          Filenames must be UTF-8 encoded.
+          @param [in]  inputFilename Name of the file to be read.
+          @param [in]  inputType File type of the file to be read.
+          @param [in]  outputFilename Name of the file to be written. An existing file is replaced.
+          @param [in]  outputType File type of the file to be written.
+        */FormatConverter(const std::string& inputFilename, FileType inputType, const std::string& outputFilename, FileType outputType);
+
+        /** @brief Destructor. */
+        ~FormatConverter();
+
+        /**
+          @brief Sets the number of samples per channel that are read, converted and written at once. Default is 1048576.
+          Must be set before convert() is called.
+          @param [in]  nofSamples Number of samples (I/Q pairs for complex data) per channel and chunk.
+          @returns Returns ErrorCodes::Success (=0) if the chunk size has been set. If nofSamples is 0, ErrorCodes::InvalidArraySize
+          is returned.
+        */int setChunkSize(size_t nofSamples);
+
+        /**
+          @returns Returns the number of samples per channel that are read, converted and written at once.
+        */size_t getChunkSize() const;
+
+        /**
+          @brief Sets the number of chunk buffers shared by the pipeline stages. Default is 4, i.e. while one chunk is
+          written, the next chunks can be converted and read. Must be set before convert() is called.
+          @param [in]  nofChunks Number of chunk buffers.
+          @returns Returns ErrorCodes::Success (=0) if the queue size has been set. If nofChunks is 0, ErrorCodes::InvalidArraySize
+          is returned.
+        */int setQueueSize(size_t nofChunks);
+
+        /**
+          @returns Returns the number of chunk buffers shared by the pipeline stages.
+        */size_t getQueueSize() const;
+
+        /**
+          @brief Sets the precision of the I/Q values passed from the input to the output file. By default, float64 is used
+          if the input file stores float64 data, otherwise float32 is used. Must be set before convert() is called.
+          @param [in]  dataType Precision of the values.
+        */void setDataType(IqDataType dataType);
+
+        /**
+          @brief Converts the input file to the output file. The call returns when the output file has been closed.
+          @returns Returns ErrorCodes::Success (=0) if the file has been converted. If the input file cannot be read or the
+          output file cannot be written, the error code of the failed operation is returned. For further error codes,
+          see \ref ErrorCodes.
+        */int convert();
+
+        /**
+          @returns Returns the number of samples (I/Q pairs for complex data) converted by the last call of convert(),
+          summed over all channels.
+        */uint64_t getSamplesConverted() const;
+
+        /**
+          @returns Returns the number of bytes of I/Q values passed from the input to the output file
+          by the last call of convert(), with the precision set by setDataType().
+        */uint64_t getBytesConverted() const;
+
+        /**
+          @returns Returns the duration of the last call of convert() in seconds, from opening the input
+          file until the output file has been closed.
+        */double getElapsedSeconds() const;
+
+        /**
+          @returns Returns the throughput of the last call of convert() in MB/s (10^6 bytes per second),
+          i.e. getBytesConverted() / getElapsedSeconds().
+        */double getMegabytesPerSecond() const;
+
+      private:
+        /** @brief Private default constructor. */
+        FormatConverter();
+
+        /** @brief Private copy constructor. */
+        FormatConverter(const FormatConverter&);
+
+        /** @brief Private assignment operator.*/
+        FormatConverter& operator=(const FormatConverter&);
+
+        /** @brief BatchConverter converts each file with the implementation of this class. */
+        friend class BatchConverter;
+
+        /** @brief Private implementation */
+        class Impl;
+
+        /** @brief Private implementation */
+        Impl* pimpl;
+      };
+    }
+  }
+}
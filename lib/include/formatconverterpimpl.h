@@ -0,0 +1,462 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      formatconverterpimpl.h
+*
+* @brief     This is the header file of class FormatConverter::Impl.
+*
+* @details   This class contains the implementation of FormatConverter.
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "formatconverter.h"
+#include "idataimportexport.h"
+#include "errorcodes.h"
+#include "daiexception.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+      * @brief Private implementation of class FormatConverter.
+      */
+      class FormatConverter::Impl
+      {
+      public:
+        /** @copydoc FormatConverter::FormatConverter() */
+        Impl(const std::string& inputFilename, FileType inputType, const std::string& outputFilename, FileType outputType);
+
+        /** @copydoc FormatConverter::setChunkSize() */
+        int setChunkSize(size_t nofSamples);
+
+        /** @copydoc FormatConverter::getChunkSize() */
+        size_t getChunkSize() const;
+
+        /** @copydoc FormatConverter::setQueueSize() */
+        int setQueueSize(size_t nofChunks);
+
+        /** @copydoc FormatConverter::getQueueSize() */
+        size_t getQueueSize() const;
+
+        /** @copydoc FormatConverter::setDataType() */
+        void setDataType(IqDataType dataType);
+
+        /** @copydoc FormatConverter::convert() */
+        int convert();
+
+        /** @copydoc FormatConverter::getSamplesConverted() */
+        uint64_t getSamplesConverted() const;
+
+        /** @copydoc FormatConverter::getBytesConverted() */
+        uint64_t getBytesConverted() const;
+
+        /** @copydoc FormatConverter::getElapsedSeconds() */
+        double getElapsedSeconds() const;
+
+        /** @copydoc FormatConverter::getMegabytesPerSecond() */
+        double getMegabytesPerSecond() const;
+
+        /** @brief A chunk of I/Q data of all channels, passed from stage to stage. */
+        template<typename T>
+        struct Chunk
+        {
+          /** @brief Values of each channel, interleaved for complex and polar data. */
+          std::vector<std::vector<T>> values;
+
+          /** @brief Number of valid values of each channel. */
+          std::vector<size_t> sizes;
+        };
+
+        /** @brief Input and output file of one conversion with the settings derived from the input file. */
+        struct Conversion
+        {
+          /** @brief The input file. */
+          std::unique_ptr<IDataImportExport> reader;
+
+          /** @brief The output file. */
+          std::unique_ptr<IDataImportExport> writer;
+
+          /** @brief Channels of the input file. */
+          std::vector<ChannelInfo> channelInfos;
+
+          /** @brief Meta data copied to the output file, without the mandatory keys. */
+          std::map<std::string, std::string> metadata;
+
+          /** @brief Application name of the output file. */
+          std::string applicationName;
+
+          /** @brief Comment of the output file. */
+          std::string comment;
+
+          /** @brief Data format of the input file. */
+          IqDataFormat inputFormat;
+
+          /** @brief Data format of the output file. */
+          IqDataFormat outputFormat;
+
+          /** @brief Precision of the values passed from the input to the output file. */
+          IqDataType dataType;
+        };
+
+        /**
+          @brief Creates and opens a reader of the input file. A conversion may use several readers, e.g. to read in parallel.
+          @param [out]  reader The opened reader.
+          @param [out]  arrayNames The arrays of the input file.
+          @returns Returns ErrorCodes::Success (=0) or the error code of the failed operation.
+        */int openReader(std::unique_ptr<IDataImportExport>& reader, std::vector<std::string>& arrayNames) const;
+
+        /**
+          @brief Opens the input file and derives data format, precision and meta data of the output file.
+          @param [out]  conversion The conversion, the output file is not yet created.
+          @returns Returns ErrorCodes::Success (=0) or the error code of the failed operation.
+        */int openInput(Conversion& conversion) const;
+
+        /**
+          @brief Creates and opens the output file of a conversion prepared by openInput().
+          @param [in,out]  conversion The conversion.
+          @returns Returns ErrorCodes::Success (=0) or the error code of the failed operation.
+        */int openOutput(Conversion& conversion) const;
+
+        /**
+          @brief Converts the values of one channel from the input to the output data format in place.
+          Real data is converted to complex data with Q = 0, polar data is converted to complex data.
+          @param [in,out]  values The values, must be able to hold twice the number of values if real data is converted.
+          @param [in]  nofValues Number of values in the input data format.
+          @param [in]  inputFormat Data format of the values.
+          @param [in]  outputFormat Data format to convert to.
+          @returns Returns the number of values in the output data format.
+        */template<typename T>
+        static size_t convertFormat(T* values, size_t nofValues, IqDataFormat inputFormat, IqDataFormat outputFormat)
+        {
+          if (inputFormat == outputFormat)
+          {
+            return nofValues;
+          }
+
+          if (inputFormat == IqDataFormat::Real)
+          {
+            // expand from the back to keep the conversion in place
+            for (size_t i = nofValues; i-- > 0;)
+            {
+              values[2 * i] = values[i];
+              values[2 * i + 1] = 0;
+            }
+            return 2 * nofValues;
+          }
+
+          // polar data contains pairs of magnitude and phase (rad)
+          for (size_t i = 0; i < nofValues; i += 2)
+          {
+            const T magnitude = values[i];
+            const T phase = values[i + 1];
+            values[i] = magnitude * std::cos(phase);
+            values[i + 1] = magnitude * std::sin(phase);
+          }
+          return nofValues;
+        }
+
+        /**
+          @param [in]  fileType A file type.
+          @param [in]  format A data format.
+          @returns Returns TRUE if files of the specified type can store data of the specified format.
+        */static bool supportsFormat(FileType fileType, IqDataFormat format);
+
+        /**
+          @param [in]  fileType A file type.
+          @returns Returns TRUE if readChannel() of files of the specified type counts I/Q pairs instead of values.
+          These files store complex data only and return one array per channel.
+        */static bool readsIqPairs(FileType fileType);
+
+        /**
+          @brief Returns the number to pass as nofValues to readChannel() of the input file to read the specified
+          number of samples.
+          @param [in]  inputFormat Data format of the input file.
+          @param [in]  nofSamples Number of samples to read.
+          @returns Returns the number of pairs or values to read.
+        */size_t getReadChannelCount(IqDataFormat inputFormat, size_t nofSamples) const;
+
+      private:
+        /**
+        * @brief Queue connecting two pipeline stages. The queue is bounded by the number of chunks in the pool.
+        */template<typename T>
+        class ChunkQueue
+        {
+        public:
+          ChunkQueue() : closed_(false) {}
+
+          /** @brief Appends a chunk. Chunks pushed to a closed queue are dropped. */
+          void push(std::unique_ptr<T> chunk)
+          {
+            {
+              std::lock_guard<std::mutex> lock(this->mutex_);
+              if (this->closed_)
+              {
+                return;
+              }
+              this->chunks_.push_back(std::move(chunk));
+            }
+            this->condition_.notify_one();
+          }
+
+          /** @brief Waits for a chunk. Returns nullptr if the queue has been closed and all chunks have been taken. */
+          std::unique_ptr<T> pop()
+          {
+            std::unique_lock<std::mutex> lock(this->mutex_);
+            this->condition_.wait(lock, [this] { return this->closed_ || false == this->chunks_.empty(); });
+            if (this->chunks_.empty())
+            {
+              return nullptr;
+            }
+
+            std::unique_ptr<T> chunk = std::move(this->chunks_.front());
+            this->chunks_.pop_front();
+            return chunk;
+          }
+
+          /** @brief Signals that no more chunks will be pushed. Remaining chunks can still be taken. */
+          void close()
+          {
+            {
+              std::lock_guard<std::mutex> lock(this->mutex_);
+              this->closed_ = true;
+            }
+            this->condition_.notify_all();
+          }
+
+          /** @brief Closes the queue and drops all chunks, e.g. if a stage failed. */
+          void abort()
+          {
+            {
+              std::lock_guard<std::mutex> lock(this->mutex_);
+              this->closed_ = true;
+              this->chunks_.clear();
+            }
+            this->condition_.notify_all();
+          }
+
+        private:
+          std::mutex mutex_;
+          std::condition_variable condition_;
+          std::deque<std::unique_ptr<T>> chunks_;
+          bool closed_;
+        };
+
+        /** @brief The queues of one conversion. */
+        template<typename T>
+        struct Pipeline
+        {
+          /** @brief Unused chunks. */
+          ChunkQueue<Chunk<T>> pool;
+
+          /** @brief Chunks read, waiting for conversion. */
+          ChunkQueue<Chunk<T>> read;
+
+          /** @brief Chunks converted, waiting to be written. */
+          ChunkQueue<Chunk<T>> converted;
+
+          /** @brief Aborts all stages. */
+          void abort()
+          {
+            this->pool.abort();
+            this->read.abort();
+            this->converted.abort();
+          }
+        };
+
+        /**
+          @brief Runs the pipeline with the specified precision.
+          @tparam T Precision of the values - float or double.
+          @param [in]  reader The opened input file.
+          @param [in]  writer The opened output file.
+          @param [in]  channelInfos Channels of the input file.
+          @param [in]  inputFormat Data format of the input file.
+          @param [in]  outputFormat Data format of the output file.
+          @returns Returns ErrorCodes::Success (=0) or the error code of the first failed stage.
+        */template<typename T>
+        int run(IDataImportExport& reader, IDataImportExport& writer, const std::vector<ChannelInfo>& channelInfos, IqDataFormat inputFormat, IqDataFormat outputFormat)
+        {
+          Pipeline<T> pipeline;
+          std::atomic<int> error(ErrorCodes::Success);
+          const size_t valuesPerSample = (inputFormat == IqDataFormat::Real) ? 1 : 2;
+
+          for (size_t i = 0; i < this->queueSize_; ++i)
+          {
+            std::unique_ptr<Chunk<T>> chunk(new Chunk<T>());
+            chunk->values.resize(channelInfos.size());
+            chunk->sizes.resize(channelInfos.size());
+            pipeline.pool.push(std::move(chunk));
+          }
+
+          // reader stage
+          std::thread readThread([&]()
+          {
+            try
+            {
+              std::vector<uint64_t> offsets(channelInfos.size(), 0);
+              for (;;)
+              {
+                bool done = true;
+                for (size_t ch = 0; ch < channelInfos.size(); ++ch)
+                {
+                  done = done && offsets[ch] >= static_cast<uint64_t>(channelInfos[ch].getSamples());
+                }
+                if (done)
+                {
+                  break;
+                }
+
+                std::unique_ptr<Chunk<T>> chunk = pipeline.pool.pop();
+                if (chunk == nullptr)
+                {
+                  break;
+                }
+
+                for (size_t ch = 0; ch < channelInfos.size(); ++ch)
+                {
+                  const uint64_t left = static_cast<uint64_t>(channelInfos[ch].getSamples()) - offsets[ch];
+                  const size_t nofSamples = static_cast<size_t>(std::min<uint64_t>(left, this->chunkSize_));
+
+                  // real data may be expanded to complex data by the conversion stage
+                  chunk->values[ch].resize(2 * this->chunkSize_);
+                  chunk->sizes[ch] = valuesPerSample * nofSamples;
+                  if (nofSamples > 0)
+                  {
+                    int ret = reader.readChannel(channelInfos[ch].getChannelName(), chunk->values[ch].data(), this->getReadChannelCount(inputFormat, nofSamples), static_cast<size_t>(offsets[ch]));
+                    if (ret != ErrorCodes::Success)
+                    {
+                      throw DaiException(ret);
+                    }
+                  }
+                  offsets[ch] += nofSamples;
+                }
+
+                pipeline.read.push(std::move(chunk));
+              }
+            }
+            catch (const DaiException& e)
+            {
+              error = e.code();
+              pipeline.abort();
+            }
+            catch (...)
+            {
+              error = ErrorCodes::InternalError;
+              pipeline.abort();
+            }
+            pipeline.read.close();
+          });
+
+          // conversion stage
+          std::thread convertThread([&]()
+          {
+            std::unique_ptr<Chunk<T>> chunk;
+            while ((chunk = pipeline.read.pop()) != nullptr)
+            {
+              for (size_t ch = 0; ch < chunk->values.size(); ++ch)
+              {
+                chunk->sizes[ch] = Impl::convertFormat(chunk->values[ch].data(), chunk->sizes[ch], inputFormat, outputFormat);
+              }
+              pipeline.converted.push(std::move(chunk));
+            }
+            pipeline.converted.close();
+          });
+
+          // writer stage
+          std::vector<T*> values(channelInfos.size());
+          std::unique_ptr<Chunk<T>> chunk;
+          while ((chunk = pipeline.converted.pop()) != nullptr)
+          {
+            for (size_t ch = 0; ch < values.size(); ++ch)
+            {
+              values[ch] = chunk->values[ch].data();
+            }
+
+            int ret = writer.appendChannels(values, chunk->sizes);
+            if (ret != ErrorCodes::Success)
+            {
+              error = ret;
+              pipeline.abort();
+              break;
+            }
+
+            for (size_t ch = 0; ch < values.size(); ++ch)
+            {
+              const size_t nofSamples = chunk->sizes[ch] / ((outputFormat == IqDataFormat::Real) ? 1 : 2);
+              this->samplesConverted_ += nofSamples;
+              this->bytesConverted_ += valuesPerSample * nofSamples * sizeof(T);
+            }
+            pipeline.pool.push(std::move(chunk));
+          }
+
+          readThread.join();
+          convertThread.join();
+          return error;
+        }
+
+        /** @brief Name of the file to be read. */
+        const std::string inputFilename_;
+
+        /** @brief File type of the file to be read. */
+        const FileType inputType_;
+
+        /** @brief Name of the file to be written. */
+        const std::string outputFilename_;
+
+        /** @brief File type of the file to be written. */
+        const FileType outputType_;
+
+        /** @brief Number of samples per channel and chunk. */
+        size_t chunkSize_;
+
+        /** @brief Number of chunks shared by the pipeline stages. */
+        size_t queueSize_;
+
+        /** @brief Precision of the values passed through the pipeline. */
+        IqDataType dataType_;
+
+        /** @brief TRUE if the precision has been set by setDataType(), otherwise it is taken from the input file. */
+        bool dataTypeSet_;
+
+        /** @brief Number of samples converted, summed over all channels. */
+        uint64_t samplesConverted_;
+
+        /** @brief Number of bytes passed through the pipeline. */
+        uint64_t bytesConverted_;
+
+        /** @brief Duration of the last conversion in seconds. */
+        double elapsedSeconds_;
+      };
+    }
+  }
+}
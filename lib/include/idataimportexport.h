@@ -36,6 +36,7 @@
 #include "exportdecl.h"
 #include "enums.h"
 #include "channelinfo.h"
+#include "iostatistics.h"
 
 namespace rohdeschwarz
 {
@@ -307,6 +308,18 @@ namespace rohdeschwarz
           @param [in] sizes Vector containing the length of each I/Q data-array.
           @returns If data was successfully added, ErrorCodes.Success (=0) is returned. For further error codes, see \ref ErrorCodes.
         */virtual int appendChannels(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes) = 0;
+
+        /**
+          @brief Enables or disables the collection of I/O statistics, see \ref getStatistics(). The collection is disabled by default
+          and costs a branch per counter if disabled. Enabling or disabling resets all counters.
+          @param [in]  enabled TRUE to collect statistics.
+        */virtual void setStatisticsEnabled(bool enabled) = 0;
+
+        /**
+          @brief Returns the I/O statistics collected since the collection has been enabled by \ref setStatisticsEnabled(), i.e. the bytes
+          read and written, the number of maps, unmaps and file calls, the wall time per phase and the peak size of temporary files.
+          @returns Returns the statistics. If the collection is disabled, all counters are 0.
+        */virtual IoStatistics getStatistics() const = 0;
       };
     }
   }
@@ -0,0 +1,137 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      iostatistics.h
+*
+* @brief     This is the header file of class IoStatistics.
+*
+* @details   I/O and compute statistics of a file format object.
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "exportdecl.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+      * @brief Defines the phases the wall time of a file format object is split into, see IoStatistics::getSeconds().
+      */
+      enum class IoPhase
+      {
+        /** @brief Parsing of headers and meta data, e.g. the XML file of an iq.tar or the header of a WV file. */
+        Parsing = 0,
+
+        /** @brief Mapping, reading, writing and flushing of file content. */
+        Io = 1,
+
+        /** @brief Conversion of the I/Q values between the file and the user precision and layout. */
+        Conversion = 2,
+
+        /** @brief Calculation of the preview of iq.tar files. */
+        Preview = 3,
+
+        /** @brief Finalization of the file on close(), e.g. merging temporary files. */
+        Finalize = 4
+      };
+
+      /**
+      * @brief I/O and compute statistics collected by a file format object, see IDataImportExport::getStatistics().
+      *
+      * Times are exclusive: if a phase is entered while another phase is measured, e.g. I/O during finalization,
+      * the time is only counted for the inner phase. Page faults of memory mapped files are counted for the phase
+      * that touches the data first, which is the conversion for most formats.
+      */
+      class IoStatistics
+      {
+      public:
+        /** @brief Number of phases, see IoPhase. */
+        static const int NofPhases = 5;
+
+        /**
+          @brief Constructor. Initializes all counters with 0.
+        */MOSAIK_MODULE IoStatistics();
+
+        /**
+          @returns Returns the number of bytes read from files, including meta data.
+        */MOSAIK_MODULE uint64_t getBytesRead() const;
+
+        /**
+          @returns Returns the number of bytes written to files, including meta data and temporary files.
+        */MOSAIK_MODULE uint64_t getBytesWritten() const;
+
+        /**
+          @returns Returns the number of file regions mapped to memory.
+        */MOSAIK_MODULE uint64_t getNofMaps() const;
+
+        /**
+          @returns Returns the number of file regions unmapped from memory.
+        */MOSAIK_MODULE uint64_t getNofUnmaps() const;
+
+        /**
+          @returns Returns the number of calls to read, write, seek and flush file content, as issued by the library.
+          Buffered calls, e.g. by libarchive or C streams, are counted once per call and may cause fewer system calls.
+        */MOSAIK_MODULE uint64_t getNofSyscalls() const;
+
+        /**
+          @param [in]  phase The phase.
+          @returns Returns the wall time spent in the specified phase in seconds.
+        */MOSAIK_MODULE double getSeconds(IoPhase phase) const;
+
+        /**
+          @returns Returns the maximum number of bytes stored in temporary files at once.
+        */MOSAIK_MODULE uint64_t getPeakTempFileBytes() const;
+
+      private:
+        friend class StatisticsCollector;
+
+        /** @brief Number of bytes read. */
+        uint64_t bytesRead_;
+
+        /** @brief Number of bytes written. */
+        uint64_t bytesWritten_;
+
+        /** @brief Number of regions mapped. */
+        uint64_t nofMaps_;
+
+        /** @brief Number of regions unmapped. */
+        uint64_t nofUnmaps_;
+
+        /** @brief Number of read, write, seek and flush calls. */
+        uint64_t nofSyscalls_;
+
+        /** @brief Wall time per phase in seconds. */
+        double seconds_[NofPhases];
+
+        /** @brief Number of bytes currently stored in temporary files. */
+        uint64_t tempFileBytes_;
+
+        /** @brief Maximum of tempFileBytes_. */
+        uint64_t peakTempFileBytes_;
+      };
+    }
+  }
+}
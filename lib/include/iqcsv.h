@@ -207,6 +207,9 @@ namespace rohdeschwarz
         int appendChannels(const std::vector<std::vector<double>>& iqdata);
         int appendChannels(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes);
 
+        void setStatisticsEnabled(bool enabled);
+        IoStatistics getStatistics() const;
+
         int64_t getNofRows(size_t column);
         int64_t getNofCols();
         int readRawArray(size_t column, size_t nofValues, std::vector<float>& values, size_t offset = 0);
@@ -283,6 +283,7 @@ namespace rohdeschwarz
           size_t arrayCount = sizes.size();
           size_t columnCount = std::max(static_cast<size_t>(2), arrayCount);
 
+          StatisticsCollector::Timer timer(this->statistics_, IoPhase::Conversion);
           std::string firstVal = IqCsv::Impl::getFormattedValue(iqdata[0][0], this->formatSpecifier_, this->numberDecimalSeparator_);
           auto rowSize = arrayCount * (firstVal.size() + 1);
           std::string rowString;
@@ -325,6 +326,7 @@ namespace rohdeschwarz
             }
 
             this->writer_->writeLine(rowString);
+            this->statistics_.addWrite(rowString.size() + 2);
           }
 
           // count number of samples written
@@ -344,7 +346,9 @@ namespace rohdeschwarz
           }
 
           // write to file
+          StatisticsCollector::Timer ioTimer(this->statistics_, IoPhase::Io);
           this->writer_->flush();
+          this->statistics_.addSyscalls();
         }
 
         /**
@@ -388,6 +392,7 @@ namespace rohdeschwarz
           size_t rowCount = *std::max_element(sizes.begin(), sizes.end()) / 2;
           size_t arrayCount = sizes.size();
 
+          StatisticsCollector::Timer timer(this->statistics_, IoPhase::Conversion);
           std::string firstVal = IqCsv::Impl::getFormattedValue(iqdata[0][0], this->formatSpecifier_, this->numberDecimalSeparator_);
           auto rowSize = arrayCount * (firstVal.size() + 1);
           std::string rowString;
@@ -418,6 +423,7 @@ namespace rohdeschwarz
             }
 
             this->writer_->writeLine(rowString);
+            this->statistics_.addWrite(rowString.size() + 2);
           }
 
           // count number of samples written
@@ -433,7 +439,9 @@ namespace rohdeschwarz
             }
           }
 
+          StatisticsCollector::Timer ioTimer(this->statistics_, IoPhase::Io);
           this->writer_->flush();
+          this->statistics_.addSyscalls();
         }
 
         /** @brief CSV reader instance. */
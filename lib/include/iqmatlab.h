@@ -102,6 +102,27 @@ namespace rohdeschwarz
           @returns Returns the matlab file version that is used to write a file.
         */MatlabVersion getMatlabVersion() const;
 
+        /**
+          @brief Sets the deflate level used to compress the I/Q data variables of matlab v7.3 files.
+          Data variables are written in chunks, which are compressed in parallel by worker threads.
+          Matlab v4 files cannot be compressed, the setting is ignored for them. Defaults to 0.
+          @param [in]  level Deflate level 1 (fastest) to 9 (smallest), 0 to disable compression.
+          @returns Returns ErrorCodes::InvalidDataFormat if level is not within [0, 9] or
+          ErrorCodes::WriterAlreadyInitialized if the matlab writer has already been initialized.
+          Otherwise ErrorCodes::Success is returned.
+        */int setCompressionLevel(int level);
+
+        /**
+          @brief Sets the precision used to store I/Q data in the matlab file. IqDataType::Float32 writes
+          the data arrays as single (MAT_C_SINGLE), which halves temporary disk space and file size.
+          IqDataType::Float64 writes double arrays (MAT_C_DOUBLE). Appended data is converted if its precision
+          differs. Defaults to IqDataType::Float64.
+          @param [in]  dataType The storage precision.
+          @returns Returns ErrorCodes::InvalidDataFormat if dataType is unknown or
+          ErrorCodes::WriterAlreadyInitialized if the matlab writer has already been initialized.
+          Otherwise ErrorCodes::Success is returned.
+        */int setStorageType(IqDataType dataType);
+
         time_t getTimestamp() const;
         void setTimestamp(const time_t timestamp);
 
@@ -116,9 +137,9 @@ namespace rohdeschwarz
 
          /**
           @brief Closes a file that has previously been opened. The method is also called by the destructor.
-          @remarks This is be a long-running operation, since temporary files need to be merged to the final .mat file. 
-          be aware that all i/q data written is loaded to RAM before written to the matlab file, since it is currently not
-          possible to append data to a matlab variable.
+          @remarks For matlab v4 files this is a long-running operation, since temporary files need to be merged to the
+          final .mat file. Matlab v7.3 data has already been appended to the file, only the last chunks and the meta data
+          are written on close.
           @returns If the final I/Q file has successfully been written, ErrorCodes.Success (=0) is returned. For further error codes, see \ref ErrorCodes.
         */int close();
 
@@ -145,6 +166,9 @@ namespace rohdeschwarz
         int appendChannels(const std::vector<std::vector<double>>& iqdata);
         int appendChannels(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes);
 
+        void setStatisticsEnabled(bool enabled);
+        IoStatistics getStatistics() const;
+
         int matchArrayDimensions(size_t minCols, size_t minRows, bool exactColMatch, std::vector<std::string>& arrayNames);
         int64_t getNofRows(const std::string& arrayName);
         int64_t getNofCols(const std::string& arrayName);
@@ -0,0 +1,244 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      iqmatlab_h5writer.h
+*
+* @brief     This is the header file of class IqMatlabH5Writer.
+*
+* @details   This class streams the I/Q data variables of matlab v7.3 files.
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hdf5.h"
+
+#include "enums.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+      * @brief This class streams the I/Q data variables of a matlab v7.3 file, which is a HDF5 file
+      * with a 512 byte user block. Each variable is created as extendible, chunked HDF5 dataset of type single
+      * or double and grows chunk by chunk while data is appended. If a compression level is set, full chunks are
+      * deflate compressed by worker threads and written in order by the appending thread.
+      */
+      class IqMatlabH5Writer
+      {
+      public:
+        /** @brief Number of rows of a variable stored in one HDF5 chunk. */
+        static const size_t ChunkRows;
+
+        /**
+          @brief Constructor. Initializes a new instance with the specified parameters.
+          @param [in]  filename Name of an existing matlab v7.3 file, e.g. created by matio.
+          @param [in]  arrayNames Names of the matlab variables to be created.
+          @param [in]  nofColumns Number of columns of each variable.
+          @param [in]  dataType Precision of the variables.
+          @param [in]  compressionLevel Deflate level 1 (fastest) to 9 (smallest) of the chunks, 0 to write uncompressed chunks.
+        */IqMatlabH5Writer(const std::string& filename, const std::vector<std::string>& arrayNames, size_t nofColumns, IqDataType dataType, int compressionLevel);
+
+        /** @brief Destructor. Releases all handles and stops the worker threads without writing buffered data.
+        */~IqMatlabH5Writer();
+
+        /**
+          @brief Opens the file and creates the empty variables.
+          @throws DaiException(FileOpenError) Thrown if the file could not be opened.
+          @throws DaiException(InternalError) Thrown if the variables could not be created.
+        */void open();
+
+        /**
+          @brief Writes the buffered rows of all variables, removes variables that do not contain any data
+          and closes the file.
+          @throws DaiException(InternalError) Thrown if data could not be written.
+        */void close();
+
+        /**
+          @brief Appends rows to a variable. The values of each column are converted to the precision of the variable.
+          @tparam Precision of the value arrays - single or double.
+          @param [in]  array Index of the variable.
+          @param [in]  columns One value array per column of the variable.
+          @param [in]  stride Distance between two rows within the value arrays, e.g. 2 for interleaved I/Q data.
+          @param [in]  rows Number of rows to append.
+          @throws DaiException(InternalError) Thrown if data could not be written.
+        */template<typename T>
+        void append(size_t array, const std::vector<const T*>& columns, size_t stride, size_t rows)
+        {
+          Variable& var = this->variables_[array];
+          size_t done = 0;
+          while (done < rows)
+          {
+            if (var.chunk == nullptr)
+            {
+              var.chunk = this->takeChunk(array);
+            }
+
+            const size_t n = std::min(rows - done, ChunkRows - var.fill);
+            for (size_t col = 0; col < columns.size(); ++col)
+            {
+              const T* src = columns[col] + done * stride;
+              if (this->dataType_ == IqDataType::Float32)
+              {
+                this->copyRows(reinterpret_cast<float*>(var.chunk->data.data()) + col * ChunkRows + var.fill, src, stride, n);
+              }
+              else
+              {
+                this->copyRows(reinterpret_cast<double*>(var.chunk->data.data()) + col * ChunkRows + var.fill, src, stride, n);
+              }
+            }
+
+            var.fill += n;
+            done += n;
+            if (var.fill == ChunkRows)
+            {
+              this->submit(array);
+            }
+          }
+        }
+
+        /**
+          @param [in]  array Index of the variable.
+          @returns Returns the number of rows appended to the variable.
+        */uint64_t getRows(size_t array) const;
+
+      private:
+        /** @brief Private copy constructor. */
+        IqMatlabH5Writer(const IqMatlabH5Writer&);
+
+        /** @brief Private assignment operator.*/
+        IqMatlabH5Writer& operator=(const IqMatlabH5Writer&);
+
+        /** @brief Copies rows of a column with stride to a chunk, converting the values to the precision of the chunk. */
+        template<typename S, typename T>
+        static void copyRows(S* dst, const T* src, size_t stride, size_t rows)
+        {
+          for (size_t row = 0; row < rows; ++row)
+          {
+            dst[row] = static_cast<S>(src[row * stride]);
+          }
+        }
+
+        /** @brief One chunk of a variable, column-major as stored by matlab. */
+        struct Chunk
+        {
+          size_t array;
+          uint64_t firstRow;
+          size_t rows;
+          std::vector<char> data;
+          std::vector<unsigned char> compressed;
+          bool done;
+          bool failed;
+        };
+
+        /** @brief A variable being written. */
+        struct Variable
+        {
+          hid_t dataset;
+          uint64_t rows;
+          std::shared_ptr<Chunk> chunk;
+          size_t fill;
+        };
+
+        /** @brief Returns an unused chunk buffer for the specified variable. */
+        std::shared_ptr<Chunk> takeChunk(size_t array);
+
+        /** @brief Hands the current chunk of the specified variable over for compression and writing. */
+        void submit(size_t array);
+
+        /** @brief Waits for the compression of the oldest pending chunk and writes it. */
+        void writeFront();
+
+        /** @brief Extends the variable of the specified chunk and writes the chunk. */
+        void writeChunk(const std::shared_ptr<Chunk>& chunk);
+
+        /** @brief Compresses chunks until stopped. */
+        void workerLoop();
+
+        /** @brief Stops the worker threads and closes all HDF5 handles.
+        @returns Returns FALSE if a handle could not be closed. */
+        bool release();
+
+        /** @brief Name of the matlab file. */
+        const std::string filename_;
+
+        /** @brief Names of the matlab variables. */
+        const std::vector<std::string> arrayNames_;
+
+        /** @brief Number of columns of each variable. */
+        const size_t nofColumns_;
+
+        /** @brief Precision of the variables. */
+        const IqDataType dataType_;
+
+        /** @brief Size of a value in bytes. */
+        const size_t wordWidth_;
+
+        /** @brief Deflate level of the chunks, 0 if uncompressed. */
+        const int compressionLevel_;
+
+        /** @brief HDF5 file handle. */
+        hid_t file_;
+
+        /** @brief Variables being written. */
+        std::vector<Variable> variables_;
+
+        /** @brief Chunk buffers that can be reused. */
+        std::vector<std::shared_ptr<Chunk>> spareChunks_;
+
+        /** @brief Chunks submitted for writing, in order of submission. */
+        std::deque<std::shared_ptr<Chunk>> pending_;
+
+        /** @brief Chunks waiting to be compressed by a worker. */
+        std::deque<std::shared_ptr<Chunk>> jobs_;
+
+        /** @brief Maximum number of pending chunks before the appending thread waits for the oldest one. */
+        size_t maxPending_;
+
+        /** @brief Compression worker threads. */
+        std::vector<std::thread> workers_;
+
+        /** @brief Guards jobs_, the done and failed flags of the chunks and stop_. */
+        std::mutex mutex_;
+
+        /** @brief Signals new jobs to the workers. */
+        std::condition_variable jobCondition_;
+
+        /** @brief Signals compressed chunks to the appending thread. */
+        std::condition_variable doneCondition_;
+
+        /** @brief If set TRUE, the workers terminate. */
+        bool stop_;
+      };
+    }
+  }
+}
@@ -27,11 +27,16 @@
 
 #pragma once
 
+#include <cstring>
+
 #include "common.h"
 
 #include "matio.h"
+#include "hdf5.h"
 
+#include "platform.h"
 #include "ianalyzecontent.h"
+#include "tracescope.h"
 #include "daiexception.h"
 #include "errorcodes.h"
 #include "enums.h"
@@ -138,6 +143,7 @@ namespace rohdeschwarz
         */template<typename T>
         void readArray(const std::string& arrayName, T* values, size_t nofValues, size_t offset)
         {
+          DAIEX_TRACE_SCOPE("IqMatlabReader::readArray");
           // check if file contains array name
           if (false == this->containsArray(arrayName))
           {
@@ -181,6 +187,7 @@ namespace rohdeschwarz
         */template<typename T>
         void readChannel(const std::string& channelName, T* values, size_t nofValues, size_t offset)
         {
+          DAIEX_TRACE_SCOPE("IqMatlabReader::readChannel");
           // get actual array name
           std::string arrayName;
           if (this->dataFormat_ == IqDataFormat::Real)
@@ -230,78 +237,21 @@ namespace rohdeschwarz
             this->open();
           }
 
-          // get matlab variable
-          matvar_t* matvar = Mat_VarReadInfo(this->matfp_, arrayName.c_str());
-          if (matvar == nullptr)
-          {
-            throw DaiException(ErrorCodes::InvalidMatlabArrayName);
-          }
-
-          // check variable type to match either double or float
-          if (matvar->class_type != MAT_C_DOUBLE && matvar->class_type != MAT_C_SINGLE)
-          {
-            Mat_VarFree(matvar);
-            throw DaiException(ErrorCodes::InvalidMatlabArrayType);
-          }
-
-          // get dimensions of matlab variable 
-          auto rows = matvar->dims[0];
-          auto cols = matvar->dims[1];
+          const MatlabArray& array = this->getArray(arrayName);
 
           // does matlab variable dimension match expected size?
-          if (column > cols)
+          if (column >= array.cols)
           {
-            Mat_VarFree(matvar);
             throw DaiException(ErrorCodes::InvalidColumnIndex);
           }
 
           // check read interval to be within matlab variable boundaries
-          if (offset + nofValues > rows)
+          if (offset + nofValues > array.rows)
           {
-            Mat_VarFree(matvar);
             throw DaiException(ErrorCodes::InvalidDataInterval);
           }
 
-          // matlab data is read linearly -> adapt offset
-          offset += column * rows;
-
-          int ret = 0;
-          if (std::is_same<T, double>::value) // desired output precision of data is double
-          {
-            // matlab variable contains single precision data
-            if (matvar->class_type == MAT_C_SINGLE) 
-            {
-              // read data and cast type to desired output type
-              std::vector<float> tmp(nofValues);
-              ret = Mat_VarReadDataLinear(this->matfp_, matvar, tmp.data(), static_cast<int>(offset), 1, nofValues);
-              std::copy(tmp.begin(), tmp.end(), values);
-            }
-            else // otherwise output type does already match matlab type
-            {
-              ret = Mat_VarReadDataLinear(this->matfp_, matvar, values, static_cast<int>(offset), 1, nofValues);
-            }
-          }
-          else // T == single output precision
-          {
-            // matlab data contains double precision data
-            if (matvar->class_type == MAT_C_DOUBLE)
-            {
-              // read data and cast type to desired output type
-              std::vector<double> tmp(nofValues);
-              ret = Mat_VarReadDataLinear(this->matfp_, matvar, tmp.data(), static_cast<int>(offset), 1, nofValues);
-              std::copy(tmp.begin(), tmp.end(), values);
-            }
-            else // otherwise output type does already match matlab type
-            {
-              ret = Mat_VarReadDataLinear(this->matfp_, matvar, values, static_cast<int>(offset), 1, nofValues);
-            }
-          }
-
-          Mat_VarFree(matvar);
-          if (ret != 0)
-          {
-            throw DaiException(ErrorCodes::InternalError);
-          }
+          this->readRows(array, column, 1, offset, nofValues, values);
         }
 
       private:
@@ -314,6 +264,41 @@ namespace rohdeschwarz
         /** @brief Private assignment operator.*/
         IqMatlabReader& operator=(const IqMatlabReader&);
 
+        /**
+          @brief Reads values linearly from a matlab array of type single or double. matio returns
+          the values with the precision of the matlab array, they are only converted if the requested
+          precision differs.
+          @tparam Precision of the target array - single or double.
+          @param [in]  matvar The matlab array to read from.
+          @param [in]  offset Linear index of the first value to read.
+          @param [in]  nofValues The number of values to read.
+          @param [out]  values The values read.
+          @returns Returns the result of Mat_VarReadDataLinear(), 0 on success.
+        */template<typename T>
+        int readLinear(matvar_t* matvar, size_t offset, size_t nofValues, T* values)
+        {
+          if ((matvar->class_type == MAT_C_SINGLE) == std::is_same<T, float>::value)
+          {
+            return Mat_VarReadDataLinear(this->matfp_, matvar, values, static_cast<int>(offset), 1, static_cast<int>(nofValues));
+          }
+
+          int ret = 0;
+          if (matvar->class_type == MAT_C_SINGLE)
+          {
+            std::vector<float> tmp(nofValues);
+            ret = Mat_VarReadDataLinear(this->matfp_, matvar, tmp.data(), static_cast<int>(offset), 1, static_cast<int>(nofValues));
+            std::copy(tmp.begin(), tmp.end(), values);
+          }
+          else
+          {
+            std::vector<double> tmp(nofValues);
+            ret = Mat_VarReadDataLinear(this->matfp_, matvar, tmp.data(), static_cast<int>(offset), 1, static_cast<int>(nofValues));
+            std::copy(tmp.begin(), tmp.end(), values);
+          }
+
+          return ret;
+        }
+
         /**
           @brief Reads I/Q data from the specified matlab array.
           @tparam Precision of the target array - single or double.
@@ -324,7 +309,7 @@ namespace rohdeschwarz
           column is read.
           @param [in]  values The values read.
           @throws DaiException(InvalidMatlabArrayName) If matlab array name was not found.
-          @throws DaiException(InvalidMatlabArrayType) If the found matlab array is not of type double.
+          @throws DaiException(InvalidMatlabArrayType) If the found matlab array is neither of type single nor double.
           @throws DaiException(InvalidMatlabArraySize) If the found matlab array is ill-sized.
           @throws DaiException(InvalidDataInterval) If combination of offset and number of values to read exceeds the 
           matlab array size.
@@ -332,60 +317,22 @@ namespace rohdeschwarz
         */template<typename T>
         void readData(const std::string& arrayName, size_t nofValues, size_t offset, bool readIValues, T* values)
         {
-          // get matlab variable
-          matvar_t* matvar = Mat_VarReadInfo(this->matfp_, arrayName.c_str());
-          if (matvar == nullptr)
-          {
-            throw DaiException(ErrorCodes::InvalidMatlabArrayName);
-          }
-
-          // we expect the matlab variable to contain double data
-          if (matvar->class_type != MAT_C_DOUBLE)
-          {
-            Mat_VarFree(matvar);
-            throw DaiException(ErrorCodes::InvalidMatlabArrayType);
-          }
+          const MatlabArray& array = this->getArray(arrayName);
 
           // check if I/Q data format matches matlab variable dimensions
-          if ((this->dataFormat_ == IqDataFormat::Real && matvar->dims[1] != 1) || (this->dataFormat_ != IqDataFormat::Real && matvar->dims[1] != 2))
+          if ((this->dataFormat_ == IqDataFormat::Real && array.cols != 1) || (this->dataFormat_ != IqDataFormat::Real && array.cols != 2))
           {
             throw DaiException(ErrorCodes::InvalidMatlabArraySize);
           }
 
-          // adapt indices for linear matlab read operation if Q-values are going to be read
-          size_t maxVal = matvar->dims[0];
-          if (false == readIValues)
-          {
-            offset += matvar->dims[0];
-            maxVal += matvar->dims[0];
-          }
-
           // check boundaries
-          if (offset + nofValues > maxVal)
+          if (offset + nofValues > array.rows)
           {
-            Mat_VarFree(matvar);
             throw DaiException(ErrorCodes::InvalidDataInterval);
           }
 
-          // conversion needed in case of float array
-          int ret = 0;
-          if (std::is_same<T, float>::value)
-          {
-            // copy double data and cast tmp array if single-precision output is desired
-            std::vector<double> tmp(nofValues);
-            ret = Mat_VarReadDataLinear(this->matfp_, matvar, tmp.data(), static_cast<int>(offset), 1, nofValues);
-            std::copy(tmp.begin(), tmp.end(), values);
-          }
-          else
-          {
-            ret = Mat_VarReadDataLinear(this->matfp_, matvar, values, static_cast<int>(offset), 1, nofValues);
-          }
-
-          Mat_VarFree(matvar);
-          if (ret != 0)
-          {
-            throw DaiException(ErrorCodes::InternalError);
-          }
+          // I values are stored in the first column, Q values in the second column
+          this->readRows(array, readIValues ? 0 : 1, 1, offset, nofValues, values);
         }
 
         /**
@@ -396,92 +343,214 @@ namespace rohdeschwarz
           @param [in]  offset Number of pairs to skip.
           @param [in]  values The values read.
           @throws DaiException(InvalidMatlabArrayName) If matlab array name was not found.
-          @throws DaiException(InvalidMatlabArrayType) If the found matlab array is not of type double.
+          @throws DaiException(InvalidMatlabArrayType) If the found matlab array is neither of type single nor double.
           @throws DaiException(InvalidMatlabArraySize) If the found matlab array is ill-sized.
           @throws DaiException(InvalidDataInterval) If combination of offset and number of values to read exceeds the 
           matlab array size.
         */template<typename T>
         void readChannel(const std::string& arrayName, size_t nofValues, size_t offset, T* values)
         {
-          // get matlab variable
-          matvar_t* matvar = Mat_VarReadInfo(this->matfp_, arrayName.c_str());
-          if (matvar == nullptr)
+          const MatlabArray& array = this->getArray(arrayName);
+
+          // check if I/Q data format matches matlab variable dimensions
+          if ((this->dataFormat_ == IqDataFormat::Real && array.cols != 1) || (this->dataFormat_ != IqDataFormat::Real && array.cols != 2))
           {
-            throw DaiException(ErrorCodes::InvalidMatlabArrayName);
+            throw DaiException(ErrorCodes::InvalidMatlabArraySize);
           }
 
-          // we expect the matlab variable to contain double data
-          if (matvar->class_type != MAT_C_DOUBLE)
+          // complex data is returned as I/Q pairs, i.e. both columns interleaved
+          const size_t nofRows = nofValues / array.cols;
+          if (offset + nofRows > array.rows)
           {
-            Mat_VarFree(matvar);
-            throw DaiException(ErrorCodes::InvalidMatlabArrayType);
+            throw DaiException(ErrorCodes::InvalidDataInterval);
           }
 
-          // check if I/Q data format matches matlab variable dimensions
-          if ((this->dataFormat_ == IqDataFormat::Real && matvar->dims[1] != 1) || (this->dataFormat_ != IqDataFormat::Real && matvar->dims[1] != 2))
+          this->readRows(array, 0, array.cols, offset, nofRows, values);
+        }
+
+        /** @brief Location and size of a matlab array of type single or double, found when the file is opened. */
+        struct MatlabArray
+        {
+          /** @brief Number of rows of the array. */
+          size_t rows;
+
+          /** @brief Number of columns of the array. */
+          size_t cols;
+
+          /** @brief TRUE if the values are stored with single precision, FALSE if stored with double precision. */
+          bool single;
+
+          /** @brief File position of the first value if the values are stored contiguously (column-major) with
+          * native byte order, otherwise -1. */
+          int64_t offset;
+
+          /** @brief HDF5 dataset of a v7.3 array that cannot be read from file directly, otherwise -1. */
+          hid_t dataset;
+
+          /** @brief Number of rows of a HDF5 chunk of the dataset. */
+          size_t chunkRows;
+
+          /** @brief Variable information returned by matio, used to read all other arrays. */
+          matvar_t* matvar;
+        };
+
+        /**
+          @brief Returns the array of the specified name from the array directory.
+          @param [in]  arrayName Name of the matlab array.
+          @throws DaiException(InvalidMatlabArrayName) If matlab array name was not found.
+          @throws DaiException(InvalidMatlabArrayType) If the found matlab array is neither of type single nor double.
+        */const MatlabArray& getArray(const std::string& arrayName);
+
+        /**
+          @brief Reads consecutive rows of one or two columns of a matlab array. The values are stored row by row,
+          i.e. the values of two columns are returned interleaved.
+          @tparam Precision of the target array - single or double.
+          @param [in]  array The matlab array to read from.
+          @param [in]  firstColumn Index of the first column to read.
+          @param [in]  nofColumns Number of columns to read, 1 or 2.
+          @param [in]  offset Index of the first row to read.
+          @param [in]  nofRows Number of rows to read.
+          @param [out]  values The values read, nofColumns * nofRows values.
+          @throws DaiException(InternalError) If an error during the actual read operation occurred.
+        */template<typename T>
+        void readRows(const MatlabArray& array, size_t firstColumn, size_t nofColumns, size_t offset, size_t nofRows, T* values)
+        {
+          if (nofRows == 0)
           {
-            throw DaiException(ErrorCodes::InvalidMatlabArraySize);
+            return;
           }
 
-          if (this->dataFormat_ == IqDataFormat::Real)
+          if (array.offset >= 0)
           {
-            if (offset + nofValues > matvar->dims[0])
+            if (array.single)
             {
-              Mat_VarFree(matvar);
-              throw DaiException(ErrorCodes::InvalidDataInterval);
+              this->readMappedRows<float>(array, firstColumn, nofColumns, offset, nofRows, values);
             }
+            else
+            {
+              this->readMappedRows<double>(array, firstColumn, nofColumns, offset, nofRows, values);
+            }
+          }
+          else if (array.dataset >= 0)
+          {
+            this->readH5Rows(array, firstColumn, nofColumns, offset, nofRows, values);
+          }
+          else
+          {
+            int ret = 0;
+            if (nofColumns == 1)
+            {
+              ret = this->readLinear(array.matvar, firstColumn * array.rows + offset, nofRows, values);
+            }
+            else
+            {
+              std::vector<T> tempI(nofRows);
+              std::vector<T> tempQ(nofRows);
+              ret = this->readLinear(array.matvar, firstColumn * array.rows + offset, nofRows, tempI.data());
+              ret |= this->readLinear(array.matvar, (firstColumn + 1) * array.rows + offset, nofRows, tempQ.data());
+              Common::mergeInterleaved(tempI.begin(), tempI.end(), tempQ.begin(), values);
+            }
+
+            if (ret != 0)
+            {
+              throw DaiException(ErrorCodes::InternalError);
+            }
+          }
+        }
 
-            if (std::is_same<T, float>::value)
+        /**
+          @brief Reads rows of an array from the mapped file, see readRows(). The values are converted and
+          interleaved in a single pass into the target array.
+          @tparam S Precision of the array in file.
+          @tparam T Precision of the target array.
+        */template<typename S, typename T>
+        void readMappedRows(const MatlabArray& array, size_t firstColumn, size_t nofColumns, size_t offset, size_t nofRows, T* values)
+        {
+          const size_t size = nofRows * sizeof(S);
+          const char* columns[2] = { nullptr, nullptr };
+          for (size_t col = 0; col < nofColumns; ++col)
+          {
+            memory_mapped_file::read_only_mmf& mmf = this->mmf_[col];
+            mmf.map(static_cast<size_t>(array.offset) + ((firstColumn + col) * array.rows + offset) * sizeof(S), size);
+            Common::mmfDataAssert(mmf);
+            if (mmf.mapped_size() < size)
             {
-              // conversion needed in case of float array
-              std::vector<double> tmp(nofValues);
-              
-              int ret = Mat_VarReadDataLinear(this->matfp_, matvar, tmp.data(), static_cast<int>(offset), 1, nofValues);
-              Mat_VarFree(matvar);
-              if (ret != 0)
-              {
-                throw DaiException(ErrorCodes::InternalError);
-              }
-
-              // copy values from tmp to dest array
-              std::copy(tmp.begin(), tmp.end(), values);
+              throw DaiException(ErrorCodes::InternalError);
             }
-            else // read to double array
+
+            columns[col] = mmf.data();
+          }
+
+          // values are loaded with memcpy, as arrays of a v4 file are not aligned
+          S value[2];
+          if (nofColumns == 1 && std::is_same<S, T>::value)
+          {
+            std::memcpy(values, columns[0], size);
+          }
+          else if (nofColumns == 1)
+          {
+            for (size_t row = 0; row < nofRows; ++row)
             {
-              int ret = Mat_VarReadDataLinear(this->matfp_, matvar, values, static_cast<int>(offset), 1, nofValues);
-              Mat_VarFree(matvar);
-              if (ret != 0)
-              {
-                throw DaiException(ErrorCodes::InternalError);
-              }
+              std::memcpy(&value[0], columns[0] + row * sizeof(S), sizeof(S));
+              values[row] = static_cast<T>(value[0]);
             }
           }
-          else // complex data
+          else
           {
-            if (offset + nofValues / 2 > matvar->dims[0])
+            for (size_t row = 0; row < nofRows; ++row)
             {
-              Mat_VarFree(matvar);
-              throw DaiException(ErrorCodes::InvalidDataInterval);
+              std::memcpy(&value[0], columns[0] + row * sizeof(S), sizeof(S));
+              std::memcpy(&value[1], columns[1] + row * sizeof(S), sizeof(S));
+              values[2 * row] = static_cast<T>(value[0]);
+              values[2 * row + 1] = static_cast<T>(value[1]);
             }
+          }
 
-            int ret = 0;
-            std::vector<double> tempI(nofValues / 2);
-            std::vector<double> tempQ(nofValues / 2);
-            
-            // read I
-            ret = Mat_VarReadDataLinear(this->matfp_, matvar, tempI.data(), static_cast<int>(offset), 1, nofValues / 2);
-            
-            // read Q
-            offset = matvar->dims[0] + offset;
-            ret = Mat_VarReadDataLinear(this->matfp_, matvar, tempQ.data(), static_cast<int>(offset), 1, nofValues / 2);					
-            Mat_VarFree(matvar);
-            if (ret != 0)
+          for (size_t col = 0; col < nofColumns; ++col)
+          {
+            this->mmf_[col].unmap();
+          }
+        }
+
+        /**
+          @brief Reads rows of a v7.3 array with HDF5, see readRows(). HDF5 converts the values and stores them
+          directly at their interleaved position in the target array.
+          @tparam T Precision of the target array.
+        */template<typename T>
+        void readH5Rows(const MatlabArray& array, size_t firstColumn, size_t nofColumns, size_t offset, size_t nofRows, T* values)
+        {
+          const hid_t memType = std::is_same<T, float>::value ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE;
+          hsize_t memDims[1] = { nofColumns * nofRows };
+          hid_t fileSpace = H5Dget_space(array.dataset);
+          hid_t memSpace = H5Screate_simple(1, memDims, nullptr);
+          bool success = fileSpace >= 0 && memSpace >= 0;
+
+          // rows are read chunk by chunk, so the chunk decoded for the first column is still cached when reading the second one
+          for (size_t done = 0; success && done < nofRows;)
+          {
+            const size_t n = std::min(nofRows - done, array.chunkRows - (offset + done) % array.chunkRows);
+            for (size_t col = 0; success && col < nofColumns; ++col)
             {
-              throw DaiException(ErrorCodes::InternalError);
+              // matlab arrays are stored column-major, i.e. HDF5 dimensions are (columns x rows)
+              hsize_t fileStart[2] = { firstColumn + col, offset + done };
+              hsize_t fileCount[2] = { 1, n };
+              hsize_t memStart[1] = { done * nofColumns + col };
+              hsize_t memStride[1] = { nofColumns };
+              hsize_t memCount[1] = { n };
+              success = H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, fileStart, nullptr, fileCount, nullptr) >= 0
+                && H5Sselect_hyperslab(memSpace, H5S_SELECT_SET, memStart, memStride, memCount, nullptr) >= 0
+                && H5Dread(array.dataset, memType, memSpace, fileSpace, H5P_DEFAULT, values) >= 0;
             }
 
-            // merge to output vector: data from I and Q vector will be merged to IQIQIQ in values-vector.
-            Common::mergeInterleaved(tempI.begin(), tempI.end(), tempQ.begin(), values);
+            done += n;
+          }
+
+          if (memSpace >= 0) H5Sclose(memSpace);
+          if (fileSpace >= 0) H5Sclose(fileSpace);
+
+          if (false == success)
+          {
+            throw DaiException(ErrorCodes::InternalError);
           }
         }
 
@@ -496,6 +565,18 @@ namespace rohdeschwarz
         /** @brief Creates channel information for each channel found in meta data.
         */void createChannelInformation();
 
+        /**
+          @brief Creates the directory of all arrays of type single or double contained by the file. The file
+          positions of the arrays are determined for matlab v4 files with native byte order and for v7.3 files.
+        */void readDirectory();
+
+        /** @brief Determines the file position of the arrays of a matlab v4 file by parsing the headers of all variables. */
+        void readMat4Offsets();
+
+        /** @brief Opens the HDF5 datasets of the arrays of a matlab v7.3 file and determines the file position of
+        * contiguous arrays. */
+        void readMat73Offsets();
+
         /**
           @brief Reads data from a matlab character array of dimension [1 x n].
           @param [in]  matfp The matlab file to read from.
@@ -552,6 +633,15 @@ namespace rohdeschwarz
 
         /** @brief Mapping between an array name and the corresponding channel. */
         std::map<std::string, size_t> arrayNameToChannelNo_;
+
+        /** @brief Directory of all matlab arrays of type single or double, by matlab array name. */
+        std::map<std::string, MatlabArray> arrays_;
+
+        /** @brief HDF5 handle to a matlab v7.3 file, -1 otherwise. */
+        hid_t h5file_;
+
+        /** @brief Memory mapped file, one per column read at once. */
+        memory_mapped_file::read_only_mmf mmf_[2];
       };
     }
   }
@@ -27,12 +27,16 @@
 
 #pragma once
 
+#include <memory>
+#include <ostream>
+
 #include "itempdir.h"
 
 #include "common.h"
 
 #include "matio.h"
 #include "memory_mapped_file.hpp"
+#include "iqmatlab_h5writer.h"
 
 #include "dataimportexportbase.h"
 #include "channelinfo.h"
@@ -81,6 +85,19 @@ namespace rohdeschwarz
         /** @brief Destructor. Calls close()
         */~IqMatlabWriter();
 
+        /**
+          @brief Sets the deflate level used to compress the I/Q data variables of matlab v7.3 files.
+          Has no effect on matlab v4 files. Must be called before open().
+          @param [in]  level Deflate level 1 (fastest) to 9 (smallest), 0 to disable compression.
+        */void setCompressionLevel(int level);
+
+        /**
+          @brief Sets the precision used to store I/Q data in temporary files and matlab arrays, i.e.
+          IqDataType::Float32 writes arrays of type MAT_C_SINGLE and IqDataType::Float64 arrays of type
+          MAT_C_DOUBLE. Appended data is converted if necessary. Must be called before open().
+          @param [in]  dataType Storage precision, defaults to IqDataType::Float64.
+        */void setStorageType(IqDataType dataType);
+
         /**
           @brief Opens the file for writing and verifies that the names of the specified channels
           are unique.
@@ -92,12 +109,13 @@ namespace rohdeschwarz
         */void close();
 
         /**
-          @brief Adds the specified I/Q data to the existing data record. Data is first written to 
-          temporary files and added to the actual .mat file when close() is called. 
+          @brief Adds the specified I/Q data to the existing data record. Matlab v7.3 data is appended to the
+          .mat file directly, matlab v4 data is first written to temporary files and added to the actual .mat
+          file when close() is called.
           The number of the I/Q data arrays passed to this method as well as the lengths of the arrays
           are validated w.r.t the specified channel information. In case of a mismatch between the channel
-          information and passed data, an exception is thrown. Iq-data will always be written to 
-          matlab arrays of type MAT_C_DOUBLE.
+          information and passed data, an exception is thrown. Iq-data is written to matlab arrays
+          of type MAT_C_DOUBLE or MAT_C_SINGLE, see setStorageType().
           @tparam Precision of the value array - single or double.
           @param [in]  iqdata Vector containing I/Q data arrays.
           @param [in]  sizes The length of the specified data arrays.
@@ -122,39 +140,37 @@ namespace rohdeschwarz
             throw DaiException(ErrorCodes::InconsistentInputData);
           }
 
-          try
+          // matlab v7.3: I and Q arrays of a channel are the columns of its data variable
+          if (this->h5Writer_ != nullptr)
           {
-            for (size_t i = 0; i < iqdata.size(); i++)
+            const size_t nofColumns = (this->dataFormat_ == IqDataFormat::Real) ? 1 : 2;
+            for (size_t ch = 0; ch < this->channelInfos_.size(); ++ch)
             {
-              // we always write MAT_T_DOUBLE, so already cast when writing to tmp file.
-              size_t writeSize = sizes[i] * sizeof(double);
-              size_t writeOffset = this->mmfWriters_[i].file_size();
-
-              // get memory to write data to
-              this->mmfWriters_[i].map(writeOffset, writeSize);
-              Common::mmfDataAssert(this->mmfWriters_[i]);
-
-              // copy data to memory mapped file with double-precision
-              std::copy(iqdata[i], iqdata[i] + sizes[i], reinterpret_cast<double*>(this->mmfWriters_[i].data()));
-
-              // unmap mmf
-              this->mmfWriters_[i].flush();
-              this->mmfWriters_[i].unmap();
+              std::vector<const T*> columns(iqdata.begin() + nofColumns * ch, iqdata.begin() + nofColumns * (ch + 1));
+              this->h5Writer_->append(ch, columns, 1, sizes[nofColumns * ch]);
             }
+            return;
           }
-          catch (const std::exception &e)
+
+          // temp files are written with the storage precision
+          if (this->storageType_ == IqDataType::Float32)
           {
-            throw DaiException(ErrorCodes::InternalError, e.what());
+            this->writeTempArrays<float>(iqdata, sizes);
+          }
+          else
+          {
+            this->writeTempArrays<double>(iqdata, sizes);
           }
         }
 
         /**
-          @brief Add the specified I/Q channel to the existing data record. Data is first written to 
-          temporary files and added to the actual .mat file when close() is called. 
+          @brief Add the specified I/Q channel to the existing data record. Matlab v7.3 data is appended to the
+          .mat file directly, matlab v4 data is first written to temporary files and added to the actual .mat
+          file when close() is called.
           The number of the I/Q data arrays passed to this method as well as the lengths of the arrays
           are validated w.r.t the specified channel information. In case of a mismatch between the channel
-          information and passed data, an exception is thrown. Iq-data will always be written to 
-          matlab arrays of type MAT_C_DOUBLE.
+          information and passed data, an exception is thrown. Iq-data is written to matlab arrays
+          of type MAT_C_DOUBLE or MAT_C_SINGLE, see setStorageType().
           @tparam Precision of the value array - single or double.
           @param [in]  iqdata Vector containing I/Q data in interleaved format.
           @param [in]  sizes The length of the specified data arrays.
@@ -184,12 +200,89 @@ namespace rohdeschwarz
 
           DataImportExportBase::initializeDataType<T>(this->dataType_, this->lockDataType_);
 
+          if (this->h5Writer_ != nullptr)
+          {
+            for (size_t i = 0; i < iqdata.size(); i++)
+            {
+              std::vector<const T*> columns = { iqdata[i], iqdata[i] + 1 };
+              this->h5Writer_->append(i, columns, 2, sizes[i] / 2);
+            }
+            return;
+          }
+
+          if (this->storageType_ == IqDataType::Float32)
+          {
+            this->writeTempChannels<float>(iqdata, sizes);
+          }
+          else
+          {
+            this->writeTempChannels<double>(iqdata, sizes);
+          }
+        }
+
+      private:
+        /** @brief Private default constructor. */
+        IqMatlabWriter();
+
+        /** @brief Private copy constructor. */
+        IqMatlabWriter(const IqMatlabWriter&);
+
+        /** @brief Private assignment operator.*/
+        IqMatlabWriter& operator=(const IqMatlabWriter&);
+
+        /**
+          @brief Appends I/Q data arrays to the temporary files.
+          @tparam S Precision of the temporary files - single or double.
+          @tparam T Precision of the value arrays - single or double.
+          @param [in]  iqdata Vector containing I/Q data arrays.
+          @param [in]  sizes The length of the specified data arrays.
+          @throws DaiException(InternalError) Thrown if data could not be saved to file.
+        */template<typename S, typename T>
+        void writeTempArrays(const std::vector<T*>& iqdata, const std::vector<size_t>& sizes)
+        {
+          try
+          {
+            for (size_t i = 0; i < iqdata.size(); i++)
+            {
+              // already cast to the storage precision when writing to tmp file.
+              size_t writeSize = sizes[i] * sizeof(S);
+              size_t writeOffset = this->mmfWriters_[i].file_size();
+
+              // get memory to write data to
+              this->mmfWriters_[i].map(writeOffset, writeSize);
+              Common::mmfDataAssert(this->mmfWriters_[i]);
+
+              // copy data to memory mapped file with storage precision
+              std::copy(iqdata[i], iqdata[i] + sizes[i], reinterpret_cast<S*>(this->mmfWriters_[i].data()));
+
+              // unmap mmf
+              this->mmfWriters_[i].flush();
+              this->mmfWriters_[i].unmap();
+            }
+          }
+          catch (const std::exception &e)
+          {
+            throw DaiException(ErrorCodes::InternalError, e.what());
+          }
+        }
+
+        /**
+          @brief Appends interleaved I/Q channels to the temporary files, I and Q data of each channel
+          are written to separate files.
+          @tparam S Precision of the temporary files - single or double.
+          @tparam T Precision of the value arrays - single or double.
+          @param [in]  iqdata Vector containing I/Q data in interleaved format.
+          @param [in]  sizes The length of the specified data arrays.
+          @throws DaiException(InternalError) Thrown if data could not be saved to file.
+        */template<typename S, typename T>
+        void writeTempChannels(const std::vector<T*>& iqdata, const std::vector<size_t>& sizes)
+        {
           try
           {
             for (size_t i = 0; i < iqdata.size(); i++)
             {
-              // we always write MAT_T_DOUBLE, so already cast when writing to tmp file.
-              size_t writeSize = sizes[i] / 2 * sizeof(double);
+              // already cast to the storage precision when writing to tmp file.
+              size_t writeSize = sizes[i] / 2 * sizeof(S);
               size_t writeOffsetI = this->mmfWriters_[2*i].file_size();
               size_t writeOffsetQ = this->mmfWriters_[2*i + 1].file_size();
 
@@ -199,20 +292,20 @@ namespace rohdeschwarz
               Common::mmfDataAssert(this->mmfWriters_[2*i]);
               Common::mmfDataAssert(this->mmfWriters_[2*i + 1]);
 
-              // write I data with double-precision
+              // write I data with storage precision
               // stride iterator will return every second element from vector -> only I data
               std::copy(
                 stride_iterator<T*>(iqdata[i], 2),
                 stride_iterator<T*>(iqdata[i] + sizes[i], 2),
-                reinterpret_cast<double*>(this->mmfWriters_[2*i].data()));
+                reinterpret_cast<S*>(this->mmfWriters_[2*i].data()));
 
-              // write Q data with double-precision
+              // write Q data with storage precision
               // stride iterator will return every second element from vector -> only Q data
               std::copy(
                 stride_iterator<T*>(iqdata[i] + 1, 2),
                 stride_iterator<T*>(iqdata[i] + sizes[i] - 1, 2),
-                reinterpret_cast<double*>(this->mmfWriters_[2*i + 1].data()));
-              *(reinterpret_cast<double*>(this->mmfWriters_[2*i + 1].data()) + sizes[i] / 2 - 1) = *(iqdata[i] + sizes[i] - 1);
+                reinterpret_cast<S*>(this->mmfWriters_[2*i + 1].data()));
+              *(reinterpret_cast<S*>(this->mmfWriters_[2*i + 1].data()) + sizes[i] / 2 - 1) = *(iqdata[i] + sizes[i] - 1);
 
               this->mmfWriters_[2*i].flush();
               this->mmfWriters_[2*i + 1].flush();
@@ -226,16 +319,6 @@ namespace rohdeschwarz
           }
         }
 
-      private:
-        /** @brief Private default constructor. */
-        IqMatlabWriter();
-
-        /** @brief Private copy constructor. */
-        IqMatlabWriter(const IqMatlabWriter&);
-
-        /** @brief Private assignment operator.*/
-        IqMatlabWriter& operator=(const IqMatlabWriter&);
-
         /**
           @brief Writes a string to a matlab char array.
           @param [in]  mat The matlab file handle used to write the data.
@@ -267,21 +350,46 @@ namespace rohdeschwarz
           @param [in]  mat The matlab file handle used to write the data.
         */void writeMetadata(mat_t* const mat);
 
-        /** 
-          @brief Used to transfer I/Q data from temporary files to the
-          final .mat file when iq format type is IqDataFormat::Real.
-        */void writeRealData(mat_t* const mat);
+        /**
+          @brief Used to transfer I/Q data from temporary files to the final matlab v4 file, which
+          has been closed by matio before. Each data variable is appended as v4 matrix header
+          followed by its columns, copied chunk-wise from the temporary files.
+          @param [in]  filename Name of the matlab file to append to.
+        */void writeMat4Data(const std::string& filename);
 
         /**
-          @brief Used to transfer I/Q data from temporary files to the
-          final .mat file when iq format type is IqDataFormat::Complex.
-        */void writeData(mat_t* const mat);
+          @brief Writes the header of a numeric matlab v4 matrix.
+          @param [in]  out Stream to write to.
+          @param [in]  arrayName Name of the matlab array.
+          @param [in]  rows Number of rows.
+          @param [in]  cols Number of columns.
+          @param [in]  dataType Precision of the matrix elements.
+        */static void writeMat4Header(std::ostream& out, const std::string& arrayName, size_t rows, size_t cols, IqDataType dataType);
 
         /**
          @brief Closes the temporary file writers and transfers the written
-         I/Q data to the matlab file.
+         I/Q data to the matlab v4 file.
         */void finalizeTemporarySequence();
 
+        /**
+          @brief Creates an empty matlab file of the specified version. An existing file is replaced.
+          @param [in]  version Matlab file version.
+          @returns Returns the matio file handle.
+        */mat_t* createMatFile(mat_ft version) const;
+
+        /**
+          @brief Creates the matlab v7.3 file and its extendible data variables. I/Q data is
+          appended to the variables directly.
+        */void openMat73();
+
+        /**
+          @brief Writes the buffered I/Q data and the meta data to the matlab v7.3 file.
+        */void closeMat73();
+
+        /**
+          @brief Renames the file written on Windows to the actual filename.
+        */void renameMatFile() const;
+
         /**
           @brief Deletes the temporary files created by this class. 
           File handle must be released before calling this method. 
@@ -293,6 +401,16 @@ namespace rohdeschwarz
         /** @brief Filename of the matlab file */
         const std::string filename_;
 
+        /** @brief Name of the file actually written. Since matio does not support utf-16 encoding
+        * for windows, a temporary file is written there and renamed to \ref filename_ on close.
+        */std::string matFile_;
+
+        /** @brief Writer of the data variables of matlab v7.3 files. */
+        std::unique_ptr<IqMatlabH5Writer> h5Writer_;
+
+        /** @brief Deflate level of matlab v7.3 data variables, 0 if uncompressed. */
+        int compressionLevel_;
+
         /** @brief Vector containing the paths of all temporary files used.
         *	The number of temporary files depends on the I/Q data format as well as 
         *	the number of channels. For instance, complex data requires 2 temp files per
@@ -317,6 +435,9 @@ namespace rohdeschwarz
         /** @brief Precision used to write data to file. */
         IqDataType dataType_;
 
+        /** @brief Precision used to store I/Q data in temporary files and matlab arrays. */
+        IqDataType storageType_;
+
         /** @brief If set TRUE, \ref dataType_ cannot be changed. Value is set at first call
         * of \ref appendArray() or \ref appendChannel(). 
         */bool lockDataType_;
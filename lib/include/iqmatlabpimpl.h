@@ -71,6 +71,22 @@ namespace rohdeschwarz
           @returns Returns the matlab file version that is used to write a file.
         */MatlabVersion getMatlabVersion() const;
 
+        /**
+          @brief Sets the deflate level used to compress the I/Q data variables of matlab v7.3 files.
+          @param [in]  level Deflate level 1 (fastest) to 9 (smallest), 0 to disable compression.
+          @returns Returns ErrorCodes::InvalidDataFormat if level is not within [0, 9] or
+          ErrorCodes::WriterAlreadyInitialized if the matlab writer has already been initialized.
+          Otherwise ErrorCodes::Success is returned.
+        */int setCompressionLevel(int level);
+
+        /**
+          @brief Sets the precision used to store I/Q data in the matlab file.
+          @param [in]  dataType The storage precision.
+          @returns Returns ErrorCodes::InvalidDataFormat if dataType is unknown or
+          ErrorCodes::WriterAlreadyInitialized if the matlab writer has already been initialized.
+          Otherwise ErrorCodes::Success is returned.
+        */int setStorageType(IqDataType dataType);
+
         int readOpen(std::vector<std::string>& arrayNames);
         int writeOpen(
           IqDataFormat format,
@@ -139,6 +155,12 @@ namespace rohdeschwarz
 
         /** @brief Matlab version used to create .mat file. */
         MatlabVersion matVersion_;
+
+        /** @brief Deflate level of the data variables of matlab v7.3 files. */
+        int compressionLevel_;
+
+        /** @brief Precision used to store I/Q data. */
+        IqDataType storageType_;
       };
     }
   }
@@ -34,7 +34,10 @@
 #include "archive.h"
 #include "archive_entry.h"
 
+#include "asyncreadservice.h"
 #include "ianalyzecontentiqtar.h"
+#include "statisticscollector.h"
+#include "tracescope.h"
 #include "daiexception.h"
 #include "errorcodes.h"
 #include "enums.h"
@@ -54,12 +57,17 @@ namespace rohdeschwarz
       {
         /**
           @brief Constructor. 
-        */mmfReadMemoryData() : offset(0), copyBufSize(Settings::getBufferSize()){}
+        */mmfReadMemoryData() : offset(0), copyBufSize(Settings::getBufferSize()), statistics(nullptr){}
 
         /**
           @brief Closes the file handle.
         */void close()
         {
+          if (this->statistics != nullptr && this->mmf.data() != nullptr)
+          {
+            this->statistics->addUnmap();
+          }
+
           this->mmf.close();
           this->offset = 0;
         }
@@ -72,6 +80,9 @@ namespace rohdeschwarz
 
         /** @brief Number of bytes copied at once, when calling archiveReadCallback(). */
         size_t copyBufSize;
+
+        /** @brief I/O statistics updated when regions are mapped, nullptr if not collected. */
+        StatisticsCollector* statistics;
       };
 
       /**
@@ -86,7 +97,8 @@ namespace rohdeschwarz
           Be aware that the filename cannot be changed after construction.
           @param [in]  filename Name of the file to be read or to be written.
           @param [in]  updateContent Provides callback methods to process meta data found in file.
-        */IqTarReader(const std::string& filename, IAnalyzeContentIqTar& updateContent);
+          @param [in]  statistics I/O statistics updated by this reader.
+        */IqTarReader(const std::string& filename, IAnalyzeContentIqTar& updateContent, StatisticsCollector& statistics);
 
         /* @copydoc IqTar::~IqTar() */
         ~IqTarReader();
@@ -146,6 +158,7 @@ namespace rohdeschwarz
         */template<typename T>
         void readArray(const std::string& arrayName, T* values, size_t nofValues, size_t offset)
         {
+          DAIEX_TRACE_SCOPE("IqTarReader::readArray");
           size_t readOffset = 0;
           size_t ignoreNofChannelValues = 0;
           this->readPrepare(arrayName, nofValues, offset, readOffset, ignoreNofChannelValues);
@@ -182,6 +195,7 @@ namespace rohdeschwarz
         */template<typename T>
         void readChannel(const std::string& channelName, T* values, size_t nofValues, size_t offset)
         {
+          DAIEX_TRACE_SCOPE("IqTarReader::readChannel");
           // get array name
           std::string arrayName;
           if (this->dataFormat_ == IqDataFormat::Real)
@@ -247,6 +261,26 @@ namespace rohdeschwarz
           }
         }
 
+        /**
+          @brief Computes the values of the file read by readArray(), for an asynchronous read.
+          @param [in]  arrayName The name of the array to read.
+          @param [in]  nofValues Number of values to read.
+          @param [in]  offset Defines the start position in the I/Q data record at which the read operation is started.
+          @param [out]  type Binary type of the values in the file.
+          @param [out]  scale Scaling factor to apply, 1 if the file does not define one.
+          @param [out]  segments The values to read.
+        */void prepareArrayAsync(const std::string& arrayName, size_t nofValues, size_t offset, RawValueType& type, double& scale, std::vector<RawSegment>& segments);
+
+        /**
+          @brief Computes the values of the file read by readChannel(), for an asynchronous read.
+          @param [in]  channelName The name of the channel to read.
+          @param [in]  nofValues Number of values to read.
+          @param [in]  offset Defines the number of I/Q pairs to be skipped before the read operation is started.
+          @param [out]  type Binary type of the values in the file.
+          @param [out]  scale Scaling factor to apply, 1 if the file does not define one.
+          @param [out]  segments The values to read.
+        */void prepareChannelAsync(const std::string& channelName, size_t nofValues, size_t offset, RawValueType& type, double& scale, std::vector<RawSegment>& segments);
+
       private:
         /** @brief Private default constructor. */
         IqTarReader();
@@ -309,6 +343,7 @@ namespace rohdeschwarz
         */template<typename T, typename T2>
         void readData(size_t nofValues, size_t readOffset, size_t ignoreNofChannelValues, bool readIValues, T2* values)
         {
+          StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Conversion);
           try
           {
             memory_mapped_file::read_only_mmf mmf;
@@ -320,8 +355,7 @@ namespace rohdeschwarz
               size_t readSize = (nofValues + nofValues * ignoreNofChannelValues) * sizeof(T);
 
               // align memory
-              mmf.map(readOffset, readSize);
-              Common::mmfDataAssert(mmf);
+              this->mapRead(mmf, readOffset, readSize);
 
               // copy data from file to values vector: strideCopy copies one value and then skips 
               // n-values (ignoreNofChannelValues) before reading the next value again
@@ -333,8 +367,7 @@ namespace rohdeschwarz
               size_t readSize = (2 * nofValues + nofValues * ignoreNofChannelValues) * sizeof(T);
 
               // align memory
-              mmf.map(readOffset, readSize);
-              Common::mmfDataAssert(mmf);
+              this->mapRead(mmf, readOffset, readSize);
 
               // calculate the position of the requested value in the data stream
               // calculate the number of values to be skipped ahead of reading the desired value and
@@ -357,7 +390,7 @@ namespace rohdeschwarz
               Common::strideCopy(reinterpret_cast<const T*>(mmf.data()) + preSkip, values, nofValues, preSkip + postSkip);
             }
 
-            mmf.close();
+            this->closeRead(mmf);
 
             // apply scaling if required
             if (false == std::isnan(this->scalingFactor_))
@@ -388,6 +421,7 @@ namespace rohdeschwarz
         */template<typename T, typename T2>
         void readDataInterleaved(size_t samplesToRead, size_t readOffset, size_t ignoreNofChannelValues, T2* values)
         {
+          StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Conversion);
           try
           {
             // calculate number of bytes to read. Double number of values to read as samplesToRead is number of I/Q pairs
@@ -398,13 +432,12 @@ namespace rohdeschwarz
             Platform::mmfOpen(mmf, this->filename_, false);
 
             // align memory
-            mmf.map(readOffset, readSize);
-            Common::mmfDataAssert(mmf);
+            this->mapRead(mmf, readOffset, readSize);
 
             // copy 1 I/Q pair (2 values) and skip ignoreNofChannelValues values before reading the next pair
             Common::strideCopyIqPairs(reinterpret_cast<const T*>(mmf.data()), values, nofValues, ignoreNofChannelValues);
 
-            mmf.close();
+            this->closeRead(mmf);
 
             // apply scaling if required
             if (0 == std::isnan(this->scalingFactor_))
@@ -426,6 +459,19 @@ namespace rohdeschwarz
           @brief Opens the file for reading. If already opened, the file is closed and re-opened again.
         */void open();
 
+        /**
+          @brief Maps a region of the file and updates the I/O statistics.
+          @param [in]  mmf The memory mapped file.
+          @param [in]  offset Offset of the region in bytes.
+          @param [in]  size Size of the region in bytes.
+          @throws DaiException(InternalError) If the region could not be mapped.
+        */void mapRead(memory_mapped_file::read_only_mmf& mmf, size_t offset, size_t size);
+
+        /**
+          @brief Closes a file mapped by mapRead() and updates the I/O statistics.
+          @param [in]  mmf The memory mapped file.
+        */void closeRead(memory_mapped_file::read_only_mmf& mmf);
+
         /** 
           @returns Returns the number of values per samples, based on
           the data format, i.e. 1 for IqDataFormat::Real.
@@ -439,6 +485,13 @@ namespace rohdeschwarz
           prepare read
         */void readPrepare(const std::string& arrayName, size_t nofReadValues, size_t offset, size_t& readOffset, size_t& ignoreNofChannelValues);
 
+        /**
+          @brief Gets the binary type and the scaling factor of the values for an asynchronous read.
+          @param [out]  type Binary type of the values in the file.
+          @param [out]  scale Scaling factor to apply, 1 if the file does not define one.
+          @throws DaiException(WrongDataType) If the data type is not supported.
+        */void getAsyncValueType(RawValueType& type, double& scale) const;
+
         /**
           @brief Extracts the names of all tar elements found in this file.
           @param [out]  tarElementNames Vector containing all tar element names found.
@@ -491,6 +544,9 @@ namespace rohdeschwarz
           Called by analyzeContent(). 
         */IAnalyzeContentIqTar* updateContent_;
 
+        /** @brief I/O statistics updated by this reader. */
+        StatisticsCollector* statistics_;
+
         /** @brief Set true, if analyseContent() was called and the file was parsed successfully. */
         bool initialized_;
 
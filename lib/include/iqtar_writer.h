@@ -39,6 +39,7 @@
 
 #include "dataimportexportbase.h"
 #include "iqtar_preview.h"
+#include "tracescope.h"
 #include "channelinfo.h"
 #include "daiexception.h"
 #include "errorcodes.h"
@@ -72,6 +73,7 @@ namespace rohdeschwarz
           @param [in]  enablePreview If set TRUE, a preview of the I/Q data will be calculated and saved as meta data to the XML-file
           every time new data is added.
           @param [in]  tempPath Path used to write temporary files to.
+          @param [in]  statistics I/O statistics updated by this writer.
           @param [in]  metadata Additional non-standardized meta data as key - value pairs to be saved.
           @param [in]  deprecatedInfoXml Information that can be added to the XML file at hierarchy level 
           &lt;UserData&gt;&lt;RohdeSchwarz&gt;DEPRECATED_INFO_STRING, as required by FSW. Make sure to pass a valid XML string.
@@ -88,6 +90,7 @@ namespace rohdeschwarz
           const std::vector<ChannelInfo>& channelInfos,
           bool enablePreview,
           const std::string& tempPath,
+          StatisticsCollector& statistics,
           const std::map<std::string, std::string>* metadata = 0,
           const std::string* deprecatedInfoXml = 0,
           const uint64_t expectedNofIqBytes = 0);
@@ -128,6 +131,7 @@ namespace rohdeschwarz
         */template<typename T>
         void appendArray(const std::vector<T*>& iqdata, const std::vector<size_t>& sizes)
         {
+          DAIEX_TRACE_SCOPE("IqTarWriter::appendArray");
           if (false == this->initialized_)
           {
             throw DaiException(ErrorCodes::FileWriterUninitialized);
@@ -140,6 +144,8 @@ namespace rohdeschwarz
             throw DaiException(ErrorCodes::InconsistentInputData);
           }
 
+          StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Conversion);
+
           // write to tmp file
           if (this->expectedNofIqBytes_ == 0)
           {
@@ -169,6 +175,7 @@ namespace rohdeschwarz
           // add data to I/Q tar preview
           if (this->enablePreview_)
           {
+            StatisticsCollector::Timer previewTimer(*this->statistics_, IoPhase::Preview);
             this->tarPreview_.addArrayData(iqdata, sizes[0], this->dataFormat_);
           }
         }
@@ -189,6 +196,7 @@ namespace rohdeschwarz
         */template<typename T>
         void appendChannel(const std::vector<T*>& iqdata, const std::vector<size_t>& sizes)
         {
+          DAIEX_TRACE_SCOPE("IqTarWriter::appendChannel");
           // real data
           if (this->dataFormat_ == IqDataFormat::Real)
           {
@@ -209,6 +217,8 @@ namespace rohdeschwarz
             throw DaiException(ErrorCodes::InconsistentInputData);
           }
 
+          StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Conversion);
+
           // write to tmp file
           if (this->expectedNofIqBytes_ == 0)
           {
@@ -239,6 +249,7 @@ namespace rohdeschwarz
           // add data to I/Q tar preview
           if (this->enablePreview_)
           {
+            StatisticsCollector::Timer previewTimer(*this->statistics_, IoPhase::Preview);
             this->tarPreview_.addChannelData(iqdata, sizes[0], this->dataFormat_);
           }
         }
@@ -263,6 +274,14 @@ namespace rohdeschwarz
           @returns Returns a filename that can be used within the iq.tar file.
         */static std::string generateIqDataFilename(const std::string& tarFilename, int nofChannels, IqDataFormat dataFormat, IqDataType dataType, time_t timestamp);
 
+        /**
+          @brief Writes the tar header of an archive entry. The entry name is converted with a thread locale,
+          so several archives can be written in parallel.
+          @param [in]  a Tar archive the header is written to.
+          @param [in]  entry The archive entry.
+          @throws DaiException::InvalidTarArchive if the header cannot be written.
+        */static void writeEntryHeader(struct archive* a, struct archive_entry* entry);
+
         /**
           @brief Build the XML content of the iq-tar file that describes the content of the file.
           @param [in]  iqDataFilename Name of the actual I/Q data file used within the iq.tar. Use
@@ -287,7 +306,7 @@ namespace rohdeschwarz
           size_t writeOffset = this->mmfWriter_.file_size();
           size_t writeSize = usedChannels * nofValues * valuesPerSample * sizeof(T); // all channels have equal length in iq-tar
 
-          this->mmfWriter_.map(writeOffset, writeSize);
+          this->mapWrite(writeOffset, writeSize);
           Common::mmfDataAssert(this->mmfWriter_);
 
           if (this->dataFormat_ == IqDataFormat::Real) // write real samples
@@ -317,8 +336,7 @@ namespace rohdeschwarz
             }
           }
 
-          this->mmfWriter_.flush();
-          this->mmfWriter_.unmap();
+          this->flushWrite(writeSize);
         }
 
         /**
@@ -341,6 +359,8 @@ namespace rohdeschwarz
             throw DaiException(ErrorCodes::DataOverflow);
           }
 
+          StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Io);
+
           if (this->dataFormat_ == IqDataFormat::Real) // write real samples
           {
             for (size_t channelIdx = 0; channelIdx < usedChannels; ++channelIdx)
@@ -377,6 +397,7 @@ namespace rohdeschwarz
           }
 
           this->writtenIqBytes_ += writeSize;
+          this->statistics_->addWrite(writeSize, writeSize / sizeof(T));
         }
 
         /**
@@ -393,7 +414,7 @@ namespace rohdeschwarz
           size_t nofValues = sizes[0];
           size_t writeSize = nofChannels * nofValues * sizeof(T);
 
-          this->mmfWriter_.map(writeOffset, writeSize);
+          this->mapWrite(writeOffset, writeSize);
           Common::mmfDataAssert(this->mmfWriter_);
 
           auto writeBuf = reinterpret_cast<T*>(this->mmfWriter_.data());
@@ -407,8 +428,7 @@ namespace rohdeschwarz
             }
           }
 
-          this->mmfWriter_.flush();
-          this->mmfWriter_.unmap();
+          this->flushWrite(writeSize);
         }
 
          /**
@@ -430,6 +450,8 @@ namespace rohdeschwarz
             throw DaiException(ErrorCodes::DataOverflow);
           }
 
+          StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Io);
+
           this->mmfWriter_.map(this->mmfWriter_.file_size(), writeSize);
 
           long i = -1;
@@ -454,6 +476,7 @@ namespace rohdeschwarz
           }
 
           this->writtenIqBytes_ += writeSize;
+          this->statistics_->addWrite(writeSize, writeSize / sizeof(T));
         }
 
         /**
@@ -510,6 +533,17 @@ namespace rohdeschwarz
           buffer I/Q data. Should be called after finalizeTemporarySequence().
         */void deleteTempFiles();
 
+        /**
+          @brief Maps a region of the temporary file and updates the I/O statistics.
+          @param [in]  offset Offset of the region in bytes.
+          @param [in]  size Size of the region in bytes.
+        */void mapWrite(size_t offset, size_t size);
+
+        /**
+          @brief Flushes and unmaps the region mapped by mapWrite() and updates the I/O statistics.
+          @param [in]  size Size of the region in bytes.
+        */void flushWrite(size_t size);
+
         /** @brief TRUE if IqTarWriter was initialized successfully and is 
         ready to take I/Q data.*/
         bool initialized_;
@@ -527,6 +561,9 @@ namespace rohdeschwarz
         /** @brief Memory mapped file writer used to write I/Q data to tempFile_. */
         memory_mapped_file::writable_mmf mmfWriter_;
 
+        /** @brief I/O statistics updated by this writer. */
+        StatisticsCollector* statistics_;
+
         /** @brief Counts the number of samples written to file. */
         size_t nofSamplesWritten_;
 
@@ -114,6 +114,47 @@ namespace rohdeschwarz
         int readChannel(const std::string& channelName, std::vector<double>& values, size_t nofValues, size_t offset = 0);
         int readChannel(const std::string& channelName, double* values, size_t nofValues, size_t offset = 0);
 
+        /**
+          @brief Starts an asynchronous read of an array or a channel, see IqTar::readArrayAsync() and IqTar::readChannelAsync().
+          @tparam Template parameter of the destination I/Q data precision, i.e. float or double.
+          @param [in]  readChannel TRUE to read a channel, FALSE to read an array.
+          @param [in]  name Name of the array or channel.
+          @param [out]  values The values read.
+          @param [in]  nofValues Number of values to read.
+          @param [in]  offset Index of the first value or sample to read.
+          @param [in]  callback Called when the values have been read.
+          @returns Returns ErrorCodes::Success if the read has been started, otherwise an error code.
+        */template<typename T>
+        int readAsync(bool readChannel, const std::string& name, T* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+        {
+          DAIEX_TRACE_SCOPE("IqTar::readAsync");
+          if (this->reader_ == nullptr)
+          {
+            return ErrorCodes::OpenFileHasNotBeenCalled;
+          }
+
+          try
+          {
+            RawValueType type = RawValueType::Float32;
+            double scale = 1.0;
+            std::vector<RawSegment> segments;
+            if (readChannel)
+            {
+              this->reader_->prepareChannelAsync(name, nofValues, offset, type, scale, segments);
+            }
+            else
+            {
+              this->reader_->prepareArrayAsync(name, nofValues, offset, type, scale, segments);
+            }
+
+            return AsyncReadService::instance().read(this->asyncFile_, this->filename_, type, scale, segments, values, callback, &this->statistics_);
+          }
+          catch (DaiException &e)
+          {
+            return e.code();
+          }
+        }
+
         int appendArrays(const std::vector<std::vector<float>>& iqdata);
         int appendArrays(const std::vector<float*>& iqdata, const std::vector<size_t>& sizes);
         int appendArrays(const std::vector<std::vector<double>>& iqdata);
@@ -181,6 +222,9 @@ namespace rohdeschwarz
           @brief If set TRUE, the IqTarPreview will be calculated every time new I/Q data is added.
           Otherwise no preview will be available in the XML meta data file .
         */bool enablePreview_;
+
+        /** @brief File of the asynchronous reads, opened by the first read and released by close(). */
+        std::shared_ptr<AsyncFile> asyncFile_;
       };
     }
   }
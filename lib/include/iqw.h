@@ -27,6 +27,7 @@
 
 #pragma  once
 
+#include "asyncread.h"
 #include "idataimportexport.h"
 #include "itempdir.h"
 
@@ -108,6 +109,32 @@ namespace rohdeschwarz
         int readChannel(const std::string& channelName, std::vector<double>& values, size_t nofValues, size_t offset = 0);
         int readChannel(const std::string& channelName, double* values, size_t nofValues, size_t offset = 0);
 
+        /**
+          @brief Starts to read the I or Q values of an array, see readArray() and AsyncRead. Returns without
+          waiting for the data.
+          @param [in]  arrayName Name of the array.
+          @param [out]  values Preallocated buffer for nofValues values. Must not be accessed until the callback is called.
+          @param [in]  nofValues Number of values to read.
+          @param [in]  offset Index of the first value to read.
+          @param [in]  callback Called with ErrorCodes::Success or an error code when the values have been read.
+          @returns Returns ErrorCodes::Success if the read has been started, otherwise an error code as returned by
+          readArray() and the callback is not called.
+        */int readArrayAsync(const std::string& arrayName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+        int readArrayAsync(const std::string& arrayName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+
+        /**
+          @brief Starts to read the interleaved I/Q values of a channel, see readChannel() and AsyncRead. Returns
+          without waiting for the data.
+          @param [in]  channelName Name of the channel.
+          @param [out]  values Preallocated buffer for nofValues values. Must not be accessed until the callback is called.
+          @param [in]  nofValues Number of values to read, as in readChannel().
+          @param [in]  offset Index of the first I/Q pair to read.
+          @param [in]  callback Called with ErrorCodes::Success or an error code when the values have been read.
+          @returns Returns ErrorCodes::Success if the read has been started, otherwise an error code as returned by
+          readChannel() and the callback is not called.
+        */int readChannelAsync(const std::string& channelName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+        int readChannelAsync(const std::string& channelName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+
         int appendArrays(const std::vector<std::vector<float>>& iqdata);
         int appendArrays(const std::vector<float*>& iqdata, const std::vector<size_t>& sizes);
         int appendArrays(const std::vector<std::vector<double>>& iqdata);
@@ -118,6 +145,9 @@ namespace rohdeschwarz
         int appendChannels(const std::vector<std::vector<double>>& iqdata);
         int appendChannels(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes);
 
+        void setStatisticsEnabled(bool enabled);
+        IoStatistics getStatistics() const;
+
         int setTempDir(const std::string& path);
         std::string getTempDir() const;
 
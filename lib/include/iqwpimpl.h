@@ -34,12 +34,14 @@
 #include "memory_mapped_file.hpp"
 
 #include "iqw.h"
+#include "asyncreadservice.h"
 #include "dataimportexportbase.h"
 #include "enums.h"
 #include "errorcodes.h"
 #include "daiexception.h"
 #include "channelinfo.h"
 #include "stride_iterator.h"
+#include "tracescope.h"
 #include "platform.h"
 
 namespace rohdeschwarz
@@ -100,6 +102,12 @@ namespace rohdeschwarz
         int readChannel(const std::string& channelName, std::vector<double>& values, size_t nofValues, size_t offset = 0);
         int readChannel(const std::string& channelName, double* values, size_t nofValues, size_t offset = 0);
 
+        int readArrayAsync(const std::string& arrayName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+        int readArrayAsync(const std::string& arrayName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+
+        int readChannelAsync(const std::string& channelName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+        int readChannelAsync(const std::string& channelName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+
         int appendArrays(const std::vector<std::vector<float>>& iqdata);
         int appendArrays(const std::vector<float*>& iqdata, const std::vector<size_t>& sizes);
         int appendArrays(const std::vector<std::vector<double>>& iqdata);
@@ -156,6 +164,27 @@ namespace rohdeschwarz
         /** @brief Deletes temporary files created while writing IQW file with data order IIIQQQ. 
         */void deleteTempFiles();
 
+        /**
+          @brief Maps a region of a file for reading and updates the I/O statistics.
+          @param [in]  mmf The memory mapped file.
+          @param [in]  offset Offset of the region in bytes.
+          @param [in]  size Size of the region in bytes.
+          @throws DaiException(InternalError) If the region could not be mapped.
+        */void mapRead(memory_mapped_file::read_only_mmf& mmf, size_t offset, size_t size);
+
+        /**
+          @brief Maps a region of a file for writing and updates the I/O statistics.
+          @param [in]  mmf The memory mapped file.
+          @param [in]  offset Offset of the region in bytes.
+          @param [in]  size Size of the region in bytes.
+        */void mapWrite(memory_mapped_file::writable_mmf& mmf, size_t offset, size_t size);
+
+        /**
+          @brief Flushes and unmaps the region mapped by mapWrite() and updates the I/O statistics.
+          @param [in]  mmf The memory mapped file.
+          @param [in]  size Size of the region in bytes.
+        */void flushWrite(memory_mapped_file::writable_mmf& mmf, size_t size);
+
         /**
           @brief Reads I/Q data from the specified array name. This methods prepares the actual
           read operation by calculating the necessary parameters, followed by a call of readData().
@@ -175,6 +204,7 @@ namespace rohdeschwarz
         */template<typename T>
         void readArrayInternal(const std::string& arrayName, T* values, size_t nofValues, size_t offset)
         {
+          DAIEX_TRACE_SCOPE("Iqw::readArray");
           // is file ready to read?
           if (0 == this->getChannelInfos().size())
           {
@@ -199,6 +229,104 @@ namespace rohdeschwarz
           this->readData(nofValues, readOffsetI, readOffsetQ, readI, values);
         }
 
+        /**
+          @brief Starts to read I/Q data from the specified array, see readArrayInternal().
+          @tparam Template parameter of the destination I/Q data precision, i.e. float or double.
+          @param [in]  arrayName The name of the array to read.
+          @param [out]  values The values read.
+          @param [in]  nofValues Number of values to read. Make sure to provide sufficient memory to store the values.
+          @param [in]  offset Defines the start position in the I/Q data record at which the read operation is started.
+          @param [in]  callback Called when the values have been read.
+          @throws DaiException If the parameters are invalid, see readArrayInternal(), or FileOpenError.
+        */template<typename T>
+        void readArrayAsyncInternal(const std::string& arrayName, T* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+        {
+          DAIEX_TRACE_SCOPE("Iqw::readArrayAsync");
+          if (0 == this->getChannelInfos().size())
+          {
+            throw DaiException(ErrorCodes::OpenFileHasNotBeenCalled);
+          }
+
+          bool readI = true;
+          if (false == this->isArrayNameValid(arrayName, readI))
+          {
+            throw DaiException(ErrorCodes::InvalidArrayName);
+          }
+
+          size_t readOffsetI = 0;
+          size_t readOffsetQ = 0;
+          size_t pairs = 0;
+          size_t fileSize = Common::getFileSize(this->filename_);
+          this->getReadParameters(fileSize, false, offset, nofValues, pairs, readOffsetI, readOffsetQ);
+
+          // IQIQIQ reads every second value, IIIQQQ a contiguous range
+          const size_t srcStride = this->dataOrder_ == IqDataOrder::IQIQIQ ? 2 : 1;
+          std::vector<RawSegment> segments;
+          segments.push_back(RawSegment(readI ? readOffsetI : readOffsetQ, nofValues, 1, srcStride, 0, 1));
+          this->startAsyncRead(segments, values, callback);
+        }
+
+        /**
+          @brief Starts to read I/Q data from the specified channel, see readChannelInternal().
+          @tparam Template parameter of the destination I/Q data precision, i.e. float or double.
+          @param [in]  channelName The name of the channel to read.
+          @param [out]  values The values read, interleaved.
+          @param [in]  nofValues Number of values to read. Make sure to provide sufficient memory to store the values.
+          @param [in]  offset Defines the start position in the I/Q data record at which the read operation is started.
+          @param [in]  callback Called when the values have been read.
+          @throws DaiException If the parameters are invalid, see readChannelInternal(), or FileOpenError.
+        */template<typename T>
+        void readChannelAsyncInternal(const std::string& channelName, T* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+        {
+          DAIEX_TRACE_SCOPE("Iqw::readChannelAsync");
+          if (0 == this->getChannelInfos().size())
+          {
+            throw DaiException(ErrorCodes::OpenFileHasNotBeenCalled);
+          }
+
+          std::string fullChannelName = channelName + "_I";
+          if (0 != fullChannelName.compare(Iqw::Impl::DefaultArrayNameI_))
+          {
+            throw DaiException(ErrorCodes::InvalidArrayName);
+          }
+
+          size_t readOffsetI = 0;
+          size_t readOffsetQ = 0;
+          size_t pairs = 0;
+          size_t fileSize = Common::getFileSize(this->filename_);
+          this->getReadParameters(fileSize, true, offset, nofValues, pairs, readOffsetI, readOffsetQ);
+
+          std::vector<RawSegment> segments;
+          if (this->dataOrder_ == IqDataOrder::IQIQIQ)
+          {
+            segments.push_back(RawSegment(readOffsetI, nofValues, 1, 1, 0, 1));
+          }
+          else
+          {
+            // I and Q values are read from two ranges and interleaved in the destination
+            segments.push_back(RawSegment(readOffsetI, nofValues / 2, 1, 1, 0, 2));
+            segments.push_back(RawSegment(readOffsetQ, nofValues / 2, 1, 1, 1, 2));
+          }
+
+          this->startAsyncRead(segments, values, callback);
+        }
+
+        /**
+          @brief Submits an asynchronous read of float values to the AsyncReadService.
+          @param [in]  segments The values to read.
+          @param [out]  values The destination of the values.
+          @param [in]  callback Called when the values have been read.
+          @throws DaiException(FileOpenError) If the file cannot be opened.
+        */template<typename T>
+        void startAsyncRead(const std::vector<RawSegment>& segments, T* values, AsyncReadCallback callback)
+        {
+          const int res = AsyncReadService::instance().read(this->asyncFile_, this->filename_, RawValueType::Float32, 1.0, segments, values, callback, &this->statistics_);
+          if (res != ErrorCodes::Success)
+          {
+            throw DaiException(res);
+          }
+        }
+
         /**
           @brief Reads I/Q data from the specified channel. This methods prepares the actual 
           read operation by calculating the necessary parameters, followed by a call of readDataInterleaved().
@@ -218,6 +346,7 @@ namespace rohdeschwarz
         */template<typename T>
         void readChannelInternal(const std::string& channelName, T* values, size_t nofValues, size_t offset)
         {
+          DAIEX_TRACE_SCOPE("Iqw::readChannel");
           // is file ready to read?
           if (0 == this->getChannelInfos().size())
           {
@@ -255,6 +384,7 @@ namespace rohdeschwarz
         */template<typename T>
         void readData(size_t nofValues, size_t readOffset, size_t readOffsetQ, bool readIValues, T& values)
         {
+          StatisticsCollector::Timer timer(this->statistics_, IoPhase::Conversion);
           try
           {
             // open mmf
@@ -269,8 +399,7 @@ namespace rohdeschwarz
               size_t readSize = 2 * nofValues * sizeof(float);
 
               // align memory
-              mmf.map(setReadOffset, readSize);
-              Common::mmfDataAssert(mmf);
+              this->mapRead(mmf, setReadOffset, readSize);
 
               // stride iterator returns only every second value. Therewith we read either I or Q, dependent
               // on 'setReadOffset'
@@ -286,14 +415,14 @@ namespace rohdeschwarz
               size_t readSize = nofValues * sizeof(float);
 
               // align memory
-              mmf.map(setReadOffset, readSize);
-              Common::mmfDataAssert(mmf);
+              this->mapRead(mmf, setReadOffset, readSize);
 
               // copy values from file to values-vector
               std::copy(reinterpret_cast<const float*>(mmf.data()), reinterpret_cast<const float*>(mmf.data()) + nofValues, values);
             }
 
             mmf.close();
+            this->statistics_.addUnmap();
           }
           catch (const std::exception &e)
           {
@@ -312,6 +441,7 @@ namespace rohdeschwarz
         */template<typename T>
         void readDataInterleaved(size_t nofValues, size_t readOffset, size_t readOffsetQ, T* values)
         {
+          StatisticsCollector::Timer timer(this->statistics_, IoPhase::Conversion);
           try
           {
             // open mmf
@@ -325,8 +455,7 @@ namespace rohdeschwarz
               size_t readSize = nofValues * sizeof(float);
 
               // align memory
-              mmf.map(readOffset, readSize);
-              Common::mmfDataAssert(mmf);
+              this->mapRead(mmf, readOffset, readSize);
 
               // copy values from file to value-vector
               std::copy(reinterpret_cast<const float*>(mmf.data()), reinterpret_cast<const float*>(mmf.data()) + nofValues, values);
@@ -339,8 +468,7 @@ namespace rohdeschwarz
               size_t readSize = nofPairs * sizeof(float);
 
               // align memory to read I values
-              mmf.map(readOffset, readSize);
-              Common::mmfDataAssert(mmf);
+              this->mapRead(mmf, readOffset, readSize);
 
               // copy I values from file to values-vector
               auto cdata = reinterpret_cast<const float*>(mmf.data());
@@ -350,8 +478,8 @@ namespace rohdeschwarz
               }
 
               // align memory to read Q values
-              mmf.map(readOffsetQ, readSize);
-              Common::mmfDataAssert(mmf);
+              this->statistics_.addUnmap();
+              this->mapRead(mmf, readOffsetQ, readSize);
 
               // copy Q values from file to values-vector
               cdata = reinterpret_cast<const float*>(mmf.data());
@@ -362,6 +490,7 @@ namespace rohdeschwarz
             }
 
             mmf.close();
+            this->statistics_.addUnmap();
           }
           catch (const std::exception &e)
           {
@@ -420,20 +549,22 @@ namespace rohdeschwarz
             size_t writeOffsetQ = this->mmfWriterTwo_.file_size();
 
             // align memory for I and Q writer
-            this->mmfWriterOne_.map(writeOffsetI, writeSize);
+            this->mapWrite(this->mmfWriterOne_, writeOffsetI, writeSize);
             Common::mmfDataAssert(this->mmfWriterOne_);
-            this->mmfWriterTwo_.map(writeOffsetQ, writeSize);
+            this->mapWrite(this->mmfWriterTwo_, writeOffsetQ, writeSize);
             Common::mmfDataAssert(this->mmfWriterTwo_);
             
             // copy I and Q data to file; IQW only supports single-precision
-            std::copy(iqdata[0], iqdata[0] + sizes[0], reinterpret_cast<float*>(this->mmfWriterOne_.data()));
-            std::copy(iqdata[1], iqdata[1] + sizes[1], reinterpret_cast<float*>(this->mmfWriterTwo_.data()));
+            {
+              StatisticsCollector::Timer timer(this->statistics_, IoPhase::Conversion);
+              std::copy(iqdata[0], iqdata[0] + sizes[0], reinterpret_cast<float*>(this->mmfWriterOne_.data()));
+              std::copy(iqdata[1], iqdata[1] + sizes[1], reinterpret_cast<float*>(this->mmfWriterTwo_.data()));
+            }
 
             // flush writers
-            this->mmfWriterOne_.flush();
-            this->mmfWriterTwo_.flush();
-            this->mmfWriterOne_.unmap();
-            this->mmfWriterTwo_.unmap();
+            this->flushWrite(this->mmfWriterOne_, writeSize);
+            this->flushWrite(this->mmfWriterTwo_, writeSize);
+            this->statistics_.addTempFileBytes(2 * writeSize);
           }
           catch (const std::exception &e)
           {
@@ -457,17 +588,19 @@ namespace rohdeschwarz
 
             // get end of file and align memory
             size_t writeOffset = this->mmfWriterOne_.file_size();
-            this->mmfWriterOne_.map(writeOffset, writeSize);
+            this->mapWrite(this->mmfWriterOne_, writeOffset, writeSize);
 
             // mix data of separated I and Q values from the corresponding vectors
             // to interleaved format IQIQIQ and copy to file.
-            Common::mergeInterleaved(
-              iqdata[0], iqdata[0] + sizes[0],
-              iqdata[1], 
-              reinterpret_cast<float*>(this->mmfWriterOne_.data()));
+            {
+              StatisticsCollector::Timer timer(this->statistics_, IoPhase::Conversion);
+              Common::mergeInterleaved(
+                iqdata[0], iqdata[0] + sizes[0],
+                iqdata[1], 
+                reinterpret_cast<float*>(this->mmfWriterOne_.data()));
+            }
 
-            this->mmfWriterOne_.flush();
-            this->mmfWriterOne_.unmap();
+            this->flushWrite(this->mmfWriterOne_, writeSize);
           }
           catch (const std::exception &e)
           {
@@ -524,23 +657,25 @@ namespace rohdeschwarz
             size_t writeOffsetQ = this->mmfWriterTwo_.file_size();
 
             // align amemory
-            this->mmfWriterOne_.map(writeOffsetI, writeSize);
+            this->mapWrite(this->mmfWriterOne_, writeOffsetI, writeSize);
             Common::mmfDataAssert(this->mmfWriterOne_);
-            this->mmfWriterTwo_.map(writeOffsetQ, writeSize);
+            this->mapWrite(this->mmfWriterTwo_, writeOffsetQ, writeSize);
             Common::mmfDataAssert(this->mmfWriterTwo_);
 
             // split the interleaved data of iqdata array to I and Q data and 
             // write to dedicated I and Q temp files
-            Common::split(
-              iqdata,
-              reinterpret_cast<float*>(this->mmfWriterOne_.data()),
-              reinterpret_cast<float*>(this->mmfWriterTwo_.data()),
-              size);
-
-            this->mmfWriterOne_.flush();
-            this->mmfWriterTwo_.flush();
-            this->mmfWriterOne_.unmap();
-            this->mmfWriterTwo_.unmap();
+            {
+              StatisticsCollector::Timer timer(this->statistics_, IoPhase::Conversion);
+              Common::split(
+                iqdata,
+                reinterpret_cast<float*>(this->mmfWriterOne_.data()),
+                reinterpret_cast<float*>(this->mmfWriterTwo_.data()),
+                size);
+            }
+
+            this->flushWrite(this->mmfWriterOne_, writeSize);
+            this->flushWrite(this->mmfWriterTwo_, writeSize);
+            this->statistics_.addTempFileBytes(2 * writeSize);
           }
           catch (const std::exception &e)
           {
@@ -564,13 +699,15 @@ namespace rohdeschwarz
             size_t writeOffset = this->mmfWriterOne_.file_size();
 
             // align memory
-            this->mmfWriterOne_.map(writeOffset, writeSize);
+            this->mapWrite(this->mmfWriterOne_, writeOffset, writeSize);
 
             // copy interleaved I/Q values to file
-            std::copy(iqdata, iqdata + size, reinterpret_cast<float*>(this->mmfWriterOne_.data()));
+            {
+              StatisticsCollector::Timer timer(this->statistics_, IoPhase::Conversion);
+              std::copy(iqdata, iqdata + size, reinterpret_cast<float*>(this->mmfWriterOne_.data()));
+            }
 
-            this->mmfWriterOne_.flush();
-            this->mmfWriterOne_.unmap();
+            this->flushWrite(this->mmfWriterOne_, writeSize);
           }
           catch (const std::exception &e)
           {
@@ -610,6 +747,9 @@ namespace rohdeschwarz
         /** @brief Indicates whether or not the file has been initialized for writing. If
         * initialized in write-mode, file cannot read data. 
         */bool writerInitialized_;
+
+        /** @brief File of the asynchronous reads, opened by the first read and released by close(). */
+        std::shared_ptr<AsyncFile> asyncFile_;
       };
     }
   }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "asyncread.h"
 #include "idataimportexport.h"
 
 namespace rohdeschwarz
@@ -130,6 +131,103 @@ public:
   /// @brief append channels
   int appendChannels(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes) override;
 
+  void setStatisticsEnabled(bool enabled) override;
+
+  IoStatistics getStatistics() const override;
+
+  /** @brief Store the frame table of a file without cue frame to the sidecar file <filename>.iqxcue
+  * and reuse it on the next readOpen(), so that the frames do not have to be scanned again.
+  * Must be called before readOpen(). Disabled by default.
+  * @param [in]  enabled True to load and store the sidecar file.
+  * @returns ErrorCodes.Success (=0), ErrorCodes::ReaderAlreadyInitialized if the file is already open for reading or
+  * ErrorCodes::WriterAlreadyInitialized if it is open for writing.
+  */ int setCueIndexFile(bool enabled);
+
+  /** @brief Set the resolution of the IQ streams written by writeOpen(). 12 bit streams store the upper 12 bits of
+  * each value packed into DIGIQ words of 10 IQ pairs, which needs 25% less space than 16 bit streams. The last
+  * frame of a 12 bit stream is padded with zero samples to a complete DIGIQ word.
+  * Must be called before writeOpen(). Defaults to 16 bit.
+  * @param [in]  bits Resolution in bits, either 12 or 16.
+  * @returns ErrorCodes.Success (=0), ErrorCodes::InvalidDataFormat if bits is neither 12 nor 16 or
+  * ErrorCodes::WriterAlreadyInitialized if the file is already open.
+  */ int setResolution(int bits);
+
+  /** @brief Read a window of IQ samples around every trigger of a channel in one call.
+  * The windows are read in file order by one forward sweep, windows close to each other share one read.
+  * Each window contains preSamples IQ pairs before and postSamples IQ pairs starting at the trigger,
+  * interleaved as in readChannel(). Windows at the start or end of the recording are shortened accordingly.
+  * @param [in]  channelName Name of the channel.
+  * @param [in]  preSamples Number of IQ pairs before the trigger.
+  * @param [in]  postSamples Number of IQ pairs starting at the trigger.
+  * @param [out] windows One window per trigger, in order of the triggers.
+  * @param [out] triggerSamples Sample index of each trigger.
+  * @returns ErrorCodes.Success (=0) or an error code, e.g. ErrorCodes::InvalidArrayName if the channel does not exist.
+  */ int readTriggerWindows(const std::string& channelName, size_t preSamples, size_t postSamples,
+                            std::vector<std::vector<float> >& windows, std::vector<int64_t>& triggerSamples);
+
+  /// @brief read a window of IQ samples around every trigger of a channel into double vectors, see readTriggerWindows()
+  int readTriggerWindows(const std::string& channelName, size_t preSamples, size_t postSamples,
+                         std::vector<std::vector<double> >& windows, std::vector<int64_t>& triggerSamples);
+
+  /** @brief Read a window of IQ samples around each of a list of timestamps in one call, see readTriggerWindows().
+  * @param [in]  channelName Name of the channel.
+  * @param [in]  timestamps Time stamps in seconds relative to the start of the recording, in any order.
+  * @param [in]  preSamples Number of IQ pairs before each time stamp.
+  * @param [in]  postSamples Number of IQ pairs starting at each time stamp.
+  * @param [out] windows One window per time stamp, in order of the time stamps.
+  * @returns ErrorCodes.Success (=0) or an error code, e.g. ErrorCodes::InvalidArrayName if the channel does not exist.
+  */ int readTimestampWindows(const std::string& channelName, const std::vector<double>& timestamps, size_t preSamples,
+                              size_t postSamples, std::vector<std::vector<float> >& windows);
+
+  /// @brief read a window of IQ samples around each of a list of timestamps into double vectors, see readTimestampWindows()
+  int readTimestampWindows(const std::string& channelName, const std::vector<double>& timestamps, size_t preSamples,
+                           size_t postSamples, std::vector<std::vector<double> >& windows);
+
+  /** @brief Read the I or Q values of an array as stored in the file, without conversion to floating point.
+  * 12 bit streams are expanded to 16 bit. Multiplying the values with scale results in the values returned by
+  * readArray() with float or double values.
+  * @param [in]  arrayName Name of the array.
+  * @param [out] values Preallocated buffer for nofValues values.
+  * @param [in]  nofValues Number of values to read.
+  * @param [out] scale Factor converting the values to volts.
+  * @param [in]  offset Index of the first value to read.
+  * @returns ErrorCodes.Success (=0) or an error code, e.g. ErrorCodes::InternalError if the range exceeds the stream.
+  */ int readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset = 0);
+
+  /** @brief Read the IQ values of a channel as stored in the file, without conversion to floating point.
+  * The values are interleaved as in readChannel() with float or double values, see readArray() for the scale.
+  * @param [in]  channelName Name of the channel.
+  * @param [out] values Preallocated buffer for 2 * nofValues values.
+  * @param [in]  nofValues Number of IQ pairs to read.
+  * @param [out] scale Factor converting the values to volts.
+  * @param [in]  offset Index of the first IQ pair to read.
+  * @returns ErrorCodes.Success (=0) or an error code, e.g. ErrorCodes::InternalError if the range exceeds the stream.
+  */ int readChannel(const std::string& channelName, int16_t* values, size_t nofValues, double& scale, size_t offset = 0);
+
+  /** @brief Start to read the I or Q values of an array, see readArray() and AsyncRead. Returns without waiting for the data.
+  * The frames are located with the cue index and their preambles are read before returning, the I/Q data is read
+  * asynchronously. 12 bit streams are not supported.
+  * @param [in]  arrayName Name of the array.
+  * @param [out] values Preallocated buffer for nofValues values, not to be accessed until the callback is called.
+  * @param [in]  nofValues Number of values to read.
+  * @param [in]  offset Index of the first value to read.
+  * @param [in]  callback Called with ErrorCodes.Success (=0) or an error code when the values have been read.
+  * @returns ErrorCodes.Success (=0) if the read has been started, otherwise an error code and the callback is not called,
+  * e.g. ErrorCodes::InvalidDataFormat for 12 bit streams.
+  */ int readArrayAsync(const std::string& arrayName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+  int readArrayAsync(const std::string& arrayName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+
+  /** @brief Start to read the interleaved IQ values of a channel, see readChannel() and readArrayAsync(). Returns without
+  * waiting for the data.
+  * @param [in]  channelName Name of the channel.
+  * @param [out] values Preallocated buffer for 2 * nofValues values, not to be accessed until the callback is called.
+  * @param [in]  nofValues Number of IQ pairs to read.
+  * @param [in]  offset Index of the first IQ pair to read.
+  * @param [in]  callback Called with ErrorCodes.Success (=0) or an error code when the values have been read.
+  * @returns ErrorCodes.Success (=0) if the read has been started, otherwise an error code and the callback is not called.
+  */ int readChannelAsync(const std::string& channelName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+  int readChannelAsync(const std::string& channelName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+
 private:
   /// pointer to implementation class
   MosaikIqxImpl* m_pimpl;
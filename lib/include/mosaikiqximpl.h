@@ -18,11 +18,14 @@
 
 #include <time.h>
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "asyncreadservice.h"
 #include "idataimportexport.h"
+#include "statisticscollector.h"
 
 namespace IQW
 {
@@ -96,6 +99,40 @@ public:
   int appendChannels(const std::vector<std::vector<double> >& iqdata);
   /// @brief append channels
   int appendChannels(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes);
+  /// @brief load/store the cue table of files without cue frame from/to a sidecar file
+  int setCueIndexFile(bool enabled);
+  /// @brief set the resolution (12 or 16 bit) of the streams written
+  int setResolution(int bits);
+  /// @brief read a window of IQ samples around every trigger of a channel
+  int readTriggerWindows(const std::string& channelName, size_t preSamples, size_t postSamples,
+                         std::vector<std::vector<float> >& windows, std::vector<int64_t>& triggerSamples);
+  /// @brief read a window of IQ samples around every trigger of a channel
+  int readTriggerWindows(const std::string& channelName, size_t preSamples, size_t postSamples,
+                         std::vector<std::vector<double> >& windows, std::vector<int64_t>& triggerSamples);
+  /// @brief read a window of IQ samples around each of a list of timestamps
+  int readTimestampWindows(const std::string& channelName, const std::vector<double>& timestamps, size_t preSamples,
+                           size_t postSamples, std::vector<std::vector<float> >& windows);
+  /// @brief read a window of IQ samples around each of a list of timestamps
+  int readTimestampWindows(const std::string& channelName, const std::vector<double>& timestamps, size_t preSamples,
+                           size_t postSamples, std::vector<std::vector<double> >& windows);
+  /// @brief read I or Q values as stored in the file
+  int readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset);
+  /// @brief read interleaved IQ values as stored in the file
+  int readChannel(const std::string& channelName, int16_t* values, size_t nofValues, double& scale, size_t offset);
+  /// @brief start to read I or Q values without waiting for the data
+  int readArrayAsync(const std::string& arrayName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+  /// @brief start to read I or Q values without waiting for the data
+  int readArrayAsync(const std::string& arrayName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+  /// @brief start to read interleaved IQ values without waiting for the data
+  int readChannelAsync(const std::string& channelName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+  /// @brief start to read interleaved IQ values without waiting for the data
+  int readChannelAsync(const std::string& channelName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+
+  /// @brief enables or disables the collection of I/O statistics
+  void setStatisticsEnabled(bool enabled);
+
+  /// @brief returns the I/O statistics
+  IoStatistics getStatistics() const;
 
 private:
 
@@ -117,6 +154,25 @@ private:
   /// assemble IQX meta data
   void assembleIqxMetaData();
 
+  /// @brief locate the frame containing actPair with the cue index and read its preamble. dataOffset is the file offset
+  /// of the IQ data, firstPairInFrame the index of its first pair, pairsInFrame its number of pairs and resolution 12 or 16
+  int locateFrame(size_t streamNo, int64_t actPair, int64_t& dataOffset, int64_t& firstPairInFrame, int64_t& pairsInFrame, uint32_t& resolution);
+
+  /// @brief read the pairs of the frame containing actPair, at most pairCount, by positional reads into thread local
+  /// scratch buffers. values points to the first IQ pair, useablePairsInFrame is the number of pairs read.
+  int readFramePairs(size_t streamNo, int64_t actPair, int64_t pairCount, const int16_t*& values, int64_t& useablePairsInFrame);
+
+  /// @brief get the sample index of every trigger of a channel, or of every timestamp if timestamps is not null
+  int getWindowCenters(const std::string& channelName, const std::vector<double>* timestamps, size_t& streamNo, std::vector<int64_t>& centers);
+
+  /// @brief read the windows [center - preSamples, center + postSamples) of a stream, sorted by file offset in one forward sweep
+  template <typename T>
+  int readWindowsAll(size_t streamNo, const std::vector<int64_t>& centers, size_t preSamples, size_t postSamples, std::vector<std::vector<T> >& windows);
+
+  /// @brief start an asynchronous read of nofPairs pairs of a channel or array of a 16 bit stream, one segment per frame
+  template <typename T>
+  int readAsync(bool readChannel, const std::string& name, T* values, size_t nofPairs, size_t offset, AsyncReadCallback callback);
+
   /// @brief read a number of I or Q values into a float vector
   int readArrayAll(const std::string& arrayName, std::vector<float>& vfValues, std::vector<double>& vdValues, float* fValues, double* dValues, size_t nofValues, size_t offset, rType rw);
 
@@ -129,6 +185,14 @@ private:
   /// @brief write channel of float or double data to disk
   int writeIqFramesFromChannel(int64_t streamno, float * fChannel, double * dChannel, int64_t samples, wType w);
 
+  /// @brief reserve the frame buffer for pairs new IQ pairs behind the pending pairs of a 12 bit stream, which are
+  /// moved to the start of the buffer. Returns the offset of the new pairs in values
+  size_t prepareFrameBuffer(int64_t streamno, int64_t pairs);
+
+  /// @brief write pairs IQ pairs of the frame buffer as data frame. 12 bit streams keep a partial DIGIQ word pending
+  /// for the next frame, flush writes it nevertheless
+  void writeFrameBuffer(int64_t streamno, size_t pairs, bool flush = false);
+
   /// points to file impl
   std::unique_ptr<IQW::IqxFile> m_piqx;
   /// file name
@@ -146,9 +210,24 @@ private:
   /// meta data
   std::map<std::string, std::string> m_metaData;
   /// indicates if file is opened for read or write
-  bool m_write;
+  bool m_write{ false };
+  /// stream types (IqxStreamType) of the file opened for reading
+  std::map<size_t, uint32_t> m_streamTypes;
+  /// load/store the cue table from/to a sidecar file on readOpen
+  bool m_cueIndexFile{ false };
+  /// aligned frame buffer reused by the writer for the conversion to int16, allocated by the first frame written
+  struct FrameBuffer;
+  std::unique_ptr<FrameBuffer> m_frameBuffer;
+  /// resolution of the streams written
+  int m_resolution{ 16 };
+  /// IQ values of each 12 bit stream that do not fill a complete DIGIQ word yet
+  std::map<int64_t, std::vector<int16_t>> m_pendingValues;
   double m_scaleFactor{ 1.0 };
   double m_multiplicator{ 1.0 / INT16_MAX };
+  /// I/O statistics
+  StatisticsCollector m_statistics;
+  /// file of the asynchronous reads, opened by the first read and released by close()
+  std::shared_ptr<AsyncFile> m_asyncFile;
 };
 
 }
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <fcntl.h>
 #include <iostream>
 #include <sys/types.h>
@@ -88,6 +89,13 @@ namespace rohdeschwarz
           @returns Returns the file size in bytes.
         */static uint64_t getFileSize(const std::string& filename);
 
+        /**
+          @brief Returns the files matching the specified pattern. Wildcards '*' and '?' are supported in the filename,
+          not in the directory part of the pattern.
+          @param [in]  pattern Fully qualified path with wildcards, UTF-8 encoded.
+          @returns Returns the matching files, sorted by name. If no file matches, an empty vector is returned.
+        */static std::vector<std::string> findFiles(const std::string& pattern);
+
         /**
           @brief Parses strings of format "%Y-%m-%d %H:%M:%S" and "%Y-%m-%dT%H:%M:%S"
           and returns the corresponding time_t.
@@ -152,6 +160,59 @@ namespace rohdeschwarz
           @param [in]  filename File to be opened, UTF-8 encoded.
           @returns LibArchive error code or ARCHIVE_OK in case of success.
         */static int archiveWriteOpen(struct archive* a, const std::string& filename);
+
+        /**
+          @brief Opens a file for reading with readAt().
+          @param [in]  filename File to be opened, UTF-8 encoded.
+          @returns Returns the file descriptor or -1 if the file cannot be opened.
+        */static int fileOpenRead(const std::string& filename);
+
+        /**
+          @brief Reads from a file at the specified position. The file position is not used, so that several
+          threads can read from the same descriptor concurrently.
+          @param [in]  fd File descriptor returned by fileOpenRead().
+          @param [in]  offset Position in the file in bytes.
+          @param [out]  buffer Destination buffer of at least bytes size.
+          @param [in]  bytes Number of bytes to read.
+          @returns Returns the number of bytes read, which is less than bytes at the end of the file, or -1 on error.
+        */static int64_t fileReadAt(int fd, uint64_t offset, void* buffer, size_t bytes);
+
+        /**
+          @brief Closes a file opened by fileOpenRead().
+          @param [in]  fd File descriptor.
+        */static void fileClose(int fd);
+      };
+
+      /**
+      * @brief Switches the calling thread to its own copy of the global locale while the object exists.
+      * libarchive converts the names of archive entries with the locale of the calling thread. With a
+      * thread locale, archives are read and written by several threads in parallel without a process-wide
+      * lock, and setlocale() calls of the application cannot change the locale during a conversion.
+      */
+      class ThreadLocale final
+      {
+      public:
+        /** @brief Constructor. Copies the global locale and makes it the locale of the calling thread. */
+        ThreadLocale();
+
+        /** @brief Destructor. Restores the previous locale of the calling thread. */
+        ~ThreadLocale();
+
+      private:
+        /** @brief Private copy constructor. */
+        ThreadLocale(const ThreadLocale&);
+
+        /** @brief Private assignment operator.*/
+        ThreadLocale& operator=(const ThreadLocale&);
+
+        /** @brief The copy of the global locale, not used on Windows. */
+        void* locale_;
+
+        /** @brief Locale of the thread before construction, not used on Windows. */
+        void* previousLocale_;
+
+        /** @brief Per-thread locale setting before construction, only used on Windows. */
+        int previousSetting_;
       };
     }
   }
@@ -51,6 +51,7 @@ __pragma(warning(disable: 4018))
 
 #include "window.h"
 #include "ringbuffer.h"
+#include "tracescope.h"
 
 namespace rohdeschwarz
 {
@@ -417,6 +418,7 @@ namespace rohdeschwarz
       template <typename T> void CPWelch<T>::
         Feed(const std::complex<T>* a_pFeedData,const int a_iLengthFeedData)
       {
+        DAIEX_TRACE_SCOPE("CPWelch::Feed");
         cRingBuffer.Feed(a_pFeedData,a_iLengthFeedData);
         while (cRingBuffer.GetMaxReadLength()>=m_iWindowLength)
         {
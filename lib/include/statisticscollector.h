@@ -0,0 +1,250 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      statisticscollector.h
+*
+* @brief     This is the header file of class StatisticsCollector.
+*
+* @details   Collects the IoStatistics of one file format object.
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+#include "iostatistics.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+      * @brief Collects the IoStatistics of one file format object. All methods return immediately
+      * if the collection is disabled, which is the default. Counters and timers may be used by concurrent
+      * reads of the same object, enabling and disabling the collection must not run concurrently with them.
+      */
+      class StatisticsCollector
+      {
+      public:
+        /**
+        * @brief Measures the wall time of a scope and adds it to a phase. Timers may be nested,
+        * the time of the inner timer is not counted for the outer timer. Nesting is tracked per thread,
+        * timers of concurrent threads add their time independently.
+        */
+        class Timer
+        {
+        public:
+          /**
+            @brief Constructor. Starts measuring, if the collection is enabled.
+            @param [in]  collector The collector the time is added to.
+            @param [in]  phase The phase the time is added to.
+          */Timer(StatisticsCollector& collector, IoPhase phase) :
+            collector_(collector.enabled_ ? &collector : nullptr),
+            phase_(phase),
+            parent_(nullptr)
+          {
+            if (this->collector_ == nullptr)
+            {
+              return;
+            }
+
+            this->start_ = std::chrono::steady_clock::now();
+            this->parent_ = Timer::active();
+            if (this->parent_ != nullptr)
+            {
+              this->parent_->charge(this->start_);
+            }
+
+            Timer::active() = this;
+          }
+
+          /** @brief Destructor. Adds the measured time to the phase and resumes the outer timer. */
+          ~Timer()
+          {
+            if (this->collector_ == nullptr)
+            {
+              return;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            this->charge(now);
+            Timer::active() = this->parent_;
+            if (this->parent_ != nullptr)
+            {
+              this->parent_->start_ = now;
+            }
+          }
+
+        private:
+          /** @brief Private copy constructor. */
+          Timer(const Timer&);
+
+          /** @brief Private assignment operator.*/
+          Timer& operator=(const Timer&);
+
+          /** @returns Returns the innermost timer running in the calling thread. */
+          static Timer*& active()
+          {
+            static thread_local Timer* timer = nullptr;
+            return timer;
+          }
+
+          /** @brief Adds the time since the last start to the phase and restarts at the specified time. */
+          void charge(std::chrono::steady_clock::time_point now)
+          {
+            const double seconds = std::chrono::duration<double>(now - this->start_).count();
+            std::lock_guard<std::mutex> lock(this->collector_->mutex_);
+            this->collector_->statistics_.seconds_[static_cast<int>(this->phase_)] += seconds;
+            this->start_ = now;
+          }
+
+          /** @brief The collector, nullptr if the collection is disabled. */
+          StatisticsCollector* collector_;
+
+          /** @brief The phase the time is added to. */
+          const IoPhase phase_;
+
+          /** @brief Timer that has been active when this timer has been started. */
+          Timer* parent_;
+
+          /** @brief Start of the time not yet added to the phase. */
+          std::chrono::steady_clock::time_point start_;
+        };
+
+        /** @brief Constructor. The collection is disabled. */
+        StatisticsCollector() : enabled_(false) {}
+
+        /**
+          @brief Enables or disables the collection. All counters are reset.
+          @param [in]  enabled TRUE to enable the collection.
+        */void setEnabled(bool enabled)
+        {
+          std::lock_guard<std::mutex> lock(this->mutex_);
+          this->enabled_ = enabled;
+          this->statistics_ = IoStatistics();
+        }
+
+        /** @returns Returns TRUE if the collection is enabled. */
+        bool isEnabled() const
+        {
+          return this->enabled_;
+        }
+
+        /** @returns Returns a copy of the statistics collected. */
+        IoStatistics get() const
+        {
+          std::lock_guard<std::mutex> lock(this->mutex_);
+          return this->statistics_;
+        }
+
+        /** @brief Counts bytes read from file by nofCalls calls. */
+        void addRead(uint64_t nofBytes, uint64_t nofCalls = 1)
+        {
+          if (this->enabled_)
+          {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->statistics_.bytesRead_ += nofBytes;
+            this->statistics_.nofSyscalls_ += nofCalls;
+          }
+        }
+
+        /** @brief Counts bytes written to file by nofCalls calls. */
+        void addWrite(uint64_t nofBytes, uint64_t nofCalls = 1)
+        {
+          if (this->enabled_)
+          {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->statistics_.bytesWritten_ += nofBytes;
+            this->statistics_.nofSyscalls_ += nofCalls;
+          }
+        }
+
+        /** @brief Counts calls that do not transfer data, e.g. seek and flush. */
+        void addSyscalls(uint64_t nofCalls = 1)
+        {
+          if (this->enabled_)
+          {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->statistics_.nofSyscalls_ += nofCalls;
+          }
+        }
+
+        /** @brief Counts a mapped region. For read-only maps the mapped size is counted as bytes read. */
+        void addMap(uint64_t nofBytesRead = 0)
+        {
+          if (this->enabled_)
+          {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->statistics_.nofMaps_ += 1;
+            this->statistics_.bytesRead_ += nofBytesRead;
+          }
+        }
+
+        /** @brief Counts an unmapped region. */
+        void addUnmap()
+        {
+          if (this->enabled_)
+          {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->statistics_.nofUnmaps_ += 1;
+          }
+        }
+
+        /** @brief Counts bytes added to temporary files. */
+        void addTempFileBytes(uint64_t nofBytes)
+        {
+          if (this->enabled_)
+          {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->statistics_.tempFileBytes_ += nofBytes;
+            this->statistics_.peakTempFileBytes_ = std::max(this->statistics_.peakTempFileBytes_, this->statistics_.tempFileBytes_);
+          }
+        }
+
+        /** @brief Counts the deletion of all temporary files. */
+        void removeTempFiles()
+        {
+          std::lock_guard<std::mutex> lock(this->mutex_);
+          this->statistics_.tempFileBytes_ = 0;
+        }
+
+      private:
+        /** @brief Private copy constructor. */
+        StatisticsCollector(const StatisticsCollector&);
+
+        /** @brief Private assignment operator.*/
+        StatisticsCollector& operator=(const StatisticsCollector&);
+
+        /** @brief TRUE if the collection is enabled. */
+        bool enabled_;
+
+        /** @brief Guards the statistics against concurrent reads of the file format object. */
+        mutable std::mutex mutex_;
+
+        /** @brief The statistics collected. */
+        IoStatistics statistics_;
+      };
+    }
+  }
+}
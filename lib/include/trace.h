@@ -0,0 +1,75 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      trace.h
+*
+* @brief     This is the header file of class Trace.
+*
+* @details   Access to the trace events recorded by the library.
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+#include <string>
+
+#include "exportdecl.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+      * @brief Access to the trace events recorded by the library, e.g. the begin and end of appending, preview
+      * calculation, reading and finalization. The events show the timeline of all threads and can be
+      * inspected with any viewer of the Chrome trace event format, e.g. chrome://tracing or Perfetto.
+      *
+      * Trace events are only recorded if the library has been built with the CMake option BUILD_TRACING.
+      * Otherwise all trace hooks are compiled out and the trace written is empty.
+      * If trace events are recorded and the environment variable DAIEX_TRACE_FILE is set, the trace is written
+      * to the specified file when the library is unloaded.
+      */
+      class Trace final
+      {
+      public:
+        /**
+          @returns Returns TRUE if the library has been built with trace events.
+        */MOSAIK_MODULE static bool isEnabled();
+
+        /**
+          @brief Discards all trace events recorded so far. Must not be called while other threads
+          use the library.
+        */MOSAIK_MODULE static void clear();
+
+        /**
+          @brief Writes all trace events recorded so far to a file in Chrome trace event JSON format.
+          Events recorded by other threads while writing may be missing.
+          @param [in]  filename Name of the file to write.
+          @returns Returns ErrorCodes::Success or ErrorCodes::FileOpenError if the file cannot be written.
+        */MOSAIK_MODULE static int writeChromeTrace(const std::string& filename);
+
+      private:
+        /** @brief Private constructor, class is static. */
+        Trace();
+      };
+    }
+  }
+}
@@ -0,0 +1,86 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      tracescope.h
+*
+* @brief     This is the header file of class TraceScope and macro DAIEX_TRACE_SCOPE.
+*
+* @details   Records begin and end trace events of a scope, see Trace.
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+        @brief Appends a trace event to the buffer of the calling thread. Lock-free, except for the
+        first event of a thread.
+        @param [in]  name Name of the event. Must be a string literal, only the pointer is stored.
+        @param [in]  phase 'B' for the begin or 'E' for the end of a scope.
+      */void traceEvent(const char* name, char phase);
+
+      /**
+      * @brief Records a begin event on construction and an end event on destruction.
+      * Use macro DAIEX_TRACE_SCOPE, which compiles to nothing if tracing is disabled.
+      */
+      class TraceScope
+      {
+      public:
+        /**
+          @brief Constructor. Records the begin event.
+          @param [in]  name Name of the scope. Must be a string literal.
+        */explicit TraceScope(const char* name) : name_(name)
+        {
+          traceEvent(this->name_, 'B');
+        }
+
+        /** @brief Destructor. Records the end event. */
+        ~TraceScope()
+        {
+          traceEvent(this->name_, 'E');
+        }
+
+      private:
+        /** @brief Private copy constructor. */
+        TraceScope(const TraceScope&);
+
+        /** @brief Private assignment operator.*/
+        TraceScope& operator=(const TraceScope&);
+
+        /** @brief Name of the scope. */
+        const char* name_;
+      };
+    }
+  }
+}
+
+#define DAIEX_TRACE_CONCAT_(a, b) a##b
+#define DAIEX_TRACE_CONCAT(a, b) DAIEX_TRACE_CONCAT_(a, b)
+
+#ifdef DAIEX_TRACING
+/** @brief Records the begin and end of the enclosing scope with the specified name, a string literal. */
+#define DAIEX_TRACE_SCOPE(name) ::rohdeschwarz::mosaik::dataimportexport::TraceScope DAIEX_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#else
+#define DAIEX_TRACE_SCOPE(name)
+#endif
@@ -0,0 +1,132 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+/*!
+* @file      workstealingpool.h
+*
+* @brief     This is the header file of class WorkStealingPool.
+*
+* @details   Thread pool with one task queue per worker. Idle workers steal tasks from busy workers.
+*
+* @copyright Copyright (c) Rohde &amp; Schwarz GmbH &amp; Co. KG, Munich.
+*            All rights reserved.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      /**
+      * @brief Thread pool with one task queue per worker.
+      *
+      * Tasks submitted by a worker are appended to the queue of this worker and are executed LIFO by the worker itself,
+      * tasks submitted by other threads are appended to a shared queue and are executed FIFO. A worker without tasks
+      * steals the oldest task of another worker, i.e. work spawned by a long-running task (e.g. ranges of a large file)
+      * is distributed to idle workers.
+      */
+      class WorkStealingPool
+      {
+      public:
+        /**
+          @brief Constructor. Starts the specified number of workers.
+          @param [in]  nofThreads Number of workers. If 0, one worker per hardware thread is started.
+        */explicit WorkStealingPool(size_t nofThreads);
+
+        /** @brief Destructor. Waits until all submitted tasks have been executed and stops the workers. */
+        ~WorkStealingPool();
+
+        /**
+          @brief Submits a task. Tasks must not throw.
+          @param [in]  task The task to be executed by a worker.
+        */void submit(std::function<void()> task);
+
+        /** @brief Waits until all submitted tasks have been executed. */
+        void wait();
+
+        /**
+          @returns Returns the number of workers.
+        */size_t getNofThreads() const;
+
+      private:
+        /** @brief Private copy constructor. */
+        WorkStealingPool(const WorkStealingPool&);
+
+        /** @brief Private assignment operator.*/
+        WorkStealingPool& operator=(const WorkStealingPool&);
+
+        /** @brief Task queue of one worker. */
+        struct Queue
+        {
+          std::mutex mutex;
+          std::deque<std::function<void()>> tasks;
+        };
+
+        /**
+          @brief Takes the next task for the specified worker: the newest task of its own queue, the oldest task of the
+          shared queue or the oldest task of another worker.
+          @param [in]  worker Index of the worker.
+          @param [out]  task The task taken.
+          @returns Returns TRUE if a task has been taken.
+        */bool take(size_t worker, std::function<void()>& task);
+
+        /**
+          @brief Main loop of a worker.
+          @param [in]  worker Index of the worker.
+        */void workerLoop(size_t worker);
+
+        /** @brief One queue per worker. */
+        std::vector<std::unique_ptr<Queue>> queues_;
+
+        /** @brief Tasks submitted by threads outside the pool. */
+        Queue shared_;
+
+        /** @brief The workers. */
+        std::vector<std::thread> threads_;
+
+        /** @brief Protects waiting for tasks and for completion. */
+        std::mutex mutex_;
+
+        /** @brief Signaled if a task has been submitted or the pool is stopped. */
+        std::condition_variable taskCondition_;
+
+        /** @brief Signaled if all submitted tasks have been executed. */
+        std::condition_variable idleCondition_;
+
+        /** @brief Number of tasks in all queues. */
+        std::atomic<size_t> queued_;
+
+        /** @brief Number of tasks submitted, but not yet executed completely. */
+        size_t pending_;
+
+        /** @brief TRUE if the workers shall stop. */
+        bool stop_;
+      };
+    }
+  }
+}
@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include "asyncread.h"
 #include "idataimportexport.h"
 
 class WvScramblerBase;
@@ -140,6 +141,52 @@ namespace rohdeschwarz
 				  /// @brief append channels
 				  int appendChannels(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes) override;
 
+				  void setStatisticsEnabled(bool enabled) override;
+
+				  IoStatistics getStatistics() const override;
+
+				  /** @brief Read the I or Q values of an array as stored in the file, without conversion to floating point.
+				  * Multiplying the values with scale results in the values returned by readArray() with float or double values.
+				  * @param [in]  arrayName Name of the array.
+				  * @param [out] values Preallocated buffer for nofValues values.
+				  * @param [in]  nofValues Number of values to read.
+				  * @param [out] scale Factor converting the values to volts.
+				  * @param [in]  offset Index of the first value to read.
+				  * @returns ErrorCodes.Success (=0) or an error code.
+				  */ int readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset = 0);
+
+				  /** @brief Read the IQ values of a channel as stored in the file, without conversion to floating point.
+				  * The values are interleaved as in readChannel() with float or double values, see readArray() for the scale.
+				  * @param [in]  channelName Name of the channel.
+				  * @param [out] values Preallocated buffer for 2 * nofValues values.
+				  * @param [in]  nofValues Number of IQ pairs to read.
+				  * @param [out] scale Factor converting the values to volts.
+				  * @param [in]  offset Index of the first IQ pair to read.
+				  * @returns ErrorCodes.Success (=0) or an error code.
+				  */ int readChannel(const std::string& channelName, int16_t* values, size_t nofValues, double& scale, size_t offset = 0);
+
+				  /** @brief Start to read the I or Q values of an array, see readArray() and AsyncRead. Returns without waiting for the data.
+				  * Scrambled files are not supported.
+				  * @param [in]  arrayName Name of the array.
+				  * @param [out] values Preallocated buffer for nofValues values, not to be accessed until the callback is called.
+				  * @param [in]  nofValues Number of values to read.
+				  * @param [in]  offset Index of the first value to read.
+				  * @param [in]  callback Called with ErrorCodes.Success (=0) or an error code when the values have been read.
+				  * @returns ErrorCodes.Success (=0) if the read has been started, otherwise an error code and the callback is not called.
+				  */ int readArrayAsync(const std::string& arrayName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+				  int readArrayAsync(const std::string& arrayName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+
+				  /** @brief Start to read the interleaved IQ values of a channel, see readChannel() and AsyncRead. Returns without waiting
+				  * for the data. Scrambled files are not supported.
+				  * @param [in]  channelName Name of the channel.
+				  * @param [out] values Preallocated buffer for 2 * nofValues values, not to be accessed until the callback is called.
+				  * @param [in]  nofValues Number of IQ pairs to read.
+				  * @param [in]  offset Index of the first IQ pair to read.
+				  * @param [in]  callback Called with ErrorCodes.Success (=0) or an error code when the values have been read.
+				  * @returns ErrorCodes.Success (=0) if the read has been started, otherwise an error code and the callback is not called.
+				  */ int readChannelAsync(const std::string& channelName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+				  int readChannelAsync(const std::string& channelName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+
 				  void setScrambler(WvScramblerBase * scrambler);
 
 			private:
@@ -36,6 +36,8 @@
 #include "wv.h"
 #include "dataimportexportbase.h"
 #include "CLBWvInFile.h"
+#include "asyncreadservice.h"
+#include "statisticscollector.h"
 
 namespace rohdeschwarz
 {
@@ -105,6 +107,20 @@ namespace rohdeschwarz
 				  /// @brief append channels
 				  int appendChannels(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes);
 
+				  /// @brief enables or disables the collection of I/O statistics
+				  void setStatisticsEnabled(bool enabled);
+				  /// @brief returns the I/O statistics
+				  IoStatistics getStatistics() const;
+
+				  /// @brief read I or Q values as stored in the file
+				  int readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset);
+				  /// @brief read interleaved IQ values as stored in the file
+				  int readChannel(const std::string& channelName, int16_t* values, size_t nofValues, double& scale, size_t offset);
+
+				  /// @brief start an asynchronous read of an array or a channel, float or double
+				  template<typename T>
+				  int readAsync(bool readChannel, const std::string& name, T* values, size_t nofValues, size_t offset, AsyncReadCallback callback);
+
 				  void setScrambler(WvScramblerBase * scrambler);
 
 			private:
@@ -162,6 +178,10 @@ namespace rohdeschwarz
                 double m_multiplicator{ 1.0 / INT16_MAX };
                 bool m_scramblerSet;
 				time_t m_timeStamp;
+				/// I/O statistics
+				StatisticsCollector m_statistics;
+				/// file of the asynchronous reads, released by close()
+				std::shared_ptr<AsyncFile> m_asyncFile;
 			};
 
 		}
@@ -47,8 +47,10 @@ public:
 	/// test if a given file is an IQX file
   static bool isIqxFile(const std::string& filename);
 
-  /// constructor with the full absolute filename, including the path
-  IqxFile(const std::string& filename, bool edit = false);
+  /// constructor with the full absolute filename, including the path.
+  /// If cueIndexFile is set and the file has no cue frame, the cue table built by scanning the frames
+  /// is stored to <filename>.iqxcue and reused when the same file is opened again.
+  IqxFile(const std::string& filename, bool edit = false, bool cueIndexFile = false);
 
   /// constructor with the file descriptor
   IqxFile(int fd);
@@ -72,6 +74,10 @@ public:
   /// cast to file descriptor
   operator int();
 
+  /// read bytes at the given file offset without moving the file position, e.g. from several threads.
+  /// Returns the number of bytes read, which is less than bytes at the end of the file, or -1 on error
+  int64_t readAt(iqx_off_t offset, void* buffer, size_t bytes) const;
+
   /// offset to the stream payload
   size_t getPayloadOffset() const;
 
@@ -210,6 +216,9 @@ public:
   /// @brief write a data frame to file
   void writeDataFrame(int64_t streamno, int64_t sequenceno, std::vector<int16_t>& data);
 
+  /// @brief write a data frame of interleaved IQ values (values is the number of int16 values) to file, e.g. from a reused frame buffer
+  void writeDataFrame(int64_t streamno, int64_t sequenceno, const int16_t* data, size_t values);
+
   /// @brief indicate if file has overrun
   bool hasOverrun() const;
 
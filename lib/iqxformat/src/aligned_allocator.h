@@ -42,7 +42,8 @@ public:
 
   inline const_pointer adress (const_reference r) const { return &r; }
 
-  inline pointer allocate (size_type n) { return (pointer)aligned_alloc(N, n*sizeof(value_type)); }
+  // aligned_alloc requires the size to be a multiple of the alignment
+  inline pointer allocate (size_type n) { return (pointer)aligned_alloc(N, (n*sizeof(value_type) + N - 1) / N * N); }
 
   inline void deallocate (pointer p, size_type) { aligned_free(p); }
 
@@ -0,0 +1,563 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+#ifdef _WIN32
+#include <cstdint>
+#include "wincompat.h"
+#else
+#include <sys/types.h>
+#endif
+
+#include "iqbitconverter.h"
+
+#include <atomic>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define IQBITCONV_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define IQBITCONV_TARGET_SSE41
+#define IQBITCONV_TARGET_AVX2
+#define IQBITCONV_TARGET_AVX512VBMI
+#else
+#define IQBITCONV_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define IQBITCONV_TARGET_AVX2 __attribute__((target("avx2")))
+#define IQBITCONV_TARGET_AVX512VBMI __attribute__((target("avx512f,avx512bw,avx512vbmi")))
+// the AVX-512 intrinsics of gcc are based on _mm512_undefined_epi32(), which causes false positives
+#if !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#endif
+#endif
+
+namespace IQW
+{
+
+using namespace std;
+
+namespace
+{
+
+/// 12 bit source bytes per half DIGIQ word, which holds 10 real samples and a padding byte
+const size_t halfWordBytes = DIGIQ_WORD_SIZE / 2;
+/// 16 bit samples per half DIGIQ word
+const size_t halfWordSamples = SAMPLES_REAL12_PER_DIGIQ_WORD / 2;
+
+IqBitConverter::SimdLevel detectSimdLevel()
+{
+#ifdef IQBITCONV_X86
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 0);
+  const int maxLeaf = info[0];
+  __cpuid(info, 1);
+  const bool sse41 = (info[2] & (1 << 9)) != 0 && (info[2] & (1 << 19)) != 0;
+  // AVX2 and AVX-512 require os support for the ymm/zmm registers (osxsave + xcr0)
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+  bool avx2 = false;
+  bool avx512vbmi = false;
+  if (maxLeaf >= 7 && (xcr0 & 0x6) == 0x6)
+  {
+    __cpuidex(info, 7, 0);
+    avx2 = (info[1] & (1 << 5)) != 0;
+    avx512vbmi = (xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0 && (info[2] & (1 << 1)) != 0;
+  }
+#else
+  __builtin_cpu_init();
+  const bool sse41 = __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1");
+  const bool avx2 = __builtin_cpu_supports("avx2");
+  const bool avx512vbmi = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vbmi");
+#endif
+  if (avx512vbmi)
+  {
+    return IqBitConverter::SimdAvx512Vbmi;
+  }
+  if (avx2)
+  {
+    return IqBitConverter::SimdAvx2;
+  }
+  if (sse41)
+  {
+    return IqBitConverter::SimdSse41;
+  }
+#endif
+  return IqBitConverter::SimdNone;
+}
+
+const IqBitConverter::SimdLevel simdLevelMax = detectSimdLevel();
+atomic<int> simdLevel(simdLevelMax);
+
+#ifdef IQBITCONV_X86
+/// byte offset of the 12 bit sample k within a block of DIGIQ words
+inline size_t sourceByte(size_t k)
+{
+  return (k / halfWordSamples) * halfWordBytes + (k % halfWordSamples) / 2 * 3 + (k % 2);
+}
+
+/// @brief shuffle tables for the vectorized conversions. Every group of 16 bit samples is gathered
+/// from a load at a group specific offset, so that no group crosses the loaded register.
+struct Tables
+{
+  /// 12->16, 16 byte lanes: offsets and shuffle masks of the 5 groups of 8 samples in 64 source bytes
+  size_t unpackLaneOffset[5];
+  uint8_t unpackLaneMask[5][16];
+  /// 12->16, 64 byte registers: offsets, load masks and permutations of the 5 groups of 32 samples in 256 source bytes
+  size_t unpackZmmOffset[5];
+  uint64_t unpackZmmLoadMask[5];
+  uint8_t unpackZmmIndex[5][64];
+  /// 16->12: permutation of the packed 24 bit sample pairs of 4 half words
+  uint8_t packZmmIndex[64];
+
+  Tables()
+  {
+    for (size_t g = 0; g < 5; ++g)
+    {
+      // the last lane must not exceed the 64 byte block
+      unpackLaneOffset[g] = sourceByte(8 * g) < 48 ? sourceByte(8 * g) : 48;
+      for (size_t i = 0; i < 8; ++i)
+      {
+        unpackLaneMask[g][2 * i] = static_cast<uint8_t>(sourceByte(8 * g + i) - unpackLaneOffset[g]);
+        unpackLaneMask[g][2 * i + 1] = static_cast<uint8_t>(sourceByte(8 * g + i) + 1 - unpackLaneOffset[g]);
+      }
+
+      unpackZmmOffset[g] = sourceByte(32 * g);
+      const size_t bytes = sourceByte(32 * g + 31) + 2 - unpackZmmOffset[g];
+      unpackZmmLoadMask[g] = (bytes >= 64) ? ~0ULL : ((1ULL << bytes) - 1);
+      for (size_t i = 0; i < 32; ++i)
+      {
+        unpackZmmIndex[g][2 * i] = static_cast<uint8_t>(sourceByte(32 * g + i) - unpackZmmOffset[g]);
+        unpackZmmIndex[g][2 * i + 1] = static_cast<uint8_t>(sourceByte(32 * g + i) + 1 - unpackZmmOffset[g]);
+      }
+    }
+
+    // each 32 bit lane holds a 24 bit sample pair, 5 pairs per half word followed by a padding byte
+    for (size_t q = 0; q < 64; ++q)
+    {
+      const size_t r = q % halfWordBytes;
+      const size_t pair = (q / halfWordBytes) * 5 + r / 3;
+      packZmmIndex[q] = (r == halfWordBytes - 1) ? 0 : static_cast<uint8_t>(pair * 4 + r % 3);
+    }
+  }
+};
+
+const Tables tables;
+
+// -----------------------------------------------------------------------------------------------
+// 12 -> 16 bit, each kernel returns the number of processed source bytes
+// -----------------------------------------------------------------------------------------------
+
+IQBITCONV_TARGET_SSE41 size_t conv12to16Sse41(const uint8_t* src8, uint16_t* dst16, size_t count)
+{
+  const __m128i shuffleMask = _mm_setr_epi8(0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11);
+  const __m128i andMask = _mm_setr_epi16(
+    (short)0xFFFF, (short)0xFFF0, (short)0xFFFF, (short)0xFFF0,
+    (short)0xFFFF, (short)0xFFF0, (short)0xFFFF, (short)0xFFF0);
+
+  size_t done = 0;
+  // frame loop (process half a DIGIQ 256 bit word per loop)
+  for (; done + halfWordBytes <= count; done += halfWordBytes, src8 += halfWordBytes, dst16 += halfWordSamples)
+  {
+    // load and reorder bytes
+    __m128i tmp = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src8), shuffleMask);
+    // left shift 16bit integers by 4 bit (needed on even indices), clear lower nibble on odd indices
+    tmp = _mm_and_si128(_mm_blend_epi16(_mm_slli_epi16(tmp, 4), tmp, 0xAA), andMask);
+    _mm_storeu_si128((__m128i*)dst16, tmp);
+    // convert indices 8..9
+    dst16[8] = (uint16_t)(src8[12] | (src8[13] << 8)) << 4;
+    dst16[9] = (uint16_t)(src8[13] | (src8[14] << 8)) & 0xFFF0;
+  }
+  return done;
+}
+
+IQBITCONV_TARGET_AVX2 size_t conv12to16Avx2(const uint8_t* src8, uint16_t* dst16, size_t count)
+{
+  const __m256i andMask = _mm256_set1_epi32((int)0xFFF0FFFF);
+  const __m256i mask01 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)tables.unpackLaneMask[0])), _mm_loadu_si128((const __m128i*)tables.unpackLaneMask[1]), 1);
+  const __m256i mask23 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)tables.unpackLaneMask[2])), _mm_loadu_si128((const __m128i*)tables.unpackLaneMask[3]), 1);
+  const __m128i mask4 = _mm_loadu_si128((const __m128i*)tables.unpackLaneMask[4]);
+  const size_t* offset = tables.unpackLaneOffset;
+
+  size_t done = 0;
+  // process two DIGIQ words (40 samples in 5 lanes of 8 samples) per loop
+  for (; done + 2 * DIGIQ_WORD_SIZE <= count; done += 2 * DIGIQ_WORD_SIZE, src8 += 2 * DIGIQ_WORD_SIZE, dst16 += 2 * SAMPLES_REAL12_PER_DIGIQ_WORD)
+  {
+    __m256i a = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(src8 + offset[0]))), _mm_loadu_si128((const __m128i*)(src8 + offset[1])), 1);
+    __m256i b = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(src8 + offset[2]))), _mm_loadu_si128((const __m128i*)(src8 + offset[3])), 1);
+    __m128i c = _mm_loadu_si128((const __m128i*)(src8 + offset[4]));
+
+    a = _mm256_shuffle_epi8(a, mask01);
+    b = _mm256_shuffle_epi8(b, mask23);
+    c = _mm_shuffle_epi8(c, mask4);
+    a = _mm256_and_si256(_mm256_blend_epi16(_mm256_slli_epi16(a, 4), a, 0xAA), andMask);
+    b = _mm256_and_si256(_mm256_blend_epi16(_mm256_slli_epi16(b, 4), b, 0xAA), andMask);
+    c = _mm_and_si128(_mm_blend_epi16(_mm_slli_epi16(c, 4), c, 0xAA), _mm256_castsi256_si128(andMask));
+
+    _mm256_storeu_si256((__m256i*)dst16, a);
+    _mm256_storeu_si256((__m256i*)(dst16 + 16), b);
+    _mm_storeu_si128((__m128i*)(dst16 + 32), c);
+  }
+  return done;
+}
+
+IQBITCONV_TARGET_AVX512VBMI size_t conv12to16Avx512Vbmi(const uint8_t* src8, uint16_t* dst16, size_t count)
+{
+  const __m512i andMask = _mm512_set1_epi32((int)0xFFF0FFFF);
+  __m512i index[5];
+  for (size_t g = 0; g < 5; ++g)
+  {
+    index[g] = _mm512_loadu_si512(tables.unpackZmmIndex[g]);
+  }
+
+  size_t done = 0;
+  // process eight DIGIQ words (160 samples in 5 registers of 32 samples) per loop
+  for (; done + 8 * DIGIQ_WORD_SIZE <= count; done += 8 * DIGIQ_WORD_SIZE, src8 += 8 * DIGIQ_WORD_SIZE, dst16 += 8 * SAMPLES_REAL12_PER_DIGIQ_WORD)
+  {
+    for (size_t g = 0; g < 5; ++g)
+    {
+      // the masked load does not touch bytes behind the block
+      __m512i x = _mm512_maskz_loadu_epi8(tables.unpackZmmLoadMask[g], src8 + tables.unpackZmmOffset[g]);
+      x = _mm512_permutexvar_epi8(index[g], x);
+      x = _mm512_and_si512(_mm512_mask_blend_epi16(0xAAAAAAAA, _mm512_slli_epi16(x, 4), x), andMask);
+      _mm512_storeu_si512(dst16 + 32 * g, x);
+    }
+  }
+  return done;
+}
+
+// -----------------------------------------------------------------------------------------------
+// 16 -> 12 bit, each kernel returns the number of processed source bytes
+// -----------------------------------------------------------------------------------------------
+
+/// @brief pack each pair of 16 bit samples to the lower 24 bits of its 32 bit lane
+IQBITCONV_TARGET_SSE41 inline __m128i packPairs(__m128i x)
+{
+  return _mm_or_si128(_mm_srli_epi32(_mm_and_si128(x, _mm_set1_epi32(0x0000FFF0)), 4),
+                      _mm_srli_epi32(_mm_and_si128(x, _mm_set1_epi32((int)0xFFF00000)), 8));
+}
+
+IQBITCONV_TARGET_SSE41 size_t conv16to12Sse41(const uint16_t* src16, uint8_t* dst8, size_t count)
+{
+  // pairs 0..3 from the first load, pair 4 from the second load starting at pair 1
+  const __m128i maskA = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  const __m128i maskB = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 12, 13, 14, -1);
+  const size_t srcBytes = halfWordSamples * sizeof(uint16_t);
+
+  size_t done = 0;
+  // frame loop (process half a DIGIQ 256 bit word per loop)
+  for (; done + srcBytes <= count; done += srcBytes, src16 += halfWordSamples, dst8 += halfWordBytes)
+  {
+    __m128i a = packPairs(_mm_loadu_si128((const __m128i*)src16));
+    __m128i b = packPairs(_mm_loadu_si128((const __m128i*)(src16 + 2)));
+    _mm_storeu_si128((__m128i*)dst8, _mm_or_si128(_mm_shuffle_epi8(a, maskA), _mm_shuffle_epi8(b, maskB)));
+  }
+  return done;
+}
+
+IQBITCONV_TARGET_AVX2 inline __m256i packPairs(__m256i x)
+{
+  return _mm256_or_si256(_mm256_srli_epi32(_mm256_and_si256(x, _mm256_set1_epi32(0x0000FFF0)), 4),
+                         _mm256_srli_epi32(_mm256_and_si256(x, _mm256_set1_epi32((int)0xFFF00000)), 8));
+}
+
+IQBITCONV_TARGET_AVX2 size_t conv16to12Avx2(const uint16_t* src16, uint8_t* dst8, size_t count)
+{
+  const __m256i maskA = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                         0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  const __m256i maskB = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 12, 13, 14, -1,
+                                         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 12, 13, 14, -1);
+  const size_t srcBytes = SAMPLES_REAL12_PER_DIGIQ_WORD * sizeof(uint16_t);
+
+  size_t done = 0;
+  // process a DIGIQ word (two half words in the two lanes) per loop
+  for (; done + srcBytes <= count; done += srcBytes, src16 += SAMPLES_REAL12_PER_DIGIQ_WORD, dst8 += DIGIQ_WORD_SIZE)
+  {
+    __m256i a = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)src16)), _mm_loadu_si128((const __m128i*)(src16 + halfWordSamples)), 1);
+    __m256i b = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(src16 + 2))), _mm_loadu_si128((const __m128i*)(src16 + halfWordSamples + 2)), 1);
+    a = _mm256_shuffle_epi8(packPairs(a), maskA);
+    b = _mm256_shuffle_epi8(packPairs(b), maskB);
+    _mm256_storeu_si256((__m256i*)dst8, _mm256_or_si256(a, b));
+  }
+  return done;
+}
+
+IQBITCONV_TARGET_AVX512VBMI inline __m512i packPairs(__m512i x)
+{
+  return _mm512_or_si512(_mm512_srli_epi32(_mm512_and_si512(x, _mm512_set1_epi32(0x0000FFF0)), 4),
+                         _mm512_srli_epi32(_mm512_and_si512(x, _mm512_set1_epi32((int)0xFFF00000)), 8));
+}
+
+IQBITCONV_TARGET_AVX512VBMI size_t conv16to12Avx512Vbmi(const uint16_t* src16, uint8_t* dst8, size_t count)
+{
+  const __m512i index = _mm512_loadu_si512(tables.packZmmIndex);
+  // clear the padding byte of each half word
+  const __mmask64 padMask = 0x7FFF7FFF7FFF7FFFULL;
+  const size_t srcBytes = 2 * SAMPLES_REAL12_PER_DIGIQ_WORD * sizeof(uint16_t);
+
+  size_t done = 0;
+  // process two DIGIQ words (40 samples from a full and a masked load) per loop
+  for (; done + srcBytes <= count; done += srcBytes, src16 += 2 * SAMPLES_REAL12_PER_DIGIQ_WORD, dst8 += 2 * DIGIQ_WORD_SIZE)
+  {
+    __m512i a = packPairs(_mm512_loadu_si512(src16));
+    __m512i b = packPairs(_mm512_maskz_loadu_epi16(0xFF, src16 + 32));
+    _mm512_storeu_si512(dst8, _mm512_maskz_permutex2var_epi8(padMask, a, index, b));
+  }
+  return done;
+}
+
+// The float to int16 kernels clamp before the truncating conversion, so that values out of range saturate
+// instead of becoming INT32_MIN. max(x, lo) returns lo for NaN like the scalar path.
+
+IQBITCONV_TARGET_SSE41 inline __m128i floatToInt32(const float* src, __m128 scale)
+{
+  __m128 x = _mm_mul_ps(_mm_loadu_ps(src), scale);
+  x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-32768.0f)), _mm_set1_ps(32767.0f));
+  return _mm_cvttps_epi32(x);
+}
+
+IQBITCONV_TARGET_SSE41 size_t convFloatToInt16Sse41(const float* src, int16_t* dst, size_t count, float scale)
+{
+  const __m128 vscale = _mm_set1_ps(scale);
+  size_t done = 0;
+  for (; done + 8 <= count; done += 8)
+  {
+    _mm_storeu_si128((__m128i*)(dst + done), _mm_packs_epi32(floatToInt32(src + done, vscale), floatToInt32(src + done + 4, vscale)));
+  }
+  return done;
+}
+
+IQBITCONV_TARGET_SSE41 size_t convFloatToInt16InterleavedSse41(const float* srcI, const float* srcQ, int16_t* dst, size_t pairs, float scale)
+{
+  const __m128 vscale = _mm_set1_ps(scale);
+  size_t done = 0;
+  for (; done + 8 <= pairs; done += 8)
+  {
+    const __m128i i = _mm_packs_epi32(floatToInt32(srcI + done, vscale), floatToInt32(srcI + done + 4, vscale));
+    const __m128i q = _mm_packs_epi32(floatToInt32(srcQ + done, vscale), floatToInt32(srcQ + done + 4, vscale));
+    _mm_storeu_si128((__m128i*)(dst + 2 * done), _mm_unpacklo_epi16(i, q));
+    _mm_storeu_si128((__m128i*)(dst + 2 * done + 8), _mm_unpackhi_epi16(i, q));
+  }
+  return done;
+}
+
+IQBITCONV_TARGET_AVX2 inline __m256i floatToInt32(const float* src, __m256 scale)
+{
+  __m256 x = _mm256_mul_ps(_mm256_loadu_ps(src), scale);
+  x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-32768.0f)), _mm256_set1_ps(32767.0f));
+  return _mm256_cvttps_epi32(x);
+}
+
+IQBITCONV_TARGET_AVX2 size_t convFloatToInt16Avx2(const float* src, int16_t* dst, size_t count, float scale)
+{
+  const __m256 vscale = _mm256_set1_ps(scale);
+  size_t done = 0;
+  for (; done + 16 <= count; done += 16)
+  {
+    // the pack works per lane, restore the order of the 64 bit groups
+    const __m256i x = _mm256_packs_epi32(floatToInt32(src + done, vscale), floatToInt32(src + done + 8, vscale));
+    _mm256_storeu_si256((__m256i*)(dst + done), _mm256_permute4x64_epi64(x, 0xD8));
+  }
+  return done;
+}
+
+IQBITCONV_TARGET_AVX2 size_t convFloatToInt16InterleavedAvx2(const float* srcI, const float* srcQ, int16_t* dst, size_t pairs, float scale)
+{
+  const __m256 vscale = _mm256_set1_ps(scale);
+  size_t done = 0;
+  for (; done + 16 <= pairs; done += 16)
+  {
+    // per lane pack and unpack yield pairs 0..7 in the low and 8..15 in the high result
+    const __m256i i = _mm256_packs_epi32(floatToInt32(srcI + done, vscale), floatToInt32(srcI + done + 8, vscale));
+    const __m256i q = _mm256_packs_epi32(floatToInt32(srcQ + done, vscale), floatToInt32(srcQ + done + 8, vscale));
+    _mm256_storeu_si256((__m256i*)(dst + 2 * done), _mm256_unpacklo_epi16(i, q));
+    _mm256_storeu_si256((__m256i*)(dst + 2 * done + 16), _mm256_unpackhi_epi16(i, q));
+  }
+  return done;
+}
+
+IQBITCONV_TARGET_AVX512VBMI inline __m512i floatToInt32(const float* src, __m512 scale)
+{
+  __m512 x = _mm512_mul_ps(_mm512_loadu_ps(src), scale);
+  x = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(-32768.0f)), _mm512_set1_ps(32767.0f));
+  return _mm512_cvttps_epi32(x);
+}
+
+IQBITCONV_TARGET_AVX512VBMI size_t convFloatToInt16Avx512(const float* src, int16_t* dst, size_t count, float scale)
+{
+  const __m512 vscale = _mm512_set1_ps(scale);
+  const __m512i order = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+  size_t done = 0;
+  for (; done + 32 <= count; done += 32)
+  {
+    const __m512i x = _mm512_packs_epi32(floatToInt32(src + done, vscale), floatToInt32(src + done + 16, vscale));
+    _mm512_storeu_si512(dst + done, _mm512_permutexvar_epi64(order, x));
+  }
+  return done;
+}
+
+IQBITCONV_TARGET_AVX512VBMI size_t convFloatToInt16InterleavedAvx512(const float* srcI, const float* srcQ, int16_t* dst, size_t pairs, float scale)
+{
+  const __m512 vscale = _mm512_set1_ps(scale);
+  size_t done = 0;
+  for (; done + 32 <= pairs; done += 32)
+  {
+    const __m512i i = _mm512_packs_epi32(floatToInt32(srcI + done, vscale), floatToInt32(srcI + done + 16, vscale));
+    const __m512i q = _mm512_packs_epi32(floatToInt32(srcQ + done, vscale), floatToInt32(srcQ + done + 16, vscale));
+    _mm512_storeu_si512(dst + 2 * done, _mm512_unpacklo_epi16(i, q));
+    _mm512_storeu_si512(dst + 2 * done + 32, _mm512_unpackhi_epi16(i, q));
+  }
+  return done;
+}
+#endif
+
+} // namespace
+
+IqBitConverter::SimdLevel IqBitConverter::getSimdLevel()
+{
+  return static_cast<SimdLevel>(simdLevel.load(memory_order_relaxed));
+}
+
+IqBitConverter::SimdLevel IqBitConverter::getSupportedSimdLevel()
+{
+  return simdLevelMax;
+}
+
+bool IqBitConverter::setSimdLevel(SimdLevel level)
+{
+  if (level > simdLevelMax)
+  {
+    return false;
+  }
+  simdLevel.store(level, memory_order_relaxed);
+  return true;
+}
+
+ssize_t IqBitConverter::conv12to16(const void* src, const void* dst, size_t count)
+{
+  if (count % DIGIQ_WORD_SIZE)
+  {
+    return -1;
+  }
+
+  const uint8_t* src8 = (const uint8_t*)src;
+  uint16_t* dst16 = (uint16_t*)dst;
+  size_t done = 0;
+
+#ifdef IQBITCONV_X86
+  // every level processes what it can, the rest is left to the next lower level
+  const SimdLevel level = getSimdLevel();
+  if (level >= SimdAvx512Vbmi)
+  {
+    done += conv12to16Avx512Vbmi(src8 + done, dst16 + done / halfWordBytes * halfWordSamples, count - done);
+  }
+  if (level >= SimdAvx2)
+  {
+    done += conv12to16Avx2(src8 + done, dst16 + done / halfWordBytes * halfWordSamples, count - done);
+  }
+  if (level >= SimdSse41)
+  {
+    done += conv12to16Sse41(src8 + done, dst16 + done / halfWordBytes * halfWordSamples, count - done);
+  }
+#endif
+  if (done < count)
+  {
+    conv12to16_array(src8 + done, dst16 + done / halfWordBytes * halfWordSamples, count - done);
+  }
+  return count;
+}
+
+ssize_t IqBitConverter::conv16to12(const void* src, const void* dst, size_t count)
+{
+  const size_t srcBytes = halfWordSamples * sizeof(uint16_t);
+  if (count % (SAMPLES_REAL12_PER_DIGIQ_WORD * sizeof(uint16_t)))
+  {
+    return -1;
+  }
+
+  const uint16_t* src16 = (const uint16_t*)src;
+  uint8_t* dst8 = (uint8_t*)dst;
+  size_t done = 0;
+
+#ifdef IQBITCONV_X86
+  const SimdLevel level = getSimdLevel();
+  if (level >= SimdAvx512Vbmi)
+  {
+    done += conv16to12Avx512Vbmi(src16 + done / sizeof(uint16_t), dst8 + done / srcBytes * halfWordBytes, count - done);
+  }
+  if (level >= SimdAvx2)
+  {
+    done += conv16to12Avx2(src16 + done / sizeof(uint16_t), dst8 + done / srcBytes * halfWordBytes, count - done);
+  }
+  if (level >= SimdSse41)
+  {
+    done += conv16to12Sse41(src16 + done / sizeof(uint16_t), dst8 + done / srcBytes * halfWordBytes, count - done);
+  }
+#endif
+  if (done < count)
+  {
+    conv16to12_array(src16 + done / sizeof(uint16_t), dst8 + done / srcBytes * halfWordBytes, count - done);
+  }
+  return count;
+}
+
+size_t IqBitConverter::convFloatToInt16(const float* src, int16_t* dst, size_t count, float scale)
+{
+  size_t done = 0;
+
+#ifdef IQBITCONV_X86
+  const SimdLevel level = getSimdLevel();
+  if (level >= SimdAvx512Vbmi)
+  {
+    done += convFloatToInt16Avx512(src + done, dst + done, count - done, scale);
+  }
+  if (level >= SimdAvx2)
+  {
+    done += convFloatToInt16Avx2(src + done, dst + done, count - done, scale);
+  }
+  if (level >= SimdSse41)
+  {
+    done += convFloatToInt16Sse41(src + done, dst + done, count - done, scale);
+  }
+#endif
+  convFloatToInt16_array(src + done, dst + done, count - done, scale);
+  return count;
+}
+
+size_t IqBitConverter::convFloatToInt16Interleaved(const float* srcI, const float* srcQ, int16_t* dst, size_t pairs, float scale)
+{
+  size_t done = 0;
+
+#ifdef IQBITCONV_X86
+  const SimdLevel level = getSimdLevel();
+  if (level >= SimdAvx512Vbmi)
+  {
+    done += convFloatToInt16InterleavedAvx512(srcI + done, srcQ + done, dst + 2 * done, pairs - done, scale);
+  }
+  if (level >= SimdAvx2)
+  {
+    done += convFloatToInt16InterleavedAvx2(srcI + done, srcQ + done, dst + 2 * done, pairs - done, scale);
+  }
+  if (level >= SimdSse41)
+  {
+    done += convFloatToInt16InterleavedSse41(srcI + done, srcQ + done, dst + 2 * done, pairs - done, scale);
+  }
+#endif
+  convFloatToInt16Interleaved_array(srcI + done, srcQ + done, dst + 2 * done, pairs - done, scale);
+  return pairs;
+}
+
+} // namespace IQW
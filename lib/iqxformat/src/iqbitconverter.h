@@ -1,20 +1,9 @@
 #pragma once
 
-// set target cpu for IPC11/4
-#pragma GCC push_options
-#pragma GCC target ("sse4.2")
-
-// enable/disable intel intrinsics for IPC11/4
-#define IQBITCONV_ENABLE_INTRINSICS
-
 #include <stdio.h>
 #include <stdint.h>
 #include <math.h>
 
-#ifdef IQBITCONV_ENABLE_INTRINSICS
-#include <immintrin.h>
-#endif
-
 #ifdef __cplusplus
 namespace IQW
 {
@@ -74,14 +63,13 @@ static inline ssize_t conv16to12_srcsize(size_t count)
   }
 }
 
-#ifndef IQBITCONV_ENABLE_INTRINSICS
 /******************************************************************************
 * convert count src bytes of 12 bit digiq data to 16 bit dst by using arrays
 * count must be a multiple of 32 byte
 * on success, the number of src bytes processed is returned
 * on error, -1 is returned
 ******************************************************************************/
-static inline ssize_t __attribute__((optimize("Ofast"))) conv12to16(const void* src, const void* dst, size_t count)
+static inline ssize_t conv12to16_array(const void* src, const void* dst, size_t count)
 {
   uint8_t* src8 = (uint8_t*)src;
   uint16_t* dst16 = (uint16_t*)dst;
@@ -109,52 +97,6 @@ static inline ssize_t __attribute__((optimize("Ofast"))) conv12to16(const void*
   }
   return count;
 }
-#else
-/******************************************************************************
-* convert count src bytes of 12 bit digiq data to 16 bit dst by using intrinsics
-* count must be a multiple of 32 byte
-* on success, the number of src bytes processed is returned
-* on error, -1 is returned
-******************************************************************************/
-static inline ssize_t conv12to16(const void* src, const void* dst, size_t count)
-{
-  uint8_t* src8 = (uint8_t*)src;
-  uint16_t* dst16 = (uint16_t*)dst;
-  __m128i tmp128a, tmp128b, tmp128c, shuffle_mask, and_mask;
-
-  if (count % DIGIQ_WORD_SIZE)
-  {
-    return -1;
-  }
-
-  shuffle_mask = _mm_setr_epi8(0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11);
-  and_mask = _mm_setr_epi16(
-    (short)0xFFFF, (short)0xFFF0, (short)0xFFFF, (short)0xFFF0,
-    (short)0xFFFF, (short)0xFFF0, (short)0xFFFF, (short)0xFFF0);
-
-  // frame loop (process half a DIGIQ 256 bit word per loop)
-  for (src8 = (uint8_t*)src; src8 < (uint8_t*)src + count; src8 += DIGIQ_WORD_SIZE / 2)
-  {
-    // load and reorder bytes
-    tmp128a = _mm_load_si128((__m128i*)src8); // SSE2
-    tmp128b = _mm_shuffle_epi8(tmp128a, shuffle_mask); // SSSE3
-    // left shift 16bit integers by 4 bit (needed on even indices)
-    tmp128a = _mm_slli_epi16(tmp128b, 4); // SSE2
-    // interleave 16bit integers from even and odd indices
-    tmp128c = _mm_blend_epi16(tmp128a, tmp128b, 0xAA);  // SSE4.1
-    // clear lower nibble on odd indices
-    tmp128a = _mm_and_si128(tmp128c, and_mask);  // SSE2
-    // store
-    _mm_storeu_si128((__m128i*)dst16, tmp128a);  // SSE2
-    // convert indices 8..9
-    dst16[8] = *(uint16_t*)&src8[12] << 4;
-    dst16[9] = *(uint16_t*)&src8[13] & 0xFFF0;
-
-    dst16 += SAMPLES_REAL12_PER_DIGIQ_WORD / 2;
-  }
-  return count;
-}
-#endif
 
 /******************************************************************************
 * convert count src bytes of 2x12=24 bit digiq data to 32 bit lsb right aligned
@@ -219,12 +161,161 @@ static inline ssize_t conv16to12_array(const void* src, const void* dst, size_t
   return count;
 }
 
+/******************************************************************************
+* convert a float value scaled by scale to int16 with saturation. The value is
+* truncated towards zero, NaN is converted to INT16_MIN
+******************************************************************************/
+static inline int16_t convFloatToInt16_value(float value, float scale)
+{
+  float scaled = value * scale;
+  if (!(scaled > -32768.0f))
+  {
+    return -32768;
+  }
+  if (scaled > 32767.0f)
+  {
+    return 32767;
+  }
+  return (int16_t)scaled;
+}
+
+/******************************************************************************
+* convert a double value scaled by scale to int16 with saturation, see
+* convFloatToInt16_value
+******************************************************************************/
+static inline int16_t convDoubleToInt16_value(double value, double scale)
+{
+  double scaled = value * scale;
+  if (!(scaled > -32768.0))
+  {
+    return -32768;
+  }
+  if (scaled > 32767.0)
+  {
+    return 32767;
+  }
+  return (int16_t)scaled;
+}
+
+/******************************************************************************
+* convert count float values scaled by scale to int16 dst with saturation
+* the number of values processed is returned
+******************************************************************************/
+static inline size_t convFloatToInt16_array(const float* src, int16_t* dst, size_t count, float scale)
+{
+  size_t i;
+  for (i = 0; i < count; ++i)
+  {
+    dst[i] = convFloatToInt16_value(src[i], scale);
+  }
+  return count;
+}
+
+/******************************************************************************
+* convert pairs I and Q float values scaled by scale to interleaved int16 dst
+* (IQIQ...) with saturation
+* the number of pairs processed is returned
+******************************************************************************/
+static inline size_t convFloatToInt16Interleaved_array(const float* srcI, const float* srcQ, int16_t* dst, size_t pairs, float scale)
+{
+  size_t i;
+  for (i = 0; i < pairs; ++i)
+  {
+    dst[2 * i] = convFloatToInt16_value(srcI[i], scale);
+    dst[2 * i + 1] = convFloatToInt16_value(srcQ[i], scale);
+  }
+  return pairs;
+}
+
+/******************************************************************************
+* convert count double values scaled by scale to int16 dst with saturation
+* the number of values processed is returned
+******************************************************************************/
+static inline size_t convDoubleToInt16_array(const double* src, int16_t* dst, size_t count, double scale)
+{
+  size_t i;
+  for (i = 0; i < count; ++i)
+  {
+    dst[i] = convDoubleToInt16_value(src[i], scale);
+  }
+  return count;
+}
+
+/******************************************************************************
+* convert pairs I and Q double values scaled by scale to interleaved int16 dst
+* (IQIQ...) with saturation
+* the number of pairs processed is returned
+******************************************************************************/
+static inline size_t convDoubleToInt16Interleaved_array(const double* srcI, const double* srcQ, int16_t* dst, size_t pairs, double scale)
+{
+  size_t i;
+  for (i = 0; i < pairs; ++i)
+  {
+    dst[2 * i] = convDoubleToInt16_value(srcI[i], scale);
+    dst[2 * i + 1] = convDoubleToInt16_value(srcQ[i], scale);
+  }
+  return pairs;
+}
+
 #ifdef __cplusplus
+/******************************************************************************
+* instruction set extensions used by conv12to16 and conv16to12. The best
+* level supported by the cpu is selected when the library is loaded.
+******************************************************************************/
+enum SimdLevel
+{
+  SimdNone,       ///< scalar conversion only
+  SimdSse41,      ///< SSSE3 shuffle and SSE4.1 blend
+  SimdAvx2,       ///< 256 bit shuffle and blend
+  SimdAvx512Vbmi  ///< AVX-512 BW with VBMI byte permutation
+};
+
+/// @brief get the instruction set level used for the conversions
+static SimdLevel getSimdLevel();
+
+/// @brief get the best instruction set level supported by the cpu
+static SimdLevel getSupportedSimdLevel();
+
+/// @brief restrict the conversions to a instruction set level, e.g. for comparisons with the scalar path.
+/// returns false if the level is not supported by the cpu
+static bool setSimdLevel(SimdLevel level);
+
+/******************************************************************************
+* convert count src bytes of 12 bit digiq data to 16 bit dst with the
+* instruction set level selected at load time, see conv12to16_array
+* count must be a multiple of 32 byte
+* on success, the number of src bytes processed is returned
+* on error, -1 is returned
+******************************************************************************/
+static ssize_t conv12to16(const void* src, const void* dst, size_t count);
+
+/******************************************************************************
+* convert count src bytes of 16 bit digiq data to 12 bit dst with the
+* instruction set level selected at load time, see conv16to12_array
+* count must be a multiple of SAMPLES_REAL12_PER_DIGIQ_WORD * sizeof(uint16_t)
+* = 40 byte
+* on success, the number of src bytes processed is returned
+* on error, -1 is returned
+******************************************************************************/
+static ssize_t conv16to12(const void* src, const void* dst, size_t count);
+
+/******************************************************************************
+* convert count float values scaled by scale to int16 dst with saturation and
+* the instruction set level selected at load time, see convFloatToInt16_array
+* the number of values processed is returned
+******************************************************************************/
+static size_t convFloatToInt16(const float* src, int16_t* dst, size_t count, float scale);
+
+/******************************************************************************
+* convert pairs I and Q float values scaled by scale to interleaved int16 dst
+* with saturation and the instruction set level selected at load time, see
+* convFloatToInt16Interleaved_array
+* the number of pairs processed is returned
+******************************************************************************/
+static size_t convFloatToInt16Interleaved(const float* srcI, const float* srcQ, int16_t* dst, size_t pairs, float scale);
 };
 #endif
 
 #ifdef __cplusplus
 } // namespace
 #endif
-
-#pragma GCC push_options
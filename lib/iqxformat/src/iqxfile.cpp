@@ -38,8 +38,8 @@ bool IqxFile::isIqxFile(const string& filename)
   return IqxFileImpl::isIqxFile(filename);
 }
 
-IqxFile::IqxFile(const string& filename, bool edit)
-  : m_pimpl(new IqxFileImpl(filename, edit))
+IqxFile::IqxFile(const string& filename, bool edit, bool cueIndexFile)
+  : m_pimpl(new IqxFileImpl(filename, edit, cueIndexFile))
 {}
 
 IqxFile::IqxFile(int fd)
@@ -62,6 +62,11 @@ IqxFile::operator int()
   return m_pimpl->operator int();
 }
 
+int64_t IqxFile::readAt(iqx_off_t offset, void* buffer, size_t bytes) const
+{
+  return m_pimpl->readAt(offset, buffer, bytes);
+}
+
 size_t IqxFile::getPayloadOffset() const
 {
   return m_pimpl->getPayloadOffset();
@@ -186,6 +191,11 @@ void IqxFile::writeDataFrame(int64_t streamno, int64_t sequenceno, std::vector<i
 	m_pimpl->writeDataFrame(streamno, sequenceno, data);
 }
 
+void IqxFile::writeDataFrame(int64_t streamno, int64_t sequenceno, const int16_t* data, size_t values)
+{
+	m_pimpl->writeDataFrame(streamno, sequenceno, data, values);
+}
+
 void IqxFile::setDuration(iqx_timespec duration)
 {
     m_pimpl->setDuration(duration);
@@ -24,8 +24,13 @@
 #include <fcntl.h>
 #ifdef _WIN32
 #include <io.h>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
 #include "wincompat.h"
 #else
+#include <sys/uio.h>
 #include <unistd.h>
 #endif
 #include <sys/stat.h>
@@ -33,6 +38,9 @@
 #ifndef _WIN32
 #include <uuid/uuid.h>
 #endif
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
 #include <cstring>
 #include <memory>
 #include <stdexcept>
@@ -40,12 +48,38 @@
 
 #include "iqxformat/iqxfile.h"
 #include "iqxformat/iqxtypes.h"
+#include "iqbitconverter.h"
 
 namespace IQW
 {
 
 using namespace std;
 
+/// buffer size used to scan the frame preambles of files without cue frame
+#define IQX_SCAN_BUFFER_SIZE (4 * 1024 * 1024)
+/// file extension of the cue index sidecar file
+#define IQX_CUE_INDEX_FILE_EXTENSION ".iqxcue"
+/// version of the cue index sidecar file
+#define IQX_CUE_INDEX_FILE_VERSION 1
+/// magic number of the cue index sidecar file
+const char iqxcueindexmagic[8] = {'I', 'Q', 'X', 'C', 'U', 'E', 0, 0};
+
+/// @brief header of the cue index sidecar file, followed by the number of frames and samples
+/// of each stream (uint64_t) and the cue entries
+typedef struct
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t entrysize;
+  uint64_t filesize;
+  iqx_off_t payloadoffset;
+  iqx_off_t epilogoffset;
+  iqx_uuid uuid;
+  uint32_t nstreams;
+  uint32_t reserved;
+  uint64_t numentries;
+} IqxCueIndexFileHeader;
+
 bool IqxFileImpl::isIqxFile(const string& filename)
 {
   try
@@ -59,12 +93,14 @@ bool IqxFileImpl::isIqxFile(const string& filename)
   return true;
 }
 
-IqxFileImpl::IqxFileImpl(const string& filename, bool edit)
+IqxFileImpl::IqxFileImpl(const string& filename, bool edit, bool cueIndexFile)
 #ifndef _WIN32
   : m_fd(portable_open(filename.c_str(), (edit == true)? O_RDWR : O_RDONLY))
 #else
   : m_fd(portable_open(filename.c_str(), ((edit == true)? O_RDWR : O_RDONLY) | O_BINARY))
 #endif
+  , m_filename(filename)
+  , m_cueIndexFile(cueIndexFile)
 {
   initRead(edit);
 }
@@ -81,6 +117,7 @@ void IqxFileImpl::initRead(bool edit)
   m_write = false;  
   m_edit = edit;
   m_cueNoOfEntries = 0;
+  m_streamCuesValid = false;
   m_trigNoOfEntries = 0;
   m_overrunNoOfEntries = 0;
   m_hasOverrun = false;
@@ -154,6 +191,7 @@ void IqxFileImpl::initWrite(const string& descname, const vector<pair<string, Iq
   }
   m_write = true;
   m_cueNoOfEntries = 0;
+  m_streamCuesValid = false;
   m_trigNoOfEntries = 0;
   m_overrunNoOfEntries = 0;
   ALIGNED_VAR(IqxFileDescHeader, header) = {0};
@@ -255,6 +293,48 @@ IqxFileImpl::operator int()
   return m_fd;
 }
 
+int64_t IqxFileImpl::readAt(iqx_off_t offset, void* buffer, size_t bytes) const
+{
+  uint8_t* dst = static_cast<uint8_t*>(buffer);
+  size_t done = 0;
+  while (done < bytes)
+  {
+#ifdef _WIN32
+    // ReadFile with an explicit offset does not depend on the file position shared with other threads
+    OVERLAPPED overlapped = {0};
+    const uint64_t pos = static_cast<uint64_t>(offset) + done;
+    overlapped.Offset = static_cast<DWORD>(pos);
+    overlapped.OffsetHigh = static_cast<DWORD>(pos >> 32);
+    DWORD chunk = static_cast<DWORD>(min<size_t>(bytes - done, 0x40000000));
+    DWORD res = 0;
+    if (!ReadFile(reinterpret_cast<HANDLE>(_get_osfhandle(m_fd)), dst + done, chunk, &res, &overlapped))
+    {
+      if (GetLastError() == ERROR_HANDLE_EOF)
+      {
+        break;
+      }
+      return -1;
+    }
+#else
+    ssize_t res = pread(m_fd, dst + done, bytes - done, offset + done);
+    if (res < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return -1;
+    }
+#endif
+    if (res == 0)
+    {
+      break;
+    }
+    done += res;
+  }
+  return static_cast<int64_t>(done);
+}
+
 size_t IqxFileImpl::getPayloadOffset() const
 {
   return static_cast<size_t>(m_fileDescFrame.header().payloadoffset);
@@ -544,56 +624,176 @@ void IqxFileImpl::readIqFrameData()
       m_iqStreamNoOfFrames[m_cues[i].streamnum]++;
     }
   }
-  else
+  else if (!m_cueIndexFile || !loadCueIndexFile())
   {
-    iqx_off_t offset = portable_lseek(m_fd, m_fileDescFrame.header().payloadoffset, SEEK_SET);
-
-    for (bool eof = false; !eof;)
+    scanIqFrames();
+    if (m_cueIndexFile)
     {
-      ALIGNED_VAR(IqxPreamble, preamble) = {0};
+      storeCueIndexFile();
+    }
+  }
 
-      if (read(m_fd, &preamble, sizeof(IqxPreamble)) < static_cast<ssize_t>(sizeof(IqxPreamble)) )
+  buildCueIndex();
+}
+
+void IqxFileImpl::scanIqFrames()
+{
+  // the preambles of small frames are taken from one large read, frames larger than the buffer
+  // are skipped with a single preamble read instead of a read and a seek per frame
+  vector<uint8_t, AlignedAllocator<uint8_t, IQX_DATA_ALIGNMENT> > buffer(IQX_SCAN_BUFFER_SIZE);
+  iqx_off_t bufferOffset = 0;
+  size_t bufferBytes = 0;
+  uint64_t lastFrameSize = 0;
+  iqx_off_t offset = m_fileDescFrame.header().payloadoffset;
+
+  for (bool eof = false; !eof;)
+  {
+    if ((offset < bufferOffset) || (static_cast<uint64_t>(offset - bufferOffset) + sizeof(IqxPreamble) > bufferBytes))
+    {
+      size_t bytes = (lastFrameSize >= buffer.size()) ? sizeof(IqxPreamble) : buffer.size();
+      portable_lseek(m_fd, offset, SEEK_SET);
+      ssize_t res = read(m_fd, &buffer[0], bytes);
+      bufferOffset = offset;
+      bufferBytes = (res > 0) ? static_cast<size_t>(res) : 0;
+      if (bufferBytes < sizeof(IqxPreamble))
       {
         throw iqxformat_error("frame incomplete");
       }
+    }
 
-      if (memcmp(preamble.sync, iqxsync, sizeof(iqxsync)) != 0)
-      {
-        throw iqxformat_error("wrong frame magic number");
-      }
-      // remeber the filepos and
-      // skip rest of frame
-      iqx_off_t newOffset = portable_lseek(m_fd, preamble.framesize - sizeof(IqxPreamble), SEEK_CUR);
+    const IqxPreamble& preamble = *reinterpret_cast<const IqxPreamble*>(&buffer[static_cast<size_t>(offset - bufferOffset)]);
+    if (memcmp(preamble.sync, iqxsync, sizeof(iqxsync)) != 0)
+    {
+      throw iqxformat_error("wrong frame magic number");
+    }
+    if (preamble.framesize < sizeof(IqxPreamble))
+    {
+      throw iqxformat_error("frame size too small");
+    }
 
-      switch (preamble.frametype)
-      {
-      case IQX_FRAME_TYPE_IQDATA:
-      {
-        // create cue entry, so that mosaik can always workwith cues
-        IqxCueEntry cue;
-        cue.streamnum = preamble.streamnum;
-        cue.offset = offset;
-        offset = newOffset;
-        cue.timestamp = getTimestampFromSample(static_cast<size_t>(cue.streamnum), m_iqStreamNoOfSamples[preamble.streamnum]);
-        addCueEntry(cue);
-
-        // calculate frames/stream samples/stream
-        m_iqStreamNoOfFrames[preamble.streamnum]++;
-
-        // calculate number of samples
-        IqxStreamType strtype = getStreamType(preamble.streamnum);
-        m_iqStreamNoOfSamples[preamble.streamnum] += (strtype == IQX_STREAM_TYPE_IQDATA16) ? (preamble.datasize / 4) : (static_cast<float>(preamble.datasize) / 3 * 240 / 256);
-        break;
-      }
-      case IQX_FRAME_TYPE_PAYLOADEND:
-      {
-        eof = true;
-        break;
-      }
-      default:
-        break;
-      }
+    switch (preamble.frametype)
+    {
+    case IQX_FRAME_TYPE_IQDATA:
+    {
+      // create cue entry, so that mosaik can always workwith cues
+      IqxCueEntry cue;
+      cue.streamnum = preamble.streamnum;
+      cue.offset = offset;
+      cue.timestamp = getTimestampFromSample(static_cast<size_t>(cue.streamnum), m_iqStreamNoOfSamples[preamble.streamnum]);
+      addCueEntry(cue);
+
+      // calculate frames/stream samples/stream
+      m_iqStreamNoOfFrames[preamble.streamnum]++;
+
+      // calculate number of samples
+      IqxStreamType strtype = getStreamType(preamble.streamnum);
+      m_iqStreamNoOfSamples[preamble.streamnum] += (strtype == IQX_STREAM_TYPE_IQDATA16) ? (preamble.datasize / 4) : (preamble.datasize / DIGIQ_WORD_SIZE * SAMPLES_COMPLEX12_PER_DIGIQ_WORD);
+      break;
+    }
+    case IQX_FRAME_TYPE_PAYLOADEND:
+    {
+      eof = true;
+      break;
     }
+    default:
+      break;
+    }
+
+    lastFrameSize = preamble.framesize;
+    offset += preamble.framesize;
+  }
+}
+
+bool IqxFileImpl::loadCueIndexFile()
+{
+  struct portable_stat st = {0};
+  if (m_filename.empty() || portable_fstat(m_fd, &st))
+  {
+    return false;
+  }
+  FILE* file = fopen((m_filename + IQX_CUE_INDEX_FILE_EXTENSION).c_str(), "rb");
+  if (file == nullptr)
+  {
+    return false;
+  }
+
+  const IqxFileDescHeader& desc = m_fileDescFrame.header();
+  const size_t nstreams = desc.nstreams;
+  IqxCueIndexFileHeader header = {};
+  bool valid = (fread(&header, 1, sizeof(header), file) == sizeof(header))
+    && (memcmp(header.magic, iqxcueindexmagic, sizeof(header.magic)) == 0)
+    && (header.version == IQX_CUE_INDEX_FILE_VERSION)
+    && (header.entrysize == sizeof(IqxCueEntry))
+    && (header.filesize == static_cast<uint64_t>(st.st_size))
+    && (header.payloadoffset == desc.payloadoffset)
+    && (header.epilogoffset == desc.epilogoffset)
+    && (memcmp(header.uuid, desc.uuid, sizeof(header.uuid)) == 0)
+    && (header.nstreams == nstreams)
+    && (header.numentries <= MAX_CUE_ENTRIES);
+
+  vector<IqxCueEntry> cues;
+  if (valid)
+  {
+    cues.resize(static_cast<size_t>(header.numentries));
+    valid = (fread(&m_iqStreamNoOfFrames[0], sizeof(uint64_t), nstreams, file) == nstreams)
+      && (fread(&m_iqStreamNoOfSamples[0], sizeof(uint64_t), nstreams, file) == nstreams)
+      && (cues.empty() || (fread(&cues[0], sizeof(IqxCueEntry), cues.size(), file) == cues.size()));
+  }
+  fclose(file);
+
+  // the entries have to reference data frames of existing streams within the payload
+  for (size_t i = 0; valid && i < cues.size(); ++i)
+  {
+    valid = (cues[i].streamnum >= 0) && (static_cast<size_t>(cues[i].streamnum) < nstreams)
+      && (cues[i].offset >= desc.payloadoffset) && (cues[i].offset < desc.epilogoffset);
+  }
+
+  if (!valid)
+  {
+    fill(m_iqStreamNoOfFrames.begin(), m_iqStreamNoOfFrames.end(), 0);
+    fill(m_iqStreamNoOfSamples.begin(), m_iqStreamNoOfSamples.end(), 0);
+    return false;
+  }
+  m_cues.assign(cues.begin(), cues.end());
+  m_cueNoOfEntries = cues.size();
+  return true;
+}
+
+void IqxFileImpl::storeCueIndexFile() const
+{
+  struct portable_stat st = {0};
+  if (m_filename.empty() || portable_fstat(m_fd, &st))
+  {
+    return;
+  }
+  FILE* file = fopen((m_filename + IQX_CUE_INDEX_FILE_EXTENSION).c_str(), "wb");
+  if (file == nullptr)
+  {
+    return;
+  }
+
+  const IqxFileDescHeader& desc = m_fileDescFrame.header();
+  IqxCueIndexFileHeader header = {};
+  memcpy(header.magic, iqxcueindexmagic, sizeof(header.magic));
+  header.version = IQX_CUE_INDEX_FILE_VERSION;
+  header.entrysize = sizeof(IqxCueEntry);
+  header.filesize = static_cast<uint64_t>(st.st_size);
+  header.payloadoffset = desc.payloadoffset;
+  header.epilogoffset = desc.epilogoffset;
+  memcpy(header.uuid, desc.uuid, sizeof(header.uuid));
+  header.nstreams = desc.nstreams;
+  header.numentries = m_cueNoOfEntries;
+
+  bool ok = (fwrite(&header, 1, sizeof(header), file) == sizeof(header))
+    && (fwrite(&m_iqStreamNoOfFrames[0], sizeof(uint64_t), m_iqStreamNoOfFrames.size(), file) == m_iqStreamNoOfFrames.size())
+    && (fwrite(&m_iqStreamNoOfSamples[0], sizeof(uint64_t), m_iqStreamNoOfSamples.size(), file) == m_iqStreamNoOfSamples.size())
+    && ((m_cueNoOfEntries == 0) || (fwrite(&m_cues[0], sizeof(IqxCueEntry), m_cueNoOfEntries, file) == m_cueNoOfEntries));
+  fclose(file);
+
+  if (!ok)
+  {
+    // never leave a truncated sidecar behind
+    remove((m_filename + IQX_CUE_INDEX_FILE_EXTENSION).c_str());
   }
 }
 
@@ -640,34 +840,72 @@ void IqxFileImpl::writeFrame(IqxPreamble& preamble, const void* head, const void
   // Frame size if always a multiple of 4k. Tail is zero for now
   preamble.framesize = IQX_PREAMBLESIZE + preamble.headsize + preamble.datasize;
 
-  if (write(m_fd, &preamble, sizeof(IqxPreamble)) < (static_cast<ssize_t>(sizeof(IqxPreamble))))
+  // consecutive parts are written with a single system call, missing parts are skipped by seeking
+  const void* parts[] = { &preamble, head, data };
+  const size_t sizes[] = { sizeof(IqxPreamble), static_cast<size_t>(preamble.headsize), static_cast<size_t>(preamble.datasize) };
+  const size_t nparts = sizeof(parts) / sizeof(parts[0]);
+  size_t first = 0;
+  for (size_t part = 0; part <= nparts; ++part)
   {
-    throw iqxformat_error(strerror(errno));
+    if (part == nparts || parts[part] == nullptr)
+    {
+      writeParts(&parts[first], &sizes[first], part - first);
+      if (part < nparts)
+      {
+        portable_lseek(m_fd, sizes[part], SEEK_CUR);
+      }
+      first = part + 1;
+    }
   }
+}
 
-  if (head != nullptr)
+void IqxFileImpl::writeParts(const void* const* parts, const size_t* sizes, size_t count)
+{
+#ifdef _WIN32
+  for (size_t part = 0; part < count; ++part)
   {
-    if (write(m_fd, head, (size_t)preamble.headsize) < (static_cast<ssize_t>(preamble.headsize)))
+    if (write(m_fd, parts[part], static_cast<unsigned int>(sizes[part])) < static_cast<int>(sizes[part]))
     {
       throw iqxformat_error(strerror(errno));
     }
   }
-  else
+#else
+  struct iovec iov[3];
+  if (count > sizeof(iov) / sizeof(iov[0]))
+  {
+    throw iqxformat_error("too many frame parts");
+  }
+  for (size_t part = 0; part < count; ++part)
   {
-     portable_lseek(m_fd, preamble.headsize, SEEK_CUR);
+    iov[part].iov_base = const_cast<void*>(parts[part]);
+    iov[part].iov_len = sizes[part];
   }
 
-  if (data != nullptr)
+  size_t first = 0;
+  while (first < count)
   {
-    if (write(m_fd, data, (size_t)preamble.datasize) < (static_cast<ssize_t>(preamble.datasize)))
+    ssize_t written = writev(m_fd, &iov[first], static_cast<int>(count - first));
+    if (written < 0 && errno == EINTR)
     {
-      throw iqxformat_error(strerror(errno));
+      continue;
+    }
+    if (written <= 0)
+    {
+      throw iqxformat_error(written < 0 ? strerror(errno) : "write failed");
+    }
+    // continue a partial write behind the last byte written
+    while (first < count && static_cast<size_t>(written) >= iov[first].iov_len)
+    {
+      written -= iov[first].iov_len;
+      ++first;
+    }
+    if (first < count)
+    {
+      iov[first].iov_base = static_cast<uint8_t*>(iov[first].iov_base) + written;
+      iov[first].iov_len -= written;
     }
   }
-  else
-  {
-    portable_lseek(m_fd, preamble.datasize, SEEK_CUR);
-  }
+#endif
 }
 
 void IqxFileImpl::writeFileDescriptionFrame(IqxFileDescHeader& header, const void* data)
@@ -709,6 +947,7 @@ void IqxFileImpl::writeIqStreamDescriptionFrame(size_t streamNumber, const strin
   header.framesize_min = preamble.framesize; // TODO
   header.framesize_max = preamble.framesize; // TODO
   header.type = (iqStreamDescriptor.resolution == 16) ? IQX_STREAM_TYPE_IQDATA16 : IQX_STREAM_TYPE_IQDATA12;
+  m_streams[streamNumber] = header.type;
 
   ALIGNED_VAR(IqxStreamDescDataIQ, iqdata) = {0};
   memcpy(&iqdata, &iqStreamDescriptor, sizeof(IqxStreamDescDataIQ));
@@ -773,16 +1012,32 @@ void IqxFileImpl::writeEofFrame()
 }
 
 void IqxFileImpl::writeDataFrame(int64_t streamno, int64_t sequenceno, vector<int16_t>& data)
+{
+  writeDataFrame(streamno, sequenceno, data.data(), data.size());
+}
+
+void IqxFileImpl::writeDataFrame(int64_t streamno, int64_t sequenceno, const int16_t* data, size_t values)
 {
   ALIGNED_VAR(IqxPreamble, preamble) = {0};
   memcpy(&preamble.sync[0], iqxsync, sizeof(iqxsync));
   preamble.streamnum = static_cast<int32_t>(streamno);
-  preamble.datasize = data.size() * 2;
+  preamble.datasize = values * sizeof(int16_t);
   preamble.frametype = IQX_FRAME_TYPE_IQDATA;
   preamble.headsize =  max(sizeof(IqxIqDataHeader), static_cast<size_t>(IQX_HEADSIZE_MIN));
   //preamble.previousframesize = ;
   preamble.timestamp = m_duration;
-  m_samples[streamno] += data.size() / 2;
+
+  size_t pairs = values / 2;
+  const void* payload = data;
+  auto type = m_streams.find(static_cast<size_t>(streamno));
+  if ((type != m_streams.end()) && (type->second == IQX_STREAM_TYPE_IQDATA12))
+  {
+    payload = packDataFrame12(data, values);
+    // readers derive the sample count from the data size, so the padding of the last DIGIQ word counts as well
+    pairs = m_packBuffer.size() / DIGIQ_WORD_SIZE * SAMPLES_COMPLEX12_PER_DIGIQ_WORD;
+    preamble.datasize = m_packBuffer.size();
+  }
+  m_samples[streamno] += pairs;
   if (m_streamSampleRate[streamno] > 0)
   {
     float64_t duration = m_samples[streamno] / m_streamSampleRate[streamno];
@@ -792,7 +1047,28 @@ void IqxFileImpl::writeDataFrame(int64_t streamno, int64_t sequenceno, vector<in
   }
   ALIGNED_VAR(IqxIqDataHeader, datahead) = {0};
   datahead.sequencenum = sequenceno;
-  writeFrame(preamble, &datahead, &data[0], nullptr);
+  writeFrame(preamble, &datahead, payload, nullptr);
+}
+
+const void* IqxFileImpl::packDataFrame12(const int16_t* data, size_t values)
+{
+  const size_t wordValues = SAMPLES_REAL12_PER_DIGIQ_WORD;
+  const size_t fullWords = values / wordValues;
+  const size_t words = (values + wordValues - 1) / wordValues;
+  m_packBuffer.resize(words * DIGIQ_WORD_SIZE);
+
+  if (fullWords > 0)
+  {
+    IqBitConverter::conv16to12(data, m_packBuffer.data(), fullWords * wordValues * sizeof(int16_t));
+  }
+  if (words > fullWords)
+  {
+    // a partial DIGIQ word is padded with zero samples
+    int16_t last[SAMPLES_REAL12_PER_DIGIQ_WORD] = {0};
+    memcpy(last, data + fullWords * wordValues, (values - fullWords * wordValues) * sizeof(int16_t));
+    IqBitConverter::conv16to12_array(last, m_packBuffer.data() + fullWords * DIGIQ_WORD_SIZE, sizeof(last));
+  }
+  return m_packBuffer.data();
 }
 
 void IqxFileImpl::writeTagFrame(const char* tag)
@@ -1102,6 +1378,7 @@ void IqxFileImpl::addCueEntry(IqxCueEntry& cue)
   {
     m_cues.push_back(cue);
     ++m_cueNoOfEntries;
+    m_streamCuesValid = false;
   }
 }
 
@@ -1119,16 +1396,63 @@ vector<IqxCueEntry> IqxFileImpl::getCues(size_t streamno)
   return result;
 }
 
+uint64_t IqxFileImpl::getCuePosition(size_t streamno, const iqx_timespec& timestamp)
+{
+  if (streamno < m_streamSources.size() && m_iqProperties.count(m_streamSources[streamno]) > 0)
+  {
+    return getSampleFromTimestamp(streamno, timestamp);
+  }
+  return static_cast<uint64_t>(timestamp.tv_sec) * 1000000000ULL + static_cast<uint64_t>(timestamp.tv_nsec);
+}
+
+void IqxFileImpl::buildCueIndex()
+{
+  size_t nstreams = m_streamSources.size();
+  for (size_t i = 0; i < m_cueNoOfEntries; ++i)
+  {
+    nstreams = portable_max(nstreams, static_cast<size_t>(m_cues[i].streamnum) + 1);
+  }
+
+  vector<vector<pair<uint64_t, IqxCueEntry>>> sorted(nstreams);
+  for (size_t i = 0; i < m_cueNoOfEntries; ++i)
+  {
+    const size_t streamno = static_cast<size_t>(m_cues[i].streamnum);
+    sorted[streamno].emplace_back(getCuePosition(streamno, m_cues[i].timestamp), m_cues[i]);
+  }
+
+  m_streamCues.assign(nstreams, vector<IqxCueEntry>());
+  m_streamCuePositions.assign(nstreams, vector<uint64_t>());
+  for (size_t streamno = 0; streamno < nstreams; ++streamno)
+  {
+    // cues are usually written in order, so this is a linear pass in the common case
+    stable_sort(sorted[streamno].begin(), sorted[streamno].end(),
+      [](const pair<uint64_t, IqxCueEntry>& a, const pair<uint64_t, IqxCueEntry>& b) { return a.first < b.first; });
+
+    m_streamCues[streamno].reserve(sorted[streamno].size());
+    m_streamCuePositions[streamno].reserve(sorted[streamno].size());
+    for (const auto& entry : sorted[streamno])
+    {
+      m_streamCuePositions[streamno].push_back(entry.first);
+      m_streamCues[streamno].push_back(entry.second);
+    }
+  }
+  m_streamCuesValid = true;
+}
+
 IqxCueEntry IqxFileImpl::getCueEntry(size_t streamno, iqx_timespec timestamp)
 {
-  double time = timestamp.tv_sec + timestamp.tv_nsec * 1e-9;
-  vector<IqxCueEntry> cues = getCues(streamno);
-  for (int64_t i = m_cueNoOfEntries - 1; i >= 0; i--)
+  if (!m_streamCuesValid)
+  {
+    buildCueIndex();
+  }
+  if (streamno < m_streamCuePositions.size())
   {
-    double timeOfFrame = cues[i].timestamp.tv_sec + cues[i].timestamp.tv_nsec * 1e-9;
-    if (time >= timeOfFrame)
+    // last cue entry at or before the given position
+    const vector<uint64_t>& positions = m_streamCuePositions[streamno];
+    auto it = upper_bound(positions.begin(), positions.end(), getCuePosition(streamno, timestamp));
+    if (it != positions.begin())
     {
-      return cues[i];
+      return m_streamCues[streamno][static_cast<size_t>(it - positions.begin()) - 1];
     }
   }
   throw iqxformat_error("no matching cue entry found at given timestamp");
@@ -1136,15 +1460,18 @@ IqxCueEntry IqxFileImpl::getCueEntry(size_t streamno, iqx_timespec timestamp)
 
 IqxCueEntry IqxFileImpl::getNextCueEntry(size_t streamno, iqx_timespec timestamp)
 {
-  double time = timestamp.tv_sec + timestamp.tv_nsec * 1e-9;
-  vector<IqxCueEntry> cues = getCues(streamno);
-  for (size_t i = 0; i < m_cueNoOfEntries-1; i++)
+  if (!m_streamCuesValid)
+  {
+    buildCueIndex();
+  }
+  if (streamno < m_streamCuePositions.size())
   {
-    double timeOfFrame = cues[i].timestamp.tv_sec + cues[i].timestamp.tv_nsec * 1e-9;
-    double timeOfNextFrame = cues[i+1].timestamp.tv_sec + cues[i+1].timestamp.tv_nsec * 1e-9;
-    if ((time >= timeOfFrame) && (time < timeOfNextFrame))
+    // first cue entry after the given position, provided there is one at or before it
+    const vector<uint64_t>& positions = m_streamCuePositions[streamno];
+    auto it = upper_bound(positions.begin(), positions.end(), getCuePosition(streamno, timestamp));
+    if (it != positions.begin() && it != positions.end())
     {
-      return cues[i+1];
+      return m_streamCues[streamno][static_cast<size_t>(it - positions.begin())];
     }
   }
   throw iqxformat_error("no matching cue entry found at given timestamp");
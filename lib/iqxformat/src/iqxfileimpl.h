@@ -102,7 +102,8 @@ public:
   static bool isIqxFile(const std::string& filename);
 
   /// @brief constructor. To be used only for reading/editing
-  IqxFileImpl(const std::string& filename, bool edit = false);
+  /// If cueIndexFile is set, the cue table of a file without cue frame is loaded from or stored to <filename>.iqxcue
+  IqxFileImpl(const std::string& filename, bool edit = false, bool cueIndexFile = false);
   /// @brief constructor taking in file descriptor as argument. To be used only for reading
   IqxFileImpl(int fd);
   /// @brief constructor. To be used only for writing offline files
@@ -120,6 +121,9 @@ public:
 #endif
   /// @brief ???
   operator int();
+  /// @brief read bytes at the given file offset without moving the file position.
+  /// Safe for concurrent readers. Returns the number of bytes read or -1 on error.
+  int64_t readAt(iqx_off_t offset, void* buffer, size_t bytes) const;
   /// @brief gets the offset to the payload in the file
   size_t getPayloadOffset() const;
   /// @brief gets the offset to the epilogue
@@ -212,6 +216,8 @@ public:
   void editComment(const std::string& comment);
   /// @brief write a data frame to file
   void writeDataFrame(int64_t streamno, int64_t sequenceno, std::vector<int16_t>& data);
+  /// @brief write a data frame of interleaved IQ values (values is the number of int16 values) to file
+  void writeDataFrame(int64_t streamno, int64_t sequenceno, const int16_t* data, size_t values);
   /// @brief indicate if file has overrun
   bool hasOverrun() const;
 
@@ -240,10 +246,25 @@ private:
   /// @brief read all IQ data frames and calculate the sample count of each IQ stream (channel)
   void readIqFrameData();
 
+  /// @brief scan the preambles of all IQ data frames with large buffered reads and synthesize a cue entry for each frame
+  void scanIqFrames();
+
+  /// @brief load the cue table and sample counts from the sidecar file. Returns false if the sidecar is missing or stale
+  bool loadCueIndexFile();
+
+  /// @brief store the cue table and sample counts to the sidecar file
+  void storeCueIndexFile() const;
+
+  /// @brief pack values int16 values of a 12 bit stream into DIGIQ words in m_packBuffer, padding a partial word with zeros
+  const void* packDataFrame12(const int16_t* data, size_t values);
+
   /// @brief write a frame to file from header, data an tail pointers and according size fields
   /// seek according to size field if pointer is NULL.
   void writeFrame(IqxPreamble& preamble, const void* head, const void* data, const void* tail);
 
+  /// @brief write count parts of a frame with a single gathering write where available
+  void writeParts(const void* const* parts, const size_t* sizes, size_t count);
+
   /// @brief write a file description frame to file
   void writeFileDescriptionFrame(IqxFileDescHeader& header, const void* data);
 
@@ -301,6 +322,12 @@ private:
   /// @brief get cue table of a particular stream
   std::vector<IqxCueEntry> getCues(size_t streamno);
 
+  /// @brief sort the cue entries of each stream by sample position into m_streamCues
+  void buildCueIndex();
+
+  /// @brief get the position used for cue lookups: sample index for iq streams, nanoseconds otherwise
+  uint64_t getCuePosition(size_t streamno, const iqx_timespec& timestamp);
+
   /// @brief write overrun frame to iqx file
   void writeOverrunFrame();
 
@@ -355,6 +382,8 @@ private:
   std::vector<float64_t> m_streamSampleRate;
   /// list of samples for each stream. Needed for calculation of duration
   std::vector<float64_t> m_samples;
+  /// reused buffer of the packed payload of 12 bit data frames
+  std::vector<uint8_t, AlignedAllocator<uint8_t, IQX_DATA_ALIGNMENT> > m_packBuffer;
   /// list of bookmarks
   std::map<std::string, iqx_timespec> m_bookmarks;
   /* Note: the size of m_cues, m_triggers and m_overruns is always a multiple of IQX_DATA_ALIGNMENT as required by O_DIRECT write/read */
@@ -362,6 +391,12 @@ private:
   /// list of cue entries
   std::vector<IqxCueEntry, AlignedAllocator<IqxCueEntry, IQX_DATA_ALIGNMENT> > m_cues;
   uint64_t m_cueNoOfEntries;
+  /// cue entries of each stream, sorted by cue position for binary search
+  std::vector<std::vector<IqxCueEntry>> m_streamCues;
+  /// cue positions of each stream, parallel to m_streamCues
+  std::vector<std::vector<uint64_t>> m_streamCuePositions;
+  /// false if cue entries were added after m_streamCues has been built
+  bool m_streamCuesValid;
   /// list of trigger entries
   std::vector<IqxTriggerEntry, AlignedAllocator<IqxTriggerEntry, IQX_DATA_ALIGNMENT> > m_triggers;
   uint64_t m_trigNoOfEntries;
@@ -373,6 +408,10 @@ private:
   bool m_edit;  
   /// uuid of the iqx file
   std::string m_uuid;
+  /// name of the file, empty if constructed from a file descriptor
+  std::string m_filename;
+  /// load or store the cue table of files without cue frame from/to a sidecar file
+  bool m_cueIndexFile{false};
   /// list of necessary information of iqx file to be used for comment editing feature
   class MetaOffset
   {
@@ -1,5 +1,13 @@
 #include "test_iqxformat.h"
 
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <thread>
+
+#include "iqxformat/iqxfile.h"
+#include "../src/iqbitconverter.h"
+
 namespace IQW
 {
 
@@ -74,4 +82,384 @@ TEST_F(IqxFormat, Mosaik)
 #endif
 }
 
+TEST_F(IqxFormat, CueLookupPerStream)
+{
+  const string filename = "cuelookup.iqx";
+  const size_t samplesPerFrame = 1024;
+  const size_t framesPerStream = 16;
+
+  {
+    IqxStreamDescDataIQ iq = {};
+    iq.samplerate = 1.0e6;
+    iq.samplerate_valid = IQX_BOOL_TRUE;
+    iq.resolution = 16;
+    vector<pair<string, IqxStreamDescDataIQ>> streams = { make_pair("stream1", iq), make_pair("stream2", iq) };
+    IqxFile writer(filename, "test", "", streams);
+    vector<int16_t> data(2 * samplesPerFrame);
+    for (size_t frame = 0; frame < framesPerStream; ++frame)
+    {
+      // interleave both streams, so that the cue entries of a stream are not adjacent
+      writer.writeDataFrame(0, frame, data);
+      writer.writeDataFrame(1, frame, data);
+    }
+  }
+
+  {
+    IqxFile reader(filename);
+    for (size_t streamno = 0; streamno < 2; ++streamno)
+    {
+      ASSERT_EQ(reader.getStreamNoOfFrames(streamno), framesPerStream);
+
+      iqx_off_t lastOffset = -1;
+      for (size_t frame = 0; frame < framesPerStream; ++frame)
+      {
+        const uint64_t first = frame * samplesPerFrame;
+        IqxCueEntry cue = reader.getCueEntry(streamno, reader.getTimestampFromSample(streamno, first));
+        ASSERT_EQ(cue.streamnum, static_cast<int32_t>(streamno));
+        ASSERT_EQ(reader.getSampleFromTimestamp(streamno, cue.timestamp), first);
+        ASSERT_GT(cue.offset, lastOffset);
+        lastOffset = cue.offset;
+
+        // the last sample of a frame resolves to the same cue entry
+        IqxCueEntry inner = reader.getCueEntry(streamno, reader.getTimestampFromSample(streamno, first + samplesPerFrame - 1));
+        ASSERT_EQ(inner.offset, cue.offset);
+
+        if (frame + 1 < framesPerStream)
+        {
+          IqxCueEntry next = reader.getNextCueEntry(streamno, reader.getTimestampFromSample(streamno, first));
+          ASSERT_EQ(reader.getSampleFromTimestamp(streamno, next.timestamp), first + samplesPerFrame);
+        }
+        else
+        {
+          ASSERT_THROW(reader.getNextCueEntry(streamno, reader.getTimestampFromSample(streamno, first)), iqxformat_error);
+        }
+      }
+    }
+    ASSERT_THROW(reader.getCueEntry(5, reader.getTimestampFromSample(0, 0)), iqxformat_error);
+  }
+
+  remove(filename.c_str());
+}
+
+TEST_F(IqxFormat, CueIndexFile)
+{
+  const string filename = "cueindexfile.iqx";
+  const string sidecar = filename + ".iqxcue";
+  // the frames of the second stream are larger than the buffer used to scan the preambles
+  const size_t samplesPerFrame[] = { 1024, 1536 * 1024 };
+  const size_t framesPerStream = 4;
+  remove(sidecar.c_str());
+
+  {
+    IqxStreamDescDataIQ iq = {};
+    iq.samplerate = 1.0e6;
+    iq.samplerate_valid = IQX_BOOL_TRUE;
+    iq.resolution = 16;
+    vector<pair<string, IqxStreamDescDataIQ>> streams = { make_pair("stream1", iq), make_pair("stream2", iq) };
+    IqxFile writer(filename, "test", "", streams);
+    for (size_t frame = 0; frame < framesPerStream; ++frame)
+    {
+      for (size_t streamno = 0; streamno < 2; ++streamno)
+      {
+        vector<int16_t> data(2 * samplesPerFrame[streamno]);
+        writer.writeDataFrame(streamno, frame, data);
+      }
+    }
+  }
+
+  vector<iqx_off_t> offsets;
+  {
+    IqxFile reader(filename, false, true);
+    for (size_t streamno = 0; streamno < 2; ++streamno)
+    {
+      ASSERT_EQ(reader.getStreamNoOfFrames(streamno), framesPerStream);
+      ASSERT_EQ(reader.getStreamNoOfSamples(streamno), framesPerStream * samplesPerFrame[streamno]);
+      for (size_t frame = 0; frame < framesPerStream; ++frame)
+      {
+        offsets.push_back(reader.getCueEntry(streamno, reader.getTimestampFromSample(streamno, frame * samplesPerFrame[streamno])).offset);
+      }
+    }
+  }
+  FILE* file = fopen(sidecar.c_str(), "rb");
+  ASSERT_NE(file, nullptr);
+  fclose(file);
+
+  // reopening uses the sidecar and yields the same cue table
+  {
+    IqxFile reader(filename, false, true);
+    size_t i = 0;
+    for (size_t streamno = 0; streamno < 2; ++streamno)
+    {
+      ASSERT_EQ(reader.getStreamNoOfFrames(streamno), framesPerStream);
+      ASSERT_EQ(reader.getStreamNoOfSamples(streamno), framesPerStream * samplesPerFrame[streamno]);
+      for (size_t frame = 0; frame < framesPerStream; ++frame)
+      {
+        ASSERT_EQ(reader.getCueEntry(streamno, reader.getTimestampFromSample(streamno, frame * samplesPerFrame[streamno])).offset, offsets[i++]);
+      }
+    }
+  }
+
+  // a stale sidecar is ignored
+  file = fopen(sidecar.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  fseek(file, 16, SEEK_SET);
+  const uint64_t wrongSize = 1;
+  fwrite(&wrongSize, sizeof(wrongSize), 1, file);
+  fclose(file);
+  {
+    IqxFile reader(filename, false, true);
+    ASSERT_EQ(reader.getStreamNoOfFrames(1), framesPerStream);
+    ASSERT_EQ(reader.getCueEntry(1, reader.getTimestampFromSample(1, samplesPerFrame[1])).offset, offsets[framesPerStream + 1]);
+  }
+
+  remove(sidecar.c_str());
+  remove(filename.c_str());
+}
+
+TEST_F(IqxFormat, ConcurrentPositionalReads)
+{
+  const string filename = "positionalreads.iqx";
+  const size_t samplesPerFrame = 4096;
+  const size_t frames = 16;
+  const size_t threads = 4;
+
+  {
+    IqxStreamDescDataIQ iq = {};
+    iq.samplerate = 1.0e6;
+    iq.samplerate_valid = IQX_BOOL_TRUE;
+    iq.resolution = 16;
+    vector<pair<string, IqxStreamDescDataIQ>> streams = { make_pair("stream1", iq) };
+    IqxFile writer(filename, "test", "", streams);
+    vector<int16_t> data(2 * samplesPerFrame);
+    for (size_t frame = 0; frame < frames; ++frame)
+    {
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        data[i] = static_cast<int16_t>(frame * 1000 + i % 1000);
+      }
+      writer.writeDataFrame(0, frame, data);
+    }
+  }
+
+  {
+    IqxFile reader(filename);
+    vector<iqx_off_t> offsets;
+    for (size_t frame = 0; frame < frames; ++frame)
+    {
+      offsets.push_back(reader.getCueEntry(0, reader.getTimestampFromSample(0, frame * samplesPerFrame)).offset);
+    }
+
+    // all threads share the reader, each walks the frames in a different order
+    vector<size_t> errors(threads, 0);
+    vector<thread> workers;
+    for (size_t t = 0; t < threads; ++t)
+    {
+      workers.emplace_back([&, t]()
+      {
+        vector<int16_t> data(2 * samplesPerFrame);
+        for (size_t repeat = 0; repeat < 8; ++repeat)
+        {
+          for (size_t n = 0; n < frames; ++n)
+          {
+            const size_t frame = (n * (2 * t + 1) + repeat) % frames;
+            IqxPreamble preamble;
+            if (reader.readAt(offsets[frame], &preamble, sizeof(preamble)) != static_cast<int64_t>(sizeof(preamble)))
+            {
+              ++errors[t];
+              continue;
+            }
+            const iqx_off_t dataOffset = offsets[frame] + static_cast<iqx_off_t>(sizeof(preamble) + preamble.headsize);
+            const size_t bytes = data.size() * sizeof(int16_t);
+            if (reader.readAt(dataOffset, data.data(), bytes) != static_cast<int64_t>(bytes))
+            {
+              ++errors[t];
+              continue;
+            }
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+              if (data[i] != static_cast<int16_t>(frame * 1000 + i % 1000))
+              {
+                ++errors[t];
+                break;
+              }
+            }
+          }
+        }
+      });
+    }
+    for (auto& worker : workers)
+    {
+      worker.join();
+    }
+    for (size_t t = 0; t < threads; ++t)
+    {
+      ASSERT_EQ(errors[t], 0u);
+    }
+
+    // reading beyond the end of the file returns no data
+    int16_t value;
+    ASSERT_EQ(reader.readAt(static_cast<iqx_off_t>(1) << 40, &value, sizeof(value)), 0);
+  }
+
+  remove(filename.c_str());
+}
+
+TEST_F(IqxFormat, Write12BitStream)
+{
+  const string filename = "write12bit.iqx";
+  const size_t samplesPerFrame = 1000;
+  const size_t frames = 4;
+  // the last frame ends within a DIGIQ word and is padded with zeros
+  const size_t lastFrameSamples = 15;
+
+  vector<int16_t> written;
+  {
+    IqxStreamDescDataIQ iq = {};
+    iq.samplerate = 1.0e6;
+    iq.samplerate_valid = IQX_BOOL_TRUE;
+    iq.resolution = 12;
+    vector<pair<string, IqxStreamDescDataIQ>> streams = { make_pair("stream1", iq) };
+    IqxFile writer(filename, "test", "", streams);
+    for (size_t frame = 0; frame <= frames; ++frame)
+    {
+      vector<int16_t> data(2 * ((frame < frames) ? samplesPerFrame : lastFrameSamples));
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        data[i] = static_cast<int16_t>((frame * 7919 + i * 131) & 0xFFFF);
+      }
+      writer.writeDataFrame(0, frame, data.data(), data.size());
+      written.insert(written.end(), data.begin(), data.end());
+    }
+  }
+
+  {
+    IqxFile reader(filename);
+    ASSERT_EQ(reader.getStreamType(0), static_cast<IqxStreamType>(IQX_STREAM_TYPE_IQDATA12));
+    ASSERT_EQ(reader.getStreamNoOfFrames(0), frames + 1);
+    ASSERT_EQ(reader.getStreamNoOfSamples(0), frames * samplesPerFrame + 2 * SAMPLES_COMPLEX12_PER_DIGIQ_WORD);
+
+    for (size_t frame = 0; frame <= frames; ++frame)
+    {
+      const uint64_t first = frame * samplesPerFrame;
+      IqxCueEntry cue = reader.getCueEntry(0, reader.getTimestampFromSample(0, first));
+      ASSERT_EQ(reader.getSampleFromTimestamp(0, cue.timestamp), first);
+
+      IqxPreamble preamble;
+      ASSERT_EQ(reader.readAt(cue.offset, &preamble, sizeof(preamble)), static_cast<int64_t>(sizeof(preamble)));
+      ASSERT_EQ(preamble.datasize % DIGIQ_WORD_SIZE, 0u);
+      vector<uint8_t> packed(preamble.datasize);
+      ASSERT_EQ(reader.readAt(cue.offset + sizeof(preamble) + preamble.headsize, packed.data(), packed.size()), static_cast<int64_t>(packed.size()));
+      vector<int16_t> unpacked(IqBitConverter::conv12to16_dstsize(packed.size()) / sizeof(int16_t));
+      ASSERT_EQ(IqBitConverter::conv12to16(packed.data(), unpacked.data(), packed.size()), static_cast<ssize_t>(packed.size()));
+
+      // 12 bit streams keep the upper 12 bits of each value
+      for (size_t i = 0; i < unpacked.size(); ++i)
+      {
+        const size_t index = 2 * first + i;
+        const int16_t expected = (index < written.size()) ? static_cast<int16_t>(written[index] & 0xFFF0) : 0;
+        ASSERT_EQ(unpacked[i], expected) << "frame " << frame << ", value " << i;
+      }
+    }
+  }
+
+  remove(filename.c_str());
+}
+
+TEST_F(IqxFormat, BitConverterMatchesScalar)
+{
+  const IqBitConverter::SimdLevel supported = IqBitConverter::getSupportedSimdLevel();
+  mt19937 rng(4711);
+  uniform_int_distribution<int> byte(0, 255);
+
+  // sizes in DIGIQ words, covering the tails of every vector width
+  for (size_t words : { 1, 2, 3, 7, 8, 9, 17, 1000 })
+  {
+    vector<uint8_t> src12(words * DIGIQ_WORD_SIZE);
+    for (auto& b : src12)
+    {
+      b = static_cast<uint8_t>(byte(rng));
+    }
+    vector<uint16_t> src16(words * SAMPLES_REAL12_PER_DIGIQ_WORD);
+    for (auto& v : src16)
+    {
+      v = static_cast<uint16_t>(byte(rng) << 8 | byte(rng));
+    }
+
+    vector<uint16_t> ref16(src16.size());
+    vector<uint8_t> ref12(src12.size());
+    ASSERT_EQ(IqBitConverter::conv12to16_array(src12.data(), ref16.data(), src12.size()), static_cast<ssize_t>(src12.size()));
+    ASSERT_EQ(IqBitConverter::conv16to12_array(src16.data(), ref12.data(), src16.size() * 2), static_cast<ssize_t>(src16.size() * 2));
+
+    for (int level = IqBitConverter::SimdNone; level <= supported; ++level)
+    {
+      ASSERT_TRUE(IqBitConverter::setSimdLevel(static_cast<IqBitConverter::SimdLevel>(level)));
+      vector<uint16_t> dst16(src16.size() + 1, 0xAAAA);
+      vector<uint8_t> dst12(src12.size() + 1, 0xAA);
+      ASSERT_EQ(IqBitConverter::conv12to16(src12.data(), dst16.data(), src12.size()), static_cast<ssize_t>(src12.size()));
+      ASSERT_EQ(IqBitConverter::conv16to12(src16.data(), dst12.data(), src16.size() * 2), static_cast<ssize_t>(src16.size() * 2));
+
+      ASSERT_TRUE(equal(ref16.begin(), ref16.end(), dst16.begin())) << "12 to 16 bit, level " << level << ", words " << words;
+      ASSERT_TRUE(equal(ref12.begin(), ref12.end(), dst12.begin())) << "16 to 12 bit, level " << level << ", words " << words;
+      // nothing written behind the destination
+      ASSERT_EQ(dst16.back(), 0xAAAA);
+      ASSERT_EQ(dst12.back(), 0xAA);
+    }
+  }
+
+  ASSERT_EQ(IqBitConverter::conv12to16(nullptr, nullptr, DIGIQ_WORD_SIZE + 1), -1);
+  ASSERT_EQ(IqBitConverter::conv16to12(nullptr, nullptr, SAMPLES_REAL12_PER_DIGIQ_WORD * 2 + 2), -1);
+  IqBitConverter::setSimdLevel(supported);
+}
+
+TEST_F(IqxFormat, FloatConverterMatchesScalar)
+{
+  const IqBitConverter::SimdLevel supported = IqBitConverter::getSupportedSimdLevel();
+  const float scale = INT16_MAX;
+  mt19937 rng(4711);
+  // values beyond full scale must saturate
+  uniform_real_distribution<float> value(-1.5f, 1.5f);
+
+  // sizes in pairs, covering the tails of every vector width
+  for (size_t pairs : { 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 1000 })
+  {
+    vector<float> srcI(pairs);
+    vector<float> srcQ(pairs);
+    for (size_t i = 0; i < pairs; ++i)
+    {
+      srcI[i] = value(rng);
+      srcQ[i] = value(rng);
+    }
+    srcI[0] = numeric_limits<float>::quiet_NaN();
+    srcQ[pairs - 1] = -numeric_limits<float>::infinity();
+    vector<float> channel(2 * pairs);
+    for (size_t i = 0; i < pairs; ++i)
+    {
+      channel[2 * i] = srcI[i];
+      channel[2 * i + 1] = srcQ[i];
+    }
+
+    vector<int16_t> ref(2 * pairs);
+    ASSERT_EQ(IqBitConverter::convFloatToInt16Interleaved_array(srcI.data(), srcQ.data(), ref.data(), pairs, scale), pairs);
+    ASSERT_EQ(ref[0], INT16_MIN);
+    ASSERT_EQ(IqBitConverter::convFloatToInt16_value(1.5f, scale), INT16_MAX);
+    ASSERT_EQ(IqBitConverter::convFloatToInt16_value(0.5f, scale), static_cast<int16_t>(0.5f * scale));
+
+    for (int level = IqBitConverter::SimdNone; level <= supported; ++level)
+    {
+      ASSERT_TRUE(IqBitConverter::setSimdLevel(static_cast<IqBitConverter::SimdLevel>(level)));
+      vector<int16_t> interleaved(2 * pairs + 1, 0x5555);
+      vector<int16_t> converted(2 * pairs + 1, 0x5555);
+      ASSERT_EQ(IqBitConverter::convFloatToInt16Interleaved(srcI.data(), srcQ.data(), interleaved.data(), pairs, scale), pairs);
+      ASSERT_EQ(IqBitConverter::convFloatToInt16(channel.data(), converted.data(), 2 * pairs, scale), 2 * pairs);
+
+      ASSERT_TRUE(equal(ref.begin(), ref.end(), interleaved.begin())) << "interleaved, level " << level << ", pairs " << pairs;
+      ASSERT_TRUE(equal(ref.begin(), ref.end(), converted.begin())) << "channel, level " << level << ", pairs " << pairs;
+      // nothing written behind the destination
+      ASSERT_EQ(interleaved.back(), 0x5555);
+      ASSERT_EQ(converted.back(), 0x5555);
+    }
+  }
+  IqBitConverter::setSimdLevel(supported);
+}
+
 }// namespace
@@ -96,6 +96,51 @@ void Aid::setTimestamp(const time_t timestamp)
   return m_pimpl->setTimestamp(timestamp);
 }
 
+void Aid::setStatisticsEnabled(bool enabled)
+{
+  m_pimpl->setStatisticsEnabled(enabled);
+}
+
+IoStatistics Aid::getStatistics() const
+{
+  return m_pimpl->getStatistics();
+}
+
+int Aid::setFrameSettings(size_t samplesPerBlock, size_t blocksPerFrame)
+{
+  return m_pimpl->setFrameSettings(samplesPerBlock, blocksPerFrame);
+}
+
+int Aid::readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  return m_pimpl->readArray(arrayName, values, nofValues, scale, offset);
+}
+
+int Aid::readArray(const std::string& arrayName, int32_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  return m_pimpl->readArray(arrayName, values, nofValues, scale, offset);
+}
+
+int Aid::readChannel(const std::string& channelName, int16_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  return m_pimpl->readChannel(channelName, values, nofValues, scale, offset);
+}
+
+int Aid::readChannel(const std::string& channelName, int32_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  return m_pimpl->readChannel(channelName, values, nofValues, scale, offset);
+}
+
+int Aid::setAsyncWrite(bool asyncWrite)
+{
+  return m_pimpl->setAsyncWrite(asyncWrite);
+}
+
+int Aid::setFrameIndexFileEnabled(bool enabled)
+{
+  return m_pimpl->setFrameIndexFileEnabled(enabled);
+}
+
 int Aid::readArray(const std::string& arrayName, std::vector<float>& values, size_t nofValues, size_t offset)
 {
   return m_pimpl->readArray(arrayName, values, nofValues, offset);
@@ -28,9 +28,12 @@
 #include <numeric>
 
 #include "aidpimpl.h"
+#include "tracescope.h"
 #include "ZFFileReader.h"
 #include "ZFFileWriter.h"
 #include "ArrayComplex.h"
+#include "rs_gx40x_global_frame_header_if_defs.h"
+#include "rs_gx40x_global_ifdata_header_if_defs.h"
 #include <codecvt>
 #include <locale>
 namespace rohdeschwarz
@@ -47,7 +50,13 @@ AidImpl::AidImpl(const std::string& filename) :
 	m_filename(filename),
 	m_write(false),
 	m_samples(0),
-  m_timeStamp(time(nullptr))
+  m_timeStamp(time(nullptr)),
+  m_cArrOffset(0),
+  m_cArrValues(0),
+  m_cArrValid(false),
+  m_samplesPerBlock(131072u),
+  m_blocksPerFrame(1u),
+  m_asyncWrite(false)
 {
 }
 
@@ -57,6 +66,7 @@ AidImpl::~AidImpl()
 
 int AidImpl::readOpen(std::vector<std::string>& arrayNames)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Parsing);
   resetData();
   arrayNames.clear();
 
@@ -109,6 +119,7 @@ void AidImpl::resetData()
   m_channelInfo.clear();
   m_metaData.clear();
   m_samples = 0;
+  m_cArrValid = false;
   m_reader.reset();
 }
 
@@ -126,7 +137,8 @@ int AidImpl::writeOpen(IqDataFormat format, size_t nofArrays, const std::string&
   m_writer.setTimestamp(writeTime);
   m_writer.setCenterFrequency((uint64_t)channelInfos[0].getFrequency());
   m_writer.setSampleRate((uint32_t)channelInfos[0].getClockRate());
-  m_writer.setDatablockSettings(131072u, 1u);
+  m_writer.setDatablockSettings(m_samplesPerBlock, m_blocksPerFrame);
+  m_writer.setAsyncWrite(m_asyncWrite);
   //m_writer.setFrameType(ekFRH_DATASTREAM__IFDATA_32RE_32IM_FLOAT_RESCALED);
 
   // look for Bandwith in Meta data: "Ch1_MeasBandwidth[Hz]"
@@ -151,17 +163,20 @@ int AidImpl::writeOpen(IqDataFormat format, size_t nofArrays, const std::string&
 
 int AidImpl::close()
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Finalize);
   // close file
-
+  int status = 0;
   if (m_writer.isOpen())
   {
-    m_writer.close();
+    // pending frames are written by close, report write errors
+    status = m_writer.close();
   }
   if (m_reader.isOpen())
   {
     m_reader.close();
   }
-  return 0;
+  m_cArrValid = false;
+  return status;
 }
 
 time_t AidImpl::getTimestamp() const
@@ -181,19 +196,141 @@ void AidImpl::setTimestamp(const time_t timestamp)
 
 int AidImpl::readAid(size_t nofValues, size_t offset)
 {
-  int status = 0;
-  m_cArr.resize((uint32_t)nofValues);
-  status = m_reader.setReadMarker(offset, offset + nofValues);
+  DAIEX_TRACE_SCOPE("AidImpl::readAid");
+  // e.g. reading "_I" and "_Q" of the same window decodes the frames only once
+  if (m_cArrValid && m_cArrOffset == offset && m_cArrValues == nofValues)
+  {
+    return 0;
+  }
+  m_cArrValid = false;
+
+  // the buffer only grows, it is kept allocated between calls
+  if (nofValues > m_cArr.getCapacity() && !m_cArr.realloc((uint32_t)nofValues))
+  {
+    return 1;
+  }
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Io);
+  int status = m_reader.setReadMarker(offset, offset + nofValues);
   if (status != 0)
   {
     return 1;
   }
-  status = m_reader.read(m_cArr);
+  status = m_reader.read(m_cArr, (uint32_t)nofValues);
+  if (status == 0)
+  {
+    m_cArrOffset = offset;
+    m_cArrValues = nofValues;
+    m_cArrValid = true;
+    statistics_.addRead(nofValues * m_reader.getSampleSize());
+  }
   return status;
 }
 
+int AidImpl::readAidRaw(size_t nofValues, size_t offset, uint32_t valueSize, double& scale)
+{
+  DAIEX_TRACE_SCOPE("AidImpl::readAidRaw");
+  if (nofValues > m_rawArr.getCapacity() && !m_rawArr.realloc((uint32_t)nofValues))
+  {
+    return 1;
+  }
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Io);
+  int status = m_reader.setReadMarker(offset, offset + nofValues);
+  if (status != 0)
+  {
+    return 1;
+  }
+  float rawScale = 0;
+  status = m_reader.readRaw(m_rawArr, (uint32_t)nofValues, valueSize, rawScale);
+  if (status == ekUnsupportedFileFormat)
+  {
+    // e.g. float frames or 32 bit frames read as int16
+    return ErrorCodes::WrongDataType;
+  }
+  if (status == ekInvalidParameters)
+  {
+    // the gain changes within the samples, there is no single scale
+    return ErrorCodes::InconsistentInputData;
+  }
+  if (status == 0)
+  {
+    scale = rawScale;
+    statistics_.addRead(nofValues * m_reader.getSampleSize());
+  }
+  return status;
+}
+
+template<typename T>
+int AidImpl::readArrayRaw(const std::string& arrayName, T* values, size_t nofValues, double& scale, size_t offset)
+{
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
+  int status = readAidRaw(nofValues, offset, sizeof(T), scale);
+  if (status != 0)
+  {
+    return status;
+  }
+  bool isI = arrayName.find("_I", arrayName.size() - 2) != string::npos;
+  const T* data = reinterpret_cast<const T*>(m_rawArr.getPtr()) + (isI ? 0 : 1);
+  for (size_t i = 0; i < nofValues; i++)
+  {
+    values[i] = data[i * 2];
+  }
+  return 0;
+}
+
+template<typename T>
+int AidImpl::readChannelRaw(T* values, size_t nofValues, double& scale, size_t offset)
+{
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
+  int status = readAidRaw(nofValues, offset, sizeof(T), scale);
+  if (status != 0)
+  {
+    return status;
+  }
+  memcpy(values, m_rawArr.getPtr(), nofValues * 2 * sizeof(T));
+  return 0;
+}
+
+int AidImpl::readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  return readArrayRaw(arrayName, values, nofValues, scale, offset);
+}
+
+int AidImpl::readArray(const std::string& arrayName, int32_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  return readArrayRaw(arrayName, values, nofValues, scale, offset);
+}
+
+int AidImpl::readChannel(const std::string& /*channelName*/, int16_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  return readChannelRaw(values, nofValues, scale, offset);
+}
+
+int AidImpl::readChannel(const std::string& /*channelName*/, int32_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  return readChannelRaw(values, nofValues, scale, offset);
+}
+
+int AidImpl::writeAid()
+{
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Io);
+  switch (m_writer.write(m_cArr))
+  {
+  case AmlabFiles::ekNoError:
+    statistics_.addWrite(m_cArr.getSize() * m_writer.getSampleSize());
+    return ErrorCodes::Success;
+  case AmlabFiles::ekFileNotOpen:
+    return ErrorCodes::FileWriterUninitialized;
+  case AmlabFiles::ekInvalidParameters:
+    return ErrorCodes::InconsistentInputData;
+  default:
+    // converting or writing a full frame failed
+    return ErrorCodes::InternalError;
+  }
+}
+
 int AidImpl::readArray(const std::string& arrayName, std::vector<float>& values, size_t nofValues, size_t offset)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   int status = readAid(nofValues, offset);
   if (status != 0)
   {
@@ -221,6 +358,7 @@ int AidImpl::readArray(const std::string& arrayName, std::vector<float>& values,
 
 int AidImpl::readArray(const std::string& arrayName, float* values, size_t nofValues, size_t offset)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   int status = readAid(nofValues, offset);
   if (status != 0)
   {
@@ -247,6 +385,7 @@ int AidImpl::readArray(const std::string& arrayName, float* values, size_t nofVa
 
 int AidImpl::readArray(const std::string& arrayName, std::vector<double>& values, size_t nofValues, size_t offset)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   int status = readAid(nofValues, offset);
   if (status != 0)
   {
@@ -274,6 +413,7 @@ int AidImpl::readArray(const std::string& arrayName, std::vector<double>& values
 
 int AidImpl::readArray(const std::string& arrayName, double* values, size_t nofValues, size_t offset)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   int status = readAid(nofValues, offset);
   if (status != 0)
   {
@@ -300,6 +440,7 @@ int AidImpl::readArray(const std::string& arrayName, double* values, size_t nofV
 
 int AidImpl::readChannel(const std::string& /*channelName*/, std::vector<float>& values, size_t nofValues, size_t offset)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   int status = readAid(nofValues, offset);
   if (status != 0)
   {
@@ -316,6 +457,7 @@ int AidImpl::readChannel(const std::string& /*channelName*/, std::vector<float>&
 
 int AidImpl::readChannel(const std::string& /*channelName*/, float* values, size_t nofValues, size_t offset)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   int status = readAid(nofValues, offset);
   if (status != 0)
   {
@@ -331,6 +473,7 @@ int AidImpl::readChannel(const std::string& /*channelName*/, float* values, size
 
 int AidImpl::readChannel(const std::string& /*channelName*/, std::vector<double>& values, size_t nofValues, size_t offset)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   int status = readAid(nofValues, offset);
   if (status != 0)
   {
@@ -347,6 +490,7 @@ int AidImpl::readChannel(const std::string& /*channelName*/, std::vector<double>
 
 int AidImpl::readChannel(const std::string& /*channelName*/, double* values, size_t nofValues, size_t offset)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   int status = readAid(nofValues, offset);
   if (status != 0)
   {
@@ -362,6 +506,7 @@ int AidImpl::readChannel(const std::string& /*channelName*/, double* values, siz
 
 int AidImpl::appendArrays(const std::vector<std::vector<float> >& iqdata)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   // aid supports only one channel, what is the same as two arrays
   if (iqdata.size() != 2)
   {
@@ -382,12 +527,12 @@ int AidImpl::appendArrays(const std::vector<std::vector<float> >& iqdata)
     m_cArr[(uint32)i].im = iqdata[1][i];
   }
   m_cArr.setSize((uint32)iqdata[0].size());
-  m_writer.write(m_cArr);
-  return 0;
+  return writeAid();
 }
 
 int AidImpl::appendArrays(const std::vector<float*>& iqdata, const std::vector<size_t>& sizes)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   if (sizes.size() != 2)
   {
     return ErrorCodes::InternalError;
@@ -411,12 +556,12 @@ int AidImpl::appendArrays(const std::vector<float*>& iqdata, const std::vector<s
     }
   }
   m_cArr.setSize((uint32)sizes[0]);
-  m_writer.write(m_cArr);
-  return 0;
+  return writeAid();
 }
 
 int AidImpl::appendArrays(const std::vector<std::vector<double> >& iqdata)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   if (iqdata.size() != 2)
   {
     return ErrorCodes::InternalError;
@@ -436,12 +581,12 @@ int AidImpl::appendArrays(const std::vector<std::vector<double> >& iqdata)
     m_cArr[(uint32)i].im = (float)iqdata[1][i];
   }
   m_cArr.setSize((uint32)iqdata[0].size());
-  m_writer.write(m_cArr);
-  return 0;
+  return writeAid();
 }
 
 int AidImpl::appendArrays(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   if (sizes.size() != 2)
   {
     return ErrorCodes::InternalError;
@@ -461,12 +606,12 @@ int AidImpl::appendArrays(const std::vector<double*>& iqdata, const std::vector<
     m_cArr[(uint32)i].im = (float)iqdata[1][i];
   }
   m_cArr.setSize((uint32)sizes[0]);
-  m_writer.write(m_cArr);
-  return 0;
+  return writeAid();
 }
 
 int AidImpl::appendChannels(const std::vector<std::vector<float> >& iqdata)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   // aid supports only one channel
   if (iqdata.size() > 1)
   {
@@ -479,12 +624,12 @@ int AidImpl::appendChannels(const std::vector<std::vector<float> >& iqdata)
     m_cArr[(uint32)i].im = iqdata[0][i*2+1];
   }
   m_cArr.setSize((uint32)(iqdata[0].size() / 2));
-  m_writer.write(m_cArr);
-  return 0;
+  return writeAid();
 }
 
 int AidImpl::appendChannels(const std::vector<float*>& iqdata, const std::vector<size_t>& sizes)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   // aid supports only one channel
   if (iqdata.size() > 1)
   {
@@ -497,12 +642,12 @@ int AidImpl::appendChannels(const std::vector<float*>& iqdata, const std::vector
     m_cArr[(uint32)i].im = iqdata[0][i * 2 + 1];
   }
   m_cArr.setSize((uint32)sizes[0] / 2);
-  m_writer.write(m_cArr);
-  return 0;
+  return writeAid();
 }
 
 int AidImpl::appendChannels(const std::vector<std::vector<double> >& iqdata)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   // aid supports only one channel
   if (iqdata.size() > 1)
   {
@@ -515,12 +660,12 @@ int AidImpl::appendChannels(const std::vector<std::vector<double> >& iqdata)
     m_cArr[(uint32)i].im = (float)iqdata[0][i * 2 + 1];
   }
   m_cArr.setSize((uint32)(iqdata[0].size() / 2));
-  m_writer.write(m_cArr);
-  return 0;
+  return writeAid();
 }
 
 int AidImpl::appendChannels(const std::vector<double*>& iqdata, const std::vector<size_t>& sizes)
 {
+  StatisticsCollector::Timer timer(statistics_, IoPhase::Conversion);
   // aid supports only one channel
   if (iqdata.size() > 1)
   {
@@ -533,8 +678,49 @@ int AidImpl::appendChannels(const std::vector<double*>& iqdata, const std::vecto
     m_cArr[(uint32)i].im = (float)iqdata[0][i * 2 + 1];
   }
   m_cArr.setSize((uint32)(sizes[0] / 2));
-  m_writer.write(m_cArr);
-  return 0;
+  return writeAid();
+}
+
+int AidImpl::setFrameSettings(size_t samplesPerBlock, size_t blocksPerFrame)
+{
+  if (m_writer.isOpen())
+  {
+    return ErrorCodes::WriterAlreadyInitialized;
+  }
+
+  // frame length in 32 bit words: frame header, data header and per data block a statusword + float i/q samples
+  const uint64 headerLength = (sizeof(typFRH_FRAMEHEADER) + sizeof(typIFD_IFDATAHEADER_EX)) / sizeof(uint32);
+  if (samplesPerBlock == 0 || blocksPerFrame == 0
+    || headerLength + (uint64)blocksPerFrame * (2 * (uint64)samplesPerBlock + 1) > kFRH_FRAME_LENGTH_MAX)
+  {
+    return ErrorCodes::InconsistentInputData;
+  }
+
+  m_samplesPerBlock = (uint32)samplesPerBlock;
+  m_blocksPerFrame = (uint32)blocksPerFrame;
+  return ErrorCodes::Success;
+}
+
+int AidImpl::setAsyncWrite(bool asyncWrite)
+{
+  if (m_writer.isOpen())
+  {
+    return ErrorCodes::WriterAlreadyInitialized;
+  }
+
+  m_asyncWrite = asyncWrite;
+  return ErrorCodes::Success;
+}
+
+int AidImpl::setFrameIndexFileEnabled(bool enabled)
+{
+  if (m_reader.isOpen())
+  {
+    return ErrorCodes::ReaderAlreadyInitialized;
+  }
+
+  m_reader.setFrameIndexFileEnabled(enabled);
+  return ErrorCodes::Success;
 }
 
 		} // namespace
@@ -0,0 +1,904 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+#include "asyncreadservice.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <thread>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define DAIEX_IO_URING
+#endif
+#endif
+#endif
+
+#include "errorcodes.h"
+#include "platform.h"
+#include "tracescope.h"
+#include "workstealingpool.h"
+
+using namespace std;
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      namespace
+      {
+        /** @brief Size of one I/O buffer, i.e. the maximum size of a chunk in bytes. */
+        const size_t BufferSize = 256 * 1024;
+
+        /** @brief Number of I/O buffers of the io_uring backend, i.e. the maximum number of chunks in flight. */
+        const size_t NofBuffers = 32;
+
+        struct Request;
+
+        /** @brief Part of a segment that fits into one I/O buffer. */
+        struct Chunk
+        {
+          /** @brief The read the chunk belongs to. */
+          Request* request;
+
+          /** @brief The segment the chunk belongs to. */
+          const RawSegment* segment;
+
+          /** @brief Index of the first group of the segment read by this chunk. */
+          size_t firstGroup;
+
+          /** @brief Number of groups read by this chunk. */
+          size_t nofGroups;
+
+          /** @brief Position in the file in bytes. */
+          uint64_t offset;
+
+          /** @brief Number of bytes to read. */
+          size_t bytes;
+
+          /** @brief Number of bytes read so far. */
+          size_t done;
+
+          /** @brief Index of the I/O buffer assigned, used by the io_uring backend. */
+          size_t buffer;
+        };
+
+        /** @brief One asynchronous read, deleted after its callback has been called. */
+        struct Request
+        {
+          shared_ptr<AsyncFile> file;
+          RawValueType type;
+          double scale;
+          vector<RawSegment> segments;
+          void* values;
+          bool isDouble;
+          AsyncReadCallback callback;
+          /** @brief Counts the bytes read, nullptr if not counted. */
+          StatisticsCollector* statistics;
+          vector<Chunk> chunks;
+
+          /** @brief Number of chunks not completed yet. */
+          atomic<size_t> remaining;
+
+          /** @brief First error of a chunk or ErrorCodes::Success. */
+          atomic<int> error;
+        };
+
+        size_t getValueSize(RawValueType type)
+        {
+          switch (type)
+          {
+          case RawValueType::Int16:
+            return sizeof(int16_t);
+          case RawValueType::Float32:
+            return sizeof(float);
+          default:
+            return sizeof(double);
+          }
+        }
+
+        template<typename S, typename T>
+        void convert(const Chunk& chunk, const uint8_t* data, double scale, T* values)
+        {
+          const RawSegment& segment = *chunk.segment;
+          const S* src = reinterpret_cast<const S*>(data);
+          T* dest = values + segment.destIndex + chunk.firstGroup * segment.destStride;
+          for (size_t group = 0; group < chunk.nofGroups; ++group)
+          {
+            for (size_t value = 0; value < segment.groupSize; ++value)
+            {
+              dest[value] = static_cast<T>(src[value] * scale);
+            }
+
+            src += segment.srcStride;
+            dest += segment.destStride;
+          }
+        }
+
+        template<typename T>
+        void convert(const Chunk& chunk, const uint8_t* data)
+        {
+          const Request& request = *chunk.request;
+          T* values = static_cast<T*>(request.values);
+          switch (request.type)
+          {
+          case RawValueType::Int16:
+            convert<int16_t>(chunk, data, request.scale, values);
+            break;
+          case RawValueType::Float32:
+            convert<float>(chunk, data, request.scale, values);
+            break;
+          default:
+            convert<double>(chunk, data, request.scale, values);
+            break;
+          }
+        }
+
+        /** @brief Calls the callback of a read and releases the read. */
+        void finish(Request* request)
+        {
+          DAIEX_TRACE_SCOPE("AsyncRead::complete");
+          shared_ptr<AsyncFile> file = request->file;
+          try
+          {
+            request->callback(request->error.load());
+          }
+          catch (...)
+          {
+            // exceptions must not escape to the I/O threads
+          }
+
+          delete request;
+          file->endRead();
+        }
+
+        /**
+          @brief Converts the data read for a chunk to the destination. The last chunk of a read finishes the read,
+          i.e. the chunk must not be used afterwards.
+          @param [in]  chunk The chunk.
+          @param [in]  data The data read, chunk.bytes size.
+          @param [in]  error ErrorCodes::Success if the data has been read completely.
+        */void complete(Chunk& chunk, const uint8_t* data, int error)
+        {
+          Request* request = chunk.request;
+          if (error == ErrorCodes::Success)
+          {
+            if (request->statistics != nullptr)
+            {
+              request->statistics->addRead(chunk.bytes);
+            }
+
+            if (request->isDouble)
+            {
+              convert<double>(chunk, data);
+            }
+            else
+            {
+              convert<float>(chunk, data);
+            }
+          }
+          else
+          {
+            int expected = ErrorCodes::Success;
+            request->error.compare_exchange_strong(expected, error);
+          }
+
+          if (request->remaining.fetch_sub(1) == 1)
+          {
+            finish(request);
+          }
+        }
+      }
+
+      /**
+      * @brief Base class of the I/O backends.
+      */
+      class AsyncReadBackendBase
+      {
+      public:
+        /** @brief Destructor. Waits until all reads have completed. */
+        virtual ~AsyncReadBackendBase() {}
+
+        /** @returns Returns the type of the backend. */
+        virtual AsyncReadBackend getType() const = 0;
+
+        /**
+          @brief Starts to read the chunks of a read. The backend completes every chunk with complete().
+          @param [in]  request The read, which has at least one chunk.
+        */virtual void submit(Request* request) = 0;
+
+        /** @brief Waits until all chunks submitted have been completed. */
+        virtual void wait() = 0;
+      };
+
+      namespace
+      {
+        /**
+        * @brief Reads the chunks with positional reads on a work-stealing pool, each worker owning one buffer.
+        */
+        class ThreadPoolBackend : public AsyncReadBackendBase
+        {
+        public:
+          ThreadPoolBackend() : pool_(0)
+          {
+          }
+
+          ~ThreadPoolBackend()
+          {
+            this->pool_.wait();
+          }
+
+          AsyncReadBackend getType() const override
+          {
+            return AsyncReadBackend::ThreadPool;
+          }
+
+          void submit(Request* request) override
+          {
+            // the request is deleted by the last chunk completed, possibly before this loop has finished
+            Chunk* chunks = request->chunks.data();
+            const size_t nofChunks = request->chunks.size();
+            for (size_t i = 0; i < nofChunks; ++i)
+            {
+              Chunk* chunk = &chunks[i];
+              this->pool_.submit([chunk]()
+              {
+                static thread_local vector<double> buffer(BufferSize / sizeof(double));
+                const int64_t bytes = Platform::fileReadAt(chunk->request->file->getFd(), chunk->offset, buffer.data(), chunk->bytes);
+                const int error = bytes == static_cast<int64_t>(chunk->bytes) ? ErrorCodes::Success : ErrorCodes::InternalError;
+                complete(*chunk, reinterpret_cast<const uint8_t*>(buffer.data()), error);
+              });
+            }
+          }
+
+          void wait() override
+          {
+            this->pool_.wait();
+          }
+
+        private:
+          WorkStealingPool pool_;
+        };
+
+#ifdef DAIEX_IO_URING
+        /**
+        * @brief Reads the chunks with io_uring. The system calls are used directly, as liburing is not required.
+        * A chunk is submitted when one of the I/O buffers is free. The buffers are registered with the kernel
+        * and read with IORING_OP_READ_FIXED; if the registration fails, e.g. due to RLIMIT_MEMLOCK, they are read
+        * with IORING_OP_READV. One thread reaps the completions, converts the data and calls the callbacks.
+        */
+        class IoUringBackend : public AsyncReadBackendBase
+        {
+        public:
+          /** @returns Returns the backend or nullptr if io_uring is not supported by the system. */
+          static shared_ptr<AsyncReadBackendBase> create()
+          {
+            shared_ptr<IoUringBackend> backend(new IoUringBackend());
+            if (false == backend->init())
+            {
+              return nullptr;
+            }
+
+            backend->thread_ = thread(&IoUringBackend::completionLoop, backend.get());
+            return backend;
+          }
+
+          ~IoUringBackend()
+          {
+            if (this->thread_.joinable())
+            {
+              this->wait();
+              {
+                lock_guard<mutex> lock(this->mutex_);
+                io_uring_sqe* sqe = this->nextSqe();
+                sqe->opcode = IORING_OP_NOP;
+                sqe->user_data = 0;
+                this->flush();
+              }
+
+              this->thread_.join();
+            }
+
+            if (this->buffers_ != MAP_FAILED)
+            {
+              munmap(this->buffers_, NofBuffers * BufferSize);
+            }
+
+            if (this->sqes_ != MAP_FAILED)
+            {
+              munmap(this->sqes_, this->sqesSize_);
+            }
+
+            if (this->cqRing_ != MAP_FAILED && this->cqRing_ != this->sqRing_)
+            {
+              munmap(this->cqRing_, this->cqRingSize_);
+            }
+
+            if (this->sqRing_ != MAP_FAILED)
+            {
+              munmap(this->sqRing_, this->sqRingSize_);
+            }
+
+            if (this->ringFd_ >= 0)
+            {
+              close(this->ringFd_);
+            }
+          }
+
+          AsyncReadBackend getType() const override
+          {
+            return AsyncReadBackend::IoUring;
+          }
+
+          void submit(Request* request) override
+          {
+            {
+              lock_guard<mutex> lock(this->mutex_);
+              for (Chunk& chunk : request->chunks)
+              {
+                this->waiting_.push_back(&chunk);
+              }
+
+              this->inFlight_ += request->chunks.size();
+              this->dispatch();
+            }
+
+            this->completeFailed();
+          }
+
+          void wait() override
+          {
+            unique_lock<mutex> lock(this->mutex_);
+            this->idle_.wait(lock, [this] { return this->inFlight_ == 0; });
+          }
+
+        private:
+          /** @brief Number of entries of the submission queue, more than chunks and stop requests in flight. */
+          static const unsigned NofEntries = 64;
+
+          IoUringBackend() :
+            ringFd_(-1),
+            sqRing_(MAP_FAILED),
+            cqRing_(MAP_FAILED),
+            sqes_(MAP_FAILED),
+            buffers_(MAP_FAILED),
+            sqRingSize_(0),
+            cqRingSize_(0),
+            sqesSize_(0),
+            fixed_(false),
+            toSubmit_(0),
+            inFlight_(0)
+          {
+          }
+
+          IoUringBackend(const IoUringBackend&);
+          IoUringBackend& operator=(const IoUringBackend&);
+
+          bool init()
+          {
+            io_uring_params params;
+            memset(&params, 0, sizeof(params));
+            this->ringFd_ = static_cast<int>(syscall(__NR_io_uring_setup, NofEntries, &params));
+            if (this->ringFd_ < 0)
+            {
+              return false;
+            }
+
+            this->sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            this->cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (singleMmap)
+            {
+              this->sqRingSize_ = this->cqRingSize_ = max(this->sqRingSize_, this->cqRingSize_);
+            }
+
+            this->sqRing_ = mmap(nullptr, this->sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd_, IORING_OFF_SQ_RING);
+            if (this->sqRing_ == MAP_FAILED)
+            {
+              return false;
+            }
+
+            this->cqRing_ = singleMmap ? this->sqRing_ : mmap(nullptr, this->cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd_, IORING_OFF_CQ_RING);
+            if (this->cqRing_ == MAP_FAILED)
+            {
+              return false;
+            }
+
+            this->sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+            this->sqes_ = mmap(nullptr, this->sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd_, IORING_OFF_SQES);
+            if (this->sqes_ == MAP_FAILED)
+            {
+              return false;
+            }
+
+            uint8_t* sq = static_cast<uint8_t*>(this->sqRing_);
+            this->sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            this->sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            this->sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+            uint8_t* cq = static_cast<uint8_t*>(this->cqRing_);
+            this->cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            this->cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            this->cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            this->cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+            this->buffers_ = mmap(nullptr, NofBuffers * BufferSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (this->buffers_ == MAP_FAILED)
+            {
+              return false;
+            }
+
+            for (size_t i = 0; i < NofBuffers; ++i)
+            {
+              this->iovecs_[i].iov_base = this->getBuffer(i);
+              this->iovecs_[i].iov_len = BufferSize;
+              this->freeBuffers_.push_back(i);
+            }
+
+            this->fixed_ = syscall(__NR_io_uring_register, this->ringFd_, IORING_REGISTER_BUFFERS, this->iovecs_, NofBuffers) == 0;
+            return true;
+          }
+
+          uint8_t* getBuffer(size_t index) const
+          {
+            return static_cast<uint8_t*>(this->buffers_) + index * BufferSize;
+          }
+
+          /** @brief Returns the next submission queue entry, cleared. Requires mutex_. */
+          io_uring_sqe* nextSqe()
+          {
+            const unsigned tail = *this->sqTail_;
+            const unsigned index = tail & this->sqMask_;
+            io_uring_sqe* sqe = static_cast<io_uring_sqe*>(this->sqes_) + index;
+            memset(sqe, 0, sizeof(io_uring_sqe));
+            this->sqArray_[index] = index;
+            __atomic_store_n(this->sqTail_, tail + 1, __ATOMIC_RELEASE);
+            ++this->toSubmit_;
+            return sqe;
+          }
+
+          /** @brief Queues the read of the remaining bytes of a chunk to its buffer. Requires mutex_. */
+          void queueRead(Chunk* chunk)
+          {
+            uint8_t* buffer = this->getBuffer(chunk->buffer) + chunk->done;
+            const unsigned bytes = static_cast<unsigned>(chunk->bytes - chunk->done);
+            io_uring_sqe* sqe = this->nextSqe();
+            sqe->fd = chunk->request->file->getFd();
+            sqe->off = chunk->offset + chunk->done;
+            sqe->user_data = reinterpret_cast<uint64_t>(chunk);
+            if (this->fixed_)
+            {
+              sqe->opcode = IORING_OP_READ_FIXED;
+              sqe->addr = reinterpret_cast<uint64_t>(buffer);
+              sqe->len = bytes;
+              sqe->buf_index = static_cast<uint16_t>(chunk->buffer);
+            }
+            else
+            {
+              this->iovecs_[chunk->buffer].iov_base = buffer;
+              this->iovecs_[chunk->buffer].iov_len = bytes;
+              sqe->opcode = IORING_OP_READV;
+              sqe->addr = reinterpret_cast<uint64_t>(&this->iovecs_[chunk->buffer]);
+              sqe->len = 1;
+            }
+          }
+
+          /** @brief Assigns the free buffers to waiting chunks and submits them. Requires mutex_. */
+          void dispatch()
+          {
+            while (false == this->waiting_.empty() && false == this->freeBuffers_.empty())
+            {
+              Chunk* chunk = this->waiting_.front();
+              this->waiting_.pop_front();
+              chunk->buffer = this->freeBuffers_.back();
+              this->freeBuffers_.pop_back();
+              this->queueRead(chunk);
+            }
+
+            this->flush();
+          }
+
+          /** @brief Submits all queued entries to the kernel. Requires mutex_. */
+          void flush()
+          {
+            while (this->toSubmit_ > 0)
+            {
+              const long res = syscall(__NR_io_uring_enter, this->ringFd_, this->toSubmit_, 0, 0, nullptr, 0);
+              if (res >= 0)
+              {
+                this->toSubmit_ -= static_cast<unsigned>(res);
+              }
+              else if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+              {
+                this_thread::yield();
+              }
+              else
+              {
+                // without SQPOLL the kernel only consumes entries in io_uring_enter, so the entries can be taken back
+                unsigned tail = *this->sqTail_;
+                for (; this->toSubmit_ > 0; --this->toSubmit_)
+                {
+                  --tail;
+                  const io_uring_sqe& sqe = static_cast<io_uring_sqe*>(this->sqes_)[tail & this->sqMask_];
+                  if (sqe.user_data != 0)
+                  {
+                    this->failed_.push_back(reinterpret_cast<Chunk*>(sqe.user_data));
+                  }
+                }
+
+                __atomic_store_n(this->sqTail_, tail, __ATOMIC_RELEASE);
+              }
+            }
+          }
+
+          /** @brief Completes the chunks that could not be submitted with an error. Must be called without mutex_. */
+          void completeFailed()
+          {
+            vector<Chunk*> failed;
+            {
+              lock_guard<mutex> lock(this->mutex_);
+              failed.swap(this->failed_);
+            }
+
+            for (Chunk* chunk : failed)
+            {
+              this->release(chunk, ErrorCodes::InternalError);
+            }
+          }
+
+          /** @brief Reaps the completions until the stop request is completed. */
+          void completionLoop()
+          {
+            vector<pair<Chunk*, int>> completions;
+            for (;;)
+            {
+              syscall(__NR_io_uring_enter, this->ringFd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+              {
+                // the chunks have been queued with mutex_ locked, which orders their data before the completion
+                lock_guard<mutex> lock(this->mutex_);
+                unsigned head = *this->cqHead_;
+                const unsigned tail = __atomic_load_n(this->cqTail_, __ATOMIC_ACQUIRE);
+                for (; head != tail; ++head)
+                {
+                  const io_uring_cqe& cqe = this->cqes_[head & this->cqMask_];
+                  completions.push_back(make_pair(reinterpret_cast<Chunk*>(cqe.user_data), cqe.res));
+                }
+
+                __atomic_store_n(this->cqHead_, head, __ATOMIC_RELEASE);
+              }
+
+              for (auto& completion : completions)
+              {
+                if (completion.first == nullptr)
+                {
+                  return;
+                }
+
+                this->onCompletion(completion.first, completion.second);
+              }
+
+              completions.clear();
+            }
+          }
+
+          void onCompletion(Chunk* chunk, int result)
+          {
+            if (result > 0 && chunk->done + static_cast<size_t>(result) < chunk->bytes)
+            {
+              // short read, read the remaining bytes
+              chunk->done += static_cast<size_t>(result);
+              {
+                lock_guard<mutex> lock(this->mutex_);
+                this->queueRead(chunk);
+                this->flush();
+              }
+
+              this->completeFailed();
+              return;
+            }
+
+            this->release(chunk, result > 0 ? ErrorCodes::Success : ErrorCodes::InternalError);
+          }
+
+          /** @brief Completes a chunk and hands its buffer to the next waiting chunk. */
+          void release(Chunk* chunk, int error)
+          {
+            const size_t buffer = chunk->buffer;
+            complete(*chunk, this->getBuffer(buffer), error);
+
+            {
+              lock_guard<mutex> lock(this->mutex_);
+              this->freeBuffers_.push_back(buffer);
+              this->dispatch();
+              if (--this->inFlight_ == 0)
+              {
+                this->idle_.notify_all();
+              }
+            }
+
+            this->completeFailed();
+          }
+
+          int ringFd_;
+          void* sqRing_;
+          void* cqRing_;
+          void* sqes_;
+
+          /** @brief The I/O buffers, NofBuffers * BufferSize bytes. */
+          void* buffers_;
+
+          size_t sqRingSize_;
+          size_t cqRingSize_;
+          size_t sqesSize_;
+
+          unsigned* sqTail_;
+          unsigned sqMask_;
+          unsigned* sqArray_;
+          unsigned* cqHead_;
+          unsigned* cqTail_;
+          unsigned cqMask_;
+          io_uring_cqe* cqes_;
+
+          /** @brief TRUE if the buffers are registered with the kernel. */
+          bool fixed_;
+
+          /** @brief One vector per buffer, registered or used by IORING_OP_READV. */
+          iovec iovecs_[NofBuffers];
+
+          /** @brief Protects the submission queue, the buffers and the counters. */
+          mutex mutex_;
+
+          /** @brief Signaled if all chunks have been completed. */
+          condition_variable idle_;
+
+          /** @brief Number of entries queued, but not submitted to the kernel. */
+          unsigned toSubmit_;
+
+          /** @brief Number of chunks submitted, but not completed. */
+          size_t inFlight_;
+
+          /** @brief Indices of the buffers not assigned to a chunk. */
+          vector<size_t> freeBuffers_;
+
+          /** @brief Chunks whose submission has failed. */
+          vector<Chunk*> failed_;
+
+          /** @brief Chunks waiting for a buffer, in order of submission. */
+          deque<Chunk*> waiting_;
+
+          /** @brief The completion thread. */
+          thread thread_;
+        };
+#endif
+
+        shared_ptr<AsyncReadBackendBase> createBackend(AsyncReadBackend backend)
+        {
+#ifdef DAIEX_IO_URING
+          if (backend == AsyncReadBackend::IoUring)
+          {
+            shared_ptr<AsyncReadBackendBase> ioUring = IoUringBackend::create();
+            if (ioUring)
+            {
+              return ioUring;
+            }
+          }
+#else
+          (void)backend;
+#endif
+
+          return make_shared<ThreadPoolBackend>();
+        }
+      }
+
+      shared_ptr<AsyncFile> AsyncFile::open(const string& filename)
+      {
+        const int fd = Platform::fileOpenRead(filename);
+        if (fd < 0)
+        {
+          return nullptr;
+        }
+
+        return shared_ptr<AsyncFile>(new AsyncFile(fd));
+      }
+
+      AsyncFile::AsyncFile(int fd) :
+        fd_(fd),
+        pending_(0)
+      {
+      }
+
+      AsyncFile::~AsyncFile()
+      {
+        Platform::fileClose(this->fd_);
+      }
+
+      int AsyncFile::getFd() const
+      {
+        return this->fd_;
+      }
+
+      void AsyncFile::beginRead()
+      {
+        lock_guard<mutex> lock(this->mutex_);
+        ++this->pending_;
+      }
+
+      void AsyncFile::endRead()
+      {
+        lock_guard<mutex> lock(this->mutex_);
+        if (--this->pending_ == 0)
+        {
+          this->idle_.notify_all();
+        }
+      }
+
+      void AsyncFile::wait()
+      {
+        unique_lock<mutex> lock(this->mutex_);
+        this->idle_.wait(lock, [this] { return this->pending_ == 0; });
+      }
+
+      AsyncReadService::AsyncReadService()
+      {
+      }
+
+      AsyncReadService& AsyncReadService::instance()
+      {
+        // never destroyed, so the I/O threads are not joined while the library is unloaded
+        static AsyncReadService* service = new AsyncReadService();
+        return *service;
+      }
+
+      int AsyncReadService::setBackend(AsyncReadBackend backend)
+      {
+        shared_ptr<AsyncReadBackendBase> previous;
+        {
+          lock_guard<mutex> lock(this->mutex_);
+          if (this->backend_ && this->backend_->getType() == backend)
+          {
+            return ErrorCodes::Success;
+          }
+
+          shared_ptr<AsyncReadBackendBase> next = createBackend(backend);
+          if (next->getType() != backend && this->backend_)
+          {
+            return ErrorCodes::InternalError;
+          }
+
+          previous = this->backend_;
+          this->backend_ = next;
+          if (next->getType() != backend)
+          {
+            return ErrorCodes::InternalError;
+          }
+        }
+
+        if (previous)
+        {
+          previous->wait();
+        }
+
+        return ErrorCodes::Success;
+      }
+
+      AsyncReadBackend AsyncReadService::getBackend()
+      {
+        return this->getBackendInstance()->getType();
+      }
+
+      shared_ptr<AsyncReadBackendBase> AsyncReadService::getBackendInstance()
+      {
+        lock_guard<mutex> lock(this->mutex_);
+        if (!this->backend_)
+        {
+          this->backend_ = createBackend(AsyncReadBackend::IoUring);
+        }
+
+        return this->backend_;
+      }
+
+      int AsyncReadService::submit(shared_ptr<AsyncFile>& file, const string& filename, RawValueType type, double scale, const vector<RawSegment>& segments, void* values, bool isDouble, AsyncReadCallback callback, StatisticsCollector* statistics)
+      {
+        DAIEX_TRACE_SCOPE("AsyncRead::submit");
+        if (!file)
+        {
+          file = AsyncFile::open(filename);
+          if (!file)
+          {
+            return ErrorCodes::FileOpenError;
+          }
+        }
+
+        Request* request = new Request();
+        request->file = file;
+        request->type = type;
+        request->scale = scale;
+        request->segments = segments;
+        request->values = values;
+        request->isDouble = isDouble;
+        request->callback = callback;
+        request->statistics = statistics;
+        request->error = ErrorCodes::Success;
+
+        const size_t valueSize = getValueSize(type);
+        const size_t maxValues = BufferSize / valueSize;
+        for (const RawSegment& segment : request->segments)
+        {
+          if (segment.groupSize == 0)
+          {
+            continue;
+          }
+
+          const size_t groupsPerChunk = (maxValues - segment.groupSize) / segment.srcStride + 1;
+          for (size_t group = 0; group < segment.nofGroups; group += groupsPerChunk)
+          {
+            Chunk chunk;
+            chunk.request = request;
+            chunk.segment = &segment;
+            chunk.firstGroup = group;
+            chunk.nofGroups = min(groupsPerChunk, segment.nofGroups - group);
+            chunk.offset = segment.fileOffset + static_cast<uint64_t>(group) * segment.srcStride * valueSize;
+            chunk.bytes = ((chunk.nofGroups - 1) * segment.srcStride + segment.groupSize) * valueSize;
+            chunk.done = 0;
+            chunk.buffer = 0;
+            request->chunks.push_back(chunk);
+          }
+        }
+
+        file->beginRead();
+        if (request->chunks.empty())
+        {
+          finish(request);
+          return ErrorCodes::Success;
+        }
+
+        request->remaining = request->chunks.size();
+        this->getBackendInstance()->submit(request);
+        return ErrorCodes::Success;
+      }
+
+      void AsyncReadService::close(shared_ptr<AsyncFile>& file)
+      {
+        if (file)
+        {
+          file->wait();
+          file.reset();
+        }
+      }
+
+      int AsyncRead::setBackend(AsyncReadBackend backend)
+      {
+        return AsyncReadService::instance().setBackend(backend);
+      }
+
+      AsyncReadBackend AsyncRead::getBackend()
+      {
+        return AsyncReadService::instance().getBackend();
+      }
+    }
+  }
+}
@@ -0,0 +1,118 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+#include "batchconverter.h"
+
+#include "batchconverterpimpl.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      BatchConverter::BatchConverter(FileType outputType, const std::string& outputDirectory)
+      {
+        this->pimpl = new BatchConverter::Impl(outputType, outputDirectory);
+      }
+
+      BatchConverter::~BatchConverter()
+      {
+        delete this->pimpl;
+      }
+
+      int BatchConverter::addFile(const std::string& inputFilename, FileType inputType)
+      {
+        return this->pimpl->addFile(inputFilename, inputType);
+      }
+
+      int BatchConverter::addFiles(const std::string& pattern, FileType inputType)
+      {
+        return this->pimpl->addFiles(pattern, inputType);
+      }
+
+      void BatchConverter::setNofThreads(size_t nofThreads)
+      {
+        this->pimpl->setNofThreads(nofThreads);
+      }
+
+      int BatchConverter::setMaxBufferMemory(uint64_t nofBytes)
+      {
+        return this->pimpl->setMaxBufferMemory(nofBytes);
+      }
+
+      int BatchConverter::setMaxTempFiles(size_t nofFiles)
+      {
+        return this->pimpl->setMaxTempFiles(nofFiles);
+      }
+
+      int BatchConverter::setChunkSize(size_t nofSamples)
+      {
+        return this->pimpl->setChunkSize(nofSamples);
+      }
+
+      void BatchConverter::setSplitSize(uint64_t nofSamples)
+      {
+        this->pimpl->setSplitSize(nofSamples);
+      }
+
+      void BatchConverter::setDataType(IqDataType dataType)
+      {
+        this->pimpl->setDataType(dataType);
+      }
+
+      int BatchConverter::convert()
+      {
+        return this->pimpl->convert();
+      }
+
+      size_t BatchConverter::getNofFiles() const
+      {
+        return this->pimpl->getNofFiles();
+      }
+
+      std::string BatchConverter::getInputFilename(size_t index) const
+      {
+        return this->pimpl->getInputFilename(index);
+      }
+
+      std::string BatchConverter::getOutputFilename(size_t index) const
+      {
+        return this->pimpl->getOutputFilename(index);
+      }
+
+      int BatchConverter::getResult(size_t index) const
+      {
+        return this->pimpl->getResult(index);
+      }
+
+      uint64_t BatchConverter::getBytesConverted() const
+      {
+        return this->pimpl->getBytesConverted();
+      }
+
+      double BatchConverter::getElapsedSeconds() const
+      {
+        return this->pimpl->getElapsedSeconds();
+      }
+
+      double BatchConverter::getMegabytesPerSecond() const
+      {
+        return this->pimpl->getMegabytesPerSecond();
+      }
+    }
+  }
+}
@@ -0,0 +1,571 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+#include "batchconverterpimpl.h"
+
+#include <chrono>
+
+#include "platform.h"
+
+using namespace std;
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      BatchConverter::Impl::Impl(FileType outputType, const std::string& outputDirectory) :
+        outputType_(outputType),
+        outputDirectory_(outputDirectory),
+        nofThreads_(0),
+        maxBufferMemory_(268435456),
+        maxTempFiles_(64),
+        chunkSize_(262144),
+        splitSize_(16777216),
+        dataType_(IqDataType::Float32),
+        dataTypeSet_(false),
+        elapsedSeconds_(0)
+      {
+      }
+
+      int BatchConverter::Impl::addFile(const std::string& inputFilename, FileType inputType)
+      {
+        if (false == Platform::isFileAccessible(inputFilename))
+        {
+          return ErrorCodes::FileNotFound;
+        }
+
+        // the output file gets the name of the input file with the extension of the output type
+        string name = inputFilename.substr(inputFilename.find_last_of("/\\") + 1);
+        const string iqtarExtension = ".iq.tar";
+        if (name.size() > iqtarExtension.size() && name.compare(name.size() - iqtarExtension.size(), iqtarExtension.size(), iqtarExtension) == 0)
+        {
+          name.resize(name.size() - iqtarExtension.size());
+        }
+        else if (name.find_last_of('.') != string::npos && name.find_last_of('.') > 0)
+        {
+          name.resize(name.find_last_of('.'));
+        }
+
+        string extension;
+        switch (this->outputType_)
+        {
+        case FileType::Iqtar:
+          extension = iqtarExtension;
+          break;
+        case FileType::IQW:
+          extension = ".iqw";
+          break;
+        case FileType::IQX:
+          extension = ".iqx";
+          break;
+        case FileType::WV:
+          extension = ".wv";
+          break;
+        case FileType::AID:
+          extension = ".aid";
+          break;
+        case FileType::Csv:
+          extension = ".csv";
+          break;
+        default:
+          extension = ".mat";
+          break;
+        }
+
+        Job job;
+        job.inputFilename = inputFilename;
+        job.inputType = inputType;
+        job.outputFilename = this->outputDirectory_;
+        if (false == job.outputFilename.empty() && job.outputFilename.find_last_of("/\\") != job.outputFilename.size() - 1)
+        {
+          job.outputFilename += "/";
+        }
+        job.outputFilename += name + extension;
+        job.result = ErrorCodes::Success;
+        job.bytesConverted = 0;
+        this->jobs_.push_back(job);
+
+        return ErrorCodes::Success;
+      }
+
+      int BatchConverter::Impl::addFiles(const std::string& pattern, FileType inputType)
+      {
+        const vector<string> files = Platform::findFiles(pattern);
+        if (files.empty())
+        {
+          return ErrorCodes::FileNotFound;
+        }
+
+        for (const auto& file : files)
+        {
+          int ret = this->addFile(file, inputType);
+          if (ret != ErrorCodes::Success)
+          {
+            return ret;
+          }
+        }
+
+        return ErrorCodes::Success;
+      }
+
+      void BatchConverter::Impl::setNofThreads(size_t nofThreads)
+      {
+        this->nofThreads_ = nofThreads;
+      }
+
+      int BatchConverter::Impl::setMaxBufferMemory(uint64_t nofBytes)
+      {
+        if (nofBytes == 0)
+        {
+          return ErrorCodes::InvalidArraySize;
+        }
+
+        this->maxBufferMemory_ = nofBytes;
+        return ErrorCodes::Success;
+      }
+
+      int BatchConverter::Impl::setMaxTempFiles(size_t nofFiles)
+      {
+        if (nofFiles == 0)
+        {
+          return ErrorCodes::InvalidArraySize;
+        }
+
+        this->maxTempFiles_ = nofFiles;
+        return ErrorCodes::Success;
+      }
+
+      int BatchConverter::Impl::setChunkSize(size_t nofSamples)
+      {
+        if (nofSamples == 0)
+        {
+          return ErrorCodes::InvalidArraySize;
+        }
+
+        this->chunkSize_ = nofSamples;
+        return ErrorCodes::Success;
+      }
+
+      void BatchConverter::Impl::setSplitSize(uint64_t nofSamples)
+      {
+        this->splitSize_ = nofSamples;
+      }
+
+      void BatchConverter::Impl::setDataType(IqDataType dataType)
+      {
+        this->dataType_ = dataType;
+        this->dataTypeSet_ = true;
+      }
+
+      size_t BatchConverter::Impl::getNofFiles() const
+      {
+        return this->jobs_.size();
+      }
+
+      std::string BatchConverter::Impl::getInputFilename(size_t index) const
+      {
+        return this->jobs_.at(index).inputFilename;
+      }
+
+      std::string BatchConverter::Impl::getOutputFilename(size_t index) const
+      {
+        return this->jobs_.at(index).outputFilename;
+      }
+
+      int BatchConverter::Impl::getResult(size_t index) const
+      {
+        return this->jobs_.at(index).result;
+      }
+
+      uint64_t BatchConverter::Impl::getBytesConverted() const
+      {
+        uint64_t bytes = 0;
+        for (const auto& job : this->jobs_)
+        {
+          bytes += job.bytesConverted;
+        }
+
+        return bytes;
+      }
+
+      double BatchConverter::Impl::getElapsedSeconds() const
+      {
+        return this->elapsedSeconds_;
+      }
+
+      double BatchConverter::Impl::getMegabytesPerSecond() const
+      {
+        if (this->elapsedSeconds_ <= 0)
+        {
+          return 0;
+        }
+
+        return static_cast<double>(this->getBytesConverted()) / 1e6 / this->elapsedSeconds_;
+      }
+
+      int BatchConverter::Impl::convert()
+      {
+        const auto start = chrono::steady_clock::now();
+
+        // largest files first, so that the end of the batch is not a single large file
+        vector<pair<uint64_t, size_t>> order;
+        for (size_t i = 0; i < this->jobs_.size(); ++i)
+        {
+          this->jobs_[i].result = ErrorCodes::Success;
+          this->jobs_[i].bytesConverted = 0;
+          order.push_back(make_pair(Platform::getFileSize(this->jobs_[i].inputFilename), i));
+        }
+        stable_sort(order.begin(), order.end(), [](const pair<uint64_t, size_t>& a, const pair<uint64_t, size_t>& b) { return a.first > b.first; });
+
+        Budget memory(this->maxBufferMemory_);
+        Budget tempFiles(this->maxTempFiles_);
+        {
+          WorkStealingPool pool(this->nofThreads_);
+          for (const auto& file : order)
+          {
+            Job& job = this->jobs_[file.second];
+            pool.submit([this, &pool, &memory, &tempFiles, &job]()
+            {
+              try
+              {
+                job.result = this->convertFile(pool, memory, tempFiles, job);
+              }
+              catch (const DaiException& e)
+              {
+                job.result = e.code();
+              }
+              catch (...)
+              {
+                job.result = ErrorCodes::InternalError;
+              }
+            });
+          }
+
+          pool.wait();
+        }
+
+        this->elapsedSeconds_ = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        for (const auto& job : this->jobs_)
+        {
+          if (job.result != ErrorCodes::Success)
+          {
+            return job.result;
+          }
+        }
+
+        return ErrorCodes::Success;
+      }
+
+      size_t BatchConverter::Impl::getNofTempFiles(const FormatConverter::Impl::Conversion& conversion) const
+      {
+        const vector<ChannelInfo>& channelInfos = conversion.channelInfos;
+        switch (this->outputType_)
+        {
+        case FileType::Iqtar:
+          // the data file is written directly, if all channels have the same length
+          for (const auto& channel : channelInfos)
+          {
+            if (channel.getSamples() != channelInfos.front().getSamples())
+            {
+              return 1;
+            }
+          }
+          return 0;
+
+        case FileType::Matlab4:
+          // one temporary file per array
+          return channelInfos.size() * ((conversion.outputFormat == IqDataFormat::Real) ? 1 : 2);
+
+        default:
+          return 0;
+        }
+      }
+
+      int BatchConverter::Impl::convertFile(WorkStealingPool& pool, Budget& memory, Budget& tempFiles, Job& job)
+      {
+        if (job.inputFilename == job.outputFilename)
+        {
+          return ErrorCodes::InconsistentInputData;
+        }
+
+        FormatConverter::Impl converter(job.inputFilename, job.inputType, job.outputFilename, this->outputType_);
+        if (this->dataTypeSet_)
+        {
+          converter.setDataType(this->dataType_);
+        }
+
+        FormatConverter::Impl::Conversion conversion;
+        int ret = converter.openInput(conversion);
+        if (ret != ErrorCodes::Success)
+        {
+          return ret;
+        }
+
+        uint64_t nofSamples = 0;
+        for (const auto& channel : conversion.channelInfos)
+        {
+          nofSamples = max<uint64_t>(nofSamples, channel.getSamples());
+        }
+
+        // chunk buffers hold complex values, since real data may be expanded by the conversion
+        const uint64_t valueSize = (conversion.dataType == IqDataType::Float64) ? sizeof(double) : sizeof(float);
+        const uint64_t bytesPerSample = 2 * valueSize * conversion.channelInfos.size();
+        const size_t chunkSize = static_cast<size_t>(min<uint64_t>(this->chunkSize_, max<uint64_t>(1, this->maxBufferMemory_ / bytesPerSample)));
+        const uint64_t bytesPerChunk = chunkSize * bytesPerSample;
+
+        // two ranges in flight overlap reading and writing, large files are read by all idle workers
+        size_t nofSlots = (nofSamples > this->splitSize_) ? max<size_t>(2, pool.getNofThreads()) : 2;
+        nofSlots = static_cast<size_t>(max<uint64_t>(1, min<uint64_t>(nofSlots, this->maxBufferMemory_ / bytesPerChunk)));
+
+        // The input is opened first, since both budgets depend on its metadata. Open input files are not budgeted,
+        // at most one per worker is waiting here. Memory is always acquired before temporary files, so files
+        // waiting for both budgets cannot block each other.
+        const uint64_t memoryAcquired = memory.acquire(nofSlots * bytesPerChunk);
+        const uint64_t tempFilesAcquired = tempFiles.acquire(this->getNofTempFiles(conversion));
+
+        try
+        {
+          ret = converter.openOutput(conversion);
+          if (ret == ErrorCodes::Success)
+          {
+            if (conversion.dataType == IqDataType::Float64)
+            {
+              ret = this->runRanges<double>(pool, converter, conversion, chunkSize, nofSlots, job.bytesConverted);
+            }
+            else
+            {
+              ret = this->runRanges<float>(pool, converter, conversion, chunkSize, nofSlots, job.bytesConverted);
+            }
+          }
+
+          if (conversion.writer != nullptr)
+          {
+            int closeRet = conversion.writer->close();
+            ret = (ret != ErrorCodes::Success) ? ret : closeRet;
+          }
+        }
+        catch (...)
+        {
+          ret = ErrorCodes::InternalError;
+        }
+
+        memory.release(memoryAcquired);
+        tempFiles.release(tempFilesAcquired);
+        return ret;
+      }
+
+      template<typename T>
+      int BatchConverter::Impl::runRanges(WorkStealingPool& pool, const FormatConverter::Impl& converter, FormatConverter::Impl::Conversion& conversion, size_t chunkSize, size_t nofSlots, uint64_t& bytesConverted)
+      {
+        const vector<ChannelInfo>& channelInfos = conversion.channelInfos;
+        uint64_t nofSamples = 0;
+        for (const auto& channel : channelInfos)
+        {
+          nofSamples = max<uint64_t>(nofSamples, channel.getSamples());
+        }
+
+        // range tasks still queued when the file is finished keep the state alive, but do not claim ranges
+        auto state = make_shared<RangeState<T>>();
+        state->nofRanges = (nofSamples + chunkSize - 1) / chunkSize;
+        nofSlots = static_cast<size_t>(max<uint64_t>(1, min<uint64_t>(nofSlots, state->nofRanges)));
+        state->slots.resize(nofSlots);
+        for (auto& slot : state->slots)
+        {
+          slot.values.assign(channelInfos.size(), vector<T>(2 * chunkSize));
+          slot.sizes.assign(channelInfos.size(), 0);
+        }
+        state->ready.assign(nofSlots, false);
+        state->readers.push_back(move(conversion.reader));
+        state->nextRange = 0;
+        state->written = 0;
+        state->reading = 0;
+        state->finished = false;
+        state->error = ErrorCodes::Success;
+
+        const FormatConverter::Impl* converterPtr = &converter;
+        const FormatConverter::Impl::Conversion* conversionPtr = &conversion;
+        auto submitRange = [&pool, state, converterPtr, conversionPtr, chunkSize]()
+        {
+          pool.submit([state, converterPtr, conversionPtr, chunkSize]()
+          {
+            Impl::readNextRange<T>(*state, converterPtr, conversionPtr, chunkSize);
+          });
+        };
+
+        // the first range is read by this task itself
+        for (size_t i = 1; i < nofSlots; ++i)
+        {
+          submitRange();
+        }
+
+        const size_t valuesPerSample = (conversion.outputFormat == IqDataFormat::Real) ? 1 : 2;
+        vector<T*> values(channelInfos.size());
+        for (uint64_t range = 0; range < state->nofRanges; ++range)
+        {
+          FormatConverter::Impl::Chunk<T>& slot = state->slots[range % nofSlots];
+          {
+            unique_lock<mutex> lock(state->mutex);
+            while (state->error == ErrorCodes::Success && false == state->ready[range % nofSlots])
+            {
+              // read the range itself if no worker has claimed it yet, e.g. because all workers are busy
+              if (state->nextRange == range)
+              {
+                lock.unlock();
+                Impl::readNextRange<T>(*state, converterPtr, conversionPtr, chunkSize);
+                lock.lock();
+              }
+              else
+              {
+                state->condition.wait(lock);
+              }
+            }
+
+            if (state->error != ErrorCodes::Success)
+            {
+              break;
+            }
+          }
+
+          for (size_t ch = 0; ch < values.size(); ++ch)
+          {
+            values[ch] = slot.values[ch].data();
+          }
+
+          int ret = conversion.writer->appendChannels(values, slot.sizes);
+          for (size_t ch = 0; ch < values.size(); ++ch)
+          {
+            bytesConverted += slot.sizes[ch] / valuesPerSample * ((conversion.inputFormat == IqDataFormat::Real) ? 1 : 2) * sizeof(T);
+          }
+
+          bool submit = false;
+          {
+            lock_guard<mutex> lock(state->mutex);
+            if (ret != ErrorCodes::Success)
+            {
+              state->error = ret;
+              break;
+            }
+
+            state->ready[range % nofSlots] = false;
+            ++state->written;
+            submit = nofSlots > 1 && state->nextRange < state->nofRanges;
+          }
+
+          if (submit)
+          {
+            submitRange();
+          }
+        }
+
+        // wait for ranges being read, then release buffers and readers of the file
+        unique_lock<mutex> lock(state->mutex);
+        state->finished = true;
+        state->condition.wait(lock, [&state] { return state->reading == 0; });
+        state->slots.clear();
+        state->readers.clear();
+        return state->error;
+      }
+
+      template<typename T>
+      bool BatchConverter::Impl::readNextRange(RangeState<T>& state, const FormatConverter::Impl* converter, const FormatConverter::Impl::Conversion* conversion, size_t chunkSize)
+      {
+        uint64_t range = 0;
+        unique_ptr<IDataImportExport> reader;
+        {
+          lock_guard<mutex> lock(state.mutex);
+          if (state.finished || state.error != ErrorCodes::Success || state.nextRange >= state.nofRanges
+            || state.nextRange >= state.written + state.slots.size())
+          {
+            return false;
+          }
+
+          range = state.nextRange++;
+          ++state.reading;
+          if (false == state.readers.empty())
+          {
+            reader = move(state.readers.back());
+            state.readers.pop_back();
+          }
+        }
+
+        FormatConverter::Impl::Chunk<T>& slot = state.slots[range % state.slots.size()];
+        const vector<ChannelInfo>& channelInfos = conversion->channelInfos;
+        const size_t valuesPerSample = (conversion->inputFormat == IqDataFormat::Real) ? 1 : 2;
+        int ret = ErrorCodes::Success;
+        try
+        {
+          if (reader == nullptr)
+          {
+            vector<string> arrayNames;
+            ret = converter->openReader(reader, arrayNames);
+            if (ret != ErrorCodes::Success)
+            {
+              throw DaiException(ret);
+            }
+          }
+
+          const uint64_t offset = range * chunkSize;
+          for (size_t ch = 0; ch < channelInfos.size(); ++ch)
+          {
+            const uint64_t samples = static_cast<uint64_t>(channelInfos[ch].getSamples());
+            const size_t nofSamples = (offset < samples) ? static_cast<size_t>(min<uint64_t>(samples - offset, chunkSize)) : 0;
+            slot.sizes[ch] = valuesPerSample * nofSamples;
+            if (nofSamples > 0)
+            {
+              ret = reader->readChannel(channelInfos[ch].getChannelName(), slot.values[ch].data(), converter->getReadChannelCount(conversion->inputFormat, nofSamples), static_cast<size_t>(offset));
+              if (ret != ErrorCodes::Success)
+              {
+                throw DaiException(ret);
+              }
+            }
+
+            slot.sizes[ch] = FormatConverter::Impl::convertFormat(slot.values[ch].data(), slot.sizes[ch], conversion->inputFormat, conversion->outputFormat);
+          }
+        }
+        catch (const DaiException& e)
+        {
+          ret = e.code();
+        }
+        catch (...)
+        {
+          ret = ErrorCodes::InternalError;
+        }
+
+        lock_guard<mutex> lock(state.mutex);
+        --state.reading;
+        if (reader != nullptr)
+        {
+          state.readers.push_back(move(reader));
+        }
+
+        if (ret == ErrorCodes::Success)
+        {
+          state.ready[range % state.slots.size()] = true;
+        }
+        else if (state.error == ErrorCodes::Success)
+        {
+          state.error = ret;
+        }
+
+        state.condition.notify_all();
+        return true;
+      }
+    }
+  }
+}
@@ -36,8 +36,6 @@ namespace rohdeschwarz
   {
     namespace dataimportexport
     {
-      std::mutex Common::localeLock_;
-
       std::string Common::getVersion()
       {
         stringstream ss;
@@ -49,9 +49,10 @@ namespace rohdeschwarz
       const std::vector<std::string> CsvReader::boms_(boms, boms + 11);
     
 
-      CsvReader::CsvReader(const std::string& filename, IAnalyzeContent& updateContent) :
+      CsvReader::CsvReader(const std::string& filename, IAnalyzeContent& updateContent, StatisticsCollector& statistics) :
         filename_(filename),
         updateContent_(&updateContent),
+        statistics_(&statistics),
         initialized_(false),
         extractDecimalSeparator_(true),
         decimalSeperator_(Constants::SeparatorColon),
@@ -66,12 +67,15 @@ namespace rohdeschwarz
 
       size_t CsvReader::openStreamIgnoreBom(const std::string& filename, std::fstream& stream)
       {
+        StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Io);
         Platform::streamOpen(stream, filename, ios::in | ios::binary);
         if (false == stream.is_open())
         {
           throw DaiException(ErrorCodes::FileOpenError);
         }
 
+        this->statistics_->addSyscalls();
+
         // remove BOM, if existing
         string read;
         read.resize(4);
@@ -83,6 +87,7 @@ namespace rohdeschwarz
           {
             size_t bomSize = boms_[i].size();
             stream.seekg(bomSize, ios::beg);
+            this->statistics_->addSyscalls();
             return bomSize;
           }
         }
@@ -92,6 +97,7 @@ namespace rohdeschwarz
 
       void CsvReader::openStreamFeedForward(std::fstream& stream)
       {
+        StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Io);
         Platform::streamOpen(stream, this->filename_, ios::in | ios::binary);
         if (false == stream.is_open())
         {
@@ -99,6 +105,7 @@ namespace rohdeschwarz
         }
 
         stream.seekg(this->headerSectionEndOffset_, ios::beg);
+        this->statistics_->addSyscalls(2);
       }
 
       void CsvReader::analyzeContent()
@@ -113,6 +120,7 @@ namespace rohdeschwarz
           throw DaiException(ErrorCodes::FileNotFound);
         }
 
+        StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Parsing);
         fstream stream;
         try
         {
@@ -281,7 +289,11 @@ namespace rohdeschwarz
 
       void CsvReader::readLine(std::fstream& stream, std::string& line)
       {
-        getline(stream, line);
+        {
+          StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Io);
+          getline(stream, line);
+          this->statistics_->addRead(line.size() + 1);
+        }
 
         // right trim \r and \n
         line.erase(line.find_last_not_of('\n') + 1);
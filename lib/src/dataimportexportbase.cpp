@@ -155,6 +155,16 @@ namespace rohdeschwarz
         this->timestamp_ = timestamp;
       }
 
+      void DataImportExportBase::setStatisticsEnabled(bool enabled)
+      {
+        this->statistics_.setEnabled(enabled);
+      }
+
+      IoStatistics DataImportExportBase::getStatistics() const
+      {
+        return this->statistics_.get();
+      }
+
       bool DataImportExportBase::validateInputData(const std::vector<ChannelInfo>& channelInfos, const std::vector<size_t>& sizes, IqDataFormat format)
       {
         auto nofValueArrays = sizes.size();
@@ -15,6 +15,17 @@
 #include "wv.h"
 #include "aid.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include <iqxformat/iqxtypes.h>
+#include "rs_gx40x_global_frame_header_if_defs.h"
+
+#include "common.h"
+#include "errorcodes.h"
+#include "platform.h"
+
 using namespace std;
 
 namespace rohdeschwarz
@@ -23,6 +34,261 @@ namespace rohdeschwarz
   {
     namespace dataimportexport
     {
+      namespace
+      {
+        /** @brief Number of bytes read by detect(), the size of the IQX file preamble. */
+        const size_t DetectionBufferSize = 4096;
+
+        /** @brief Size of a tar header block. */
+        const size_t TarBlockSize = 512;
+
+        /** @brief Size of the text header of MAT files of version 5 and 7.3. */
+        const size_t MatHeaderSize = 128;
+
+        uint32_t readUint32(const uint8_t* data, bool bigEndian)
+        {
+          if (bigEndian)
+          {
+            return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+          }
+
+          return (uint32_t(data[3]) << 24) | (uint32_t(data[2]) << 16) | (uint32_t(data[1]) << 8) | uint32_t(data[0]);
+        }
+
+        /** @brief Verifies the checksum of a tar header, which is the only check of pre-POSIX headers without 'ustar' magic. */
+        bool isTarHeader(const uint8_t* header)
+        {
+          const char* field = reinterpret_cast<const char*>(header + 148);
+          size_t i = 0;
+          while (i < 8 && field[i] == ' ')
+          {
+            ++i;
+          }
+
+          uint32_t checksum = 0;
+          size_t digits = 0;
+          for (; i < 8 && field[i] >= '0' && field[i] <= '7'; ++i, ++digits)
+          {
+            checksum = checksum * 8 + (field[i] - '0');
+          }
+
+          if (digits == 0 || (i < 8 && field[i] != ' ' && field[i] != '\0'))
+          {
+            return false;
+          }
+
+          // the checksum field itself counts as spaces
+          uint32_t sum = 8 * ' ';
+          for (size_t n = 0; n < TarBlockSize; ++n)
+          {
+            if (n < 148 || n >= 156)
+            {
+              sum += header[n];
+            }
+          }
+
+          return sum == checksum;
+        }
+
+        /** @brief Checks if the name of a tar member is one of the names written to iq.tar files. */
+        bool isIqTarMemberName(const uint8_t* header)
+        {
+          const char* field = reinterpret_cast<const char*>(header);
+          string name(field, find(field, field + 100, '\0'));
+          name.erase(name.find_last_not_of(' ') + 1);
+          if (name.empty())
+          {
+            return false;
+          }
+
+          for (auto c : name)
+          {
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+              return false;
+            }
+          }
+
+          return Common::strEndsWithIgnoreCase(name, ".xml")
+            || Common::strEndsWithIgnoreCase(name, ".xslt")
+            || name.find(".complex.") != string::npos
+            || name.find(".real.") != string::npos
+            || name.find(".polar.") != string::npos;
+        }
+
+        bool isIqxPreamble(const uint8_t* data, size_t size)
+        {
+          return size >= sizeof(iqxsync) && memcmp(data, iqxsync, sizeof(iqxsync)) == 0;
+        }
+
+        /** @brief Searches the ZF frame magic word, which is written in little endian byte order. Returns the offset of the first frame or -1. */
+        int64_t findZfFrame(const uint8_t* data, size_t size)
+        {
+          for (size_t pos = 0; pos + 8 <= size; pos += 4)
+          {
+            // the frame length in 32 bit words includes the frame header
+            if (readUint32(data + pos, false) == kFRH_MAGIC_WORD && readUint32(data + pos + 4, false) >= sizeof(typFRH_FRAMEHEADER) / sizeof(uint32_t))
+            {
+              return static_cast<int64_t>(pos);
+            }
+          }
+
+          return -1;
+        }
+
+        /** @brief Returns the version of a MAT file of version 5 or 7.3, i.e. 0x0100 or 0x0200, or 0. */
+        uint16_t getMatHeaderVersion(const uint8_t* data, size_t size)
+        {
+          if (size < MatHeaderSize || memcmp(data, "MATLAB ", 7) != 0)
+          {
+            return 0;
+          }
+
+          // the endian indicator 'MI' is written in the byte order of the file
+          if (data[126] == 'I' && data[127] == 'M')
+          {
+            return static_cast<uint16_t>(data[124] | (data[125] << 8));
+          }
+
+          if (data[126] == 'M' && data[127] == 'I')
+          {
+            return static_cast<uint16_t>((data[124] << 8) | data[125]);
+          }
+
+          return 0;
+        }
+
+        /** @brief Validates the header of the first matrix of a MAT file of version 4, which has no file header. */
+        bool isMat4Header(const uint8_t* data, size_t size, bool bigEndian)
+        {
+          const size_t headerSize = 5 * sizeof(uint32_t);
+          if (size < headerSize)
+          {
+            return false;
+          }
+
+          // type = 1000 * byte order + 100 * 0 + 10 * precision + matrix type
+          const uint32_t type = readUint32(data, bigEndian);
+          const uint32_t mrows = readUint32(data + 4, bigEndian);
+          const uint32_t ncols = readUint32(data + 8, bigEndian);
+          const uint32_t imagf = readUint32(data + 12, bigEndian);
+          const uint32_t namlen = readUint32(data + 16, bigEndian);
+          if (type / 1000 != (bigEndian ? 1u : 0u) || (type / 100) % 10 != 0 || (type / 10) % 10 > 5 || type % 10 > 2)
+          {
+            return false;
+          }
+
+          if (imagf > 1 || namlen < 2 || namlen > size - headerSize || mrows > INT32_MAX || ncols > INT32_MAX)
+          {
+            return false;
+          }
+
+          const uint8_t* name = data + headerSize;
+          if (name[namlen - 1] != '\0')
+          {
+            return false;
+          }
+
+          for (uint32_t i = 0; i < namlen - 1; ++i)
+          {
+            if (name[i] < 0x20 || name[i] >= 0x7f)
+            {
+              return false;
+            }
+          }
+
+          return true;
+        }
+
+        /** @brief Checks for text, allowing tabs, line breaks and UTF-8 encoded characters. */
+        bool isText(const uint8_t* data, size_t size)
+        {
+          for (size_t i = 0; i < size; ++i)
+          {
+            const uint8_t c = data[i];
+            if ((c < 0x20 && c != '\t' && c != '\n' && c != '\r') || c == 0x7f)
+            {
+              return false;
+            }
+          }
+
+          return size > 0;
+        }
+
+        DetectionConfidence detectType(const uint8_t* data, size_t size, uint64_t fileSize, FileType& fileType)
+        {
+          if (isIqxPreamble(data, size))
+          {
+            fileType = FileType::IQX;
+            return DetectionConfidence::High;
+          }
+
+          if (size >= 6 && memcmp(data, "{TYPE:", 6) == 0)
+          {
+            fileType = FileType::WV;
+            return DetectionConfidence::High;
+          }
+
+          const uint16_t matVersion = getMatHeaderVersion(data, size);
+          if (matVersion == 0x0200)
+          {
+            fileType = FileType::Matlab73;
+            return DetectionConfidence::High;
+          }
+          else if (matVersion == 0x0100)
+          {
+            fileType = FileType::Matlab4;
+            return DetectionConfidence::Medium;
+          }
+
+          if (size >= TarBlockSize)
+          {
+            if (isTarHeader(data))
+            {
+              fileType = FileType::Iqtar;
+              return isIqTarMemberName(data) ? DetectionConfidence::High : DetectionConfidence::Medium;
+            }
+            else if (isIqTarMemberName(data))
+            {
+              fileType = FileType::Iqtar;
+              return DetectionConfidence::Low;
+            }
+          }
+
+          const int64_t zfFrame = findZfFrame(data, size);
+          if (zfFrame >= 0)
+          {
+            // the reader skips data in front of the first frame
+            fileType = FileType::AID;
+            return zfFrame == 0 ? DetectionConfidence::High : DetectionConfidence::Medium;
+          }
+
+          if (isMat4Header(data, size, false) || isMat4Header(data, size, true))
+          {
+            fileType = FileType::Matlab4;
+            return DetectionConfidence::High;
+          }
+
+          const bool hasBom = size >= 3 && data[0] == 0xef && data[1] == 0xbb && data[2] == 0xbf;
+          const size_t textOffset = hasBom ? 3 : 0;
+          if (isText(data + textOffset, size - textOffset))
+          {
+            const string text(reinterpret_cast<const char*>(data + textOffset), size - textOffset);
+            fileType = FileType::Csv;
+            return Common::strStartsWithIgnoreCase(text, "saved by") ? DetectionConfidence::High : DetectionConfidence::Medium;
+          }
+
+          // IQW files contain interleaved or blocked I/Q pairs of float32 values without header
+          if (fileSize > 0 && fileSize % (2 * sizeof(float)) == 0)
+          {
+            fileType = FileType::IQW;
+            return DetectionConfidence::Low;
+          }
+
+          return DetectionConfidence::Unknown;
+        }
+      }
+
       IDataImportExport* FileTypeService::create(const std::string& filename, FileType fileType)
       {
         switch (fileType)
@@ -68,6 +334,45 @@ namespace rohdeschwarz
         return nullptr;
       }
 
+      int FileTypeService::detect(const std::string& filename, FileType& fileType, DetectionConfidence& confidence)
+      {
+        confidence = DetectionConfidence::Unknown;
+        if (false == Platform::isFileAccessible(filename))
+        {
+          return ErrorCodes::FileNotFound;
+        }
+
+        const int fd = Platform::fileOpenRead(filename);
+        if (fd < 0)
+        {
+          return ErrorCodes::FileOpenError;
+        }
+
+        uint8_t data[DetectionBufferSize];
+        const int64_t size = Platform::fileReadAt(fd, 0, data, sizeof(data));
+        Platform::fileClose(fd);
+        if (size < 0)
+        {
+          return ErrorCodes::FileOpenError;
+        }
+
+        const uint64_t fileSize = static_cast<size_t>(size) < sizeof(data) ? static_cast<uint64_t>(size) : Platform::getFileSize(filename);
+        confidence = detectType(data, static_cast<size_t>(size), fileSize, fileType);
+        return ErrorCodes::Success;
+      }
+
+      IDataImportExport* FileTypeService::createAuto(const std::string& filename)
+      {
+        FileType fileType;
+        DetectionConfidence confidence;
+        if (ErrorCodes::Success != FileTypeService::detect(filename, fileType, confidence) || confidence == DetectionConfidence::Unknown)
+        {
+          return nullptr;
+        }
+
+        return FileTypeService::create(filename, fileType);
+      }
+
       std::vector<FileType> FileTypeService::getPossibleFileFormats()
       {
         vector<FileType> types;
@@ -0,0 +1,88 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+#include "formatconverter.h"
+
+#include "formatconverterpimpl.h"
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      FormatConverter::FormatConverter(const std::string& inputFilename, FileType inputType, const std::string& outputFilename, FileType outputType)
+      {
+        this->pimpl = new FormatConverter::Impl(inputFilename, inputType, outputFilename, outputType);
+      }
+
+      FormatConverter::~FormatConverter()
+      {
+        delete this->pimpl;
+      }
+
+      int FormatConverter::setChunkSize(size_t nofSamples)
+      {
+        return this->pimpl->setChunkSize(nofSamples);
+      }
+
+      size_t FormatConverter::getChunkSize() const
+      {
+        return this->pimpl->getChunkSize();
+      }
+
+      int FormatConverter::setQueueSize(size_t nofChunks)
+      {
+        return this->pimpl->setQueueSize(nofChunks);
+      }
+
+      size_t FormatConverter::getQueueSize() const
+      {
+        return this->pimpl->getQueueSize();
+      }
+
+      void FormatConverter::setDataType(IqDataType dataType)
+      {
+        this->pimpl->setDataType(dataType);
+      }
+
+      int FormatConverter::convert()
+      {
+        return this->pimpl->convert();
+      }
+
+      uint64_t FormatConverter::getSamplesConverted() const
+      {
+        return this->pimpl->getSamplesConverted();
+      }
+
+      uint64_t FormatConverter::getBytesConverted() const
+      {
+        return this->pimpl->getBytesConverted();
+      }
+
+      double FormatConverter::getElapsedSeconds() const
+      {
+        return this->pimpl->getElapsedSeconds();
+      }
+
+      double FormatConverter::getMegabytesPerSecond() const
+      {
+        return this->pimpl->getMegabytesPerSecond();
+      }
+    }
+  }
+}
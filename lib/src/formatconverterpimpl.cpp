@@ -0,0 +1,313 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+#include "formatconverterpimpl.h"
+
+#include <chrono>
+
+#include "filetypeservice.h"
+#include "iqtar.h"
+#include "common.h"
+#include "constants.h"
+
+using namespace std;
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      FormatConverter::Impl::Impl(const std::string& inputFilename, FileType inputType, const std::string& outputFilename, FileType outputType) :
+        inputFilename_(inputFilename),
+        inputType_(inputType),
+        outputFilename_(outputFilename),
+        outputType_(outputType),
+        chunkSize_(1048576),
+        queueSize_(4),
+        dataType_(IqDataType::Float32),
+        dataTypeSet_(false),
+        samplesConverted_(0),
+        bytesConverted_(0),
+        elapsedSeconds_(0)
+      {
+      }
+
+      int FormatConverter::Impl::setChunkSize(size_t nofSamples)
+      {
+        if (nofSamples == 0)
+        {
+          return ErrorCodes::InvalidArraySize;
+        }
+
+        this->chunkSize_ = nofSamples;
+        return ErrorCodes::Success;
+      }
+
+      size_t FormatConverter::Impl::getChunkSize() const
+      {
+        return this->chunkSize_;
+      }
+
+      int FormatConverter::Impl::setQueueSize(size_t nofChunks)
+      {
+        if (nofChunks == 0)
+        {
+          return ErrorCodes::InvalidArraySize;
+        }
+
+        this->queueSize_ = nofChunks;
+        return ErrorCodes::Success;
+      }
+
+      size_t FormatConverter::Impl::getQueueSize() const
+      {
+        return this->queueSize_;
+      }
+
+      void FormatConverter::Impl::setDataType(IqDataType dataType)
+      {
+        this->dataType_ = dataType;
+        this->dataTypeSet_ = true;
+      }
+
+      uint64_t FormatConverter::Impl::getSamplesConverted() const
+      {
+        return this->samplesConverted_;
+      }
+
+      uint64_t FormatConverter::Impl::getBytesConverted() const
+      {
+        return this->bytesConverted_;
+      }
+
+      double FormatConverter::Impl::getElapsedSeconds() const
+      {
+        return this->elapsedSeconds_;
+      }
+
+      double FormatConverter::Impl::getMegabytesPerSecond() const
+      {
+        if (this->elapsedSeconds_ <= 0)
+        {
+          return 0;
+        }
+
+        return static_cast<double>(this->bytesConverted_) / 1e6 / this->elapsedSeconds_;
+      }
+
+      bool FormatConverter::Impl::supportsFormat(FileType fileType, IqDataFormat format)
+      {
+        switch (fileType)
+        {
+        case FileType::Iqtar:
+        case FileType::Matlab4:
+        case FileType::Matlab73:
+        case FileType::Csv:
+          return true;
+
+        // binary formats of complex data only
+        default:
+          return format == IqDataFormat::Complex;
+        }
+      }
+
+      bool FormatConverter::Impl::readsIqPairs(FileType fileType)
+      {
+        switch (fileType)
+        {
+        case FileType::IQX:
+        case FileType::WV:
+        case FileType::AID:
+          return true;
+
+        default:
+          return false;
+        }
+      }
+
+      size_t FormatConverter::Impl::getReadChannelCount(IqDataFormat inputFormat, size_t nofSamples) const
+      {
+        if (Impl::readsIqPairs(this->inputType_))
+        {
+          return nofSamples;
+        }
+
+        return ((inputFormat == IqDataFormat::Real) ? 1 : 2) * nofSamples;
+      }
+
+      int FormatConverter::Impl::openReader(std::unique_ptr<IDataImportExport>& reader, std::vector<std::string>& arrayNames) const
+      {
+        reader.reset(FileTypeService::create(this->inputFilename_, this->inputType_));
+        if (reader == nullptr)
+        {
+          return ErrorCodes::InvalidDataFormat;
+        }
+
+        return reader->readOpen(arrayNames);
+      }
+
+      int FormatConverter::Impl::openInput(Conversion& conversion) const
+      {
+        vector<string> arrayNames;
+        int ret = this->openReader(conversion.reader, arrayNames);
+        if (ret != ErrorCodes::Success)
+        {
+          return ret;
+        }
+
+        map<string, string>& metadata = conversion.metadata;
+        ret = conversion.reader->getMetadata(conversion.channelInfos, metadata);
+        if (ret != ErrorCodes::Success)
+        {
+          return ret;
+        }
+
+        if (conversion.channelInfos.empty())
+        {
+          return ErrorCodes::EmptyChannelInfo;
+        }
+
+        // the data format is taken from the meta data, if available. Otherwise real data contains one array per channel,
+        // except for the file types reading I/Q pairs, which return one array per complex channel.
+        const bool realArrays = !Impl::readsIqPairs(this->inputType_) && arrayNames.size() == conversion.channelInfos.size();
+        IqDataFormat inputFormat = realArrays ? IqDataFormat::Real : IqDataFormat::Complex;
+        IqDataType inputType = IqDataType::Float32;
+        try
+        {
+          if (metadata.count(Constants::XmlFormat) != 0)
+          {
+            inputFormat = Common::getDataFormatFromString(metadata.at(Constants::XmlFormat));
+          }
+
+          if (metadata.count(Constants::XmlDataType) != 0)
+          {
+            inputType = Common::getDataTypeFromString(metadata.at(Constants::XmlDataType));
+          }
+        }
+        catch (const DaiException&)
+        {
+          // keep format derived from arrays and single precision
+        }
+
+        conversion.inputFormat = inputFormat;
+        conversion.outputFormat = Impl::supportsFormat(this->outputType_, inputFormat) ? inputFormat : IqDataFormat::Complex;
+        conversion.dataType = this->dataTypeSet_ ? this->dataType_ : inputType;
+
+        conversion.applicationName = "libdaiex format converter";
+        if (metadata.count(Constants::XmlApplicationName) != 0)
+        {
+          conversion.applicationName = metadata.at(Constants::XmlApplicationName);
+        }
+        else if (metadata.count("ApplicationName") != 0)
+        {
+          conversion.applicationName = metadata.at("ApplicationName");
+        }
+
+        if (metadata.count(Constants::XmlComment) != 0)
+        {
+          conversion.comment = metadata.at(Constants::XmlComment);
+        }
+
+        // mandatory meta data is written by the output file itself
+        const string mandatoryKeys[] = { Constants::XmlApplicationName, Constants::XmlComment, Constants::XmlDateTime, Constants::XmlFormat, Constants::XmlDataType, Constants::XmlChannels };
+        for (const string& key : mandatoryKeys)
+        {
+          metadata.erase(key);
+        }
+
+        return ErrorCodes::Success;
+      }
+
+      int FormatConverter::Impl::openOutput(Conversion& conversion) const
+      {
+        conversion.writer.reset(FileTypeService::create(this->outputFilename_, this->outputType_));
+        if (conversion.writer == nullptr)
+        {
+          return ErrorCodes::InvalidDataFormat;
+        }
+
+        const vector<ChannelInfo>& channelInfos = conversion.channelInfos;
+
+        // if all channels have the same length, the iq.tar data file is written directly instead of a temporary file
+        IqTar* iqtar = dynamic_cast<IqTar*>(conversion.writer.get());
+        if (iqtar != nullptr)
+        {
+          bool sameLength = true;
+          for (const auto& channel : channelInfos)
+          {
+            sameLength = sameLength && channel.getSamples() == channelInfos.front().getSamples();
+          }
+
+          if (sameLength)
+          {
+            int ret = iqtar->disableTempFile(channelInfos.front().getSamples(), channelInfos.size(), conversion.outputFormat, conversion.dataType);
+            if (ret != ErrorCodes::Success)
+            {
+              return ret;
+            }
+          }
+        }
+
+        conversion.writer->setTimestamp(conversion.reader->getTimestamp());
+        const size_t nofArrays = channelInfos.size() * ((conversion.outputFormat == IqDataFormat::Real) ? 1 : 2);
+        return conversion.writer->writeOpen(conversion.outputFormat, nofArrays, conversion.applicationName, conversion.comment, channelInfos, &conversion.metadata);
+      }
+
+      int FormatConverter::Impl::convert()
+      {
+        this->samplesConverted_ = 0;
+        this->bytesConverted_ = 0;
+        this->elapsedSeconds_ = 0;
+
+        if (this->inputFilename_ == this->outputFilename_)
+        {
+          return ErrorCodes::InconsistentInputData;
+        }
+
+        const auto start = chrono::steady_clock::now();
+
+        Conversion conversion;
+        int ret = this->openInput(conversion);
+        if (ret != ErrorCodes::Success)
+        {
+          return ret;
+        }
+
+        ret = this->openOutput(conversion);
+        if (ret != ErrorCodes::Success)
+        {
+          return ret;
+        }
+
+        if (conversion.dataType == IqDataType::Float64)
+        {
+          ret = this->run<double>(*conversion.reader, *conversion.writer, conversion.channelInfos, conversion.inputFormat, conversion.outputFormat);
+        }
+        else
+        {
+          ret = this->run<float>(*conversion.reader, *conversion.writer, conversion.channelInfos, conversion.inputFormat, conversion.outputFormat);
+        }
+
+        int closeRet = conversion.writer->close();
+        conversion.reader->close();
+        this->elapsedSeconds_ = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        return (ret != ErrorCodes::Success) ? ret : closeRet;
+      }
+    }
+  }
+}
@@ -0,0 +1,84 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+#include "iostatistics.h"
+
+using namespace std;
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      IoStatistics::IoStatistics() :
+        bytesRead_(0),
+        bytesWritten_(0),
+        nofMaps_(0),
+        nofUnmaps_(0),
+        nofSyscalls_(0),
+        tempFileBytes_(0),
+        peakTempFileBytes_(0)
+      {
+        for (int i = 0; i < IoStatistics::NofPhases; ++i)
+        {
+          this->seconds_[i] = 0;
+        }
+      }
+
+      uint64_t IoStatistics::getBytesRead() const
+      {
+        return this->bytesRead_;
+      }
+
+      uint64_t IoStatistics::getBytesWritten() const
+      {
+        return this->bytesWritten_;
+      }
+
+      uint64_t IoStatistics::getNofMaps() const
+      {
+        return this->nofMaps_;
+      }
+
+      uint64_t IoStatistics::getNofUnmaps() const
+      {
+        return this->nofUnmaps_;
+      }
+
+      uint64_t IoStatistics::getNofSyscalls() const
+      {
+        return this->nofSyscalls_;
+      }
+
+      double IoStatistics::getSeconds(IoPhase phase) const
+      {
+        int index = static_cast<int>(phase);
+        if (index < 0 || index >= IoStatistics::NofPhases)
+        {
+          return 0;
+        }
+
+        return this->seconds_[index];
+      }
+
+      uint64_t IoStatistics::getPeakTempFileBytes() const
+      {
+        return this->peakTempFileBytes_;
+      }
+    }
+  }
+}
@@ -116,6 +116,16 @@ namespace rohdeschwarz
         this->pimpl->setTimestamp(timestamp);
       }
 
+      void IqCsv::setStatisticsEnabled(bool enabled)
+      {
+        this->pimpl->setStatisticsEnabled(enabled);
+      }
+
+      IoStatistics IqCsv::getStatistics() const
+      {
+        return this->pimpl->getStatistics();
+      }
+
       int IqCsv::getMetadata(std::vector<ChannelInfo>& channelInfos, std::map<std::string, std::string>& metadata) const
       {
         return this->pimpl->getMetadata(channelInfos, metadata);
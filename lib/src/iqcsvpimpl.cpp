@@ -20,6 +20,7 @@
 
 #include "common.h"
 #include "constants.h"
+#include "tracescope.h"
 
 using namespace std;
 
@@ -73,7 +74,7 @@ namespace rohdeschwarz
         // open reader and analyze content
         try
         {
-          this->reader_ = new CsvReader(this->filename_, *this);
+          this->reader_ = new CsvReader(this->filename_, *this, this->statistics_);
           this->reader_->analyzeContent();
 
           if (this->getChannelCount() == 0)
@@ -201,6 +202,8 @@ namespace rohdeschwarz
 
           if (this->writer_ != nullptr)
           {
+            StatisticsCollector::Timer timer(this->statistics_, IoPhase::Finalize);
+
             // write meta data
             this->finalizeTemporarySequence();
 
@@ -223,6 +226,7 @@ namespace rohdeschwarz
 
       void IqCsv::Impl::finalizeTemporarySequence()
       {
+        DAIEX_TRACE_SCOPE("IqCsv::finalizeTemporarySequence");
         this->writer_->flush();
         this->writer_->beg();
         this->writeMetadata(true);
@@ -795,7 +799,7 @@ namespace rohdeschwarz
         int64_t tmp = -1;
         try
         {
-          CsvReader reader(this->filename_, *this);
+          CsvReader reader(this->filename_, *this, this->statistics_);
           tmp = reader.getNofRows(column);
         }
         catch (...)
@@ -815,7 +819,7 @@ namespace rohdeschwarz
         int64_t tmp = -1;
         try
         {
-          CsvReader reader(this->filename_, *this);
+          CsvReader reader(this->filename_, *this, this->statistics_);
           tmp = reader.getNofCols();
         }
         catch (...)
@@ -840,7 +844,7 @@ namespace rohdeschwarz
 
         try
         {
-          CsvReader reader(this->filename_, *this);
+          CsvReader reader(this->filename_, *this, this->statistics_);
           reader.readRawArray(column, nofValues, values, offset);
         }
         catch (DaiException &e)
@@ -866,7 +870,7 @@ namespace rohdeschwarz
 
         try
         {
-          CsvReader reader(this->filename_, *this);
+          CsvReader reader(this->filename_, *this, this->statistics_);
           reader.readRawArray(column, nofValues, values, offset);
         }
         catch (DaiException &e)
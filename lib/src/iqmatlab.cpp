@@ -76,6 +76,16 @@ namespace rohdeschwarz
         this->pimpl->setTimestamp(timestamp);
       }
 
+      void IqMatlab::setStatisticsEnabled(bool enabled)
+      {
+        this->pimpl->setStatisticsEnabled(enabled);
+      }
+
+      IoStatistics IqMatlab::getStatistics() const
+      {
+        return this->pimpl->getStatistics();
+      }
+
       int IqMatlab::setMatlabVersion(const MatlabVersion version)
       {
         return this->pimpl->setMatlabVersion(version);
@@ -86,6 +96,16 @@ namespace rohdeschwarz
         return this->pimpl->getMatlabVersion();
       }
 
+      int IqMatlab::setCompressionLevel(int level)
+      {
+        return this->pimpl->setCompressionLevel(level);
+      }
+
+      int IqMatlab::setStorageType(IqDataType dataType)
+      {
+        return this->pimpl->setStorageType(dataType);
+      }
+
       int IqMatlab::getMetadata(std::vector<ChannelInfo>& channelInfos, std::map<std::string, std::string>& metadata) const
       {
         return this->pimpl->getMetadata(channelInfos, metadata);
@@ -0,0 +1,378 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+#include "iqmatlab_h5writer.h"
+
+#include "dataimportexportbase.h"
+#include "daiexception.h"
+#include "errorcodes.h"
+
+#include "zlib.h"
+
+#include <cstring>
+
+// chunks can only be compressed outside of the HDF5 library if they can be written directly
+#if H5_VERSION_GE(1, 10, 3)
+#define DAI_H5_DIRECT_CHUNK_WRITE
+#endif
+
+using namespace std;
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      // 512kB per chunk of complex double data
+      const size_t IqMatlabH5Writer::ChunkRows = 32768;
+
+      IqMatlabH5Writer::IqMatlabH5Writer(const std::string& filename, const std::vector<std::string>& arrayNames, size_t nofColumns, IqDataType dataType, int compressionLevel) :
+        filename_(filename),
+        arrayNames_(arrayNames),
+        nofColumns_(nofColumns),
+        dataType_(dataType),
+        wordWidth_(DataImportExportBase::getWordWidth(dataType)),
+        compressionLevel_(compressionLevel),
+        file_(-1),
+        variables_(),
+        spareChunks_(),
+        pending_(),
+        jobs_(),
+        maxPending_(0),
+        workers_(),
+        stop_(false)
+      {
+      }
+
+      IqMatlabH5Writer::~IqMatlabH5Writer()
+      {
+        this->release();
+      }
+
+      void IqMatlabH5Writer::open()
+      {
+        this->file_ = H5Fopen(this->filename_.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+        if (this->file_ < 0)
+        {
+          throw DaiException(ErrorCodes::FileOpenError);
+        }
+
+        // matlab stores a matrix column-major, i.e. HDF5 dimensions are (columns x rows)
+        // and the rows are extended while appending.
+        hsize_t dims[2] = { this->nofColumns_, 0 };
+        hsize_t maxDims[2] = { this->nofColumns_, H5S_UNLIMITED };
+        hsize_t chunkDims[2] = { this->nofColumns_, ChunkRows };
+        hid_t space = H5Screate_simple(2, dims, maxDims);
+        hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+        hid_t classType = H5Tcopy(H5T_C_S1);
+        hid_t scalar = H5Screate(H5S_SCALAR);
+        const hid_t valueType = (this->dataType_ == IqDataType::Float32) ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE;
+        const char* className = (this->dataType_ == IqDataType::Float32) ? "single" : "double";
+        bool success = space >= 0 && dcpl >= 0 && classType >= 0 && scalar >= 0
+          && H5Pset_chunk(dcpl, 2, chunkDims) >= 0
+          && (this->compressionLevel_ == 0 || H5Pset_deflate(dcpl, static_cast<unsigned>(this->compressionLevel_)) >= 0)
+          && H5Tset_size(classType, strlen(className)) >= 0;
+
+        Variable empty = { -1, 0, nullptr, 0 };
+        this->variables_.assign(this->arrayNames_.size(), empty);
+        for (size_t i = 0; success && i < this->arrayNames_.size(); ++i)
+        {
+          hid_t dataset = H5Dcreate2(this->file_, this->arrayNames_[i].c_str(), valueType, space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+          this->variables_[i].dataset = dataset;
+
+          // matio and matlab identify the type of a variable by attribute MATLAB_class
+          hid_t attr = (dataset >= 0) ? H5Acreate2(dataset, "MATLAB_class", classType, scalar, H5P_DEFAULT, H5P_DEFAULT) : -1;
+          success = attr >= 0 && H5Awrite(attr, classType, className) >= 0;
+          if (attr >= 0)
+          {
+            H5Aclose(attr);
+          }
+        }
+
+        if (scalar >= 0) H5Sclose(scalar);
+        if (classType >= 0) H5Tclose(classType);
+        if (dcpl >= 0) H5Pclose(dcpl);
+        if (space >= 0) H5Sclose(space);
+
+        if (false == success)
+        {
+          this->release();
+          throw DaiException(ErrorCodes::InternalError);
+        }
+
+#if defined(DAI_H5_DIRECT_CHUNK_WRITE)
+        if (this->compressionLevel_ > 0)
+        {
+          const size_t nofWorkers = max(1u, thread::hardware_concurrency());
+          this->maxPending_ = 2 * nofWorkers;
+          for (size_t i = 0; i < nofWorkers; ++i)
+          {
+            this->workers_.emplace_back(&IqMatlabH5Writer::workerLoop, this);
+          }
+        }
+#endif
+      }
+
+      void IqMatlabH5Writer::close()
+      {
+        if (this->file_ < 0)
+        {
+          return;
+        }
+
+        try
+        {
+          for (size_t i = 0; i < this->variables_.size(); ++i)
+          {
+            if (this->variables_[i].fill > 0)
+            {
+              this->submit(i);
+            }
+          }
+
+          while (false == this->pending_.empty())
+          {
+            this->writeFront();
+          }
+
+          // variables without data are not written at all
+          for (size_t i = 0; i < this->variables_.size(); ++i)
+          {
+            Variable& var = this->variables_[i];
+            if (var.rows == 0)
+            {
+              H5Dclose(var.dataset);
+              var.dataset = -1;
+              if (H5Ldelete(this->file_, this->arrayNames_[i].c_str(), H5P_DEFAULT) < 0)
+              {
+                throw DaiException(ErrorCodes::InternalError);
+              }
+            }
+          }
+        }
+        catch (...)
+        {
+          this->release();
+          throw;
+        }
+
+        if (false == this->release())
+        {
+          throw DaiException(ErrorCodes::InternalError);
+        }
+      }
+
+      uint64_t IqMatlabH5Writer::getRows(size_t array) const
+      {
+        return this->variables_[array].rows + this->variables_[array].fill;
+      }
+
+      std::shared_ptr<IqMatlabH5Writer::Chunk> IqMatlabH5Writer::takeChunk(size_t array)
+      {
+        shared_ptr<Chunk> chunk;
+        if (this->spareChunks_.empty())
+        {
+          chunk = make_shared<Chunk>();
+          chunk->data.resize(this->nofColumns_ * ChunkRows * this->wordWidth_);
+        }
+        else
+        {
+          chunk = this->spareChunks_.back();
+          this->spareChunks_.pop_back();
+        }
+
+        chunk->array = array;
+        chunk->done = false;
+        chunk->failed = false;
+        return chunk;
+      }
+
+      void IqMatlabH5Writer::submit(size_t array)
+      {
+        Variable& var = this->variables_[array];
+        shared_ptr<Chunk> chunk = var.chunk;
+        var.chunk.reset();
+
+        chunk->firstRow = var.rows;
+        chunk->rows = var.fill;
+        var.rows += var.fill;
+        var.fill = 0;
+
+        // the last chunk is stored completely, even if the variable ends within it
+        if (chunk->rows < ChunkRows)
+        {
+          for (size_t col = 0; col < this->nofColumns_; ++col)
+          {
+            auto begin = chunk->data.begin() + col * ChunkRows * this->wordWidth_;
+            fill(begin + chunk->rows * this->wordWidth_, begin + ChunkRows * this->wordWidth_, 0);
+          }
+        }
+
+        if (this->workers_.empty())
+        {
+          this->writeChunk(chunk);
+          return;
+        }
+
+        {
+          lock_guard<mutex> lock(this->mutex_);
+          this->jobs_.push_back(chunk);
+        }
+        this->jobCondition_.notify_one();
+
+        this->pending_.push_back(chunk);
+        while (this->pending_.size() > this->maxPending_)
+        {
+          this->writeFront();
+        }
+      }
+
+      void IqMatlabH5Writer::writeFront()
+      {
+        shared_ptr<Chunk> chunk = this->pending_.front();
+        this->pending_.pop_front();
+
+        {
+          unique_lock<mutex> lock(this->mutex_);
+          this->doneCondition_.wait(lock, [&chunk] { return chunk->done; });
+        }
+
+        if (chunk->failed)
+        {
+          throw DaiException(ErrorCodes::InternalError);
+        }
+
+        this->writeChunk(chunk);
+      }
+
+      void IqMatlabH5Writer::writeChunk(const std::shared_ptr<Chunk>& chunk)
+      {
+        const Variable& var = this->variables_[chunk->array];
+        hsize_t dims[2] = { this->nofColumns_, chunk->firstRow + chunk->rows };
+        if (H5Dset_extent(var.dataset, dims) < 0)
+        {
+          throw DaiException(ErrorCodes::InternalError);
+        }
+
+        herr_t res = -1;
+#if defined(DAI_H5_DIRECT_CHUNK_WRITE)
+        if (false == chunk->compressed.empty())
+        {
+          hsize_t offset[2] = { 0, chunk->firstRow };
+          res = H5Dwrite_chunk(var.dataset, H5P_DEFAULT, 0, offset, chunk->compressed.size(), chunk->compressed.data());
+        }
+        else
+#endif
+        {
+          hsize_t start[2] = { 0, chunk->firstRow };
+          hsize_t count[2] = { this->nofColumns_, chunk->rows };
+          hsize_t memDims[2] = { this->nofColumns_, ChunkRows };
+          hsize_t memStart[2] = { 0, 0 };
+          hid_t fileSpace = H5Dget_space(var.dataset);
+          hid_t memSpace = H5Screate_simple(2, memDims, nullptr);
+          if (fileSpace >= 0 && memSpace >= 0
+            && H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, nullptr, count, nullptr) >= 0
+            && H5Sselect_hyperslab(memSpace, H5S_SELECT_SET, memStart, nullptr, count, nullptr) >= 0)
+          {
+            const hid_t valueType = (this->dataType_ == IqDataType::Float32) ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE;
+            res = H5Dwrite(var.dataset, valueType, memSpace, fileSpace, H5P_DEFAULT, chunk->data.data());
+          }
+
+          if (memSpace >= 0) H5Sclose(memSpace);
+          if (fileSpace >= 0) H5Sclose(fileSpace);
+        }
+
+        chunk->compressed.clear();
+        this->spareChunks_.push_back(chunk);
+
+        if (res < 0)
+        {
+          throw DaiException(ErrorCodes::InternalError);
+        }
+      }
+
+      void IqMatlabH5Writer::workerLoop()
+      {
+        for (;;)
+        {
+          shared_ptr<Chunk> chunk;
+          {
+            unique_lock<mutex> lock(this->mutex_);
+            this->jobCondition_.wait(lock, [this] { return this->stop_ || false == this->jobs_.empty(); });
+            if (this->stop_)
+            {
+              return;
+            }
+
+            chunk = this->jobs_.front();
+            this->jobs_.pop_front();
+          }
+
+          // same stream format as the HDF5 deflate filter, which decompresses the chunk on read
+          const uLong bytes = static_cast<uLong>(chunk->data.size());
+          uLongf size = compressBound(bytes);
+          chunk->compressed.resize(size);
+          int res = compress2(chunk->compressed.data(), &size, reinterpret_cast<const Bytef*>(chunk->data.data()), bytes, this->compressionLevel_);
+          chunk->compressed.resize(size);
+
+          {
+            lock_guard<mutex> lock(this->mutex_);
+            chunk->done = true;
+            chunk->failed = (res != Z_OK);
+          }
+          this->doneCondition_.notify_all();
+        }
+      }
+
+      bool IqMatlabH5Writer::release()
+      {
+        {
+          lock_guard<mutex> lock(this->mutex_);
+          this->stop_ = true;
+          this->jobs_.clear();
+        }
+        this->jobCondition_.notify_all();
+
+        for (auto& worker : this->workers_)
+        {
+          worker.join();
+        }
+        this->workers_.clear();
+        this->pending_.clear();
+
+        bool success = true;
+        for (auto& var : this->variables_)
+        {
+          var.chunk.reset();
+          if (var.dataset >= 0)
+          {
+            success = H5Dclose(var.dataset) >= 0 && success;
+            var.dataset = -1;
+          }
+        }
+
+        if (this->file_ >= 0)
+        {
+          success = H5Fclose(this->file_) >= 0 && success;
+          this->file_ = -1;
+        }
+
+        return success;
+      }
+    }
+  }
+}
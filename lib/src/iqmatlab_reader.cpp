@@ -22,6 +22,7 @@
 
 using namespace std;
 
+#include <fstream>
 #include <iostream>
 
 namespace rohdeschwarz
@@ -34,7 +35,8 @@ namespace rohdeschwarz
         updateContent_(&updateContent),
         matfp_(nullptr),
         initialized_(false),
-        filename_(filename)
+        filename_(filename),
+        h5file_(-1)
       {
       }
 
@@ -301,6 +303,8 @@ namespace rohdeschwarz
         {
           throw DaiException(ErrorCodes::FileOpenError);
         }
+
+        this->readDirectory();
       }
 
       void IqMatlabReader::close()
@@ -310,10 +314,212 @@ namespace rohdeschwarz
           return;
         }
 
+        for (auto& entry : this->arrays_)
+        {
+          if (entry.second.dataset >= 0)
+          {
+            H5Dclose(entry.second.dataset);
+          }
+
+          Mat_VarFree(entry.second.matvar);
+        }
+        this->arrays_.clear();
+
+        if (this->h5file_ >= 0)
+        {
+          H5Fclose(this->h5file_);
+          this->h5file_ = -1;
+        }
+
+        for (auto& mmf : this->mmf_)
+        {
+          mmf.close();
+        }
+
         Mat_Close(this->matfp_);
         this->matfp_ = nullptr;
       }
 
+      void IqMatlabReader::readDirectory()
+      {
+        // all variables are scanned once, arrays are read from the directory afterwards
+        matvar_t* matvar;
+        while ((matvar = Mat_VarReadNextInfo(this->matfp_)) != nullptr)
+        {
+          if ((matvar->class_type != MAT_C_DOUBLE && matvar->class_type != MAT_C_SINGLE) || matvar->rank != 2 || matvar->isComplex
+            || this->arrays_.count(matvar->name) != 0)
+          {
+            Mat_VarFree(matvar);
+            continue;
+          }
+
+          MatlabArray array = { matvar->dims[0], matvar->dims[1], matvar->class_type == MAT_C_SINGLE, -1, -1, 1, matvar };
+          this->arrays_.insert(make_pair(string(matvar->name), array));
+        }
+        Mat_Rewind(this->matfp_);
+
+        if (Mat_GetVersion(this->matfp_) == MAT_FT_MAT4)
+        {
+          this->readMat4Offsets();
+        }
+        else if (Mat_GetVersion(this->matfp_) == MAT_FT_MAT73)
+        {
+          this->readMat73Offsets();
+        }
+
+        for (auto& entry : this->arrays_)
+        {
+          if (entry.second.offset >= 0)
+          {
+            Platform::mmfOpen(this->mmf_[0], this->filename_, false);
+            Platform::mmfOpen(this->mmf_[1], this->filename_, false);
+            break;
+          }
+        }
+      }
+
+      void IqMatlabReader::readMat4Offsets()
+      {
+        ifstream in;
+        Platform::streamOpen(in, this->filename_, ios::in | ios::binary);
+        in.seekg(0, ios::end);
+        const int64_t fileSize = static_cast<int64_t>(in.tellg());
+        in.seekg(0, ios::beg);
+
+        // type MOPT: machine (0 little, 1 big endian), O = 0, precision P (0 double, 1 single, ...), type T (0 numeric)
+        const uint16_t endianProbe = 1;
+        const int32_t machine = (*reinterpret_cast<const uint8_t*>(&endianProbe) == 1) ? 0 : 1;
+        const size_t precisionWidth[] = { 8, 4, 4, 2, 2, 1 };
+
+        int32_t header[5];
+        while (in.read(reinterpret_cast<char*>(header), sizeof(header)))
+        {
+          const int32_t type = header[0];
+          const int32_t precision = (type / 10) % 10;
+
+          // variables of a foreign byte order are read by matio
+          if (type < 0 || type / 1000 != machine || precision > 5 || header[1] < 0 || header[2] < 0 || header[4] <= 0)
+          {
+            return;
+          }
+
+          string name(static_cast<size_t>(header[4]), '\0');
+          if (false == static_cast<bool>(in.read(&name[0], header[4])))
+          {
+            return;
+          }
+          name = string(name.c_str());
+
+          const int64_t offset = static_cast<int64_t>(in.tellg());
+          const int64_t size = static_cast<int64_t>(header[1]) * header[2] * (header[3] != 0 ? 2 : 1) * precisionWidth[precision];
+          if (offset + size > fileSize)
+          {
+            return;
+          }
+
+          auto it = this->arrays_.find(name);
+          if (it != this->arrays_.end() && type % 10 == 0 && precision == (it->second.single ? 1 : 0) && header[3] == 0
+            && static_cast<size_t>(header[1]) == it->second.rows && static_cast<size_t>(header[2]) == it->second.cols)
+          {
+            it->second.offset = offset;
+          }
+
+          in.seekg(offset + size, ios::beg);
+        }
+      }
+
+      void IqMatlabReader::readMat73Offsets()
+      {
+#if defined(_WIN32)
+        this->h5file_ = H5Fopen(Common::getShortFilePath(this->filename_).c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+#else
+        this->h5file_ = H5Fopen(this->filename_.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+#endif
+        if (this->h5file_ < 0)
+        {
+          return;
+        }
+
+        for (auto& entry : this->arrays_)
+        {
+          MatlabArray& array = entry.second;
+          hid_t dataset = H5Dopen2(this->h5file_, entry.first.c_str(), H5P_DEFAULT);
+          if (dataset < 0)
+          {
+            continue;
+          }
+
+          // contiguous data is read from file directly, if stored with native byte order
+          const hid_t nativeType = array.single ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE;
+          hid_t type = H5Dget_type(dataset);
+          const haddr_t address = H5Dget_offset(dataset);
+          if (type >= 0 && H5Tequal(type, nativeType) > 0 && address != HADDR_UNDEF)
+          {
+            array.offset = static_cast<int64_t>(address);
+          }
+          if (type >= 0)
+          {
+            H5Tclose(type);
+          }
+
+          if (array.offset >= 0)
+          {
+            H5Dclose(dataset);
+            continue;
+          }
+
+          array.chunkRows = max<size_t>(array.rows, 1);
+          hid_t dcpl = H5Dget_create_plist(dataset);
+          hsize_t chunkDims[2];
+          if (dcpl >= 0 && H5Pget_layout(dcpl) == H5D_CHUNKED && H5Pget_chunk(dcpl, 2, chunkDims) == 2 && chunkDims[1] > 0)
+          {
+            array.chunkRows = static_cast<size_t>(chunkDims[1]);
+
+            // reopen the dataset with a chunk cache that can hold at least two chunks
+            const size_t chunkBytes = static_cast<size_t>(chunkDims[0] * chunkDims[1]) * (array.single ? sizeof(float) : sizeof(double));
+            hid_t dapl = H5Pcreate(H5P_DATASET_ACCESS);
+            if (dapl >= 0 && H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, max<size_t>(2 * chunkBytes, 1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) >= 0)
+            {
+              hid_t cached = H5Dopen2(this->h5file_, entry.first.c_str(), dapl);
+              if (cached >= 0)
+              {
+                H5Dclose(dataset);
+                dataset = cached;
+              }
+            }
+            if (dapl >= 0)
+            {
+              H5Pclose(dapl);
+            }
+          }
+          if (dcpl >= 0)
+          {
+            H5Pclose(dcpl);
+          }
+
+          array.dataset = dataset;
+        }
+      }
+
+      const IqMatlabReader::MatlabArray& IqMatlabReader::getArray(const std::string& arrayName)
+      {
+        auto it = this->arrays_.find(arrayName);
+        if (it != this->arrays_.end())
+        {
+          return it->second;
+        }
+
+        // distinguish between missing arrays and arrays of another type
+        matvar_t* matvar = Mat_VarReadInfo(this->matfp_, arrayName.c_str());
+        if (matvar == nullptr)
+        {
+          throw DaiException(ErrorCodes::InvalidMatlabArrayName);
+        }
+
+        Mat_VarFree(matvar);
+        throw DaiException(ErrorCodes::InvalidMatlabArrayType);
+      }
+
       bool IqMatlabReader::containsArray(const std::string& arrayName) const
       {
         return this->arrayNameToChannelNo_.count(arrayName) == 0 ? false : true;
@@ -378,6 +584,12 @@ namespace rohdeschwarz
           this->open();
         }
 
+        auto it = this->arrays_.find(arrayName);
+        if (it != this->arrays_.end())
+        {
+          return static_cast<int>(it->second.rows);
+        }
+
         matvar_t* matvar = Mat_VarReadInfo(this->matfp_, arrayName.c_str());
         if (matvar == nullptr)
         {
@@ -397,6 +609,12 @@ namespace rohdeschwarz
           this->open();
         }
 
+        auto it = this->arrays_.find(arrayName);
+        if (it != this->arrays_.end())
+        {
+          return static_cast<int>(it->second.cols);
+        }
+
         matvar_t* matvar = Mat_VarReadInfo(this->matfp_, arrayName.c_str());
         if (matvar == nullptr)
         {
@@ -22,6 +22,10 @@
 #include "errorcodes.h"
 #include "settings.h"
 #include "platform.h"
+#include "tracescope.h"
+
+#include <fstream>
+#include <limits>
 
 using namespace std;
 using namespace memory_mapped_file;
@@ -44,11 +48,15 @@ namespace rohdeschwarz
         const std::map<std::string, std::string>* metadata) :
       initialized_(false),
       filename_(filename),
+      matFile_(),
+      h5Writer_(),
+      compressionLevel_(0),
       tempPath_(tempPath),
       matVersion_(matlabVersion),
       nofArrays_(nofArrays),
       dataFormat_(dataFormat),
       dataType_(IqDataType::Float32),
+      storageType_(IqDataType::Float64),
       lockDataType_(false),
       applicationName_(applicationName),
       comment_(comment),
@@ -67,6 +75,16 @@ namespace rohdeschwarz
         this->close();
       }
 
+      void IqMatlabWriter::setCompressionLevel(int level)
+      {
+        this->compressionLevel_ = level;
+      }
+
+      void IqMatlabWriter::setStorageType(IqDataType dataType)
+      {
+        this->storageType_ = dataType;
+      }
+
       void IqMatlabWriter::open()
       {
         if (this->initialized_)
@@ -85,6 +103,22 @@ namespace rohdeschwarz
           throw DaiException(ErrorCodes::InconsistentInputData);
         }
 
+#if defined(_WIN32)
+        // since matio does not support utf-16 encoding for windows, we
+        // first write data to a tmp file and then rename the tmp file to
+        // actual filename using utf-16.
+        this->matFile_ = Platform::getTmpFilename(Common::getPath(this->filename_));
+#else
+        this->matFile_ = this->filename_;
+#endif
+
+        if (this->matVersion_ == MatlabVersion::Mat73)
+        {
+          this->openMat73();
+          this->initialized_ = true;
+          return;
+        }
+
         // also split appendChannel() into sperate I and Q file
         // create required number of file writers
         size_t nofTmpFiles = (this->dataFormat_ == IqDataFormat::Real) ? this->nofArrays_ : 2 * this->channelInfos_.size();
@@ -106,6 +140,13 @@ namespace rohdeschwarz
           return;
         }
 
+        if (this->h5Writer_ != nullptr)
+        {
+          this->initialized_ = false;
+          this->closeMat73();
+          return;
+        }
+
         // writer is closed when being destroyed
         this->mmfWriters_.clear();
 
@@ -124,7 +165,7 @@ namespace rohdeschwarz
         }
       }
 
-      void IqMatlabWriter::finalizeTemporarySequence()
+      mat_t* IqMatlabWriter::createMatFile(mat_ft version) const
       {
         // we need to check if file already exists -> matio will try to open
         // existing files on Mat_CreateVer.
@@ -137,39 +178,90 @@ namespace rohdeschwarz
           }
         }
 
-        // create final matlab file
-        auto version = (this->matVersion_ == MatlabVersion::Mat4) ? MAT_FT_MAT4 : MAT_FT_MAT73;
-
-        mat_t* matfp = nullptr;
-#if defined(_WIN32)
-        // since matio does not support utf-16 encoding for windows, we
-        // first write data to a tmp file and then rename the tmp file to
-        // actual filename using utf-16.
-        string path = Common::getPath(this->filename_);
-        string tmpFile = Platform::getTmpFilename(path);
-        matfp = Mat_CreateVer(tmpFile.c_str(), nullptr, version);
-#else
-        matfp = Mat_CreateVer(filename_.c_str(), nullptr, version);
-#endif
+        mat_t* matfp = Mat_CreateVer(this->matFile_.c_str(), nullptr, version);
         if (matfp == nullptr)
         {
           throw DaiException(ErrorCodes::FileOpenError);
         }
 
+        return matfp;
+      }
+
+      void IqMatlabWriter::finalizeTemporarySequence()
+      {
+        DAIEX_TRACE_SCOPE("IqMatlabWriter::finalizeTemporarySequence");
+        mat_t* matfp = this->createMatFile(MAT_FT_MAT4);
+
         try
         {
           // write meta data
           this->writeMetadata(matfp);
           IqMatlabWriter::writeCharArray(matfp, Constants::XmlDataType, IqDataTypeNames[this->dataType_]);
-        
-          // add actual I/Q data from temporary files
-          if (this->dataFormat_ == IqDataFormat::Real)
-          {
-            this->writeRealData(matfp);
-          }
-          else
+        }
+        catch (DaiException)
+        {
+          Mat_Close(matfp);
+          throw;
+        }
+
+        Mat_Close(matfp);
+
+        // add actual I/Q data from temporary files. Data is streamed after Mat_Close(),
+        // since matio needs a variable in memory as a whole.
+        this->writeMat4Data(this->matFile_);
+
+        this->renameMatFile();
+      }
+
+      void IqMatlabWriter::openMat73()
+      {
+        // matio creates the HDF5 file including the matlab header, data variables are added by the HDF5 writer
+        Mat_Close(this->createMatFile(MAT_FT_MAT73));
+
+        vector<string> arrayNames;
+        for (size_t ch = 0; ch < this->channelInfos_.size(); ++ch)
+        {
+          arrayNames.push_back("Ch" + to_string(ch + 1) + "_Data");
+        }
+
+        const size_t nofColumns = (this->dataFormat_ == IqDataFormat::Real) ? 1 : 2;
+        this->h5Writer_.reset(new IqMatlabH5Writer(this->matFile_, arrayNames, nofColumns, this->storageType_, this->compressionLevel_));
+        try
+        {
+          this->h5Writer_->open();
+        }
+        catch (DaiException)
+        {
+          this->h5Writer_.reset();
+          throw;
+        }
+      }
+
+      void IqMatlabWriter::closeMat73()
+      {
+        // the HDF5 file must be closed before matio opens it again
+        unique_ptr<IqMatlabH5Writer> h5Writer(move(this->h5Writer_));
+        h5Writer->close();
+
+        mat_t* matfp = Mat_Open(this->matFile_.c_str(), MAT_ACC_RDWR);
+        if (matfp == nullptr)
+        {
+          throw DaiException(ErrorCodes::FileOpenError);
+        }
+
+        try
+        {
+          this->writeMetadata(matfp);
+          IqMatlabWriter::writeCharArray(matfp, Constants::XmlDataType, IqDataTypeNames[this->dataType_]);
+
+          for (size_t ch = 0; ch < this->channelInfos_.size(); ++ch)
           {
-            this->writeData(matfp);
+            const uint64_t nofSamples = h5Writer->getRows(ch);
+            if (nofSamples > 0)
+            {
+              string nofSamplesName = "Ch" + to_string(ch + 1) + "_" + Constants::XmlSamples;
+              IqMatlabWriter::writeDoubleValue(matfp, nofSamplesName, static_cast<double>(nofSamples));
+            }
           }
         }
         catch (DaiException)
@@ -180,9 +272,14 @@ namespace rohdeschwarz
 
         Mat_Close(matfp);
 
+        this->renameMatFile();
+      }
+
+      void IqMatlabWriter::renameMatFile() const
+      {
 #if defined (_WIN32)
         // rename tmp file to actual filename.
-        int res =_wrename(Common::utf8toUtf16(tmpFile).c_str(), Common::utf8toUtf16(this->filename_).c_str());
+        int res =_wrename(Common::utf8toUtf16(this->matFile_).c_str(), Common::utf8toUtf16(this->filename_).c_str());
         if (res != 0)
         {
           throw DaiException(ErrorCodes::InternalError);
@@ -190,101 +287,81 @@ namespace rohdeschwarz
 #endif
       }
 
-      void IqMatlabWriter::writeRealData(mat_t* const mat)
+      void IqMatlabWriter::writeMat4Data(const std::string& filename)
       {
+        // values copied per read and write, independent of the size of the variable
+        const size_t ChunkValues = 128 * 1024;
+
+        ofstream out;
+        Platform::streamOpen(out, filename, ios::out | ios::binary | ios::app);
+        if (!out)
+        {
+          throw DaiException(ErrorCodes::FileOpenError);
+        }
+
+        const bool isReal = (this->dataFormat_ == IqDataFormat::Real);
+        const size_t nofColumns = isReal ? 1 : 2;
+        const size_t wordWidth = DataImportExportBase::getWordWidth(this->storageType_);
+        vector<char> chunk(ChunkValues * wordWidth);
         for (size_t ch = 0; ch < this->channelInfos_.size(); ++ch)
         {
           string arrayBaseName = "Ch" + to_string(ch + 1) + "_";
           string arrayDataName = arrayBaseName + "Data";
           string nofSamplesName = arrayBaseName + Constants::XmlSamples;
 
-          // TODO task 232601: do not map all, copy step-wise -> Mat_VarWriteData() ?
-          read_only_mmf mmf;
-          Platform::mmfOpen(mmf, this->tempFiles_[ch], true);
-          
-          // temp file written with double precision
-          size_t nofSamples = mmf.file_size() / sizeof(double); 
+          // temp files written with storage precision, I and Q of complex data in separate files
+          const size_t firstTempFile = isReal ? ch : 2 * ch;
+          const uint64_t nofSamples = Platform::getFileSize(this->tempFiles_[firstTempFile]) / wordWidth;
           if (nofSamples == 0)
           {
-            mmf.close();
             return;
           }
-
-          IqMatlabWriter::writeDoubleValue(mat, nofSamplesName, static_cast<double>(nofSamples)); 
-
-          size_t dims[2] = { nofSamples, 1 };
-          matvar_t* matvar = Mat_VarCreate(arrayDataName.c_str(), MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, (double*)mmf.data(), MAT_F_DONT_COPY_DATA);
-          if (matvar == nullptr)
+          if (nofSamples > static_cast<uint64_t>(numeric_limits<int32_t>::max()))
           {
-            mmf.close();
-            throw DaiException(ErrorCodes::InternalError);
+            throw DaiException(ErrorCodes::DataOverflow);
           }
 
-          auto res = Mat_VarWrite(mat, matvar, MAT_COMPRESSION_NONE);
-          if (res != 0)
+          double samples = static_cast<double>(nofSamples);
+          IqMatlabWriter::writeMat4Header(out, nofSamplesName, 1, 1, IqDataType::Float64);
+          out.write(reinterpret_cast<const char*>(&samples), sizeof(samples));
+
+          // the columns of the data variable (I, then Q) are copied chunk-wise from the temp files
+          IqMatlabWriter::writeMat4Header(out, arrayDataName, static_cast<size_t>(nofSamples), nofColumns, this->storageType_);
+          for (size_t col = 0; col < nofColumns; ++col)
           {
-            mmf.close();
-            Mat_VarFree(matvar);
-            throw DaiException(ErrorCodes::InternalError);
+            ifstream in;
+            Platform::streamOpen(in, this->tempFiles_[firstTempFile + col], ios::in | ios::binary);
+            uint64_t valuesLeft = nofSamples;
+            while (valuesLeft > 0 && in && out)
+            {
+              const size_t values = static_cast<size_t>(min<uint64_t>(valuesLeft, ChunkValues));
+              in.read(chunk.data(), values * wordWidth);
+              out.write(chunk.data(), values * wordWidth);
+              valuesLeft -= values;
+            }
+            if (valuesLeft > 0 || !in)
+            {
+              throw DaiException(ErrorCodes::InternalError);
+            }
           }
+        }
 
-          Mat_VarFree(matvar);
-          mmf.close();
+        out.flush();
+        if (!out)
+        {
+          throw DaiException(ErrorCodes::InternalError);
         }
       }
 
-      void IqMatlabWriter::writeData(mat_t* const mat)
+      void IqMatlabWriter::writeMat4Header(std::ostream& out, const std::string& arrayName, size_t rows, size_t cols, IqDataType dataType)
       {
-        for (size_t ch = 0; ch < this->channelInfos_.size(); ++ch)
-        {
-          string arrayBaseName = "Ch" + to_string(ch + 1) + "_";
-          string arrayDataname = arrayBaseName + "Data";
-          string nofSamplesName = arrayBaseName + Constants::XmlSamples;
-
-          // TODO task 232601: do not map all, copy step-wise
-          // currently not supported by matio, vars must be written at once
-          read_only_mmf mmfI;
-          read_only_mmf mmfQ;
-          Platform::mmfOpen(mmfI, this->tempFiles_[2*ch], true);
-          Platform::mmfOpen(mmfQ, this->tempFiles_[2*ch + 1], true);
-
-          // temp file written with double precision
-          size_t nofValues = mmfI.file_size() / sizeof(double);
-          if (nofValues == 0)
-          {
-            mmfI.close();
-            mmfQ.close();
-            return;
-          }
-
-          IqMatlabWriter::writeDoubleValue(mat, nofSamplesName, static_cast<double>(nofValues));
-
-          // copy data to IIIIQQQQ
-          vector<double> data;
-          data.reserve(2 * nofValues);
-          
-          data.insert(data.begin(), reinterpret_cast<const double*>(mmfI.data()), reinterpret_cast<const double*>(mmfI.data()) + nofValues);
-          mmfI.close();
-
-          data.insert(data.begin() + nofValues, reinterpret_cast<const double*>(mmfQ.data()), reinterpret_cast<const double*>(mmfQ.data()) + nofValues);
-          mmfQ.close();
-
-          size_t dims[2] = { nofValues, 2 };
-          matvar_t* matvar = Mat_VarCreate(arrayDataname.c_str(), MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, &data[0], MAT_F_DONT_COPY_DATA);
-          if (matvar == nullptr)
-          {
-            throw DaiException(ErrorCodes::InternalError);
-          }
-
-          auto res = Mat_VarWrite(mat, matvar, MAT_COMPRESSION_NONE);
-          if (res != 0)
-          {
-            Mat_VarFree(matvar);
-            throw DaiException(ErrorCodes::InternalError);
-          }
-
-          Mat_VarFree(matvar);
-        }
+        // type MOPT: machine (0 little, 1 big endian), O = 0, precision P (0 double, 1 single), type T = 0 (numeric)
+        const uint16_t endianProbe = 1;
+        const int32_t machine = (*reinterpret_cast<const uint8_t*>(&endianProbe) == 1) ? 0 : 1000;
+        const int32_t type = machine + ((dataType == IqDataType::Float32) ? 10 : 0);
+        const int32_t header[5] = { type, static_cast<int32_t>(rows), static_cast<int32_t>(cols), 0, static_cast<int32_t>(arrayName.size() + 1) };
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(arrayName.c_str(), arrayName.size() + 1);
       }
 
       void IqMatlabWriter::writeMetadata(mat_t* const mat)
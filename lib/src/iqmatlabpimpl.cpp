@@ -32,7 +32,9 @@ namespace rohdeschwarz
         reader_(nullptr),
         writer_(nullptr),
         tempPath_(Platform::getTmpDir()),
-        matVersion_(MatlabVersion::Mat73)
+        matVersion_(MatlabVersion::Mat73),
+        compressionLevel_(0),
+        storageType_(IqDataType::Float64)
       {
       }
 
@@ -57,6 +59,38 @@ namespace rohdeschwarz
         return this->matVersion_;
       }
 
+      int IqMatlab::Impl::setCompressionLevel(int level)
+      {
+        if (this->writer_ != nullptr)
+        {
+          return ErrorCodes::WriterAlreadyInitialized;
+        }
+
+        if (level < 0 || level > 9)
+        {
+          return ErrorCodes::InvalidDataFormat;
+        }
+
+        this->compressionLevel_ = level;
+        return ErrorCodes::Success;
+      }
+
+      int IqMatlab::Impl::setStorageType(IqDataType dataType)
+      {
+        if (this->writer_ != nullptr)
+        {
+          return ErrorCodes::WriterAlreadyInitialized;
+        }
+
+        if (dataType != IqDataType::Float32 && dataType != IqDataType::Float64)
+        {
+          return ErrorCodes::InvalidDataFormat;
+        }
+
+        this->storageType_ = dataType;
+        return ErrorCodes::Success;
+      }
+
       int IqMatlab::Impl::readOpen(std::vector<std::string>& arrayNames)
       {
         int ret = DataImportExportBase::readOpen(arrayNames);
@@ -147,6 +181,8 @@ namespace rohdeschwarz
             this->tempPath_,
             metadata);  
 
+          this->writer_->setCompressionLevel(this->compressionLevel_);
+          this->writer_->setStorageType(this->storageType_);
           this->writer_->open();
         }
         catch (DaiException &e)
@@ -106,6 +106,16 @@ namespace rohdeschwarz
         this->pimpl->setTimestamp(timestamp);
       }
 
+      void IqTar::setStatisticsEnabled(bool enabled)
+      {
+        this->pimpl->setStatisticsEnabled(enabled);
+      }
+
+      IoStatistics IqTar::getStatistics() const
+      {
+        return this->pimpl->getStatistics();
+      }
+
       int IqTar::setPreviewEnabled(bool enable)
       {
         return this->pimpl->setPreviewEnabled(enable);
@@ -156,6 +166,26 @@ namespace rohdeschwarz
         return this->pimpl->readChannel(channelName, values, nofValues, offset);
       }
 
+      int IqTar::readArrayAsync(const std::string& arrayName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        return this->pimpl->readAsync(false, arrayName, values, nofValues, offset, callback);
+      }
+
+      int IqTar::readArrayAsync(const std::string& arrayName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        return this->pimpl->readAsync(false, arrayName, values, nofValues, offset, callback);
+      }
+
+      int IqTar::readChannelAsync(const std::string& channelName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        return this->pimpl->readAsync(true, channelName, values, nofValues, offset, callback);
+      }
+
+      int IqTar::readChannelAsync(const std::string& channelName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        return this->pimpl->readAsync(true, channelName, values, nofValues, offset, callback);
+      }
+
       int IqTar::appendArrays(const std::vector<std::vector<float>>& iqdata)
       {
         return this->pimpl->appendArrays(iqdata);
@@ -26,6 +26,7 @@ __pragma(warning(disable: 4996))
 #endif
 
 #include "iqtar_preview.h"
+#include "tracescope.h"
 
 #include <sstream>
 
@@ -140,6 +141,7 @@ namespace rohdeschwarz
 
       void IqTarPreview::add(const std::vector<std::complex<float>> &vfcIqDataFloat32)
       {
+        DAIEX_TRACE_SCOPE("IqTarPreview::add");
         if (false == this->m_initialized)
         {
           throw DaiException(ErrorCodes::InternalError);
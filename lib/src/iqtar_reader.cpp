@@ -33,8 +33,9 @@ namespace rohdeschwarz
   {
     namespace dataimportexport
     {
-      IqTarReader::IqTarReader(const std::string& filename, IAnalyzeContentIqTar& updateContent) :
+      IqTarReader::IqTarReader(const std::string& filename, IAnalyzeContentIqTar& updateContent, StatisticsCollector& statistics) :
         updateContent_(&updateContent),
+        statistics_(&statistics),
         initialized_(false),
         filename_(filename),
         archive_(nullptr),
@@ -43,6 +44,7 @@ namespace rohdeschwarz
         scalingFactor_(numeric_limits<double>::quiet_NaN()),
         nofSamples_(0)
       {
+        this->mmfReader_.statistics = &statistics;
       }
 
       IqTarReader::~IqTarReader()
@@ -62,6 +64,8 @@ namespace rohdeschwarz
           return;
         }
 
+        StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Parsing);
+
         // read tar header names
         std::vector<string> tarElements;
         this->readArchiveContent(tarElements);
@@ -109,6 +113,21 @@ namespace rohdeschwarz
         Common::archiveAssert(archive_read_open(this->archive_, &this->mmfReader_, nullptr, IqTarReader::archiveReadCallback, IqTarReader::archiveCloseCallback));
       }
 
+      void IqTarReader::mapRead(memory_mapped_file::read_only_mmf& mmf, size_t offset, size_t size)
+      {
+        StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Io);
+        mmf.map(offset, size);
+        Common::mmfDataAssert(mmf);
+        this->statistics_->addMap(size);
+      }
+
+      void IqTarReader::closeRead(memory_mapped_file::read_only_mmf& mmf)
+      {
+        StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Io);
+        mmf.close();
+        this->statistics_->addUnmap();
+      }
+
       size_t IqTarReader::getNofChannels() const
       {
         if (DataImportExportBase::getValuesPerSample(this->dataFormat_) == 1)
@@ -123,6 +142,8 @@ namespace rohdeschwarz
 
       void IqTarReader::readPrepare(const std::string& arrayName, size_t nofReadValues, size_t offset, size_t& readOffset, size_t& ignoreNofChannels)
       {
+        StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Parsing);
+
         if (false == this->containsArray(arrayName))
         {
           throw DaiException(ErrorCodes::InvalidArrayName);
@@ -186,6 +207,67 @@ namespace rohdeschwarz
         readOffset += offset * nofChannels * valuesPerSample * wordWidth;
       }
 
+      void IqTarReader::getAsyncValueType(RawValueType& type, double& scale) const
+      {
+        if (this->dataType_ == IqDataType::Float32)
+        {
+          type = RawValueType::Float32;
+        }
+        else if (this->dataType_ == IqDataType::Float64)
+        {
+          type = RawValueType::Float64;
+        }
+        else
+        {
+          throw DaiException(ErrorCodes::WrongDataType);
+        }
+
+        scale = std::isnan(this->scalingFactor_) ? 1.0 : this->scalingFactor_;
+      }
+
+      void IqTarReader::prepareArrayAsync(const std::string& arrayName, size_t nofValues, size_t offset, RawValueType& type, double& scale, std::vector<RawSegment>& segments)
+      {
+        size_t readOffset = 0;
+        size_t ignoreNofChannelValues = 0;
+        this->readPrepare(arrayName, nofValues, offset, readOffset, ignoreNofChannelValues);
+        this->getAsyncValueType(type, scale);
+
+        const size_t valuesPerSample = DataImportExportBase::getValuesPerSample(this->dataFormat_);
+        const bool readIValues = Common::strEndsWithIgnoreCase(arrayName, "_I") || this->dataFormat_ == IqDataFormat::Real;
+        if (false == readIValues)
+        {
+          readOffset += DataImportExportBase::getWordWidth(this->dataType_);
+        }
+
+        segments.clear();
+        segments.push_back(RawSegment(readOffset, nofValues, 1, valuesPerSample + ignoreNofChannelValues, 0, 1));
+      }
+
+      void IqTarReader::prepareChannelAsync(const std::string& channelName, size_t nofValues, size_t offset, RawValueType& type, double& scale, std::vector<RawSegment>& segments)
+      {
+        size_t readOffset = 0;
+        size_t ignoreNofChannelValues = 0;
+        segments.clear();
+        if (this->dataFormat_ == IqDataFormat::Real)
+        {
+          this->readPrepare(channelName, nofValues, offset, readOffset, ignoreNofChannelValues);
+          this->getAsyncValueType(type, scale);
+          segments.push_back(RawSegment(readOffset, nofValues, 1, 1 + ignoreNofChannelValues, 0, 1));
+        }
+        else
+        {
+          if (nofValues % 2 != 0)
+          {
+            throw DaiException(ErrorCodes::InvalidArraySize);
+          }
+
+          const size_t samplesToRead = nofValues / 2;
+          this->readPrepare(channelName + "_I", samplesToRead, offset, readOffset, ignoreNofChannelValues);
+          this->getAsyncValueType(type, scale);
+          segments.push_back(RawSegment(readOffset, samplesToRead, 2, 2 + ignoreNofChannelValues, 0, 2));
+        }
+      }
+
       void IqTarReader::readArchiveContent(std::vector<std::string>& tarElementNames)
       {
         this->open();
@@ -194,21 +276,18 @@ namespace rohdeschwarz
 
         struct archive_entry* element;
 
-		    // TODO remove lock with libarchive 4.0 -> setlocale should then not be used anymore
-        Common::localeLock_.lock();
+        // entry names are converted with the locale of the calling thread
+        ThreadLocale locale;
         while (ARCHIVE_OK == archive_read_next_header(this->archive_, &element))
         {
           string elementName(archive_entry_pathname(element));
           if (elementName.empty())
           {
-            Common::localeLock_.unlock();
             throw DaiException(ErrorCodes::InvalidTarArchive);
           }
 
           tarElementNames.push_back(elementName);
         }
-        
-        Common::localeLock_.unlock();
 
         this->close();
       }
@@ -217,20 +296,16 @@ namespace rohdeschwarz
       {
         struct archive_entry* element;
 
-		    // TODO remove lock with libarchive 4.0 -> setlocale should then not be used anymore
-        Common::localeLock_.lock();
+        ThreadLocale locale;
         while (ARCHIVE_OK == archive_read_next_header(archive, &element))
         {
           string currentElementName(archive_entry_pathname(element));
           if (0 == currentElementName.compare(tarElementName))
           {
-            Common::localeLock_.unlock();
             return element;
           }
         }
 
-        Common::localeLock_.unlock();
-
         throw DaiException(ErrorCodes::InvalidTarArchive);
       }
 
@@ -695,7 +770,17 @@ namespace rohdeschwarz
           readSize = fileSize - data->offset;
         }
 
-        // map data
+        // map data, replacing the previous region
+        if (data->statistics != nullptr)
+        {
+          if (data->mmf.data() != nullptr)
+          {
+            data->statistics->addUnmap();
+          }
+
+          data->statistics->addMap(readSize);
+        }
+
         data->mmf.map(data->offset, readSize);
         *buffer = data->mmf.data();
 
@@ -46,12 +46,14 @@ namespace rohdeschwarz
         const std::vector<ChannelInfo>& channelInfos,
         bool enablePreview,
         const std::string& tempPath,
+        StatisticsCollector& statistics,
         const std::map<std::string, std::string>* metadata,
         const std::string* deprecatedInfoXml,
         const uint64_t expectedNofIqBytes) :
       initialized_(false),
       filename_(filename),
       tempPath_(tempPath),
+      statistics_(&statistics),
       nofSamplesWritten_(0),
       applicationName_(applicationName),
       comment_(comment),
@@ -104,6 +106,12 @@ namespace rohdeschwarz
         return ss.str();
       }
 
+      void IqTarWriter::writeEntryHeader(struct archive* a, struct archive_entry* entry)
+      {
+        ThreadLocale locale;
+        Common::archiveAssert(archive_write_header(a, entry));
+      }
+
       std::string IqTarWriter::generateXml(const std::string& iqDataFilename)
       {
         ostringstream ss;
@@ -345,10 +353,7 @@ namespace rohdeschwarz
           archive_entry_set_filetype(this->archiveEntry_, AE_IFREG);
           archive_entry_set_perm(this->archiveEntry_, 0644);
 
-		      // TODO remove lock with libarchive 4.0 -> setlocale should then not be used anymore
-          Common::localeLock_.lock();
-          Common::archiveAssert(archive_write_header(this->archive_, this->archiveEntry_));
-          Common::localeLock_.unlock();
+          IqTarWriter::writeEntryHeader(this->archive_, this->archiveEntry_);
         }
 
         // init tar preview
@@ -364,6 +369,8 @@ namespace rohdeschwarz
           return;
         }
 
+        StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Finalize);
+
         try
         {
           // finalize temp and write actual tar file
@@ -398,6 +405,24 @@ namespace rohdeschwarz
       void IqTarWriter::deleteTempFiles()
       {
         remove(this->tempFile_.c_str());
+        this->statistics_->removeTempFiles();
+      }
+
+      void IqTarWriter::mapWrite(size_t offset, size_t size)
+      {
+        StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Io);
+        this->mmfWriter_.map(offset, size);
+        this->statistics_->addMap();
+      }
+
+      void IqTarWriter::flushWrite(size_t size)
+      {
+        StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Io);
+        this->mmfWriter_.flush();
+        this->mmfWriter_.unmap();
+        this->statistics_->addWrite(size);
+        this->statistics_->addUnmap();
+        this->statistics_->addTempFileBytes(size);
       }
 
       bool IqTarWriter::validateChannelInformation()
@@ -520,6 +545,7 @@ namespace rohdeschwarz
 
       void IqTarWriter::finalizeTemporarySequence()
       {
+        DAIEX_TRACE_SCOPE("IqTarWriter::finalizeTemporarySequence");
         // create name of I/Q data file and generate xml file
         string iqDataFileName = IqTarWriter::generateIqDataFilename(this->filename_, static_cast<int>(this->channelInfos_.size()), this->dataFormat_, this->dataType_, this->timestamp_);
 
@@ -549,23 +575,24 @@ namespace rohdeschwarz
         archive_entry_set_filetype(entry, AE_IFREG);
         archive_entry_set_perm(entry, 0644);
 
-		    // TODO remove lock with libarchive 4.0 -> setlocale should then not be used anymore
-        Common::localeLock_.lock();
-        Common::archiveAssert(archive_write_header(archive, entry));
-        Common::localeLock_.unlock();
+        IqTarWriter::writeEntryHeader(archive, entry);
 
         // copy data -> TODO: mmf?
         FILE* fp;
         fopen_s(&fp, this->tempFile_.c_str(), "rb");
 
+        StatisticsCollector::Timer timer(*this->statistics_, IoPhase::Io);
         char buff[8192];
         size_t len = fread(buff, sizeof(buff[0]), sizeof(buff), fp);
         while (len > 0)
         {
           archive_write_data(archive, buff, len);
+          this->statistics_->addRead(len);
+          this->statistics_->addWrite(len);
           len = fread(buff, sizeof(buff[0]), sizeof(buff), fp);
         }
 
+        this->statistics_->addSyscalls();
         fclose(fp);
 
         archive_entry_free(entry);
@@ -623,12 +650,10 @@ namespace rohdeschwarz
         archive_entry_set_filetype(entry, AE_IFREG);
         archive_entry_set_perm(entry, 0644);
 
-		    // TODO remove lock with libarchive 4.0 -> setlocale should then not be used anymore
-        Common::localeLock_.lock();
-        Common::archiveAssert(archive_write_header(a, entry));
-        Common::localeLock_.unlock();
+        IqTarWriter::writeEntryHeader(a, entry);
 
         archive_write_data(a, xml.data(), xml.size());
+        this->statistics_->addWrite(xml.size());
 
         // if preview is enabled, add xslt file to tar
         if (this->enablePreview_)
@@ -641,12 +666,10 @@ namespace rohdeschwarz
           archive_entry_set_filetype(entry, AE_IFREG);
           archive_entry_set_perm(entry, 0644);
 
- 		      // TODO remove lock with libarchive 4.0 -> setlocale should then not be used anymore
-          Common::localeLock_.lock();
-          Common::archiveAssert(archive_write_header(a, entry));
-          Common::localeLock_.unlock();
+          IqTarWriter::writeEntryHeader(a, entry);
 
           archive_write_data(a, xslt.data(), xslt.size());
+          this->statistics_->addWrite(xslt.size());
         }
 
         archive_entry_free(entry);
@@ -88,7 +88,7 @@ namespace rohdeschwarz
         // open reader and analyze tar/xml content
         try
         {
-          this->reader_ = new IqTarReader(this->filename_, *this);
+          this->reader_ = new IqTarReader(this->filename_, *this, this->statistics_);
           this->reader_->analyzeContent();
 
           if (this->getChannelCount() == 0)
@@ -152,6 +152,7 @@ namespace rohdeschwarz
             channelInfos,
             this->enablePreview_,
             this->tempPath_,
+            this->statistics_,
             metadata,
             deprecatedInfoXml,
             this->expectedIqDataFileSize_);
@@ -169,6 +170,8 @@ namespace rohdeschwarz
 
       int IqTar::Impl::close()
       {
+        AsyncReadService::close(this->asyncFile_);
+
         try
         {
           if (this->reader_ != nullptr)
@@ -76,6 +76,16 @@ namespace rohdeschwarz
         this->pimpl->setTimestamp(timestamp);
       }
 
+      void Iqw::setStatisticsEnabled(bool enabled)
+      {
+        this->pimpl->setStatisticsEnabled(enabled);
+      }
+
+      IoStatistics Iqw::getStatistics() const
+      {
+        return this->pimpl->getStatistics();
+      }
+
       int Iqw::getMetadata(std::vector<ChannelInfo>& channelInfos, std::map<std::string, std::string>& metadata) const
       {
         return this->pimpl->getMetadata(channelInfos, metadata);
@@ -131,6 +141,26 @@ namespace rohdeschwarz
         return this->pimpl->readChannel(channelName, values, nofValues, offset);
       }
 
+      int Iqw::readArrayAsync(const std::string& arrayName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        return this->pimpl->readArrayAsync(arrayName, values, nofValues, offset, callback);
+      }
+
+      int Iqw::readArrayAsync(const std::string& arrayName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        return this->pimpl->readArrayAsync(arrayName, values, nofValues, offset, callback);
+      }
+
+      int Iqw::readChannelAsync(const std::string& channelName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        return this->pimpl->readChannelAsync(channelName, values, nofValues, offset, callback);
+      }
+
+      int Iqw::readChannelAsync(const std::string& channelName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        return this->pimpl->readChannelAsync(channelName, values, nofValues, offset, callback);
+      }
+
       int Iqw::appendArrays(const std::vector<std::vector<float>>& iqdata)
       {
         return this->pimpl->appendArrays(iqdata);
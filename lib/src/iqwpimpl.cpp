@@ -72,6 +72,7 @@ namespace rohdeschwarz
 
       int Iqw::Impl::readOpen(std::vector<std::string>& arrayNames)
       {
+        StatisticsCollector::Timer timer(this->statistics_, IoPhase::Parsing);
         int ret = DataImportExportBase::readOpen(arrayNames);
         if (ErrorCodes::Success != ret)
         {
@@ -173,6 +174,8 @@ namespace rohdeschwarz
 
       int Iqw::Impl::close()
       {
+        AsyncReadService::close(this->asyncFile_);
+
         // nothing to do in read-only mode
         if (false == this->writerInitialized_)
         {
@@ -180,6 +183,8 @@ namespace rohdeschwarz
           return ErrorCodes::Success;
         }
 
+        StatisticsCollector::Timer timer(this->statistics_, IoPhase::Finalize);
+
         // interleaved format -> merge temp files
         if (this->dataOrder_ == IqDataOrder::IIIQQQ)
         {
@@ -221,6 +226,31 @@ namespace rohdeschwarz
       {
         remove(this->tempFileI_.c_str());
         remove(this->tempFileQ_.c_str());
+        this->statistics_.removeTempFiles();
+      }
+
+      void Iqw::Impl::mapRead(memory_mapped_file::read_only_mmf& mmf, size_t offset, size_t size)
+      {
+        StatisticsCollector::Timer timer(this->statistics_, IoPhase::Io);
+        mmf.map(offset, size);
+        Common::mmfDataAssert(mmf);
+        this->statistics_.addMap(size);
+      }
+
+      void Iqw::Impl::mapWrite(memory_mapped_file::writable_mmf& mmf, size_t offset, size_t size)
+      {
+        StatisticsCollector::Timer timer(this->statistics_, IoPhase::Io);
+        mmf.map(offset, size);
+        this->statistics_.addMap();
+      }
+
+      void Iqw::Impl::flushWrite(memory_mapped_file::writable_mmf& mmf, size_t size)
+      {
+        StatisticsCollector::Timer timer(this->statistics_, IoPhase::Io);
+        mmf.flush();
+        mmf.unmap();
+        this->statistics_.addWrite(size);
+        this->statistics_.addUnmap();
       }
 
       int64_t Iqw::Impl::getArraySize(const std::string& arrayName) const
@@ -340,6 +370,62 @@ namespace rohdeschwarz
         return ErrorCodes::Success;
       }
 
+      int Iqw::Impl::readArrayAsync(const std::string& arrayName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        try
+        {
+          this->readArrayAsyncInternal(arrayName, values, nofValues, offset, callback);
+        }
+        catch (DaiException &e)
+        {
+          return e.code();
+        }
+
+        return ErrorCodes::Success;
+      }
+
+      int Iqw::Impl::readArrayAsync(const std::string& arrayName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        try
+        {
+          this->readArrayAsyncInternal(arrayName, values, nofValues, offset, callback);
+        }
+        catch (DaiException &e)
+        {
+          return e.code();
+        }
+
+        return ErrorCodes::Success;
+      }
+
+      int Iqw::Impl::readChannelAsync(const std::string& channelName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        try
+        {
+          this->readChannelAsyncInternal(channelName, values, nofValues, offset, callback);
+        }
+        catch (DaiException &e)
+        {
+          return e.code();
+        }
+
+        return ErrorCodes::Success;
+      }
+
+      int Iqw::Impl::readChannelAsync(const std::string& channelName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+      {
+        try
+        {
+          this->readChannelAsyncInternal(channelName, values, nofValues, offset, callback);
+        }
+        catch (DaiException &e)
+        {
+          return e.code();
+        }
+
+        return ErrorCodes::Success;
+      }
+
       int Iqw::Impl::appendArrays(const std::vector<std::vector<float>>& iqdata)
       {
         vector<float*> dataPtrs;
@@ -523,6 +609,7 @@ namespace rohdeschwarz
 
       void Iqw::Impl::finalizeTemporarySequence()
       {
+        DAIEX_TRACE_SCOPE("Iqw::finalizeTemporarySequence");
         try
         {
           this->mmfWriterOne_.flush();
@@ -535,11 +622,22 @@ namespace rohdeschwarz
           ifstream if_two;
           Platform::streamOpen(of_one, this->tempFileI_, ios_base::binary | ios_base::app);
           Platform::streamOpen(if_two, this->tempFileQ_, ios_base::binary);
-          of_one.seekp(0, ios_base::end);
-          of_one << if_two.rdbuf();
-
-          of_one.close();
-          if_two.close();
+          {
+            StatisticsCollector::Timer timer(this->statistics_, IoPhase::Io);
+            of_one.seekp(0, ios_base::end);
+            auto start = of_one.tellp();
+            of_one << if_two.rdbuf();
+            auto end = of_one.tellp();
+
+            of_one.close();
+            if_two.close();
+
+            // the Q data is copied once, read from and written to file
+            uint64_t nofBytes = (start >= 0 && end > start) ? static_cast<uint64_t>(end - start) : 0;
+            this->statistics_.addRead(nofBytes);
+            this->statistics_.addWrite(nofBytes);
+            this->statistics_.addSyscalls();
+          }
 
 #if defined(_WIN32)
           // use utf-16 on windows
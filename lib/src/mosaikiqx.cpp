@@ -96,6 +96,16 @@ void Iqx::setTimestamp(const time_t timestamp)
   return m_pimpl->setTimestamp(timestamp);
 }
 
+void Iqx::setStatisticsEnabled(bool enabled)
+{
+  m_pimpl->setStatisticsEnabled(enabled);
+}
+
+IoStatistics Iqx::getStatistics() const
+{
+  return m_pimpl->getStatistics();
+}
+
 int Iqx::readArray(const std::string& arrayName, std::vector<float>& values, size_t nofValues, size_t offset)
 {
   return m_pimpl->readArray(arrayName, values, nofValues, offset);
@@ -176,6 +186,70 @@ int Iqx::appendChannels(const std::vector<double*>& iqdata, const std::vector<si
   return m_pimpl->appendChannels(iqdata, sizes);
 }
 
+int Iqx::setCueIndexFile(bool enabled)
+{
+  return m_pimpl->setCueIndexFile(enabled);
+}
+
+int Iqx::setResolution(int bits)
+{
+  return m_pimpl->setResolution(bits);
+}
+
+int Iqx::readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  return m_pimpl->readArray(arrayName, values, nofValues, scale, offset);
+}
+
+int Iqx::readChannel(const std::string& channelName, int16_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  return m_pimpl->readChannel(channelName, values, nofValues, scale, offset);
+}
+
+int Iqx::readTriggerWindows(const std::string& channelName, size_t preSamples, size_t postSamples,
+                            std::vector<std::vector<float> >& windows, std::vector<int64_t>& triggerSamples)
+{
+  return m_pimpl->readTriggerWindows(channelName, preSamples, postSamples, windows, triggerSamples);
+}
+
+int Iqx::readTriggerWindows(const std::string& channelName, size_t preSamples, size_t postSamples,
+                            std::vector<std::vector<double> >& windows, std::vector<int64_t>& triggerSamples)
+{
+  return m_pimpl->readTriggerWindows(channelName, preSamples, postSamples, windows, triggerSamples);
+}
+
+int Iqx::readTimestampWindows(const std::string& channelName, const std::vector<double>& timestamps, size_t preSamples,
+                              size_t postSamples, std::vector<std::vector<float> >& windows)
+{
+  return m_pimpl->readTimestampWindows(channelName, timestamps, preSamples, postSamples, windows);
+}
+
+int Iqx::readTimestampWindows(const std::string& channelName, const std::vector<double>& timestamps, size_t preSamples,
+                              size_t postSamples, std::vector<std::vector<double> >& windows)
+{
+  return m_pimpl->readTimestampWindows(channelName, timestamps, preSamples, postSamples, windows);
+}
+
+int Iqx::readArrayAsync(const std::string& arrayName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+{
+  return m_pimpl->readArrayAsync(arrayName, values, nofValues, offset, callback);
+}
+
+int Iqx::readArrayAsync(const std::string& arrayName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+{
+  return m_pimpl->readArrayAsync(arrayName, values, nofValues, offset, callback);
+}
+
+int Iqx::readChannelAsync(const std::string& channelName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+{
+  return m_pimpl->readChannelAsync(channelName, values, nofValues, offset, callback);
+}
+
+int Iqx::readChannelAsync(const std::string& channelName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+{
+  return m_pimpl->readChannelAsync(channelName, values, nofValues, offset, callback);
+}
+
 }
 }
 }
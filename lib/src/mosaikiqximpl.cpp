@@ -26,11 +26,14 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <numeric>
 
 #include "mosaikiqximpl.h"
+#include "tracescope.h"
 #include <iqxformat/iqxfile.h>
 #include "../iqxformat/src/iqbitconverter.h"
+#include "../iqxformat/src/aligned_allocator.h"
 
 namespace rohdeschwarz
 {
@@ -42,21 +45,10 @@ namespace dataimportexport
 using namespace std;
 using namespace IQW;
 
-#ifdef _WIN32
-/// seek for large files > 1TB
-#define portable_lseek _lseeki64
-#define portable_read _read
-#else
-#ifdef __APPLE__
-#define portable_lseek lseek
-#define portable_read read
-#else
-/// seek for large files > 1TB
-#define portable_lseek lseek64
-#define portable_read read
-#endif
-#endif
 
+struct MosaikIqxImpl::FrameBuffer : public vector<int16_t, AlignedAllocator<int16_t>>
+{
+};
 
 MosaikIqxImpl::MosaikIqxImpl(const std::string& filename)
   : m_filename(filename)
@@ -65,6 +57,8 @@ MosaikIqxImpl::MosaikIqxImpl(const std::string& filename)
 
 MosaikIqxImpl::~MosaikIqxImpl()
 {
+  // writes the pending pairs of 12 bit streams, pending asynchronous reads count their bytes in m_statistics
+  close();
 }
 
 int MosaikIqxImpl::readOpen(std::vector<std::string>& arrayNames)
@@ -73,10 +67,14 @@ int MosaikIqxImpl::readOpen(std::vector<std::string>& arrayNames)
   {
     return 0;
   }
+  StatisticsCollector::Timer timer(m_statistics, IoPhase::Parsing);
+  // opening scans the IQ frames of the file, see IqxFileImpl::readIqFrameData()
+  DAIEX_TRACE_SCOPE("Iqx::readOpen");
   try
   {
     arrayNames.clear();
-    m_piqx = unique_ptr<IqxFile>(new IqxFile(m_filename));
+    m_piqx = unique_ptr<IqxFile>(new IqxFile(m_filename, false, m_cueIndexFile));
+    m_streamTypes = m_piqx->getStreamTypes();
     arrayNames = m_piqx->getStreamSources();
     // remove GPS if exists, because mosaik does only support IQ channels
     for (int i = arrayNames.size() - 1; i >= 0; i--)
@@ -310,8 +308,8 @@ int MosaikIqxImpl::writeOpen(IqDataFormat format, size_t nofArrays, const string
 	description.bandwidth_variable = false;
 	description.center_frequency = info.getFrequency();
 	description.centfreq_valid = true;
-	description.resolution = 16;
-	description.resolution_valid = false;
+	description.resolution = m_resolution;
+	description.resolution_valid = (m_resolution != 16);
    descriptions.push_back(make_pair(source,description));
 
     try
@@ -335,8 +333,33 @@ int MosaikIqxImpl::writeOpen(IqDataFormat format, size_t nofArrays, const string
 
 int MosaikIqxImpl::close()
 {
+  AsyncReadService::close(m_asyncFile);
+
+  StatisticsCollector::Timer timer(m_statistics, IoPhase::Finalize);
+  int ret = 0;
+  if (m_piqx && m_write)
+  {
+    // write the last, padded DIGIQ word of 12 bit streams
+    try
+    {
+      for (auto& pending : m_pendingValues)
+      {
+        if (!pending.second.empty())
+        {
+          const size_t pairs = prepareFrameBuffer(pending.first, 0) / 2;
+          writeFrameBuffer(pending.first, pairs, true);
+        }
+      }
+    }
+    catch (const exception&)
+    {
+      ret = ErrorCodes::InternalError;
+    }
+  }
+  m_pendingValues.clear();
   m_piqx.reset();
-  return 0;
+  m_frameBuffer.reset();
+  return ret;
 }
 
 time_t MosaikIqxImpl::getTimestamp() const
@@ -521,6 +544,327 @@ int MosaikIqxImpl::appendChannels(const std::vector<double*>& iqdata, const std:
   return 0;
 }
 
+int MosaikIqxImpl::setCueIndexFile(bool enabled)
+{
+  if (m_piqx)
+  {
+    return m_write ? ErrorCodes::WriterAlreadyInitialized : ErrorCodes::ReaderAlreadyInitialized;
+  }
+  m_cueIndexFile = enabled;
+  return ErrorCodes::Success;
+}
+
+int MosaikIqxImpl::setResolution(int bits)
+{
+  if (m_piqx)
+  {
+    return ErrorCodes::WriterAlreadyInitialized;
+  }
+  if (bits != 12 && bits != 16)
+  {
+    return ErrorCodes::InvalidDataFormat;
+  }
+  m_resolution = bits;
+  return ErrorCodes::Success;
+}
+
+int MosaikIqxImpl::readTriggerWindows(const std::string& channelName, size_t preSamples, size_t postSamples,
+                                      std::vector<std::vector<float> >& windows, std::vector<int64_t>& triggerSamples)
+{
+  size_t streamNo = 0;
+  int ret = getWindowCenters(channelName, nullptr, streamNo, triggerSamples);
+  return (ret != 0) ? ret : readWindowsAll(streamNo, triggerSamples, preSamples, postSamples, windows);
+}
+
+int MosaikIqxImpl::readTriggerWindows(const std::string& channelName, size_t preSamples, size_t postSamples,
+                                      std::vector<std::vector<double> >& windows, std::vector<int64_t>& triggerSamples)
+{
+  size_t streamNo = 0;
+  int ret = getWindowCenters(channelName, nullptr, streamNo, triggerSamples);
+  return (ret != 0) ? ret : readWindowsAll(streamNo, triggerSamples, preSamples, postSamples, windows);
+}
+
+int MosaikIqxImpl::readTimestampWindows(const std::string& channelName, const std::vector<double>& timestamps, size_t preSamples,
+                                        size_t postSamples, std::vector<std::vector<float> >& windows)
+{
+  size_t streamNo = 0;
+  vector<int64_t> centers;
+  int ret = getWindowCenters(channelName, &timestamps, streamNo, centers);
+  return (ret != 0) ? ret : readWindowsAll(streamNo, centers, preSamples, postSamples, windows);
+}
+
+int MosaikIqxImpl::readTimestampWindows(const std::string& channelName, const std::vector<double>& timestamps, size_t preSamples,
+                                        size_t postSamples, std::vector<std::vector<double> >& windows)
+{
+  size_t streamNo = 0;
+  vector<int64_t> centers;
+  int ret = getWindowCenters(channelName, &timestamps, streamNo, centers);
+  return (ret != 0) ? ret : readWindowsAll(streamNo, centers, preSamples, postSamples, windows);
+}
+
+int MosaikIqxImpl::getWindowCenters(const std::string& channelName, const std::vector<double>* timestamps, size_t& streamNo, std::vector<int64_t>& centers)
+{
+  if (!m_piqx || m_write)
+  {
+    return ErrorCodes::OpenFileHasNotBeenCalled;
+  }
+  try
+  {
+    streamNo = m_piqx->getStreamNo(channelName);
+  }
+  catch (const exception&)
+  {
+    return ErrorCodes::InvalidArrayName;
+  }
+
+  centers.clear();
+  if (timestamps == nullptr)
+  {
+    for (const auto& trigger : m_piqx->getTriggers(streamNo))
+    {
+      centers.push_back(static_cast<int64_t>(m_piqx->getSampleFromTimestamp(streamNo, trigger.timestamp)));
+    }
+  }
+  else
+  {
+    centers.reserve(timestamps->size());
+    for (double timestamp : *timestamps)
+    {
+      if (timestamp < 0)
+      {
+        return ErrorCodes::StartIndexOutOfRange;
+      }
+      iqx_timespec time;
+      time.tv_sec = static_cast<int64_t>(timestamp);
+      time.tv_nsec = static_cast<int64_t>((timestamp - time.tv_sec) * 1e9 + .5);
+      centers.push_back(static_cast<int64_t>(m_piqx->getSampleFromTimestamp(streamNo, time)));
+    }
+  }
+  return 0;
+}
+
+template <typename T>
+int MosaikIqxImpl::readWindowsAll(size_t streamNo, const std::vector<int64_t>& centers, size_t preSamples, size_t postSamples, std::vector<std::vector<T> >& windows)
+{
+  // windows closer than this (in IQ pairs) are served by one read instead of one read each
+  const int64_t MergeGap = 16384;
+  // a span is not extended beyond this number of IQ pairs (4 MB), only a single larger window makes a larger span
+  const int64_t MaxSpanPairs = 1024 * 1024;
+  const int64_t samples = static_cast<int64_t>(m_piqx->getStreamNoOfSamples(streamNo));
+
+  // clip the windows to the recording and sort them by file offset, i.e. by their first pair
+  vector<pair<int64_t, int64_t>> ranges(centers.size());
+  vector<size_t> order(centers.size());
+  for (size_t i = 0; i < centers.size(); ++i)
+  {
+    ranges[i].first = min(max(centers[i] - static_cast<int64_t>(preSamples), static_cast<int64_t>(0)), samples);
+    ranges[i].second = max(min(centers[i] + static_cast<int64_t>(postSamples), samples), ranges[i].first);
+    order[i] = i;
+  }
+  sort(order.begin(), order.end(), [&ranges](size_t a, size_t b) { return ranges[a].first < ranges[b].first; });
+
+  windows.assign(centers.size(), vector<T>());
+  vector<int16_t> span;
+  for (size_t first = 0; first < order.size();)
+  {
+    // collect the windows that overlap or nearly touch into one span, until the span would exceed its maximum size
+    const int64_t spanBegin = ranges[order[first]].first;
+    int64_t spanEnd = ranges[order[first]].second;
+    size_t last = first + 1;
+    while (last < order.size() && ranges[order[last]].first <= spanEnd + MergeGap
+      && max(spanEnd, ranges[order[last]].second) - spanBegin <= MaxSpanPairs)
+    {
+      spanEnd = max(spanEnd, ranges[order[last]].second);
+      ++last;
+    }
+
+    // read the span frame by frame, forward only
+    span.resize(static_cast<size_t>(spanEnd - spanBegin) * 2);
+    int64_t actPair = spanBegin;
+    while (actPair < spanEnd)
+    {
+      const int16_t* data = nullptr;
+      int64_t useablePairsInFrame = 0;
+      int res = readFramePairs(streamNo, actPair, spanEnd - actPair, data, useablePairsInFrame);
+      if (res != 0)
+      {
+        return res;
+      }
+      copy(data, data + useablePairsInFrame * 2, span.begin() + (actPair - spanBegin) * 2);
+      actPair += useablePairsInFrame;
+    }
+
+    for (size_t i = first; i < last; ++i)
+    {
+      const auto& range = ranges[order[i]];
+      vector<T>& window = windows[order[i]];
+      window.resize(static_cast<size_t>(range.second - range.first) * 2);
+      const int16_t* value = span.data() + (range.first - spanBegin) * 2;
+      for (auto& v : window)
+      {
+        v = static_cast<T>(*value++ * m_multiplicator);
+      }
+    }
+    first = last;
+  }
+  return 0;
+}
+
+void MosaikIqxImpl::setStatisticsEnabled(bool enabled)
+{
+  m_statistics.setEnabled(enabled);
+}
+
+IoStatistics MosaikIqxImpl::getStatistics() const
+{
+  return m_statistics.get();
+}
+
+int MosaikIqxImpl::locateFrame(size_t streamNo, int64_t actPair, int64_t& dataOffset, int64_t& firstPairInFrame, int64_t& pairsInFrame, uint32_t& resolution)
+{
+  // use cue entries to calculate the frame(s) to read
+  auto cue = m_piqx->getCueEntry(streamNo, m_piqx->getTimestampFromSample(streamNo, actPair));
+  // read the preamble
+  IqxPreamble preamble;
+  {
+    StatisticsCollector::Timer timer(m_statistics, IoPhase::Io);
+    if (m_piqx->readAt(cue.offset, &preamble, sizeof(preamble)) < static_cast<int64_t>(sizeof(preamble)))
+    {
+      return ErrorCodes::InternalError;
+    }
+    m_statistics.addRead(sizeof(preamble));
+  }
+  if (memcmp(&preamble.sync, iqxsync, sizeof(iqxsync)))
+  {
+    return ErrorCodes::InternalError;
+  }
+
+  //============================================================================
+  // 12 Bit:
+  // from iqbitconverter we need
+  // - conv12to16_dstsize
+  // - conv12to16
+  /*
+    12 Bit Frame
+       --32 Byte- DIGIQ_WORD_SIZE ----------------- 256 Bit ----------- - ==> 10 IQ Samples ist kleinste Einheit
+       -- 16 Byte-------------------- 16 Byte--------------------------
+
+       -- 5 * 2 * 12 Bit + 8 Bit reserved | 5 * 2 * 12 Bit + 8 Bit reserved---- -
+       = > IQIQIQIQIQ R                   | IQIQIQIQIQ R
+       = > 120 Bit + 8                    | 120 Bit + 8
+
+  */
+
+  // calculate the first pair in the frame
+  firstPairInFrame = m_piqx->getSampleFromTimestamp(streamNo, cue.timestamp);
+
+  // skip preamble and header
+  dataOffset = cue.offset + sizeof(preamble) + preamble.headsize;
+
+  //                                 ==================== 16 Bit IQ ========================================================
+  //                                 Frame iqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiq
+  //                                       |                     values  ---  preamble.datasize / 2  ---
+  //                                       |                     samples ---  preamble.datasize / 4  ---
+  //                                       firstPairInFrame
+  //                                                      actPair
+  // read pairs if you need more
+  // first pair to read
+  // two values are one pair
+  auto streamType = m_streamTypes.find(preamble.streamnum);
+  if (streamType == m_streamTypes.end())
+  {
+    return ErrorCodes::InternalError;
+  }
+  resolution = (streamType->second == IQX_STREAM_TYPE_IQDATA16) ? 16 : 12;
+
+  pairsInFrame = preamble.datasize / 4;
+  if (resolution == 12) pairsInFrame = IqBitConverter::conv12to16_dstsize(preamble.datasize) / 4;
+  return 0;
+}
+
+int MosaikIqxImpl::readFramePairs(size_t streamNo, int64_t actPair, int64_t pairCount, const int16_t*& values, int64_t& useablePairsInFrame)
+{
+  DAIEX_TRACE_SCOPE("Iqx::readFramePairs");
+  // scratch buffers are reused by all calls of a thread, so that concurrent readers do not share state
+  static thread_local vector<int16_t> data;
+  static thread_local vector<uint8_t> data12;
+
+  int64_t dataOffset = 0;
+  int64_t firstPairInFrame = 0;
+  int64_t pairsInFrame = 0;
+  uint32_t resolution = 16;
+  int res = locateFrame(streamNo, actPair, dataOffset, firstPairInFrame, pairsInFrame, resolution);
+  if (res != 0)
+  {
+    return res;
+  }
+
+  int64_t lastPairInFrame = firstPairInFrame + pairsInFrame - 1;
+  int64_t offsetOfFirstUseablePairInFrame = actPair - firstPairInFrame;
+  int64_t lastUseablePairInFrame = min(actPair + pairCount - 1, lastPairInFrame);
+  useablePairsInFrame = lastUseablePairInFrame - actPair + 1;
+  if (offsetOfFirstUseablePairInFrame < 0 || useablePairsInFrame <= 0)
+  {
+    return ErrorCodes::InternalError;
+  }
+
+  // leading and trailing pairs for 12 Bit data (aligned to 10 Samples (32 Bit))
+  size_t leadingPairs = 0;
+  size_t trailingPairs = 0;
+  if (resolution == 12)
+  {
+    leadingPairs = offsetOfFirstUseablePairInFrame % 10;
+    size_t modTrailingPairs = (offsetOfFirstUseablePairInFrame + useablePairsInFrame) % 10;
+    if (modTrailingPairs != 0)
+    {
+      trailingPairs = 10 - modTrailingPairs;
+    }
+  }
+
+  const size_t size = (useablePairsInFrame + leadingPairs + trailingPairs) * 2;
+  if (data.size() < size)
+  {
+    data.resize(size);
+  }
+
+  if (resolution == 12)
+  {
+    // auf DIGIQ_WORD_SIZE aufgerundet lesen und dann in data konvertieren
+    const size_t size12 = (useablePairsInFrame + leadingPairs + trailingPairs) / 10 * DIGIQ_WORD_SIZE;
+    if (data12.size() < size12)
+    {
+      data12.resize(size12);
+    }
+    const iqx_off_t offset12 = dataOffset + (offsetOfFirstUseablePairInFrame - leadingPairs) / 10 * DIGIQ_WORD_SIZE;
+    {
+      StatisticsCollector::Timer timer(m_statistics, IoPhase::Io);
+      if (m_piqx->readAt(offset12, data12.data(), size12) < static_cast<int64_t>(size12))
+      {
+        return ErrorCodes::InternalError;
+      }
+      m_statistics.addRead(size12);
+    }
+    StatisticsCollector::Timer timer(m_statistics, IoPhase::Conversion);
+    if (IqBitConverter::conv12to16(data12.data(), data.data(), size12) == -1)
+    {
+      return ErrorCodes::InternalError;
+    }
+  }
+  else
+  {
+    // first pair is 2 * int16 so mult by 4, read only as much data of the data part of the stream as we need
+    StatisticsCollector::Timer timer(m_statistics, IoPhase::Io);
+    if (m_piqx->readAt(dataOffset + offsetOfFirstUseablePairInFrame * 4, data.data(), size * 2) < static_cast<int64_t>(size * 2))
+    {
+      return ErrorCodes::InternalError;
+    }
+    m_statistics.addRead(size * 2);
+  }
+
+  values = data.data() + leadingPairs * 2;
+  return 0;
+}
+
 /*
 * IQX:       IQIQIQIQ    IQIQIQIQ    IQIQIQIQ
 *                           \ \ \    / /
@@ -528,6 +872,7 @@ int MosaikIqxImpl::appendChannels(const std::vector<double*>& iqdata, const std:
 */
 int MosaikIqxImpl::readArrayAll(const std::string& arrayName, std::vector<float>& vfValues, std::vector<double>& vdValues, float* fValues, double* dValues, size_t nofValues, size_t offset, rType rw)
 {
+	DAIEX_TRACE_SCOPE("Iqx::readArray");
 	float *fPtr = fValues;
 	double *dPtr = dValues;
 	switch (rw)
@@ -548,8 +893,6 @@ int MosaikIqxImpl::readArrayAll(const std::string& arrayName, std::vector<float>
 	{
 		return ErrorCodes::InternalError;
 	}
-   map<size_t, IqxStreamType> streamtypes = m_piqx->getStreamTypes();
-
 
   bool isI = arrayName.find("_I", arrayName.size() - 2) != string::npos;
 
@@ -558,136 +901,39 @@ int MosaikIqxImpl::readArrayAll(const std::string& arrayName, std::vector<float>
   int64_t pairCount = nofValues;
   while (pairCount > 0)
   {
-    // use cue entries to calculate the frame(s) to read
-    auto cue = m_piqx->getCueEntry(streamNo, m_piqx->getTimestampFromSample(streamNo, actPair));
-    // read the preamble
-    portable_lseek(*m_piqx, cue.offset, SEEK_SET);
-    IqxPreamble preamble;
-    // read the preamble
-    if (portable_read(*m_piqx, &preamble, sizeof(preamble)) < static_cast<ssize_t>(sizeof(preamble)))
-    {
-      return ErrorCodes::InternalError;
-    }
-    if (memcmp(&preamble.sync, iqxsync, sizeof(iqxsync)))
-    {
-      return ErrorCodes::InternalError;
-    }
-
-	 //============================================================================
-	 // 12 Bit:
-	 // from iqbitconverter we need
-	 // - conv12to16_dstsize
-	 // - conv12to16
-	 /*
-    12 Bit Frame
-       --32 Byte- DIGIQ_WORD_SIZE ----------------- 256 Bit ----------- - ==> 10 IQ Samples ist kleinste Einheit
-       -- 16 Byte-------------------- 16 Byte--------------------------
-
-       -- 5 * 2 * 12 Bit + 8 Bit reserved | 5 * 2 * 12 Bit + 8 Bit reserved---- -
-       = > IQIQIQIQIQ R                   | IQIQIQIQIQ R
-       = > 120 Bit + 8                    | 120 Bit + 8
-
-	 */
-
-    // calculate the first pair in the frame
-    int64_t firstPairInFrame = m_piqx->getSampleFromTimestamp(streamNo, cue.timestamp);
-
-    // skip header
-    portable_lseek(*m_piqx, preamble.headsize, SEEK_CUR);
-
-    //                                 ==================== 16 Bit IQ ========================================================      
-    //                                 Frame iqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiqiq
-    //                                       |                     values  ---  preamble.datasize / 2  ---
-    //                                       |                     samples ---  preamble.datasize / 4  ---
-    //                                       firstPairInFrame                                                          
-    //                                                      actPair  
-    // read pairs if you need more
-    // first pair to read
-    // two values are one pair
-    uint32_t resolution = (streamtypes.at(preamble.streamnum) == IQX_STREAM_TYPE_IQDATA16) ? 16 : 12;
-
-    int64_t PairsInFrame = preamble.datasize / 4;
-    if (resolution == 12) PairsInFrame = IqBitConverter::conv12to16_dstsize(preamble.datasize) / 4;
-    int64_t lastPairInFrame = firstPairInFrame + PairsInFrame - 1;
-    int64_t firstUseablePairInFrame = actPair;
-    int64_t offsetOfFirstUseablePairInFrame = actPair - firstPairInFrame;
-    int64_t lastUseablePairInFrame = min(firstUseablePairInFrame + pairCount - 1, lastPairInFrame);
-    int64_t useablePairsInFrame = lastUseablePairInFrame - actPair + 1;
-    //size_t useableValuesInFrame = useablePairsInFrame * 2;
-
-    // leading and trailing pairs for 12 Bit data (aligned to 10 Samples (32 Bit))
-    size_t leadingPairs = 0;
-    size_t trailingPairs = 0;
-    if (resolution == 12)
-    {
-       leadingPairs = offsetOfFirstUseablePairInFrame % 10;
-       size_t modTrailingPairs = (offsetOfFirstUseablePairInFrame + pairCount) % 10;
-       if (modTrailingPairs != 0) 
-       { 
-          trailingPairs = 10 - modTrailingPairs;
-       }
-    }
-    // calculate the new actPair for the next while iteration 
-    actPair += useablePairsInFrame;
-
-
-    const size_t size = (useablePairsInFrame + leadingPairs + trailingPairs) * 2;
-    const size_t leadingValues = leadingPairs * 2;
-
-    // buffer for 16 Bit data
-    auto data = unique_ptr<int16_t[]>(new int16_t[size]);
-
-    if (resolution == 12)
+    const int16_t* data = nullptr;
+    int64_t useablePairsInFrame = 0;
+    int res = readFramePairs(streamNo, actPair, pairCount, data, useablePairsInFrame);
+    if (res != 0)
     {
-       // auf DIGIQ_WORD_SIZE aufgerundet lesen und dann in data konvertieren
-       const size_t size12 = (useablePairsInFrame + leadingPairs + trailingPairs) / 10 * DIGIQ_WORD_SIZE;
-       // offset 
-       portable_lseek(*m_piqx, (offsetOfFirstUseablePairInFrame - leadingPairs) / 10 * DIGIQ_WORD_SIZE, SEEK_CUR);
-       auto data12 = unique_ptr<uint8_t[]>(new uint8_t[size12]);
-       if (portable_read(*m_piqx, data12.get(), static_cast<unsigned int>(size12)) < static_cast<int>(size12))
-       {
-          return ErrorCodes::InternalError;
-       }
-       if (IqBitConverter::conv12to16(data12.get(), data.get(), size12) == -1)
-       {
-          return ErrorCodes::InternalError;
-       }
-    }
-    else
-    {
-       // seek to First Pair which is 2 * int16 so mult by 4
-       portable_lseek(*m_piqx, offsetOfFirstUseablePairInFrame * 4, SEEK_CUR);
-       // read only as much data of the data part of the stream as we need
-       if (portable_read(*m_piqx, data.get(), static_cast<unsigned int>(size * 2)) < static_cast<int>(size * 2))
-       {
-          return ErrorCodes::InternalError;
-       }
+      return res;
     }
 
-    int64_t firstValue = isI ? leadingValues : leadingValues + 1;
-    int64_t lastValue = firstValue + useablePairsInFrame * 2;
-    for (int64_t value = firstValue; value <= lastValue; value = value + 2)
+    StatisticsCollector::Timer timer(m_statistics, IoPhase::Conversion);
+    const int16_t* value = isI ? data : data + 1;
+    const int16_t* lastValue = value + useablePairsInFrame * 2;
+    for (; value < lastValue; value += 2)
     {
       // convert and copy
       switch (rw)
       {
       case rFloatVector:
       {
-        float f = data[value];
+        float f = *value;
         f = f * m_multiplicator;
         vfValues.push_back(f);
         break;
       }
       case rDoubleVector:
       {
-        double d = data[value];
+        double d = *value;
         d = d * m_multiplicator;
         vdValues.push_back(d);
         break;
       }
       case rFloatPointer:
       {
-        float f = data[value];
+        float f = *value;
         f = f  * m_multiplicator;
         *fPtr = f;
         fPtr++;
@@ -695,7 +941,7 @@ int MosaikIqxImpl::readArrayAll(const std::string& arrayName, std::vector<float>
       }
       case rDoublePointer:
       {
-        double d = data[value];
+        double d = *value;
         d = d  * m_multiplicator;
         *dPtr = d;
         dPtr++;
@@ -703,18 +949,176 @@ int MosaikIqxImpl::readArrayAll(const std::string& arrayName, std::vector<float>
       }
       }
       // convert and copy end
-      pairCount--;
-      if (pairCount == 0)
-      {
-        return 0;
-      }
     }
+    // calculate the new actPair for the next while iteration
+    actPair += useablePairsInFrame;
+    pairCount -= useablePairsInFrame;
   }
 	return 0;
 }
 
+int MosaikIqxImpl::readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  DAIEX_TRACE_SCOPE("Iqx::readArray");
+  scale = m_multiplicator;
+  auto streamNo = m_piqx->getStreamNo(arrayName);
+  if (m_piqx->getStreamNoOfSamples(streamNo) < (offset + nofValues))
+  {
+    return ErrorCodes::InternalError;
+  }
+
+  bool isI = arrayName.find("_I", arrayName.size() - 2) != string::npos;
+
+  int64_t actPair = offset;
+  int64_t pairCount = nofValues;
+  while (pairCount > 0)
+  {
+    const int16_t* data = nullptr;
+    int64_t useablePairsInFrame = 0;
+    int res = readFramePairs(streamNo, actPair, pairCount, data, useablePairsInFrame);
+    if (res != 0)
+    {
+      return res;
+    }
+
+    StatisticsCollector::Timer timer(m_statistics, IoPhase::Conversion);
+    const int16_t* value = isI ? data : data + 1;
+    const int16_t* lastValue = value + useablePairsInFrame * 2;
+    for (; value < lastValue; value += 2)
+    {
+      *values++ = *value;
+    }
+    actPair += useablePairsInFrame;
+    pairCount -= useablePairsInFrame;
+  }
+  return 0;
+}
+
+int MosaikIqxImpl::readChannel(const std::string& channelName, int16_t* values, size_t nofValues, double& scale, size_t offset)
+{
+  DAIEX_TRACE_SCOPE("Iqx::readChannel");
+  scale = m_multiplicator;
+  auto streamNo = m_piqx->getStreamNo(channelName);
+  if (m_piqx->getStreamNoOfSamples(streamNo) < (offset + nofValues))
+  {
+    return ErrorCodes::InternalError;
+  }
+
+  int64_t actPair = offset;
+  int64_t pairCount = nofValues;
+  while (pairCount > 0)
+  {
+    const int16_t* data = nullptr;
+    int64_t useablePairsInFrame = 0;
+    int res = readFramePairs(streamNo, actPair, pairCount, data, useablePairsInFrame);
+    if (res != 0)
+    {
+      return res;
+    }
+
+    // the values are stored as IQ pairs already
+    StatisticsCollector::Timer timer(m_statistics, IoPhase::Conversion);
+    values = copy(data, data + useablePairsInFrame * 2, values);
+    actPair += useablePairsInFrame;
+    pairCount -= useablePairsInFrame;
+  }
+  return 0;
+}
+
+int MosaikIqxImpl::readArrayAsync(const std::string& arrayName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+{
+  return readAsync(false, arrayName, values, nofValues, offset, callback);
+}
+
+int MosaikIqxImpl::readArrayAsync(const std::string& arrayName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+{
+  return readAsync(false, arrayName, values, nofValues, offset, callback);
+}
+
+int MosaikIqxImpl::readChannelAsync(const std::string& channelName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+{
+  return readAsync(true, channelName, values, nofValues, offset, callback);
+}
+
+int MosaikIqxImpl::readChannelAsync(const std::string& channelName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+{
+  return readAsync(true, channelName, values, nofValues, offset, callback);
+}
+
+template <typename T>
+int MosaikIqxImpl::readAsync(bool readChannel, const std::string& name, T* values, size_t nofPairs, size_t offset, AsyncReadCallback callback)
+{
+  DAIEX_TRACE_SCOPE("Iqx::readAsync");
+  if (!m_piqx || m_write)
+  {
+    return ErrorCodes::OpenFileHasNotBeenCalled;
+  }
+  size_t streamNo = 0;
+  try
+  {
+    streamNo = m_piqx->getStreamNo(name);
+  }
+  catch (const exception&)
+  {
+    return ErrorCodes::InvalidArrayName;
+  }
+  if (m_piqx->getStreamNoOfSamples(streamNo) < (offset + nofPairs))
+  {
+    return ErrorCodes::InternalError;
+  }
+
+  // the frames are located with the cue index and their preambles are read now, the IQ data is read asynchronously.
+  // Every frame contributes one segment, IQIQ values of a channel or every second value of an array.
+  const bool isI = readChannel || name.find("_I", name.size() - 2) != string::npos;
+  vector<RawSegment> segments;
+  size_t destIndex = 0;
+  int64_t actPair = offset;
+  int64_t pairCount = nofPairs;
+  while (pairCount > 0)
+  {
+    int64_t dataOffset = 0;
+    int64_t firstPairInFrame = 0;
+    int64_t pairsInFrame = 0;
+    uint32_t resolution = 16;
+    int res = locateFrame(streamNo, actPair, dataOffset, firstPairInFrame, pairsInFrame, resolution);
+    if (res != 0)
+    {
+      return res;
+    }
+    // 12 bit values are packed into DIGIQ words, which the asynchronous reads cannot unpack
+    if (resolution != 16)
+    {
+      return ErrorCodes::InvalidDataFormat;
+    }
+
+    const int64_t offsetInFrame = actPair - firstPairInFrame;
+    const int64_t useablePairsInFrame = min(pairCount, firstPairInFrame + pairsInFrame - actPair);
+    if (offsetInFrame < 0 || useablePairsInFrame <= 0)
+    {
+      return ErrorCodes::InternalError;
+    }
+
+    const uint64_t fileOffset = dataOffset + offsetInFrame * 2 * sizeof(int16_t) + (isI ? 0 : sizeof(int16_t));
+    if (readChannel)
+    {
+      segments.push_back(RawSegment(fileOffset, static_cast<size_t>(useablePairsInFrame) * 2, 1, 1, destIndex, 1));
+      destIndex += static_cast<size_t>(useablePairsInFrame) * 2;
+    }
+    else
+    {
+      segments.push_back(RawSegment(fileOffset, static_cast<size_t>(useablePairsInFrame), 1, 2, destIndex, 1));
+      destIndex += static_cast<size_t>(useablePairsInFrame);
+    }
+    actPair += useablePairsInFrame;
+    pairCount -= useablePairsInFrame;
+  }
+
+  return AsyncReadService::instance().read(m_asyncFile, m_filename, RawValueType::Int16, m_multiplicator, segments, values, callback, &m_statistics);
+}
+
 int MosaikIqxImpl::readChannelAll(const std::string& channelName, std::vector<float>& vfValues, std::vector<double>& vdValues, float* fValues, double* dValues, size_t nofValues, size_t offset, rType rw)
 {
+  DAIEX_TRACE_SCOPE("Iqx::readChannel");
   float *fPtr = fValues;
   double *dPtr = dValues;
   auto streamNo = m_piqx->getStreamNo(channelName);
@@ -741,119 +1145,43 @@ int MosaikIqxImpl::readChannelAll(const std::string& channelName, std::vector<fl
     vdValues.reserve(nofValues * 2);
   }
 
-  map<size_t, IqxStreamType> streamtypes = m_piqx->getStreamTypes();
-
   int64_t actPair = offset;
   // nofValues in samples, each sample has I and Q, so mult by 2 
   int64_t pairCount = nofValues;
   while (pairCount > 0)
   {
-     // use cue entries to calculate the frame(s) to read
-     auto cue = m_piqx->getCueEntry(streamNo, m_piqx->getTimestampFromSample(streamNo, actPair));
-     // read the preamble
-     portable_lseek(*m_piqx, cue.offset, SEEK_SET);
-     IqxPreamble preamble;
-     // read the preamble
-     if (portable_read(*m_piqx, &preamble, sizeof(preamble)) < static_cast<ssize_t>(sizeof(preamble)))
+     const int16_t* data = nullptr;
+     int64_t useablePairsInFrame = 0;
+     int res = readFramePairs(streamNo, actPair, pairCount, data, useablePairsInFrame);
+     if (res != 0)
      {
-        return ErrorCodes::InternalError;
-     }
-     if (memcmp(&preamble.sync, iqxsync, sizeof(iqxsync)))
-     {
-        return ErrorCodes::InternalError;
+        return res;
      }
 
-     // calculate the first pair in the frame
-     int64_t firstPairInFrame = m_piqx->getSampleFromTimestamp(streamNo, cue.timestamp);
-     // skip header
-     portable_lseek(*m_piqx, preamble.headsize, SEEK_CUR);
-     // read pairs if you need more
-     // first pair to read
-     // two values are one pair
-     uint32_t resolution = (streamtypes.at(preamble.streamnum) == IQX_STREAM_TYPE_IQDATA16) ? 16 : 12;
-
-     int64_t PairsInFrame = preamble.datasize / 4;
-     if (resolution == 12) PairsInFrame = IqBitConverter::conv12to16_dstsize(preamble.datasize) / 4;
-     int64_t lastPairInFrame = firstPairInFrame + PairsInFrame - 1;
-     int64_t firstUseablePairInFrame = actPair;
-     int64_t offsetOfFirstUseablePairInFrame = actPair - firstPairInFrame;
-     int64_t lastUseablePairInFrame = min(firstUseablePairInFrame + pairCount - 1, lastPairInFrame);
-     int64_t useablePairsInFrame = lastUseablePairInFrame - actPair + 1;
-     size_t useableValuesInFrame = useablePairsInFrame * 2;
-
-     // leading and trailing pairs for 12 Bit data (aligned to 10 Samples (32 Bit))
-     size_t leadingPairs = 0;
-     size_t trailingPairs = 0;
-     if (resolution == 12)
-     {
-        leadingPairs = offsetOfFirstUseablePairInFrame % 10;
-        size_t modTrailingPairs = (offsetOfFirstUseablePairInFrame + pairCount) % 10;
-        if (modTrailingPairs != 0)
-        {
-           trailingPairs = 10 - modTrailingPairs;
-        }
-     }
-     // calculate the new actPair for the next while iteration 
-     actPair += useablePairsInFrame;
-
-
-     const size_t size = (useablePairsInFrame + leadingPairs + trailingPairs) * 2;
-     const size_t leadingValues = leadingPairs * 2;
-
-     // buffer for 16 Bit data
-     auto data = unique_ptr<int16_t[]>(new int16_t[size]);
-
-     if (resolution == 12)
-     {
-        // auf DIGIQ_WORD_SIZE aufgerundet lesen und dann in data konvertieren
-        const size_t size12 = (useablePairsInFrame + leadingPairs + trailingPairs) / 10 * DIGIQ_WORD_SIZE;
-        // offset 
-        portable_lseek(*m_piqx, (offsetOfFirstUseablePairInFrame - leadingPairs) / 10 * DIGIQ_WORD_SIZE, SEEK_CUR);
-        auto data12 = unique_ptr<uint8_t[]>(new uint8_t[size12]);
-        if (portable_read(*m_piqx, data12.get(), static_cast<unsigned int>(size12)) < static_cast<int>(size12))
-        {
-           return ErrorCodes::InternalError;
-        }
-        if (IqBitConverter::conv12to16(data12.get(), data.get(), size12) == -1)
-        {
-           return ErrorCodes::InternalError;
-        }
-     }
-     else
-     {
-        // seek to First Pair which is 2 * int16 so mult by 4
-        portable_lseek(*m_piqx, offsetOfFirstUseablePairInFrame * 4, SEEK_CUR);
-        // read only as much data of the data part of the stream as we need
-        if (portable_read(*m_piqx, data.get(), static_cast<unsigned int>(size * 2)) < static_cast<int>(size * 2))
-        {
-           return ErrorCodes::InternalError;
-        }
-     }
-
-     int64_t firstValue = leadingValues;
-     int64_t lastValue = firstValue + useableValuesInFrame -1;
-     for (int64_t value = firstValue; value <= lastValue; value++)
+     StatisticsCollector::Timer timer(m_statistics, IoPhase::Conversion);
+     const int16_t* lastValue = data + useablePairsInFrame * 2;
+     for (const int16_t* value = data; value < lastValue; value++)
      {
         // convert and copy
         switch (rw)
         {
         case rFloatVector:
         {
-           float f = data[value];
+           float f = *value;
            f = f  * m_multiplicator;
            vfValues.push_back(f);
            break;
         }
         case rDoubleVector:
         {
-           double d = data[value];
+           double d = *value;
            d = d  * m_multiplicator;
            vdValues.push_back(d);
            break;
         }
         case rFloatPointer:
         {
-           float f = data[value];
+           float f = *value;
            f = f  * m_multiplicator;
            *fPtr = f;
            fPtr++;
@@ -861,7 +1189,7 @@ int MosaikIqxImpl::readChannelAll(const std::string& channelName, std::vector<fl
         }
         case rDoublePointer:
         {
-           double d = data[value];
+           double d = *value;
            d = d  * m_multiplicator;
            *dPtr = d;
            dPtr++;
@@ -870,11 +1198,9 @@ int MosaikIqxImpl::readChannelAll(const std::string& channelName, std::vector<fl
         } // end switch
         // convert and copy end
      } // end for
+     // calculate the new actPair for the next while iteration
+     actPair += useablePairsInFrame;
      pairCount -= useablePairsInFrame;
-     if (pairCount == 0)
-     {
-        return 0;
-     }
   }
   return 0;
 }
@@ -887,32 +1213,22 @@ int MosaikIqxImpl::writeIqFramesFromArrays(int64_t streamno, float * fArrayI, fl
 	int64_t samplesProcessed = 0;
 	while (samplesLeft > 0)
 	{
-    vector<int16_t> iqData;
     int64_t samplesToDo = samplesLeft;
 		if (samplesToDo > MaxSamples)
 		{
 			samplesToDo = MaxSamples;
 		}
-    iqData.reserve(samplesToDo * 2);
+    const size_t pending = prepareFrameBuffer(streamno, samplesToDo);
+		StatisticsCollector::Timer timer(m_statistics, IoPhase::Conversion);
 		if (w == wFloat)
 		{
-			for (int64_t i = samplesProcessed; i < samplesProcessed + samplesToDo; i++)
-			{
-				iqData.push_back((int16_t)(*(fArrayI + i) * INT16_MAX));
-				iqData.push_back((int16_t)(*(fArrayQ + i) * INT16_MAX));
-			}
+      IqBitConverter::convFloatToInt16Interleaved(fArrayI + samplesProcessed, fArrayQ + samplesProcessed, m_frameBuffer->data() + pending, samplesToDo, INT16_MAX);
 		}
 		else
 		{
-			for (int64_t i = samplesProcessed; i < samplesProcessed + samplesToDo; i++)
-			{
-				iqData.push_back((int16_t)(*(dArrayI + i) * INT16_MAX));
-				iqData.push_back((int16_t)(*(dArrayQ + i) * INT16_MAX));
-			}
+      IqBitConverter::convDoubleToInt16Interleaved_array(dArrayI + samplesProcessed, dArrayQ + samplesProcessed, m_frameBuffer->data() + pending, samplesToDo, INT16_MAX);
 		}
-		int seq = m_piqx->getSequenceNo(streamno);
-		m_piqx->writeDataFrame(streamno, seq, iqData);
-		m_piqx->setSequenceNo(streamno, seq + 1);
+		writeFrameBuffer(streamno, pending / 2 + samplesToDo);
 
 		samplesLeft -= samplesToDo;
 		samplesProcessed += samplesToDo;
@@ -928,35 +1244,24 @@ int MosaikIqxImpl::writeIqFramesFromChannel(int64_t streamno, float * fChannel,
 	int64_t samplesProcessed = 0;
 	while (samplesLeft > 0)
 	{
-    vector<int16_t> iqData;
     int64_t samplesToDo = samplesLeft;
 		if (samplesToDo > MaxSamples)
 		{
 			samplesToDo = MaxSamples;
 		}
-		iqData.reserve(samplesToDo * 2);
+    const size_t pending = prepareFrameBuffer(streamno, samplesToDo);
+		StatisticsCollector::Timer timer(m_statistics, IoPhase::Conversion);
 		if (w == wFloat)
 		{
-			for (int64_t i = samplesProcessed; i < samplesProcessed + samplesToDo; i++)
-			{
-				iqData.push_back((int16_t)(*fChannel++ * INT16_MAX));
-				iqData.push_back((int16_t)(*fChannel++ * INT16_MAX));
-			}
+      IqBitConverter::convFloatToInt16(fChannel + 2 * samplesProcessed, m_frameBuffer->data() + pending, samplesToDo * 2, INT16_MAX);
 		}
 		else
 		{
-			for (int64_t i = samplesProcessed; i < samplesProcessed + samplesToDo; i++)
-			{
-				iqData.push_back((int16_t)(*dChannel++ * INT16_MAX));
-				iqData.push_back((int16_t)(*dChannel++ * INT16_MAX));
-			}
+      IqBitConverter::convDoubleToInt16_array(dChannel + 2 * samplesProcessed, m_frameBuffer->data() + pending, samplesToDo * 2, INT16_MAX);
 		}
+		writeFrameBuffer(streamno, pending / 2 + samplesToDo);
 
-		int seq = m_piqx->getSequenceNo(streamno);
-		m_piqx->writeDataFrame(streamno, seq, iqData);
-		m_piqx->setSequenceNo(streamno, seq + 1);
-
-		// iqData has a size of 2 * samples (I+Q)
+		// the frame holds 2 * samples values (I+Q)
 		samplesLeft -= samplesToDo;
 		samplesProcessed += samplesToDo;
 	}
@@ -964,6 +1269,46 @@ int MosaikIqxImpl::writeIqFramesFromChannel(int64_t streamno, float * fChannel,
 }
 
 
+size_t MosaikIqxImpl::prepareFrameBuffer(int64_t streamno, int64_t pairs)
+{
+  const vector<int16_t>& pendingValues = m_pendingValues[streamno];
+  const size_t pending = pendingValues.size();
+  // the frame buffer is reused for all frames, it grows to the largest frame written
+  if (!m_frameBuffer)
+  {
+    m_frameBuffer.reset(new FrameBuffer());
+  }
+  if (m_frameBuffer->size() < pending + static_cast<size_t>(pairs * 2))
+  {
+    m_frameBuffer->resize(pending + pairs * 2);
+  }
+  copy(pendingValues.begin(), pendingValues.end(), m_frameBuffer->begin());
+  return pending;
+}
+
+void MosaikIqxImpl::writeFrameBuffer(int64_t streamno, size_t pairs, bool flush)
+{
+  size_t framePairs = pairs;
+  vector<int16_t>& pendingValues = m_pendingValues[streamno];
+  pendingValues.clear();
+  if (m_resolution == 12 && !flush)
+  {
+    // frames of 12 bit streams consist of complete DIGIQ words, the rest is written with the next frame
+    framePairs = pairs / SAMPLES_COMPLEX12_PER_DIGIQ_WORD * SAMPLES_COMPLEX12_PER_DIGIQ_WORD;
+    pendingValues.assign(m_frameBuffer->begin() + framePairs * 2, m_frameBuffer->begin() + pairs * 2);
+  }
+  if (framePairs == 0)
+  {
+    return;
+  }
+
+  StatisticsCollector::Timer timer(m_statistics, IoPhase::Io);
+  int seq = m_piqx->getSequenceNo(streamno);
+  m_piqx->writeDataFrame(streamno, seq, m_frameBuffer->data(), framePairs * 2);
+  m_statistics.addWrite(framePairs * 2 * sizeof(int16_t));
+  m_piqx->setSequenceNo(streamno, seq + 1);
+}
+
 } // namespace
 } // namespace
 } // namespace
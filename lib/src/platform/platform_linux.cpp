@@ -17,7 +17,13 @@
 #include "platform.h"
 
 #include <sstream>
+#include <algorithm>
+#include <glob.h>
 #include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <locale.h>
+#include <unistd.h>
 
 #include "daiexception.h"
 #include "errorcodes.h"
@@ -61,6 +67,20 @@ namespace rohdeschwarz
         return st.st_size;
       }
 
+      std::vector<std::string> Platform::findFiles(const std::string& pattern)
+      {
+        std::vector<std::string> files;
+        glob_t result;
+        if (0 == glob(pattern.c_str(), 0, nullptr, &result))
+        {
+          files.assign(result.gl_pathv, result.gl_pathv + result.gl_pathc);
+        }
+
+        globfree(&result);
+        std::sort(files.begin(), files.end());
+        return files;
+      }
+
       time_t Platform::getTime(const std::string& formattedString)
       {
         struct tm tz;
@@ -148,6 +168,61 @@ namespace rohdeschwarz
       {
         return archive_write_open_filename(a, filename.c_str());
       }
+
+      int Platform::fileOpenRead(const std::string& filename)
+      {
+        return open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+      }
+
+      int64_t Platform::fileReadAt(int fd, uint64_t offset, void* buffer, size_t bytes)
+      {
+        uint8_t* dst = static_cast<uint8_t*>(buffer);
+        size_t done = 0;
+        while (done < bytes)
+        {
+          ssize_t res = pread(fd, dst + done, bytes - done, static_cast<off_t>(offset + done));
+          if (res < 0)
+          {
+            if (errno == EINTR)
+            {
+              continue;
+            }
+            return -1;
+          }
+          if (res == 0)
+          {
+            break;
+          }
+          done += static_cast<size_t>(res);
+        }
+        return static_cast<int64_t>(done);
+      }
+
+      void Platform::fileClose(int fd)
+      {
+        close(fd);
+      }
+
+      ThreadLocale::ThreadLocale() :
+        locale_(nullptr),
+        previousLocale_(nullptr),
+        previousSetting_(0)
+      {
+        locale_t locale = duplocale(LC_GLOBAL_LOCALE);
+        if (locale == (locale_t)0)
+        {
+          throw DaiException(ErrorCodes::InternalError);
+        }
+
+        this->locale_ = locale;
+        this->previousLocale_ = uselocale(locale);
+      }
+
+      ThreadLocale::~ThreadLocale()
+      {
+        uselocale(static_cast<locale_t>(this->previousLocale_));
+        freelocale(static_cast<locale_t>(this->locale_));
+      }
     }
   }
 }
@@ -18,8 +18,10 @@
 
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 #include <fcntl.h>
 #include <io.h>
+#include <locale.h>
 #include <windows.h>
 
 #include "common.h"
@@ -67,6 +69,32 @@ namespace rohdeschwarz
         return static_cast<uint64_t>(st.st_size);
       }
 
+      std::vector<std::string> Platform::findFiles(const std::string& pattern)
+      {
+        std::vector<std::string> files;
+        const std::string::size_type pos = pattern.find_last_of("/\\");
+        const std::string path = (pos == std::string::npos) ? "" : pattern.substr(0, pos + 1);
+
+        WIN32_FIND_DATAW data;
+        HANDLE handle = FindFirstFileW(Common::utf8toUtf16(pattern).c_str(), &data);
+        if (handle == INVALID_HANDLE_VALUE)
+        {
+          return files;
+        }
+
+        do
+        {
+          if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+          {
+            files.push_back(path + Common::utf16ToUtf8(data.cFileName));
+          }
+        } while (FindNextFileW(handle, &data));
+
+        FindClose(handle);
+        std::sort(files.begin(), files.end());
+        return files;
+      }
+
       time_t Platform::getTime(const std::string& formattedString)
       {
         struct tm tz;
@@ -159,6 +187,64 @@ namespace rohdeschwarz
       {
         return archive_write_open_filename_w(a, Common::utf8toUtf16(filename).c_str());
       }
+
+      int Platform::fileOpenRead(const std::string& filename)
+      {
+        return _wopen(Common::utf8toUtf16(filename).c_str(), _O_RDONLY | _O_BINARY | _O_NOINHERIT);
+      }
+
+      int64_t Platform::fileReadAt(int fd, uint64_t offset, void* buffer, size_t bytes)
+      {
+        uint8_t* dst = static_cast<uint8_t*>(buffer);
+        size_t done = 0;
+        while (done < bytes)
+        {
+          // ReadFile with an explicit offset does not depend on the file position shared with other threads
+          OVERLAPPED overlapped = { 0 };
+          const uint64_t pos = offset + done;
+          overlapped.Offset = static_cast<DWORD>(pos);
+          overlapped.OffsetHigh = static_cast<DWORD>(pos >> 32);
+          DWORD chunk = static_cast<DWORD>((std::min)(bytes - done, static_cast<size_t>(0x40000000)));
+          DWORD res = 0;
+          if (!ReadFile(reinterpret_cast<HANDLE>(_get_osfhandle(fd)), dst + done, chunk, &res, &overlapped))
+          {
+            if (GetLastError() == ERROR_HANDLE_EOF)
+            {
+              break;
+            }
+            return -1;
+          }
+          if (res == 0)
+          {
+            break;
+          }
+          done += res;
+        }
+        return static_cast<int64_t>(done);
+      }
+
+      void Platform::fileClose(int fd)
+      {
+        _close(fd);
+      }
+
+      ThreadLocale::ThreadLocale() :
+        locale_(nullptr),
+        previousLocale_(nullptr),
+        previousSetting_(0)
+      {
+        // the per-thread locale is initialized with the global locale
+        this->previousSetting_ = _configthreadlocale(_ENABLE_PER_THREAD_LOCALE);
+        if (this->previousSetting_ == -1)
+        {
+          throw DaiException(ErrorCodes::InternalError);
+        }
+      }
+
+      ThreadLocale::~ThreadLocale()
+      {
+        _configthreadlocale(this->previousSetting_);
+      }
     }
   }
 }
@@ -0,0 +1,278 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+#include "trace.h"
+#include "tracescope.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "errorcodes.h"
+
+using namespace std;
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+#ifdef DAIEX_TRACING
+      namespace
+      {
+        /** @brief One trace event. */
+        struct TraceEvent
+        {
+          /** @brief Name of the event, a string literal. */
+          const char* name;
+
+          /** @brief Time since the origin of the registry in ns. */
+          uint64_t ns;
+
+          /** @brief 'B' for begin, 'E' for end. */
+          char phase;
+        };
+
+        /**
+        * @brief Fixed size block of trace events. Written by one thread only, which publishes
+        * new events by a release store of size, so readers never see partially written events.
+        */
+        struct TraceChunk
+        {
+          static const size_t Capacity = 4096;
+
+          TraceChunk() : size(0), next(nullptr) {}
+
+          TraceEvent events[Capacity];
+          atomic<size_t> size;
+          atomic<TraceChunk*> next;
+        };
+
+        /** @brief Trace events of one thread, a list of chunks that is only appended to. */
+        class TraceBuffer
+        {
+        public:
+          explicit TraceBuffer(size_t tid) : tid_(tid), first_(new TraceChunk()), last_(first_) {}
+
+          ~TraceBuffer()
+          {
+            this->freeChunks(this->first_);
+          }
+
+          /** @brief Appends an event, called by the owning thread only. */
+          void append(const char* name, uint64_t ns, char phase)
+          {
+            TraceChunk* chunk = this->last_;
+            size_t size = chunk->size.load(memory_order_relaxed);
+            if (size == TraceChunk::Capacity)
+            {
+              TraceChunk* next = new TraceChunk();
+              chunk->next.store(next, memory_order_release);
+              this->last_ = next;
+              chunk = next;
+              size = 0;
+            }
+
+            chunk->events[size] = TraceEvent{ name, ns, phase };
+            chunk->size.store(size + 1, memory_order_release);
+          }
+
+          /** @brief Discards all events, must not run concurrently to append(). */
+          void clear()
+          {
+            this->freeChunks(this->first_->next.load(memory_order_acquire));
+            this->first_->next.store(nullptr, memory_order_relaxed);
+            this->first_->size.store(0, memory_order_release);
+            this->last_ = this->first_;
+          }
+
+          /** @brief Writes all events published so far as JSON objects, each preceded by a comma. */
+          void write(ostream& os) const
+          {
+            for (const TraceChunk* chunk = this->first_; chunk != nullptr; chunk = chunk->next.load(memory_order_acquire))
+            {
+              const size_t size = chunk->size.load(memory_order_acquire);
+              for (size_t i = 0; i < size; ++i)
+              {
+                const TraceEvent& event = chunk->events[i];
+                os << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"daiex\",\"ph\":\"" << event.phase
+                  << "\",\"ts\":" << event.ns / 1000 << "." << (event.ns % 1000) / 100 << (event.ns % 100) / 10 << event.ns % 10
+                  << ",\"pid\":1,\"tid\":" << this->tid_ << "}";
+              }
+            }
+          }
+
+          size_t getTid() const
+          {
+            return this->tid_;
+          }
+
+        private:
+          TraceBuffer(const TraceBuffer&);
+          TraceBuffer& operator=(const TraceBuffer&);
+
+          static void freeChunks(TraceChunk* chunk)
+          {
+            while (chunk != nullptr)
+            {
+              TraceChunk* next = chunk->next.load(memory_order_relaxed);
+              delete chunk;
+              chunk = next;
+            }
+          }
+
+          /** @brief Thread id written to the trace, the index of registration. */
+          const size_t tid_;
+
+          TraceChunk* first_;
+
+          /** @brief Chunk appended to, only accessed by the owning thread. */
+          TraceChunk* last_;
+        };
+
+        /**
+        * @brief Buffers of all threads that have recorded events. Buffers are kept when their thread
+        * terminates, so the events of finished worker threads are part of the trace.
+        */
+        struct TraceRegistry
+        {
+          TraceRegistry() : origin(chrono::steady_clock::now()) {}
+
+          const chrono::steady_clock::time_point origin;
+
+          /** @brief Guards buffers, locked on the first event of a thread and when writing the trace. */
+          mutex lock;
+
+          vector<unique_ptr<TraceBuffer>> buffers;
+        };
+
+        TraceRegistry& registry()
+        {
+          static TraceRegistry instance;
+          return instance;
+        }
+
+        TraceBuffer* registerThread()
+        {
+          TraceRegistry& reg = registry();
+          lock_guard<mutex> lock(reg.lock);
+          reg.buffers.push_back(unique_ptr<TraceBuffer>(new TraceBuffer(reg.buffers.size() + 1)));
+          return reg.buffers.back().get();
+        }
+
+        /** @brief Writes the trace to the file specified by DAIEX_TRACE_FILE when the library is unloaded. */
+        class TraceFileWriter
+        {
+        public:
+          TraceFileWriter()
+          {
+            // construct the registry first, so it is destroyed after this object
+            registry();
+          }
+
+          ~TraceFileWriter()
+          {
+            const char* filename = getenv("DAIEX_TRACE_FILE");
+            if (filename != nullptr && *filename != '\0')
+            {
+              Trace::writeChromeTrace(filename);
+            }
+          }
+        };
+
+        TraceFileWriter traceFileWriter;
+      }
+
+      void traceEvent(const char* name, char phase)
+      {
+        static thread_local TraceBuffer* buffer = registerThread();
+        const uint64_t ns = static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - registry().origin).count());
+        buffer->append(name, ns, phase);
+      }
+
+      bool Trace::isEnabled()
+      {
+        return true;
+      }
+
+      void Trace::clear()
+      {
+        TraceRegistry& reg = registry();
+        lock_guard<mutex> lock(reg.lock);
+        for (auto& buffer : reg.buffers)
+        {
+          buffer->clear();
+        }
+      }
+
+      int Trace::writeChromeTrace(const string& filename)
+      {
+        ofstream os(filename, ios::out | ios::trunc);
+        if (false == os.is_open())
+        {
+          return ErrorCodes::FileOpenError;
+        }
+
+        os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"daiex\"}}";
+
+        TraceRegistry& reg = registry();
+        lock_guard<mutex> lock(reg.lock);
+        for (auto& buffer : reg.buffers)
+        {
+          os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->getTid() << ",\"args\":{\"name\":\"thread " << buffer->getTid() << "\"}}";
+          buffer->write(os);
+        }
+
+        os << "\n]}\n";
+        os.close();
+        return os.fail() ? ErrorCodes::FileOpenError : ErrorCodes::Success;
+      }
+#else
+      void traceEvent(const char*, char)
+      {
+      }
+
+      bool Trace::isEnabled()
+      {
+        return false;
+      }
+
+      void Trace::clear()
+      {
+      }
+
+      int Trace::writeChromeTrace(const string& filename)
+      {
+        ofstream os(filename, ios::out | ios::trunc);
+        if (false == os.is_open())
+        {
+          return ErrorCodes::FileOpenError;
+        }
+
+        os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[]}\n";
+        os.close();
+        return os.fail() ? ErrorCodes::FileOpenError : ErrorCodes::Success;
+      }
+#endif
+    }
+  }
+}
@@ -0,0 +1,170 @@
+/*
+	* Copyright (c) Rohde & Schwarz
+	*
+	* Licensed under the Apache License, Version 2.0 (the "License");
+	* you may not use this file except in compliance with the License.
+	* You may obtain a copy of the License at
+	*
+	*     http://www.apache.org/licenses/LICENSE-2.0
+	*
+	* Unless required by applicable law or agreed to in writing, software
+	* distributed under the License is distributed on an "AS IS" BASIS,
+	* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	* See the License for the specific language governing permissions and
+	* limitations under the License.
+*/
+
+#include "workstealingpool.h"
+
+using namespace std;
+
+namespace rohdeschwarz
+{
+  namespace mosaik
+  {
+    namespace dataimportexport
+    {
+      namespace
+      {
+        // pool and index of the worker running on the current thread
+        thread_local const WorkStealingPool* currentPool = nullptr;
+        thread_local size_t currentWorker = 0;
+      }
+
+      WorkStealingPool::WorkStealingPool(size_t nofThreads) :
+        queued_(0),
+        pending_(0),
+        stop_(false)
+      {
+        if (nofThreads == 0)
+        {
+          nofThreads = max(1u, thread::hardware_concurrency());
+        }
+
+        for (size_t i = 0; i < nofThreads; ++i)
+        {
+          this->queues_.emplace_back(new Queue());
+        }
+
+        for (size_t i = 0; i < nofThreads; ++i)
+        {
+          this->threads_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+        }
+      }
+
+      WorkStealingPool::~WorkStealingPool()
+      {
+        this->wait();
+
+        {
+          lock_guard<mutex> lock(this->mutex_);
+          this->stop_ = true;
+        }
+        this->taskCondition_.notify_all();
+
+        for (auto& t : this->threads_)
+        {
+          t.join();
+        }
+      }
+
+      void WorkStealingPool::submit(std::function<void()> task)
+      {
+        {
+          lock_guard<mutex> lock(this->mutex_);
+          Queue& queue = (currentPool == this) ? *this->queues_[currentWorker] : this->shared_;
+          {
+            lock_guard<mutex> queueLock(queue.mutex);
+            queue.tasks.push_back(move(task));
+          }
+          ++this->pending_;
+          ++this->queued_;
+        }
+        this->taskCondition_.notify_one();
+      }
+
+      void WorkStealingPool::wait()
+      {
+        unique_lock<mutex> lock(this->mutex_);
+        this->idleCondition_.wait(lock, [this] { return this->pending_ == 0; });
+      }
+
+      size_t WorkStealingPool::getNofThreads() const
+      {
+        return this->threads_.size();
+      }
+
+      bool WorkStealingPool::take(size_t worker, std::function<void()>& task)
+      {
+        // newest own task first, its data is most likely still cached
+        {
+          Queue& own = *this->queues_[worker];
+          lock_guard<mutex> lock(own.mutex);
+          if (false == own.tasks.empty())
+          {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            --this->queued_;
+            return true;
+          }
+        }
+
+        {
+          lock_guard<mutex> lock(this->shared_.mutex);
+          if (false == this->shared_.tasks.empty())
+          {
+            task = move(this->shared_.tasks.front());
+            this->shared_.tasks.pop_front();
+            --this->queued_;
+            return true;
+          }
+        }
+
+        // steal the oldest task of another worker, starting with the next worker to spread stealing
+        for (size_t i = 1; i < this->queues_.size(); ++i)
+        {
+          Queue& victim = *this->queues_[(worker + i) % this->queues_.size()];
+          lock_guard<mutex> lock(victim.mutex);
+          if (false == victim.tasks.empty())
+          {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --this->queued_;
+            return true;
+          }
+        }
+
+        return false;
+      }
+
+      void WorkStealingPool::workerLoop(size_t worker)
+      {
+        currentPool = this;
+        currentWorker = worker;
+
+        for (;;)
+        {
+          function<void()> task;
+          if (this->take(worker, task))
+          {
+            task();
+
+            lock_guard<mutex> lock(this->mutex_);
+            if (--this->pending_ == 0)
+            {
+              this->idleCondition_.notify_all();
+            }
+            continue;
+          }
+
+          unique_lock<mutex> lock(this->mutex_);
+          this->taskCondition_.wait(lock, [this] { return this->stop_ || this->queued_ > 0; });
+          if (this->stop_ && this->queued_ == 0)
+          {
+            return;
+          }
+        }
+      }
+    }
+  }
+}
@@ -95,6 +95,16 @@ namespace rohdeschwarz
 				return m_pimpl->setTimestamp(timestamp);
 			}
 
+			void Wv::setStatisticsEnabled(bool enabled)
+			{
+				m_pimpl->setStatisticsEnabled(enabled);
+			}
+
+			IoStatistics Wv::getStatistics() const
+			{
+				return m_pimpl->getStatistics();
+			}
+
 			int Wv::readArray(const std::string& arrayName, std::vector<float>& values, size_t nofValues, size_t offset)
 			{
 				return m_pimpl->readArray(arrayName, values, nofValues, offset);
@@ -175,6 +185,36 @@ namespace rohdeschwarz
 				return m_pimpl->appendChannels(iqdata, sizes);
 			}
 
+			int Wv::readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset)
+			{
+				return m_pimpl->readArray(arrayName, values, nofValues, scale, offset);
+			}
+
+			int Wv::readChannel(const std::string& channelName, int16_t* values, size_t nofValues, double& scale, size_t offset)
+			{
+				return m_pimpl->readChannel(channelName, values, nofValues, scale, offset);
+			}
+
+			int Wv::readArrayAsync(const std::string& arrayName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+			{
+				return m_pimpl->readAsync(false, arrayName, values, nofValues, offset, callback);
+			}
+
+			int Wv::readArrayAsync(const std::string& arrayName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+			{
+				return m_pimpl->readAsync(false, arrayName, values, nofValues, offset, callback);
+			}
+
+			int Wv::readChannelAsync(const std::string& channelName, float* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+			{
+				return m_pimpl->readAsync(true, channelName, values, nofValues, offset, callback);
+			}
+
+			int Wv::readChannelAsync(const std::string& channelName, double* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+			{
+				return m_pimpl->readAsync(true, channelName, values, nofValues, offset, callback);
+			}
+
 			void Wv::setScrambler(WvScramblerBase * scrambler)
 			{
 				m_pimpl->setScrambler(scrambler);
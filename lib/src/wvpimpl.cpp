@@ -30,6 +30,7 @@
 
 #include "common.h"
 #include "wvpimpl.h"
+#include "tracescope.h"
 
 namespace rohdeschwarz
 {
@@ -52,10 +53,13 @@ namespace rohdeschwarz
 
 			Wv::Impl::~Impl()
 			{
+				// pending asynchronous reads count their bytes in m_statistics
+				AsyncReadService::close(m_asyncFile);
 			}
 
 			int Wv::Impl::readOpen(std::vector<std::string>& arrayNames)
 			{
+				StatisticsCollector::Timer timer(m_statistics, IoPhase::Parsing);
 				try
 				{
           resetData();
@@ -177,6 +181,7 @@ namespace rohdeschwarz
 
 			int Wv::Impl::close()
 			{
+				AsyncReadService::close(m_asyncFile);
 				m_wv.Close();
 				return 0;
 			}
@@ -286,6 +291,16 @@ namespace rohdeschwarz
 				return 1;
 			}
 
+			void Wv::Impl::setStatisticsEnabled(bool enabled)
+			{
+				m_statistics.setEnabled(enabled);
+			}
+
+			IoStatistics Wv::Impl::getStatistics() const
+			{
+				return m_statistics.get();
+			}
+
 			void Wv::Impl::setScrambler(WvScramblerBase *scrambler)
 			{
 				m_wv.setScrambler(scrambler);
@@ -293,6 +308,105 @@ namespace rohdeschwarz
 			}
 
 
+			int Wv::Impl::readArray(const std::string& arrayName, int16_t* values, size_t nofValues, double& scale, size_t offset)
+			{
+				DAIEX_TRACE_SCOPE("Wv::readArray");
+				if (m_scrambled && !m_scramblerSet) return 1;
+				scale = m_multiplicator;
+				unsigned int samples = (unsigned int)(nofValues);
+				if (samples > m_samples)
+				{
+					return 1;
+				}
+				unique_ptr<unsigned int[]> databuffer(new unsigned int[samples]);
+				{
+					StatisticsCollector::Timer timer(m_statistics, IoPhase::Io);
+					if (m_wv.ReadSamples((unsigned int)offset, samples, databuffer.get()) != 0)
+					{
+						return 1;
+					}
+					m_statistics.addRead(samples * sizeof(unsigned int));
+				}
+
+				StatisticsCollector::Timer timer(m_statistics, IoPhase::Conversion);
+				bool isI = arrayName.find("_I", arrayName.size() - 2) != string::npos;
+				const int16_t *data = (const int16_t *)databuffer.get() + (isI ? 0 : 1);
+				for (size_t i = 0; i < nofValues; i++)
+				{
+					values[i] = data[i * 2];
+				}
+				return 0;
+			}
+
+			int Wv::Impl::readChannel(const std::string& /* channelName */, int16_t* values, size_t nofValues, double& scale, size_t offset)
+			{
+				DAIEX_TRACE_SCOPE("Wv::readChannel");
+				if (m_scrambled && !m_scramblerSet) return 1;
+				scale = m_multiplicator;
+				unsigned int samples = (unsigned int)(nofValues);
+				if (samples > m_samples)
+				{
+					return 1;
+				}
+
+				// an IQ pair is stored as one 32 bit word, so aligned buffers of the caller are read without a copy
+				unique_ptr<unsigned int[]> databuffer;
+				unsigned int *target = (unsigned int *)values;
+				if (reinterpret_cast<uintptr_t>(values) % alignof(unsigned int) != 0)
+				{
+					databuffer.reset(new unsigned int[samples]);
+					target = databuffer.get();
+				}
+
+				{
+					StatisticsCollector::Timer timer(m_statistics, IoPhase::Io);
+					if (m_wv.ReadSamples((unsigned int)offset, samples, target) != 0)
+					{
+						return 1;
+					}
+					m_statistics.addRead(samples * sizeof(unsigned int));
+				}
+
+				if (databuffer)
+				{
+					StatisticsCollector::Timer timer(m_statistics, IoPhase::Conversion);
+					memcpy(values, databuffer.get(), samples * sizeof(unsigned int));
+				}
+				return 0;
+			}
+
+			template<typename T>
+			int Wv::Impl::readAsync(bool readChannel, const std::string& name, T* values, size_t nofValues, size_t offset, AsyncReadCallback callback)
+			{
+				DAIEX_TRACE_SCOPE("Wv::readAsync");
+				// scrambled samples cannot be converted from the raw file content
+				if (m_write || m_scrambled || !m_wv.IsOpen()) return 1;
+				if (offset + nofValues > m_samples) return 1;
+
+				unsigned int optWordsOffset = 0;
+				unsigned int samplesOffset = 0;
+				bool scrambled = false;
+				m_wv.GetSamplesOffset(optWordsOffset, samplesOffset, scrambled);
+
+				// each sample is stored as int16 I followed by int16 Q
+				uint64_t fileOffset = samplesOffset + uint64_t(offset) * 2 * sizeof(int16_t);
+				std::vector<RawSegment> segments;
+				if (readChannel)
+				{
+					segments.push_back(RawSegment(fileOffset, nofValues, 2, 2, 0, 2));
+				}
+				else
+				{
+					bool isI = name.find("_I", name.size() - 2) != string::npos;
+					segments.push_back(RawSegment(fileOffset + (isI ? 0 : sizeof(int16_t)), nofValues, 1, 2, 0, 1));
+				}
+
+				return AsyncReadService::instance().read(m_asyncFile, m_filename, RawValueType::Int16, m_multiplicator, segments, values, callback, &m_statistics);
+			}
+
+			template int Wv::Impl::readAsync<float>(bool, const std::string&, float*, size_t, size_t, AsyncReadCallback);
+			template int Wv::Impl::readAsync<double>(bool, const std::string&, double*, size_t, size_t, AsyncReadCallback);
+
 			/*
 			* IQX:       IQIQIQIQ    IQIQIQIQ    IQIQIQIQ
 			*                           \ \ \    / /
@@ -300,6 +414,7 @@ namespace rohdeschwarz
 			*/
 			int Wv::Impl::readArrayAll(const std::string& arrayName, std::vector<float>& vfValues, std::vector<double>& vdValues, float* fValues, double* dValues, size_t nofValues, size_t offset, rType rw)
 			{
+				DAIEX_TRACE_SCOPE("Wv::readArray");
 				if (m_scrambled && !m_scramblerSet) return 1;
 				float *fPtr = fValues;
 				double *dPtr = dValues;
@@ -321,8 +436,13 @@ namespace rohdeschwarz
 					return 1;
 				}
 				unique_ptr<unsigned int[]> databuffer(new unsigned int[samples]);
-				m_wv.ReadSamples(offset, samples, databuffer.get());
+				{
+					StatisticsCollector::Timer timer(m_statistics, IoPhase::Io);
+					m_wv.ReadSamples(offset, samples, databuffer.get());
+					m_statistics.addRead(samples * sizeof(unsigned int));
+				}
 				int16_t *data = (int16_t *)databuffer.get();
+				StatisticsCollector::Timer timer(m_statistics, IoPhase::Conversion);
 
 				size_t readBegin8 = 0;
 				bool isI = arrayName.find("_I", arrayName.size() - 2) != string::npos;
@@ -389,6 +509,7 @@ namespace rohdeschwarz
 
 			int Wv::Impl::readChannelAll(const std::string& /* channelName */, std::vector<float>& vfValues, std::vector<double>& vdValues, float* fValues, double* dValues, size_t nofValues, size_t offset, rType rw)
 			{
+				DAIEX_TRACE_SCOPE("Wv::readChannel");
 				if (m_scrambled && !m_scramblerSet) return 1;
 				float *fPtr = fValues;
 				double *dPtr = dValues;
@@ -420,8 +541,13 @@ namespace rohdeschwarz
 				size_t symbols = nofValues;
 				unique_ptr<unsigned int[]> databuffer(new unsigned int[symbols]);
 
-				m_wv.ReadSamples((unsigned int)offset, (unsigned int)symbols, databuffer.get());
+				{
+					StatisticsCollector::Timer timer(m_statistics, IoPhase::Io);
+					m_wv.ReadSamples((unsigned int)offset, (unsigned int)symbols, databuffer.get());
+					m_statistics.addRead(symbols * sizeof(unsigned int));
+				}
 				int16_t *data = (int16_t *) databuffer.get();
+				StatisticsCollector::Timer timer(m_statistics, IoPhase::Conversion);
 
 				switch (rw)
 				{
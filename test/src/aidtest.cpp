@@ -3,6 +3,14 @@
 #include "dataimportexport.h"
 #include "common.h"
 
+#include "ZFFileWriter.h"
+#include "rs_gx40x_global_frame_types_if_defs.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
 #ifdef _WIN32
 #define isfinite(x) _finite(x)
 #endif
@@ -550,3 +558,513 @@ TEST_F(AidTest, readChannelDoubleVector)
     ASSERT_EQ(iqVector[i * 2 + 1], (double)i * -1.0);
   }
 }
+
+TEST_F(AidTest, readArrayWithGapBetweenFrames)
+{
+  // copy the recording and insert a 4K gap after the first frame (frame offsets are shifted)
+  ifstream src(Common::TestOutputDir + "appendArrayFloatVector.aid", ios::binary);
+  ASSERT_TRUE(src.good());
+  vector<char> content((istreambuf_iterator<char>(src)), istreambuf_iterator<char>());
+  src.close();
+  const size_t frames = 8; // 1M samples, 128K samples per frame
+  ASSERT_EQ(content.size() % frames, 0);
+  const size_t frameSize = content.size() / frames;
+
+  ofstream dst(Common::TestOutputDir + "readArrayWithGapBetweenFrames.aid", ios::binary | ios::trunc);
+  vector<char> gap(4 * KB, 0x5A);
+  dst.write(&content[0], frameSize);
+  dst.write(&gap[0], gap.size());
+  dst.write(&content[frameSize], content.size() - frameSize);
+  dst.close();
+
+  Aid aid(Common::TestOutputDir + "readArrayWithGapBetweenFrames.aid");
+  vector<string> arrayNames;
+  ASSERT_EQ(0, aid.readOpen(arrayNames));
+  vector<ChannelInfo> channels;
+  map<string, string> metadata;
+  ASSERT_EQ(0, aid.getMetadata(channels, metadata));
+  ASSERT_NE(channels.size(), 0);
+  ASSERT_EQ(MB, channels[0].getSamples());
+
+  // read a window crossing the gap and one at the end of the recording
+  vector<float> iVector;
+  const size_t offset = 100000;
+  ASSERT_EQ(0, aid.readArray(channels[0].getChannelName() + "_I", iVector, 100000, offset));
+  for (size_t i = 0; i < iVector.size(); i++)
+  {
+    ASSERT_EQ(iVector[i], i + offset);
+  }
+  vector<float> iVectorEnd;
+  ASSERT_EQ(0, aid.readArray(channels[0].getChannelName() + "_I", iVectorEnd, 1000, MB - 1000));
+  for (size_t i = 0; i < iVectorEnd.size(); i++)
+  {
+    ASSERT_EQ(iVectorEnd[i], i + MB - 1000);
+  }
+  ASSERT_EQ(0, aid.close());
+}
+
+TEST_F(AidTest, readArrayAlternatingWindows)
+{
+  Aid aid(Common::TestOutputDir + "appendArrayFloatVector.aid");
+  vector<string> arrayNames;
+  ASSERT_EQ(0, aid.readOpen(arrayNames));
+  vector<ChannelInfo> channels;
+  map<string, string> metadata;
+  ASSERT_EQ(0, aid.getMetadata(channels, metadata));
+  ASSERT_NE(channels.size(), 0);
+
+  // I and Q of the same window share one decoded block, a new window has to be read again
+  const size_t offsets[] = { 1000, 1000, 500000, 1000 };
+  for (size_t offset : offsets)
+  {
+    float iValues[256];
+    float qValues[256];
+    ASSERT_EQ(0, aid.readArray(channels[0].getChannelName() + "_I", iValues, 256, offset));
+    ASSERT_EQ(0, aid.readArray(channels[0].getChannelName() + "_Q", qValues, 256, offset));
+    for (size_t i = 0; i < 256; i++)
+    {
+      ASSERT_EQ(iValues[i], i + offset);
+      ASSERT_EQ(qValues[i], iValues[i] * -1);
+    }
+  }
+  ASSERT_EQ(0, aid.close());
+}
+
+TEST_F(AidTest, appendArrayFrameSettingsAsyncWrite)
+{
+  Aid aid(Common::TestOutputDir + "appendArrayFrameSettingsAsyncWrite.aid");
+  vector<float> iVector(MB + 123);
+  vector<float> qVector(MB + 123);
+  for (size_t i = 0; i < iVector.size(); i++)
+  {
+    iVector[i] = i;
+    qVector[i] = iVector[i] * -1;
+  }
+  vector<vector<float>> writeVector;
+  writeVector.push_back(iVector);
+  writeVector.push_back(qVector);
+
+  vector<ChannelInfo> channels;
+  channels.emplace_back(ChannelInfo("Channel1", 2000000, 10000000));
+  map<string, string> metadata;
+  metadata["Ch1_MeasBandwidth[Hz]"] = "1600000";
+
+  ASSERT_EQ(ErrorCodes::InconsistentInputData, aid.setFrameSettings(0, 1));
+  ASSERT_EQ(ErrorCodes::InconsistentInputData, aid.setFrameSettings(MB, 1));
+  ASSERT_EQ(0, aid.setFrameSettings(4096, 4));
+  ASSERT_EQ(0, aid.setAsyncWrite(true));
+  ASSERT_EQ(0, aid.writeOpen(IqDataFormat::Complex, 1, "appendArrayFrameSettingsAsyncWrite", "comment", channels, &metadata));
+  ASSERT_EQ(ErrorCodes::WriterAlreadyInitialized, aid.setFrameSettings(4096, 4));
+  // several calls, each one ends within a frame
+  for (size_t i = 0; i < 4; i++)
+  {
+    ASSERT_EQ(0, aid.appendArrays(writeVector));
+  }
+  ASSERT_EQ(0, aid.close());
+
+  Aid reader(Common::TestOutputDir + "appendArrayFrameSettingsAsyncWrite.aid");
+  vector<string> arrayNames;
+  ASSERT_EQ(0, reader.readOpen(arrayNames));
+  ASSERT_EQ(4 * iVector.size(), reader.getArraySize(arrayNames[0]));
+  vector<float> iRead;
+  vector<float> qRead;
+  ASSERT_EQ(0, reader.readArray(arrayNames[0] + "_I", iRead, iVector.size(), 3 * iVector.size()));
+  ASSERT_EQ(0, reader.readArray(arrayNames[0] + "_Q", qRead, qVector.size(), 3 * qVector.size()));
+  ASSERT_EQ(iVector, iRead);
+  ASSERT_EQ(qVector, qRead);
+  ASSERT_EQ(0, reader.close());
+}
+
+TEST_F(AidTest, appendWithoutWriteOpen)
+{
+  const string filename = Common::TestOutputDir + "appendWithoutWriteOpen.aid";
+  vector<vector<float>> writeVector(2, vector<float>(100, 0.5f));
+
+  // the result of writing the frame data is reported
+  Aid aid(filename);
+  ASSERT_EQ(ErrorCodes::FileWriterUninitialized, aid.appendArrays(writeVector));
+
+  vector<ChannelInfo> channels;
+  channels.emplace_back(ChannelInfo("Channel1", 2000000, 10000000));
+  map<string, string> metadata;
+  ASSERT_EQ(0, aid.writeOpen(IqDataFormat::Complex, 2, "appendWithoutWriteOpen", "comment", channels, &metadata));
+  ASSERT_EQ(0, aid.appendArrays(writeVector));
+  ASSERT_EQ(0, aid.close());
+  ASSERT_EQ(ErrorCodes::FileWriterUninitialized, aid.appendArrays(writeVector));
+  remove(filename.c_str());
+}
+
+TEST_F(AidTest, readIntegerFromFloatFrames)
+{
+  // the frames written by Aid contain float values, which cannot be read as integers
+  Aid aid(Common::TestOutputDir + "appendArrayFloatVector.aid");
+  vector<string> arrayNames;
+  ASSERT_EQ(0, aid.readOpen(arrayNames));
+  vector<ChannelInfo> channels;
+  map<string, string> metadata;
+  ASSERT_EQ(0, aid.getMetadata(channels, metadata));
+  ASSERT_NE(channels.size(), 0);
+
+  vector<int16_t> values16(2000);
+  vector<int32_t> values32(2000);
+  double scale = 0;
+  ASSERT_EQ(ErrorCodes::WrongDataType, aid.readArray(channels[0].getChannelName() + "_I", values16.data(), 1000, scale));
+  ASSERT_EQ(ErrorCodes::WrongDataType, aid.readArray(channels[0].getChannelName() + "_Q", values32.data(), 1000, scale, 1000));
+  ASSERT_EQ(ErrorCodes::WrongDataType, aid.readChannel(channels[0].getChannelName(), values16.data(), 1000, scale));
+  ASSERT_EQ(ErrorCodes::WrongDataType, aid.readChannel(channels[0].getChannelName(), values32.data(), 1000, scale));
+
+  // the float values are still readable
+  vector<float> iVector;
+  ASSERT_EQ(0, aid.readArray(channels[0].getChannelName() + "_I", iVector, 1000, 1000));
+  for (size_t i = 0; i < iVector.size(); i++)
+  {
+    ASSERT_EQ(iVector[i], i + 1000);
+  }
+  ASSERT_EQ(0, aid.close());
+}
+
+namespace
+{
+  // 8 frames of 4 data blocks with 4096 samples
+  const size_t FrameIndexFrames = 8;
+  const size_t FrameIndexSamples = FrameIndexFrames * 4 * 4096;
+  // the sidecar header has 56 bytes and ends with the number of entries, each entry has 40 bytes
+  const size_t FrameIndexHeaderSize = 56;
+  const size_t FrameIndexEntrySize = 40;
+
+  vector<char> readBinaryFile(const string& filename)
+  {
+    ifstream file(filename, ios::binary);
+    return vector<char>((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+  }
+
+  void writeBinaryFile(const string& filename, const vector<char>& content)
+  {
+    ofstream file(filename, ios::binary | ios::trunc);
+    file.write(content.data(), content.size());
+  }
+
+  void writeFrameIndexFile(const string& filename)
+  {
+    remove((filename + ".zfidx").c_str());
+
+    vector<float> iVector(FrameIndexSamples);
+    vector<float> qVector(FrameIndexSamples);
+    for (size_t i = 0; i < iVector.size(); i++)
+    {
+      iVector[i] = i;
+      qVector[i] = iVector[i] * -1;
+    }
+    vector<vector<float>> writeVector;
+    writeVector.push_back(iVector);
+    writeVector.push_back(qVector);
+
+    vector<ChannelInfo> channels;
+    channels.emplace_back(ChannelInfo("Channel1", 2000000, 10000000));
+    map<string, string> metadata;
+
+    Aid aid(filename);
+    ASSERT_EQ(0, aid.setFrameSettings(4096, 4));
+    ASSERT_EQ(0, aid.writeOpen(IqDataFormat::Complex, 1, "frameIndexFile", "comment", channels, &metadata));
+    ASSERT_EQ(0, aid.appendArrays(writeVector));
+    ASSERT_EQ(0, aid.close());
+  }
+
+  // opens the file using the sidecar, checks the number of samples and the values at the end
+  void expectFrameIndexFileRead(const string& filename, size_t nofSamples)
+  {
+    Aid aid(filename);
+    ASSERT_EQ(0, aid.setFrameIndexFileEnabled(true));
+    vector<string> arrayNames;
+    ASSERT_EQ(0, aid.readOpen(arrayNames));
+    ASSERT_EQ(ErrorCodes::ReaderAlreadyInitialized, aid.setFrameIndexFileEnabled(false));
+    ASSERT_EQ(nofSamples, aid.getArraySize(arrayNames[0]));
+
+    vector<float> iVector;
+    vector<float> qVector;
+    const size_t offset = nofSamples - 20000;
+    ASSERT_EQ(0, aid.readArray(arrayNames[0] + "_I", iVector, 20000, offset));
+    ASSERT_EQ(0, aid.readArray(arrayNames[0] + "_Q", qVector, 20000, offset));
+    for (size_t i = 0; i < iVector.size(); i++)
+    {
+      ASSERT_EQ(iVector[i], i + offset);
+      ASSERT_EQ(qVector[i], iVector[i] * -1);
+    }
+    ASSERT_EQ(0, aid.close());
+  }
+}
+
+TEST_F(AidTest, frameIndexFileBuild)
+{
+  const string filename = Common::TestOutputDir + "frameIndexFileBuild.aid";
+  const string indexFilename = filename + ".zfidx";
+  writeFrameIndexFile(filename);
+
+  // disabled by default
+  Aid aid(filename);
+  vector<string> arrayNames;
+  ASSERT_EQ(0, aid.readOpen(arrayNames));
+  ASSERT_EQ(FrameIndexSamples, aid.getArraySize(arrayNames[0]));
+  ASSERT_EQ(0, aid.close());
+  ASSERT_FALSE(ifstream(indexFilename).good());
+
+  expectFrameIndexFileRead(filename, FrameIndexSamples);
+  ASSERT_EQ(FrameIndexHeaderSize + FrameIndexFrames * FrameIndexEntrySize, readBinaryFile(indexFilename).size());
+
+  remove(indexFilename.c_str());
+  remove(filename.c_str());
+}
+
+TEST_F(AidTest, frameIndexFileLoad)
+{
+  const string filename = Common::TestOutputDir + "frameIndexFileLoad.aid";
+  const string indexFilename = filename + ".zfidx";
+  writeFrameIndexFile(filename);
+  expectFrameIndexFileRead(filename, FrameIndexSamples);
+
+  // drop the last frame from the sidecar, which is still valid. The file is not scanned, so the last frame is missing.
+  vector<char> index = readBinaryFile(indexFilename);
+  ASSERT_EQ(FrameIndexHeaderSize + FrameIndexFrames * FrameIndexEntrySize, index.size());
+  uint64_t entries = 0;
+  memcpy(&entries, &index[FrameIndexHeaderSize - sizeof(entries)], sizeof(entries));
+  ASSERT_EQ(FrameIndexFrames, entries);
+  --entries;
+  memcpy(&index[FrameIndexHeaderSize - sizeof(entries)], &entries, sizeof(entries));
+  index.resize(index.size() - FrameIndexEntrySize);
+  writeBinaryFile(indexFilename, index);
+
+  const size_t framePairs = FrameIndexSamples / FrameIndexFrames;
+  expectFrameIndexFileRead(filename, FrameIndexSamples - framePairs);
+  ASSERT_EQ(index, readBinaryFile(indexFilename));
+
+  remove(indexFilename.c_str());
+  remove(filename.c_str());
+}
+
+TEST_F(AidTest, frameIndexFileStale)
+{
+  const string filename = Common::TestOutputDir + "frameIndexFileStale.aid";
+  const string indexFilename = filename + ".zfidx";
+  writeFrameIndexFile(filename);
+  expectFrameIndexFileRead(filename, FrameIndexSamples);
+
+  // drop the last frame from the sidecar as in frameIndexFileLoad
+  vector<char> index = readBinaryFile(indexFilename);
+  ASSERT_EQ(FrameIndexHeaderSize + FrameIndexFrames * FrameIndexEntrySize, index.size());
+  uint64_t entries = FrameIndexFrames - 1;
+  memcpy(&index[FrameIndexHeaderSize - sizeof(entries)], &entries, sizeof(entries));
+  index.resize(index.size() - FrameIndexEntrySize);
+  writeBinaryFile(indexFilename, index);
+
+  // rewrite the file with the same size, the modification time has a resolution of one second on some platforms
+  this_thread::sleep_for(chrono::milliseconds(1100));
+  writeBinaryFile(filename, readBinaryFile(filename));
+
+  // the sidecar is rejected, the file is scanned again and the sidecar is replaced
+  expectFrameIndexFileRead(filename, FrameIndexSamples);
+  ASSERT_EQ(FrameIndexHeaderSize + FrameIndexFrames * FrameIndexEntrySize, readBinaryFile(indexFilename).size());
+
+  remove(indexFilename.c_str());
+  remove(filename.c_str());
+}
+
+namespace
+{
+  // 3 frames of 2 data blocks with 4096 samples and a shorter last frame
+  const size_t FixedPointSamples = 3 * 2 * 4096 + 1000;
+  // offset of the frame type in the frame header, after magic word, frame length and frame count
+  const size_t FrameTypeOffset = 12;
+
+  // Aid writes float frames only, the fixed point frames are written with CZFFileWriter
+  void writeFixedPointFile(const string& filename, uint32_t frameType, float recipGain)
+  {
+    // full scale of the values in volts is recipGain
+    AmlabCommon::CArrayComplex data((uint32_t)FixedPointSamples);
+    data.setSize((uint32_t)FixedPointSamples);
+    for (uint32_t i = 0; i < FixedPointSamples; i++)
+    {
+      data[i].re = recipGain * 0.9f * sinf(i * 0.01f);
+      data[i].im = recipGain * (((i % 1000) / 1000.0f) - 0.5f);
+    }
+
+    AmlabFiles::CZFFileWriter writer(std::wstring(filename.begin(), filename.end()));
+    writer.setFrameType(frameType);
+    writer.setSampleRate(2000000);
+    writer.setCenterFrequency(10000000);
+    writer.setDatablockSettings(4096, 2);
+    writer.setRecipGain(recipGain);
+    ASSERT_EQ(AmlabFiles::ekNoError, writer.open());
+    ASSERT_EQ(AmlabFiles::ekNoError, writer.write(data));
+    ASSERT_EQ(AmlabFiles::ekNoError, writer.close());
+  }
+
+  // the writer does not support real-valued frames, the type of 16RE_16IM frames is changed instead,
+  // so that each I and Q value becomes one real-valued sample
+  void changeFrameTypeToReal(const string& filename)
+  {
+    vector<char> content = readBinaryFile(filename);
+    size_t frameOffset = 0;
+    while (frameOffset + FrameTypeOffset + sizeof(uint32_t) <= content.size())
+    {
+      uint32_t frameLength = 0;
+      memcpy(&frameLength, content.data() + frameOffset + sizeof(uint32_t), sizeof(frameLength));
+      ASSERT_GT(frameLength, 0u);
+      const uint32_t frameType = ekFRH_DATASTREAM__IFDATA_16RE_16RE_FIX;
+      memcpy(content.data() + frameOffset + FrameTypeOffset, &frameType, sizeof(frameType));
+      frameOffset += frameLength * sizeof(uint32_t);
+    }
+    writeBinaryFile(filename, content);
+  }
+
+  // reads nofValues samples as T and as float, values * scale has to match the float values
+  template<typename T>
+  void expectFixedPointAsFloat(Aid& aid, const string& channelName, size_t nofValues, size_t offset, double& scale)
+  {
+    vector<float> expected(2 * nofValues);
+    vector<T> values(2 * nofValues);
+    scale = 0;
+    ASSERT_EQ(0, aid.readChannel(channelName, expected.data(), nofValues, offset));
+    ASSERT_EQ(0, aid.readChannel(channelName, values.data(), nofValues, scale, offset));
+    ASSERT_GT(scale, 0);
+    for (size_t i = 0; i < 2 * nofValues; i++)
+    {
+      ASSERT_FLOAT_EQ(expected[i], static_cast<float>(values[i] * scale)) << "channel index " << i;
+    }
+
+    const char* suffixes[] = { "_I", "_Q" };
+    for (const char* suffix : suffixes)
+    {
+      double arrayScale = 0;
+      ASSERT_EQ(0, aid.readArray(channelName + suffix, expected.data(), nofValues, offset));
+      ASSERT_EQ(0, aid.readArray(channelName + suffix, values.data(), nofValues, arrayScale, offset));
+      ASSERT_EQ(scale, arrayScale);
+      for (size_t i = 0; i < nofValues; i++)
+      {
+        ASSERT_FLOAT_EQ(expected[i], static_cast<float>(values[i] * scale)) << suffix << " index " << i;
+      }
+    }
+  }
+
+  void openFixedPointFile(Aid& aid, string& channelName)
+  {
+    vector<string> arrayNames;
+    ASSERT_EQ(0, aid.readOpen(arrayNames));
+    ASSERT_FALSE(arrayNames.empty());
+    channelName = arrayNames[0];
+  }
+}
+
+TEST_F(AidTest, readInteger16BitFrames)
+{
+  const string filename = Common::TestOutputDir + "readInteger16BitFrames.aid";
+  writeFixedPointFile(filename, ekFRH_DATASTREAM__IFDATA_16RE_16IM_FIX, 1.0f);
+
+  Aid aid(filename);
+  string channelName;
+  openFixedPointFile(aid, channelName);
+  ASSERT_EQ(FixedPointSamples, aid.getArraySize(channelName));
+
+  // within a data block, across data blocks and frames, and up to the end of the file
+  double scale16 = 0;
+  double scale32 = 0;
+  expectFixedPointAsFloat<int16_t>(aid, channelName, 1000, 100, scale16);
+  expectFixedPointAsFloat<int16_t>(aid, channelName, 10000, 4000, scale16);
+  expectFixedPointAsFloat<int16_t>(aid, channelName, 5000, FixedPointSamples - 5000, scale16);
+  // the 16 bit values are widened to int32 with the same scale
+  expectFixedPointAsFloat<int32_t>(aid, channelName, 10000, 4000, scale32);
+  expectFixedPointAsFloat<int32_t>(aid, channelName, 5000, FixedPointSamples - 5000, scale32);
+  ASSERT_EQ(scale16, scale32);
+  ASSERT_EQ(0, aid.close());
+  remove(filename.c_str());
+}
+
+TEST_F(AidTest, readInteger32BitFrames)
+{
+  const string filename = Common::TestOutputDir + "readInteger32BitFrames.aid";
+  writeFixedPointFile(filename, ekFRH_DATASTREAM__IFDATA_32RE_32IM_FIX, 1.0f);
+
+  Aid aid(filename);
+  string channelName;
+  openFixedPointFile(aid, channelName);
+
+  double scale = 0;
+  expectFixedPointAsFloat<int32_t>(aid, channelName, 1000, 100, scale);
+  expectFixedPointAsFloat<int32_t>(aid, channelName, 10000, 4000, scale);
+  expectFixedPointAsFloat<int32_t>(aid, channelName, 5000, FixedPointSamples - 5000, scale);
+
+  // 32 bit values do not fit into int16
+  vector<int16_t> values16(2000);
+  ASSERT_EQ(ErrorCodes::WrongDataType, aid.readChannel(channelName, values16.data(), 1000, scale));
+  ASSERT_EQ(ErrorCodes::WrongDataType, aid.readArray(channelName + "_I", values16.data(), 1000, scale));
+  ASSERT_EQ(0, aid.close());
+  remove(filename.c_str());
+}
+
+TEST_F(AidTest, readIntegerRealFrames)
+{
+  const string filename = Common::TestOutputDir + "readIntegerRealFrames.aid";
+  writeFixedPointFile(filename, ekFRH_DATASTREAM__IFDATA_16RE_16IM_FIX, 1.0f);
+  changeFrameTypeToReal(filename);
+
+  Aid aid(filename);
+  string channelName;
+  openFixedPointFile(aid, channelName);
+  ASSERT_EQ(2 * FixedPointSamples, aid.getArraySize(channelName));
+
+  // the real-valued samples are returned with Q values of 0, as int16 and widened to int32
+  double scale16 = 0;
+  double scale32 = 0;
+  expectFixedPointAsFloat<int16_t>(aid, channelName, 20000, 7000, scale16);
+  expectFixedPointAsFloat<int32_t>(aid, channelName, 20000, 7000, scale32);
+  expectFixedPointAsFloat<int32_t>(aid, channelName, 5000, 2 * FixedPointSamples - 5000, scale32);
+  ASSERT_EQ(scale16, scale32);
+
+  vector<int16_t> values(2 * 1000);
+  ASSERT_EQ(0, aid.readChannel(channelName, values.data(), 1000, scale16, 20000));
+  for (size_t i = 0; i < values.size(); i += 2)
+  {
+    ASSERT_EQ(0, values[i + 1]) << "index " << i;
+  }
+  ASSERT_EQ(0, aid.close());
+  remove(filename.c_str());
+}
+
+TEST_F(AidTest, readIntegerGainChange)
+{
+  // the frames of the second file have another gain, the files are concatenated to one recording
+  const string filename = Common::TestOutputDir + "readIntegerGainChange.aid";
+  const string secondFilename = Common::TestOutputDir + "readIntegerGainChange2.aid";
+  writeFixedPointFile(filename, ekFRH_DATASTREAM__IFDATA_16RE_16IM_FIX, 1.0f);
+  writeFixedPointFile(secondFilename, ekFRH_DATASTREAM__IFDATA_16RE_16IM_FIX, 0.5f);
+  vector<char> content = readBinaryFile(filename);
+  vector<char> secondContent = readBinaryFile(secondFilename);
+  content.insert(content.end(), secondContent.begin(), secondContent.end());
+  writeBinaryFile(filename, content);
+  remove(secondFilename.c_str());
+
+  Aid aid(filename);
+  string channelName;
+  openFixedPointFile(aid, channelName);
+  ASSERT_EQ(2 * FixedPointSamples, aid.getArraySize(channelName));
+
+  // each part has a single scale
+  double scale1 = 0;
+  double scale2 = 0;
+  expectFixedPointAsFloat<int16_t>(aid, channelName, 10000, 4000, scale1);
+  expectFixedPointAsFloat<int32_t>(aid, channelName, 10000, FixedPointSamples + 4000, scale2);
+  ASSERT_NE(scale1, scale2);
+
+  // there is no single scale for the samples of both parts
+  vector<int16_t> values16(2 * 2000);
+  vector<int32_t> values32(2 * 2000);
+  double scale = 0;
+  ASSERT_EQ(ErrorCodes::InconsistentInputData, aid.readChannel(channelName, values16.data(), 2000, scale, FixedPointSamples - 1000));
+  ASSERT_EQ(ErrorCodes::InconsistentInputData, aid.readChannel(channelName, values32.data(), 2000, scale, FixedPointSamples - 1000));
+  ASSERT_EQ(ErrorCodes::InconsistentInputData, aid.readArray(channelName + "_Q", values16.data(), 2000, scale, FixedPointSamples - 1000));
+
+  // the float values are converted with the gain of each frame
+  vector<float> floatValues(2 * 2000);
+  ASSERT_EQ(0, aid.readChannel(channelName, floatValues.data(), 2000, FixedPointSamples - 1000));
+  ASSERT_EQ(0, aid.close());
+  remove(filename.c_str());
+}
@@ -1,5 +1,9 @@
 #include "gtest/gtest.h"
 
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -43,4 +47,106 @@ TEST_P(FileTypeTests, TestFileExtensionAndFilter)
 }
 
 INSTANTIATE_TEST_CASE_P(FileTypeTests, FileTypeTests,
-                        ::testing::Values(FileType::IQW, FileType::Iqtar, FileType::Csv, FileType::Matlab4, FileType::Matlab73));
\ No newline at end of file
+                        ::testing::Values(FileType::IQW, FileType::Iqtar, FileType::Csv, FileType::Matlab4, FileType::Matlab73));
+
+TEST_F(FileTypeServiceTests, DetectFileTypes)
+{
+  struct Expected
+  {
+    string filename;
+    FileType fileType;
+    DetectionConfidence confidence;
+  };
+
+  const vector<Expected> files = {
+    { "FG_Sine_0.35MHz.wv", FileType::WV, DetectionConfidence::High },
+    { "FromFSW_1ch_WithPreview.iq.tar", FileType::Iqtar, DetectionConfidence::High },
+    { "MissingXML.iq.tar", FileType::Iqtar, DetectionConfidence::High },
+    { "CorruptTarHeader.iq.tar", FileType::Iqtar, DetectionConfidence::Low },
+    { "ReadGenuineMatFiles_v4.mat", FileType::Matlab4, DetectionConfidence::High },
+    { "ReadGenuineMatFiles_v7.mat", FileType::Matlab4, DetectionConfidence::Medium },
+    { "MultiChannel_Mosaik.csv", FileType::Csv, DetectionConfidence::High },
+    { "MultiChannel_Mosaik_ANSI.csv", FileType::Csv, DetectionConfidence::High },
+    { "RawArrayDecimalDotValueColon.csv", FileType::Csv, DetectionConfidence::Medium },
+    { "FromFSW_1ch_asiqw.iqw", FileType::IQW, DetectionConfidence::Low }
+  };
+
+  for (const auto& expected : files)
+  {
+    FileType fileType;
+    DetectionConfidence confidence;
+    int ret = FileTypeService::detect(Common::TestDataDir + expected.filename, fileType, confidence);
+    ASSERT_EQ(ErrorCodes::Success, ret) << expected.filename;
+    ASSERT_EQ(expected.confidence, confidence) << expected.filename;
+    ASSERT_EQ(expected.fileType, fileType) << expected.filename;
+  }
+}
+
+TEST_F(FileTypeServiceTests, DetectFileHeaders)
+{
+  auto detect = [](const vector<uint8_t>& content, FileType& fileType) -> DetectionConfidence
+  {
+    const string filename = Common::TestOutputDir + "DetectFileHeaders.bin";
+    ofstream os(filename, ios::binary | ios::trunc);
+    os.write(reinterpret_cast<const char*>(content.data()), content.size());
+    os.close();
+
+    DetectionConfidence confidence;
+    EXPECT_EQ(ErrorCodes::Success, FileTypeService::detect(filename, fileType, confidence));
+    remove(filename.c_str());
+    return confidence;
+  };
+
+  FileType fileType;
+
+  // IQX sync words
+  const uint64_t sync[] = { 0xF7F67574F3F27170ULL, 0x7776F5F47372F1F0ULL, 0x8778F99F8118F22FULL, 0x78876FF675576EE6ULL };
+  vector<uint8_t> iqx(4096);
+  memcpy(iqx.data(), sync, sizeof(sync));
+  ASSERT_EQ(DetectionConfidence::High, detect(iqx, fileType));
+  ASSERT_EQ(FileType::IQX, fileType);
+
+  // ZF frame magic word, little endian, at the start of the file and behind skipped data
+  vector<uint8_t> aid = { 0x72, 0x65, 0x74, 0xfb, 0x10, 0x00, 0x00, 0x00 };
+  aid.resize(64);
+  ASSERT_EQ(DetectionConfidence::High, detect(aid, fileType));
+  ASSERT_EQ(FileType::AID, fileType);
+  aid.insert(aid.begin(), 16, 0);
+  ASSERT_EQ(DetectionConfidence::Medium, detect(aid, fileType));
+  ASSERT_EQ(FileType::AID, fileType);
+
+  // MAT 7.3 text header, version 0x0200 with endian indicator 'IM'
+  string text = "MATLAB 7.3 MAT-file, Platform: GLNXA64, HDF5 schema 1.00 .";
+  vector<uint8_t> mat73(text.begin(), text.end());
+  mat73.resize(512, ' ');
+  mat73[124] = 0x00;
+  mat73[125] = 0x02;
+  mat73[126] = 'I';
+  mat73[127] = 'M';
+  ASSERT_EQ(DetectionConfidence::High, detect(mat73, fileType));
+  ASSERT_EQ(FileType::Matlab73, fileType);
+
+  // odd sized binary data matches no format
+  fileType = FileType::Csv;
+  vector<uint8_t> unknown = { 0x01, 0x00, 0x02, 0x00, 0x03 };
+  ASSERT_EQ(DetectionConfidence::Unknown, detect(unknown, fileType));
+  ASSERT_EQ(FileType::Csv, fileType);
+
+  DetectionConfidence confidence;
+  ASSERT_EQ(ErrorCodes::FileNotFound, FileTypeService::detect(Common::TestDataDir + "DoesNotExist.wv", fileType, confidence));
+  ASSERT_EQ(DetectionConfidence::Unknown, confidence);
+}
+
+TEST_F(FileTypeServiceTests, CreateAuto)
+{
+  IDataImportExport* file = FileTypeService::createAuto(Common::TestDataDir + "FromFSW_1ch_WithPreview.iq.tar");
+  ASSERT_NE(nullptr, file);
+
+  vector<string> arrayNames;
+  ASSERT_EQ(ErrorCodes::Success, file->readOpen(arrayNames));
+  ASSERT_EQ(2, arrayNames.size());
+  file->close();
+  delete file;
+
+  ASSERT_EQ(nullptr, FileTypeService::createAuto(Common::TestDataDir + "DoesNotExist.wv"));
+}
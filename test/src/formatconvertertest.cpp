@@ -0,0 +1,332 @@
+#include "gtest/gtest.h"
+
+#include "dataimportexport.h"
+#include "common.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace rohdeschwarz::mosaik::dataimportexport;
+
+class FormatConverterTest : public ::testing::Test
+{
+};
+
+namespace
+{
+  // writes a complex channel of sin/cos values with the specified writer
+  void writePairFile(IDataImportExport& file, size_t nofSamples, size_t phase)
+  {
+    vector<vector<float>> iqValues(2, vector<float>(nofSamples));
+    for (size_t i = 0; i < nofSamples; ++i)
+    {
+      iqValues[0][i] = static_cast<float>(0.5 * sin(0.01 * (i + phase)));
+      iqValues[1][i] = static_cast<float>(0.5 * cos(0.01 * (i + phase)));
+    }
+
+    vector<ChannelInfo> channelInfos;
+    channelInfos.push_back(ChannelInfo("Channel1", 1e6, 1e9, nofSamples));
+
+    map<string, string> metadata;
+    ASSERT_EQ(ErrorCodes::Success, file.writeOpen(IqDataFormat::Complex, 2, "app", "comment", channelInfos, &metadata));
+    ASSERT_EQ(ErrorCodes::Success, file.appendArrays(iqValues));
+    ASSERT_EQ(ErrorCodes::Success, file.close());
+  }
+
+  // compares the IQW output with the channel read from an input file, whose readChannel() counts I/Q pairs
+  void expectSameAsPairInput(const string& input, FileType inputType, const string& output)
+  {
+    unique_ptr<IDataImportExport> inFile(FileTypeService::create(input, inputType));
+    vector<string> arrayNames;
+    ASSERT_EQ(ErrorCodes::Success, inFile->readOpen(arrayNames));
+    vector<ChannelInfo> channelInfos;
+    map<string, string> metadata;
+    ASSERT_EQ(ErrorCodes::Success, inFile->getMetadata(channelInfos, metadata));
+    ASSERT_EQ(1, channelInfos.size());
+
+    const size_t nofSamples = static_cast<size_t>(channelInfos[0].getSamples());
+    ASSERT_GT(nofSamples, 0);
+    vector<float> expected(2 * nofSamples);
+    ASSERT_EQ(ErrorCodes::Success, inFile->readChannel(channelInfos[0].getChannelName(), expected.data(), nofSamples));
+    inFile->close();
+
+    Iqw outFile(output);
+    ASSERT_EQ(ErrorCodes::Success, outFile.readOpen(arrayNames));
+    ASSERT_EQ(2 * nofSamples, static_cast<size_t>(outFile.getArraySize(arrayNames[0]) + outFile.getArraySize(arrayNames[1])));
+    vector<float> values(2 * nofSamples);
+    ASSERT_EQ(ErrorCodes::Success, outFile.readChannel("Channel1", values.data(), values.size()));
+    outFile.close();
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      ASSERT_FLOAT_EQ(expected[i], values[i]) << "index " << i;
+    }
+  }
+}
+
+TEST_F(FormatConverterTest, InvalidSettings)
+{
+  const string filename = Common::TestOutputDir + "FormatConverterInvalidSettings.iq.tar";
+
+  FormatConverter converter(filename, FileType::Iqtar, filename, FileType::Iqtar);
+  EXPECT_EQ(ErrorCodes::InvalidArraySize, converter.setChunkSize(0));
+  EXPECT_EQ(ErrorCodes::InvalidArraySize, converter.setQueueSize(0));
+  EXPECT_EQ(1048576, converter.getChunkSize());
+  EXPECT_EQ(4, converter.getQueueSize());
+
+  // input and output must not be the same file
+  EXPECT_EQ(ErrorCodes::InconsistentInputData, converter.convert());
+}
+
+TEST_F(FormatConverterTest, IqtarToMatlab)
+{
+  const string input = Common::TestOutputDir + "FormatConverterIqtarToMatlab.iq.tar";
+  const string output = Common::TestOutputDir + "FormatConverterIqtarToMatlab.mat";
+  const size_t nofSamples = 1000;
+
+  vector<vector<float>> iqValues;
+  Common::initVector(iqValues, 2, 2 * nofSamples);
+
+  vector<ChannelInfo> channelInfos;
+  channelInfos.push_back(ChannelInfo("Channel1", 1e6, 1e9));
+  channelInfos.push_back(ChannelInfo("Channel2", 2e6, 2e9));
+
+  IqTar writeFile(input);
+  auto ret = writeFile.writeOpen(IqDataFormat::Complex, 4, "app", "comment", channelInfos);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.appendChannels(iqValues);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.close();
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  // chunks do not divide the number of samples
+  FormatConverter converter(input, FileType::Iqtar, output, FileType::Matlab73);
+  ASSERT_EQ(ErrorCodes::Success, converter.setChunkSize(64));
+  ASSERT_EQ(ErrorCodes::Success, converter.setQueueSize(2));
+  ret = converter.convert();
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  EXPECT_EQ(2 * nofSamples, converter.getSamplesConverted());
+  EXPECT_EQ(2 * 2 * nofSamples * sizeof(float), converter.getBytesConverted());
+
+  IqMatlab readFile(output);
+  vector<string> arrayNames;
+  ret = readFile.readOpen(arrayNames);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ASSERT_EQ(4, arrayNames.size());
+
+  vector<ChannelInfo> readChannelInfos;
+  map<string, string> metadata;
+  ret = readFile.getMetadata(readChannelInfos, metadata);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ASSERT_EQ(2, readChannelInfos.size());
+
+  for (size_t ch = 0; ch < readChannelInfos.size(); ++ch)
+  {
+    EXPECT_EQ(channelInfos[ch].getChannelName(), readChannelInfos[ch].getChannelName());
+    EXPECT_EQ(channelInfos[ch].getClockRate(), readChannelInfos[ch].getClockRate());
+    EXPECT_EQ(channelInfos[ch].getFrequency(), readChannelInfos[ch].getFrequency());
+    EXPECT_EQ(nofSamples, readChannelInfos[ch].getSamples());
+
+    vector<float> values(2 * nofSamples);
+    ret = readFile.readChannel(readChannelInfos[ch].getChannelName(), values, values.size());
+    ASSERT_EQ(ErrorCodes::Success, ret);
+    EXPECT_EQ(iqValues[ch], values);
+  }
+
+  readFile.close();
+  remove(input.c_str());
+  remove(output.c_str());
+}
+
+TEST_F(FormatConverterTest, RealToComplexOnlyFormat)
+{
+  const string input = Common::TestOutputDir + "FormatConverterRealToComplexOnlyFormat.mat";
+  const string output = Common::TestOutputDir + "FormatConverterRealToComplexOnlyFormat.iqw";
+  const size_t nofSamples = 500;
+
+  vector<vector<double>> values;
+  Common::initVector(values, 1, nofSamples);
+
+  vector<ChannelInfo> channelInfos;
+  channelInfos.push_back(ChannelInfo("Channel1", 1e6, 1e9));
+
+  IqMatlab writeFile(input);
+  auto ret = writeFile.setMatlabVersion(MatlabVersion::Mat4);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.writeOpen(IqDataFormat::Real, 1, "app", "comment", channelInfos);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.appendArrays(values);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.close();
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  // IQW files only store complex data, real values are converted with Q = 0
+  FormatConverter converter(input, FileType::Matlab4, output, FileType::IQW);
+  ASSERT_EQ(ErrorCodes::Success, converter.setChunkSize(128));
+  ret = converter.convert();
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  EXPECT_EQ(nofSamples, converter.getSamplesConverted());
+
+  Iqw readFile(output);
+  vector<string> arrayNames;
+  ret = readFile.readOpen(arrayNames);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ASSERT_EQ(2, arrayNames.size());
+
+  vector<double> iq(2 * nofSamples);
+  ret = readFile.readChannel("Channel1", iq, iq.size());
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  for (size_t i = 0; i < nofSamples; ++i)
+  {
+    EXPECT_NEAR(values[0][i], iq[2 * i], 1e-6);
+    EXPECT_EQ(0, iq[2 * i + 1]);
+  }
+
+  readFile.close();
+  remove(input.c_str());
+  remove(output.c_str());
+}
+
+TEST_F(FormatConverterTest, BatchIqtarToIqw)
+{
+  const size_t nofSamples[] = { 100, 2000, 5000 };
+  vector<vector<vector<float>>> iqValues(3);
+
+  BatchConverter converter(FileType::IQW, Common::TestOutputDir);
+  for (size_t i = 0; i < iqValues.size(); ++i)
+  {
+    const string input = Common::TestOutputDir + "FormatConverterBatch" + to_string(i) + ".iq.tar";
+    Common::initVector(iqValues[i], 1, 2 * nofSamples[i], i);
+
+    vector<ChannelInfo> channelInfos;
+    channelInfos.push_back(ChannelInfo("Channel1", 1e6, 1e9));
+
+    IqTar writeFile(input);
+    auto ret = writeFile.writeOpen(IqDataFormat::Complex, 2, "app", "comment", channelInfos);
+    ASSERT_EQ(ErrorCodes::Success, ret);
+    ret = writeFile.appendChannels(iqValues[i]);
+    ASSERT_EQ(ErrorCodes::Success, ret);
+    ret = writeFile.close();
+    ASSERT_EQ(ErrorCodes::Success, ret);
+  }
+
+  EXPECT_EQ(ErrorCodes::FileNotFound, converter.addFiles(Common::TestOutputDir + "FormatConverterBatch?.iqx", FileType::IQX));
+  ASSERT_EQ(ErrorCodes::Success, converter.addFiles(Common::TestOutputDir + "FormatConverterBatch?.iq.tar", FileType::Iqtar));
+  ASSERT_EQ(3, converter.getNofFiles());
+
+  // the largest files are read as ranges in parallel
+  converter.setNofThreads(3);
+  converter.setSplitSize(1000);
+  ASSERT_EQ(ErrorCodes::Success, converter.setChunkSize(64));
+  ASSERT_EQ(ErrorCodes::Success, converter.setMaxBufferMemory(4096));
+  auto ret = converter.convert();
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  EXPECT_EQ(2 * (100 + 2000 + 5000) * sizeof(float), converter.getBytesConverted());
+
+  for (size_t i = 0; i < converter.getNofFiles(); ++i)
+  {
+    EXPECT_EQ(ErrorCodes::Success, converter.getResult(i));
+    EXPECT_TRUE(Common::strEndsWithIgnoreCase(converter.getOutputFilename(i), "FormatConverterBatch" + to_string(i) + ".iqw"));
+
+    Iqw readFile(converter.getOutputFilename(i));
+    vector<string> arrayNames;
+    ret = readFile.readOpen(arrayNames);
+    ASSERT_EQ(ErrorCodes::Success, ret);
+
+    vector<float> values(2 * nofSamples[i]);
+    ret = readFile.readChannel("Channel1", values, values.size());
+    ASSERT_EQ(ErrorCodes::Success, ret);
+    EXPECT_EQ(iqValues[i][0], values);
+
+    readFile.close();
+    remove(converter.getInputFilename(i).c_str());
+    remove(converter.getOutputFilename(i).c_str());
+  }
+}
+
+TEST_F(FormatConverterTest, IqxToIqw)
+{
+  const string input = Common::TestOutputDir + "FormatConverterIqxToIqw.iqx";
+  const string output = Common::TestOutputDir + "FormatConverterIqxToIqw.iqw";
+  const size_t nofSamples = 1000;
+
+  Iqx writeFile(input);
+  writePairFile(writeFile, nofSamples, 0);
+
+  // chunks do not divide the number of samples
+  FormatConverter converter(input, FileType::IQX, output, FileType::IQW);
+  ASSERT_EQ(ErrorCodes::Success, converter.setChunkSize(64));
+  ASSERT_EQ(ErrorCodes::Success, converter.setQueueSize(2));
+  ASSERT_EQ(ErrorCodes::Success, converter.convert());
+  EXPECT_EQ(nofSamples, converter.getSamplesConverted());
+
+  expectSameAsPairInput(input, FileType::IQX, output);
+  remove(input.c_str());
+  remove(output.c_str());
+}
+
+TEST_F(FormatConverterTest, WvToIqw)
+{
+  const string input = Common::TestDataDir + "FG_Sine_0.35MHz.wv";
+  const string output = Common::TestOutputDir + "FormatConverterWvToIqw.iqw";
+
+  FormatConverter converter(input, FileType::WV, output, FileType::IQW);
+  ASSERT_EQ(ErrorCodes::Success, converter.setChunkSize(100));
+  ASSERT_EQ(ErrorCodes::Success, converter.convert());
+  EXPECT_GT(converter.getSamplesConverted(), 0);
+
+  expectSameAsPairInput(input, FileType::WV, output);
+  remove(output.c_str());
+}
+
+TEST_F(FormatConverterTest, AidToIqw)
+{
+  const string input = Common::TestOutputDir + "FormatConverterAidToIqw.aid";
+  const string output = Common::TestOutputDir + "FormatConverterAidToIqw.iqw";
+  const size_t nofSamples = 1000;
+
+  Aid writeFile(input);
+  writePairFile(writeFile, nofSamples, 0);
+
+  FormatConverter converter(input, FileType::AID, output, FileType::IQW);
+  ASSERT_EQ(ErrorCodes::Success, converter.setChunkSize(64));
+  ASSERT_EQ(ErrorCodes::Success, converter.convert());
+  EXPECT_EQ(nofSamples, converter.getSamplesConverted());
+
+  expectSameAsPairInput(input, FileType::AID, output);
+  remove(input.c_str());
+  remove(output.c_str());
+}
+
+TEST_F(FormatConverterTest, BatchIqxToIqw)
+{
+  const size_t nofSamples[] = { 100, 2000, 5000 };
+
+  BatchConverter converter(FileType::IQW, Common::TestOutputDir);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    Iqx writeFile(Common::TestOutputDir + "FormatConverterBatchIqx" + to_string(i) + ".iqx");
+    writePairFile(writeFile, nofSamples[i], i);
+  }
+
+  ASSERT_EQ(ErrorCodes::Success, converter.addFiles(Common::TestOutputDir + "FormatConverterBatchIqx?.iqx", FileType::IQX));
+  ASSERT_EQ(3, converter.getNofFiles());
+
+  // the largest files are read as ranges in parallel, IQX counts I/Q pairs when reading
+  converter.setNofThreads(3);
+  converter.setSplitSize(1000);
+  ASSERT_EQ(ErrorCodes::Success, converter.setChunkSize(64));
+  ASSERT_EQ(ErrorCodes::Success, converter.setMaxBufferMemory(4096));
+  ASSERT_EQ(ErrorCodes::Success, converter.convert());
+
+  for (size_t i = 0; i < converter.getNofFiles(); ++i)
+  {
+    EXPECT_EQ(ErrorCodes::Success, converter.getResult(i));
+    expectSameAsPairInput(converter.getInputFilename(i), FileType::IQX, converter.getOutputFilename(i));
+    remove(converter.getInputFilename(i).c_str());
+    remove(converter.getOutputFilename(i).c_str());
+  }
+}
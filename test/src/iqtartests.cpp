@@ -5,6 +5,8 @@
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <future>
+#include <thread>
 
 #include "archive.h"
 #include "archive_entry.h"
@@ -812,4 +814,139 @@ TEST_F(IqTarTests, setIqDataSizeDataOverflowChannel)
   ASSERT_EQ(ret, ErrorCodes::InvalidTarArchive);
 
   remove(filename.c_str());
-}
\ No newline at end of file
+}
+
+TEST_F(IqTarTests, WriteAndReadParallel)
+{
+  const size_t nofThreads = 8;
+  vector<int> results(nofThreads, ErrorCodes::InternalError);
+
+  // the threads write and read their own files, the tar headers are converted concurrently
+  vector<thread> threads;
+  for (size_t t = 0; t < nofThreads; ++t)
+  {
+    threads.push_back(thread([t, &results]()
+    {
+      const string filename = Common::TestOutputDir + "WriteAndReadParallel" + to_string(t) + ".iq.tar";
+      vector<vector<float>> iqValues;
+      Common::initVector(iqValues, 2, 100);
+
+      int ret = ErrorCodes::Success;
+      for (size_t i = 0; ret == ErrorCodes::Success && i < 20; ++i)
+      {
+        IqTar writeFile(filename);
+        vector<ChannelInfo> channelInfos(1, ChannelInfo("Channel", 13, 2));
+        ret = writeFile.writeOpen(IqDataFormat::Complex, 2, "app", "comment", channelInfos);
+        if (ret == ErrorCodes::Success)
+        {
+          ret = writeFile.appendArrays(iqValues);
+        }
+
+        const int closeRet = writeFile.close();
+        ret = (ret != ErrorCodes::Success) ? ret : closeRet;
+
+        IqTar readFile(filename);
+        vector<string> arrayNames;
+        if (ret == ErrorCodes::Success)
+        {
+          ret = readFile.readOpen(arrayNames);
+        }
+
+        if (ret == ErrorCodes::Success && arrayNames.size() != 2)
+        {
+          ret = ErrorCodes::InvalidArrayName;
+        }
+
+        readFile.close();
+      }
+
+      remove(filename.c_str());
+      results[t] = ret;
+    }));
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (size_t t = 0; t < nofThreads; ++t)
+  {
+    ASSERT_EQ(ErrorCodes::Success, results[t]) << "thread " << t;
+  }
+}
+
+TEST_F(IqTarTests, ReadAsync)
+{
+  const string filename = Common::TestOutputDir + "ReadAsync.iq.tar";
+  // large enough for several chunks per read
+  const size_t nofSamples = 100000;
+  const size_t offset = 1000;
+  const size_t nofRead = nofSamples - 2 * offset;
+
+  // two channels, so every read skips the values of the other channel
+  vector<vector<float>> iqValues;
+  Common::initVector(iqValues, 4, nofSamples);
+  vector<ChannelInfo> channelInfos;
+  channelInfos.push_back(ChannelInfo("Channel1", 1000, 1000));
+  channelInfos.push_back(ChannelInfo("Channel2", 1000, 1000));
+
+  IqTar writeFile(filename);
+  auto ret = writeFile.writeOpen(IqDataFormat::Complex, 4, "app", "comment", channelInfos);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.appendArrays(iqValues);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.close();
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  IqTar readFile(filename);
+  vector<string> arrayNames;
+  ret = readFile.readOpen(arrayNames);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ASSERT_EQ(4, arrayNames.size());
+
+  vector<float> expectedQ;
+  ret = readFile.readArray("Channel1_Q", expectedQ, nofRead, offset);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  vector<double> expectedChannel;
+  ret = readFile.readChannel("Channel2", expectedChannel, 2 * nofRead, offset);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  const AsyncReadBackend backends[] = { AsyncReadBackend::IoUring, AsyncReadBackend::ThreadPool };
+  for (auto backend : backends)
+  {
+    // io_uring is not available on all systems, the thread pool is used instead
+    ret = AsyncRead::setBackend(backend);
+    ASSERT_TRUE(ret == ErrorCodes::Success || backend == AsyncReadBackend::IoUring);
+
+    readFile.setStatisticsEnabled(true);
+    vector<float> valuesQ(nofRead);
+    vector<double> valuesChannel(2 * nofRead);
+    promise<int> arrayDone;
+    promise<int> channelDone;
+    ret = readFile.readArrayAsync("Channel1_Q", valuesQ.data(), nofRead, offset, [&](int errorCode) { arrayDone.set_value(errorCode); });
+    ASSERT_EQ(ErrorCodes::Success, ret);
+    ret = readFile.readChannelAsync("Channel2", valuesChannel.data(), 2 * nofRead, offset, [&](int errorCode) { channelDone.set_value(errorCode); });
+    ASSERT_EQ(ErrorCodes::Success, ret);
+
+    EXPECT_EQ(ErrorCodes::Success, arrayDone.get_future().get());
+    EXPECT_EQ(ErrorCodes::Success, channelDone.get_future().get());
+    EXPECT_EQ(expectedQ, valuesQ);
+    EXPECT_EQ(expectedChannel, valuesChannel);
+
+    // the bytes read are counted before the callbacks are called
+    EXPECT_GE(readFile.getStatistics().getBytesRead(), 3 * nofRead * sizeof(float));
+  }
+
+  // errors are returned synchronously, the callback is not called
+  vector<float> values(2 * nofSamples + 2);
+  ret = readFile.readArrayAsync("Unknown_I", values.data(), 1, 0, [](int) { FAIL(); });
+  EXPECT_NE(ErrorCodes::Success, ret);
+  ret = readFile.readChannelAsync("Channel1", values.data(), 3, 0, [](int) { FAIL(); });
+  EXPECT_EQ(ErrorCodes::InvalidArraySize, ret);
+  ret = readFile.readArrayAsync("Channel1_I", values.data(), nofSamples + 1, 0, [](int) { FAIL(); });
+  EXPECT_NE(ErrorCodes::Success, ret);
+
+  readFile.close();
+  remove(filename.c_str());
+}
@@ -8,6 +8,7 @@
 #include <map>
 #include <cmath>
 #include <fstream>
+#include <future>
 
 #ifdef _WIN32
 #define isfinite(x) _finite(x)
@@ -692,4 +693,191 @@ TYPED_TEST(IqwDataOrderTest, WriteChannelReadArray)
   ASSERT_EQ(ErrorCodes::Success, ret);
 
   remove(filename.c_str());
-}
\ No newline at end of file
+}
+
+TYPED_TEST(IqwDataOrderTest, Statistics)
+{
+  IqDataOrder dataOrder = TypeParam::Order;
+
+  const string filename = Common::TestOutputDir + "Statistics.iqw";
+  const size_t nofValues = 100;
+
+  vector<vector<typename TypeParam::Dt>> data;
+  Common::initVector(data, 2, nofValues);
+
+  vector<ChannelInfo> channelInfos;
+  channelInfos.push_back(ChannelInfo("Kanal1", 12, 12));
+
+  // write, statistics enabled
+  Iqw writeFile(filename);
+  writeFile.setDataOrder(dataOrder);
+  writeFile.setStatisticsEnabled(true);
+  auto ret = writeFile.writeOpen(IqDataFormat::Complex, 2, "", "", channelInfos);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.appendArrays(data);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.close();
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  auto statistics = writeFile.getStatistics();
+  EXPECT_GE(statistics.getBytesWritten(), 2 * nofValues * sizeof(float));
+  EXPECT_GT(statistics.getNofMaps(), 0);
+  EXPECT_EQ(statistics.getNofMaps(), statistics.getNofUnmaps());
+  EXPECT_GT(statistics.getNofSyscalls(), 0);
+  EXPECT_EQ(dataOrder == IqDataOrder::IIIQQQ ? 2 * nofValues * sizeof(float) : 0, statistics.getPeakTempFileBytes());
+
+  // read, statistics disabled
+  Iqw readFile(filename);
+  readFile.setDataOrder(dataOrder);
+  vector<string> arrayNames;
+  ret = readFile.readOpen(arrayNames);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  vector<typename TypeParam::Dt> values;
+  ret = readFile.readArray(arrayNames[0], values, nofValues);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  statistics = readFile.getStatistics();
+  EXPECT_EQ(0, statistics.getBytesRead());
+  EXPECT_EQ(0, statistics.getNofMaps());
+  EXPECT_EQ(0, statistics.getSeconds(IoPhase::Conversion));
+
+  // read, statistics enabled
+  readFile.setStatisticsEnabled(true);
+  ret = readFile.readArray(arrayNames[0], values, nofValues);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  readFile.close();
+
+  statistics = readFile.getStatistics();
+  EXPECT_GE(statistics.getBytesRead(), nofValues * sizeof(float));
+  EXPECT_EQ(1, statistics.getNofMaps());
+  EXPECT_EQ(1, statistics.getNofUnmaps());
+  EXPECT_EQ(0, statistics.getBytesWritten());
+
+  remove(filename.c_str());
+}
+
+TYPED_TEST(IqwDataOrderTest, ReadAsync)
+{
+  typedef typename TypeParam::Dt T;
+  const string filename = Common::TestOutputDir + "ReadAsync.iqw";
+  // large enough for several chunks per read
+  const size_t nofValues = 300000;
+  const size_t offset = 1000;
+  const size_t nofRead = nofValues - 2 * offset;
+
+  vector<vector<float>> data;
+  Common::initVector(data, 2, nofValues);
+
+  vector<ChannelInfo> channelInfos;
+  channelInfos.push_back(ChannelInfo("Kanal1", 12, 12));
+
+  Iqw writeFile(filename);
+  writeFile.setDataOrder(TypeParam::Order);
+  auto ret = writeFile.writeOpen(IqDataFormat::Complex, 2, "", "", channelInfos);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.appendArrays(data);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.close();
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  Iqw readFile(filename);
+  readFile.setDataOrder(TypeParam::Order);
+  vector<string> arrayNames;
+  ret = readFile.readOpen(arrayNames);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  vector<T> expectedQ;
+  ret = readFile.readArray(arrayNames[1], expectedQ, nofRead, offset);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  vector<T> expectedChannel;
+  ret = readFile.readChannel("Channel1", expectedChannel, 2 * nofRead, offset);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  const AsyncReadBackend backends[] = { AsyncReadBackend::IoUring, AsyncReadBackend::ThreadPool };
+  for (auto backend : backends)
+  {
+    // io_uring is not available on all systems, the thread pool is used instead
+    ret = AsyncRead::setBackend(backend);
+    ASSERT_TRUE(ret == ErrorCodes::Success || backend == AsyncReadBackend::IoUring);
+
+    readFile.setStatisticsEnabled(true);
+    vector<T> valuesQ(nofRead);
+    vector<T> valuesChannel(2 * nofRead);
+    promise<int> arrayDone;
+    promise<int> channelDone;
+    ret = readFile.readArrayAsync(arrayNames[1], valuesQ.data(), nofRead, offset, [&](int errorCode) { arrayDone.set_value(errorCode); });
+    ASSERT_EQ(ErrorCodes::Success, ret);
+    ret = readFile.readChannelAsync("Channel1", valuesChannel.data(), 2 * nofRead, offset, [&](int errorCode) { channelDone.set_value(errorCode); });
+    ASSERT_EQ(ErrorCodes::Success, ret);
+
+    EXPECT_EQ(ErrorCodes::Success, arrayDone.get_future().get());
+    EXPECT_EQ(ErrorCodes::Success, channelDone.get_future().get());
+    EXPECT_EQ(expectedQ, valuesQ);
+    EXPECT_EQ(expectedChannel, valuesChannel);
+
+    // the bytes read are counted before the callbacks are called
+    EXPECT_GE(readFile.getStatistics().getBytesRead(), 3 * nofRead * sizeof(float));
+  }
+
+  // errors are returned synchronously, the callback is not called
+  vector<T> values(nofValues + 1);
+  ret = readFile.readArrayAsync("Unknown_I", values.data(), 1, 0, [](int) { FAIL(); });
+  EXPECT_EQ(ErrorCodes::InvalidArrayName, ret);
+  ret = readFile.readArrayAsync(arrayNames[0], values.data(), nofValues + 1, 0, [](int) { FAIL(); });
+  EXPECT_EQ(ErrorCodes::InvalidDataInterval, ret);
+
+  readFile.close();
+  remove(filename.c_str());
+}
+
+TEST_F(IqwTest, Trace)
+{
+  const string filename = Common::TestOutputDir + "Trace.iqw";
+  const string traceFilename = Common::TestOutputDir + "Trace.json";
+  const size_t nofValues = 100;
+
+  vector<vector<float>> data;
+  Common::initVector(data, 2, nofValues);
+
+  vector<ChannelInfo> channelInfos;
+  channelInfos.push_back(ChannelInfo("Kanal1", 12, 12));
+
+  Trace::clear();
+
+  Iqw writeFile(filename);
+  writeFile.setDataOrder(IqDataOrder::IIIQQQ);
+  auto ret = writeFile.writeOpen(IqDataFormat::Complex, 2, "", "", channelInfos);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.appendArrays(data);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = writeFile.close();
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  Iqw readFile(filename);
+  readFile.setDataOrder(IqDataOrder::IIIQQQ);
+  vector<string> arrayNames;
+  ret = readFile.readOpen(arrayNames);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  vector<float> values;
+  ret = readFile.readArray(arrayNames[0], values, nofValues);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  readFile.close();
+
+  ret = Trace::writeChromeTrace(traceFilename);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  ifstream traceFile(traceFilename);
+  string trace((istreambuf_iterator<char>(traceFile)), istreambuf_iterator<char>());
+  traceFile.close();
+
+  EXPECT_EQ(0, trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+  EXPECT_EQ(Trace::isEnabled(), string::npos != trace.find("\"name\":\"Iqw::finalizeTemporarySequence\",\"cat\":\"daiex\",\"ph\":\"B\""));
+  EXPECT_EQ(Trace::isEnabled(), string::npos != trace.find("\"name\":\"Iqw::readArray\",\"cat\":\"daiex\",\"ph\":\"E\""));
+
+  ret = Trace::writeChromeTrace(Common::TestOutputDir + "unknown/Trace.json");
+  EXPECT_EQ(ErrorCodes::FileOpenError, ret);
+
+  remove(filename.c_str());
+  remove(traceFilename.c_str());
+}
@@ -3,11 +3,15 @@
 #include "dataimportexport.h"
 #include "common.h"
 
+#include <iqxformat/iqxfile.h>
+
 #include <string>
 #include <vector>
 #include <map>
 #include <cmath>
 #include <fstream>
+#include <future>
+#include <thread>
 
 
 #ifdef _WIN32
@@ -16,6 +20,7 @@
 
 using namespace std;
 using namespace rohdeschwarz::mosaik::dataimportexport;
+using IQW::IqxFile;
 
 const size_t KB = 1024;
 const size_t MB = KB * 1024;
@@ -1010,3 +1015,555 @@ TEST_F(IqxTest, Iqx2MatLab73)
 	outMat.appendChannels(iqdata);
 	outMat.close();
 }
+
+TEST_F(IqxTest, ReadInt16)
+{
+	int retCode;
+	const string outputIqx = Common::TestOutputDir + "ReadInt16.iqx";
+	const size_t nofSamples = 100 * KB;
+	vector<ChannelInfo> channelInfoWrite;
+	channelInfoWrite.push_back(ChannelInfo("Channel1", 1000.0, 1000.0, nofSamples));
+	map<string, string> metadataWrite;
+	metadataWrite.insert(make_pair("Type", "ReadInt16"));
+
+	{
+		Iqx outIqx(outputIqx);
+		retCode = outIqx.writeOpen(IqDataFormat::Complex, 2, "IQX Test", "ReadInt16", channelInfoWrite, &metadataWrite);
+		ASSERT_EQ(0, retCode) << "write open failed";
+		vector<float> iValues(nofSamples);
+		vector<float> qValues(nofSamples);
+		for (size_t i = 0; i < nofSamples; i++)
+		{
+			iValues[i] = static_cast<float>(sin(i * 0.01));
+			qValues[i] = static_cast<float>(cos(i * 0.01));
+		}
+
+		vector<vector<float>> writeVector;
+		writeVector.push_back(iValues);
+		writeVector.push_back(qValues);
+		retCode = outIqx.appendArrays(writeVector);
+		ASSERT_EQ(0, retCode) << "append failed";
+		outIqx.close();
+	}
+
+	Iqx inIqx(outputIqx);
+	vector<string> arrayNames;
+	retCode = inIqx.readOpen(arrayNames);
+	ASSERT_EQ(ErrorCodes::Success, retCode) << "file open failed";
+	ASSERT_FALSE(arrayNames.empty());
+
+	const size_t offset = 1234;
+	const size_t nofValues = nofSamples - 2 * offset;
+	vector<float> expected(2 * nofValues);
+	vector<int16_t> values(2 * nofValues);
+	double scale = 0;
+	for (size_t i = 0; i < arrayNames.size(); ++i)
+	{
+		retCode = inIqx.readArray(arrayNames[i], expected.data(), nofValues, offset);
+		ASSERT_EQ(ErrorCodes::Success, retCode);
+		retCode = inIqx.readArray(arrayNames[i], values.data(), nofValues, scale, offset);
+		ASSERT_EQ(ErrorCodes::Success, retCode);
+		ASSERT_GT(scale, 0);
+		for (size_t n = 0; n < nofValues; ++n)
+		{
+			ASSERT_FLOAT_EQ(expected[n], static_cast<float>(values[n] * scale)) << arrayNames[i] << " index " << n;
+		}
+	}
+
+	retCode = inIqx.readChannel(arrayNames[0], expected.data(), nofValues, offset);
+	ASSERT_EQ(ErrorCodes::Success, retCode);
+	retCode = inIqx.readChannel(arrayNames[0], values.data(), nofValues, scale, offset);
+	ASSERT_EQ(ErrorCodes::Success, retCode);
+	for (size_t n = 0; n < 2 * nofValues; ++n)
+	{
+		ASSERT_FLOAT_EQ(expected[n], static_cast<float>(values[n] * scale)) << "index " << n;
+	}
+
+	inIqx.close();
+}
+
+namespace
+{
+	// sample rate of the window test files, time stamps k / WindowSampleRate address sample k
+	const double WindowSampleRate = 1e6;
+
+	// writes nofSamples IQ pairs in frames of framePairs pairs, each appendChannels() call writes one frame
+	void writeWindowFile(const string& filename, size_t nofSamples, size_t framePairs)
+	{
+		vector<ChannelInfo> channelInfos;
+		channelInfos.push_back(ChannelInfo("Channel1", WindowSampleRate, 1000.0, nofSamples));
+		map<string, string> metadata;
+
+		Iqx outIqx(filename);
+		ASSERT_EQ(ErrorCodes::Success, outIqx.writeOpen(IqDataFormat::Complex, 2, "IQX Test", "ReadWindows", channelInfos, &metadata));
+		vector<vector<float>> frame(1);
+		for (size_t written = 0; written < nofSamples; written += framePairs)
+		{
+			const size_t n = min(framePairs, nofSamples - written);
+			frame[0].resize(2 * n);
+			for (size_t i = 0; i < n; i++)
+			{
+				frame[0][2 * i] = static_cast<float>(sin((written + i) * 0.01));
+				frame[0][2 * i + 1] = static_cast<float>(((written + i) % 1000) / 1000.0 - 0.5);
+			}
+			ASSERT_EQ(ErrorCodes::Success, outIqx.appendChannels(frame));
+		}
+		ASSERT_EQ(ErrorCodes::Success, outIqx.close());
+	}
+
+	// reads the windows around the centers with one readTimestampWindows() call and compares each with readChannel()
+	void expectWindowsAsReadChannel(const string& filename, const vector<int64_t>& centers, size_t preSamples, size_t postSamples)
+	{
+		Iqx inIqx(filename);
+		vector<string> arrayNames;
+		ASSERT_EQ(ErrorCodes::Success, inIqx.readOpen(arrayNames));
+		ASSERT_FALSE(arrayNames.empty());
+		vector<ChannelInfo> channelInfos;
+		map<string, string> metadata;
+		ASSERT_EQ(ErrorCodes::Success, inIqx.getMetadata(channelInfos, metadata));
+		const int64_t samples = channelInfos[0].getSamples();
+
+		vector<double> timestamps;
+		for (int64_t center : centers)
+		{
+			timestamps.push_back(center / WindowSampleRate);
+		}
+		vector<vector<float>> windows;
+		ASSERT_EQ(ErrorCodes::Success, inIqx.readTimestampWindows(arrayNames[0], timestamps, preSamples, postSamples, windows));
+		ASSERT_EQ(centers.size(), windows.size());
+
+		for (size_t w = 0; w < centers.size(); w++)
+		{
+			const int64_t first = max(centers[w] - static_cast<int64_t>(preSamples), static_cast<int64_t>(0));
+			const int64_t last = min(centers[w] + static_cast<int64_t>(postSamples), samples);
+			ASSERT_EQ(static_cast<size_t>(2 * (last - first)), windows[w].size()) << "window " << w;
+
+			vector<float> expected;
+			ASSERT_EQ(ErrorCodes::Success, inIqx.readChannel(arrayNames[0], expected, static_cast<size_t>(last - first), static_cast<size_t>(first)));
+			ASSERT_EQ(expected, windows[w]) << "window " << w;
+		}
+		inIqx.close();
+	}
+}
+
+TEST_F(IqxTest, ReadWindowsOverlapping)
+{
+	const string filename = Common::TestOutputDir + "ReadWindowsOverlapping.iqx";
+	writeWindowFile(filename, 100 * KB, 10000);
+
+	// overlapping windows, one window contained in another, windows clipped at start and end of the recording
+	const vector<int64_t> centers = { 50, 1000, 1500, 1600, 30000, 30010, 100 * KB - 100 };
+	expectWindowsAsReadChannel(filename, centers, 500, 1000);
+	remove(filename.c_str());
+}
+
+TEST_F(IqxTest, ReadWindowsUnsorted)
+{
+	const string filename = Common::TestOutputDir + "ReadWindowsUnsorted.iqx";
+	writeWindowFile(filename, 100 * KB, 10000);
+
+	// the windows are returned in order of the time stamps, not in file order
+	const vector<int64_t> centers = { 90000, 2000, 45000, 2100, 70000, 10 };
+	expectWindowsAsReadChannel(filename, centers, 300, 700);
+	remove(filename.c_str());
+}
+
+TEST_F(IqxTest, ReadWindowsAcrossFrames)
+{
+	const string filename = Common::TestOutputDir + "ReadWindowsAcrossFrames.iqx";
+	writeWindowFile(filename, 100 * KB, 10000);
+
+	// frames end at multiples of 10000 pairs, the last window spans three frames
+	const vector<int64_t> centers = { 10000, 19999, 40001, 75000 };
+	expectWindowsAsReadChannel(filename, centers, 100, 12000);
+	remove(filename.c_str());
+}
+
+TEST_F(IqxTest, ReadWindowsBeyondMergeGap)
+{
+	const string filename = Common::TestOutputDir + "ReadWindowsBeyondMergeGap.iqx";
+	writeWindowFile(filename, 200 * KB, 10000);
+
+	// the windows are more than 16k pairs apart and are read as separate spans
+	const vector<int64_t> centers = { 1000, 20000, 60000, 150000 };
+	expectWindowsAsReadChannel(filename, centers, 200, 200);
+	remove(filename.c_str());
+}
+
+TEST_F(IqxTest, ReadWindowsLargerThanSpan)
+{
+	const string filename = Common::TestOutputDir + "ReadWindowsLargerThanSpan.iqx";
+	writeWindowFile(filename, 3 * MB, 256 * KB);
+
+	// a chain of overlapping windows longer than the maximum span of 1M pairs, and one window larger than a span
+	const vector<int64_t> centers = { 100000, 400000, 700000, 1000000, 1300000, 2600000 };
+	expectWindowsAsReadChannel(filename, centers, 200000, 200000);
+	expectWindowsAsReadChannel(filename, vector<int64_t>(1, 1500000), 700000, 700000);
+	remove(filename.c_str());
+}
+
+namespace
+{
+	// writes two streams of nofSamples IQ pairs with IqxFile, because the triggers can only be added there,
+	// the I values of both streams are 10 * n and 10 * n + 1 (modulo 30000), so that the streams can be distinguished
+	void writeTriggerFile(const string& filename, size_t nofSamples, size_t framePairs, const vector<vector<int64_t>>& triggers)
+	{
+		vector<pair<string, IqxStreamDescDataIQ>> streams;
+		for (size_t s = 0; s < triggers.size(); s++)
+		{
+			IqxStreamDescDataIQ description = {};
+			description.samplerate = WindowSampleRate;
+			description.samplerate_valid = true;
+			description.center_frequency = 1000.0;
+			description.centfreq_valid = true;
+			description.resolution = 16;
+			streams.push_back(make_pair("Channel" + to_string(s + 1), description));
+		}
+
+		IqxFile outFile(filename, "IQX Test", "ReadTriggerWindows", streams);
+		vector<int16_t> frame;
+		for (size_t written = 0; written < nofSamples; written += framePairs)
+		{
+			const size_t n = min(framePairs, nofSamples - written);
+			frame.resize(2 * n);
+			for (size_t s = 0; s < triggers.size(); s++)
+			{
+				for (size_t i = 0; i < n; i++)
+				{
+					frame[2 * i] = static_cast<int16_t>((10 * (written + i) + s) % 30000);
+					frame[2 * i + 1] = static_cast<int16_t>(-static_cast<int>((written + i) % 1000));
+				}
+				outFile.writeDataFrame(s, outFile.getSequenceNo(s), frame.data(), frame.size());
+				outFile.setSequenceNo(s, outFile.getSequenceNo(s) + 1);
+			}
+		}
+
+		for (size_t s = 0; s < triggers.size(); s++)
+		{
+			for (int64_t sample : triggers[s])
+			{
+				IqxTriggerEntry trigger = {};
+				trigger.timestamp.tv_sec = sample / static_cast<int64_t>(WindowSampleRate);
+				trigger.timestamp.tv_nsec = static_cast<int64_t>((sample % static_cast<int64_t>(WindowSampleRate)) * (1e9 / WindowSampleRate));
+				trigger.type = IQX_TRIGGER_TYPE_META_EXT0;
+				trigger.streamnum = static_cast<int32_t>(s);
+				outFile.addTriggerEntry(trigger);
+			}
+		}
+		// the trigger frame is written when the file is closed
+	}
+
+	// reads the windows around the triggers of a channel with readTriggerWindows() and compares each with readChannel()
+	template<typename T>
+	void expectTriggerWindowsAsReadChannel(const string& filename, const string& channelName, const vector<int64_t>& triggers,
+	                                       size_t preSamples, size_t postSamples)
+	{
+		Iqx inIqx(filename);
+		vector<string> arrayNames;
+		ASSERT_EQ(ErrorCodes::Success, inIqx.readOpen(arrayNames));
+		vector<ChannelInfo> channelInfos;
+		map<string, string> metadata;
+		ASSERT_EQ(ErrorCodes::Success, inIqx.getMetadata(channelInfos, metadata));
+		const int64_t samples = channelInfos[0].getSamples();
+
+		vector<vector<T>> windows;
+		vector<int64_t> triggerSamples;
+		ASSERT_EQ(ErrorCodes::Success, inIqx.readTriggerWindows(channelName, preSamples, postSamples, windows, triggerSamples));
+		ASSERT_EQ(triggers, triggerSamples);
+		ASSERT_EQ(triggers.size(), windows.size());
+
+		for (size_t w = 0; w < triggers.size(); w++)
+		{
+			const int64_t first = max(triggers[w] - static_cast<int64_t>(preSamples), static_cast<int64_t>(0));
+			const int64_t last = min(triggers[w] + static_cast<int64_t>(postSamples), samples);
+			ASSERT_EQ(static_cast<size_t>(2 * (last - first)), windows[w].size()) << "window " << w;
+
+			vector<T> expected;
+			ASSERT_EQ(ErrorCodes::Success, inIqx.readChannel(channelName, expected, static_cast<size_t>(last - first), static_cast<size_t>(first)));
+			ASSERT_EQ(expected, windows[w]) << "window " << w;
+		}
+		inIqx.close();
+	}
+}
+
+TEST_F(IqxTest, ReadTriggerWindows)
+{
+	const string filename = Common::TestOutputDir + "ReadTriggerWindows.iqx";
+	const size_t nofSamples = 100 * KB;
+	// triggers at the start and the end of the recording and across frames, not in file order,
+	// the triggers of the second stream must not show up in the windows of the first one
+	const vector<int64_t> triggers1 = { 40000, 3, 10000, 10100, nofSamples - 5, 0 };
+	const vector<int64_t> triggers2 = { 500, 99000 };
+	writeTriggerFile(filename, nofSamples, 10000, { triggers1, triggers2 });
+
+	expectTriggerWindowsAsReadChannel<float>(filename, "Channel1", triggers1, 200, 700);
+	expectTriggerWindowsAsReadChannel<double>(filename, "Channel1", triggers1, 200, 700);
+	expectTriggerWindowsAsReadChannel<float>(filename, "Channel2", triggers2, 1000, 1000);
+	expectTriggerWindowsAsReadChannel<double>(filename, "Channel2", triggers2, 1000, 1000);
+
+	// the windows contain the samples of their own stream
+	Iqx inIqx(filename);
+	vector<string> arrayNames;
+	ASSERT_EQ(ErrorCodes::Success, inIqx.readOpen(arrayNames));
+	vector<vector<float>> windows;
+	vector<int64_t> triggerSamples;
+	ASSERT_EQ(ErrorCodes::Success, inIqx.readTriggerWindows("Channel2", 0, 1, windows, triggerSamples));
+	ASSERT_EQ(2u, windows.size());
+	ASSERT_EQ(2u, windows[0].size());
+	int16_t value[2] = { 0, 0 };
+	double scale = 0;
+	ASSERT_EQ(ErrorCodes::Success, inIqx.readChannel("Channel2", value, 1, scale, 500));
+	EXPECT_EQ(5001, value[0]);
+	EXPECT_FLOAT_EQ(static_cast<float>(value[0] * scale), windows[0][0]);
+
+	EXPECT_EQ(ErrorCodes::InvalidArrayName, inIqx.readTriggerWindows("Channel3", 0, 1, windows, triggerSamples));
+	inIqx.close();
+	remove(filename.c_str());
+}
+
+TEST_F(IqxTest, ReadTriggerWindowsWithoutTriggers)
+{
+	const string filename = Common::TestOutputDir + "ReadTriggerWindowsWithoutTriggers.iqx";
+	writeTriggerFile(filename, 10 * KB, 4 * KB, { vector<int64_t>() });
+
+	expectTriggerWindowsAsReadChannel<float>(filename, "Channel1", vector<int64_t>(), 100, 100);
+	remove(filename.c_str());
+}
+
+TEST_F(IqxTest, Statistics)
+{
+	const string filename = Common::TestOutputDir + "Statistics.iqx";
+	const size_t nofSamples = 100 * KB;
+	const size_t framePairs = 10000;
+	writeWindowFile(filename, nofSamples, framePairs);
+
+	// read, statistics disabled
+	Iqx inIqx(filename);
+	vector<string> arrayNames;
+	ASSERT_EQ(ErrorCodes::Success, inIqx.readOpen(arrayNames));
+	ASSERT_FALSE(arrayNames.empty());
+	vector<float> values;
+	ASSERT_EQ(ErrorCodes::Success, inIqx.readChannel(arrayNames[0], values, nofSamples));
+	auto statistics = inIqx.getStatistics();
+	EXPECT_EQ(0, statistics.getBytesRead());
+	EXPECT_EQ(0, statistics.getSeconds(IoPhase::Io));
+
+	// read, statistics enabled, all frames are read once
+	inIqx.setStatisticsEnabled(true);
+	ASSERT_EQ(ErrorCodes::Success, inIqx.readChannel(arrayNames[0], values, nofSamples));
+	statistics = inIqx.getStatistics();
+	const uint64_t bytesRead = statistics.getBytesRead();
+	EXPECT_GE(bytesRead, nofSamples * 2 * sizeof(int16_t));
+	EXPECT_GT(statistics.getNofSyscalls(), 0);
+	EXPECT_GT(statistics.getSeconds(IoPhase::Io), 0);
+	EXPECT_GT(statistics.getSeconds(IoPhase::Conversion), 0);
+	EXPECT_EQ(0, statistics.getBytesWritten());
+
+	// concurrent reads of the same file add up
+	const size_t nofThreads = 4;
+	inIqx.setStatisticsEnabled(true);
+	vector<thread> threads;
+	vector<int> results(nofThreads, -1);
+	for (size_t t = 0; t < nofThreads; t++)
+	{
+		threads.push_back(thread([&inIqx, &arrayNames, &results, t, nofSamples]()
+		{
+			vector<float> threadValues;
+			results[t] = inIqx.readChannel(arrayNames[0], threadValues, nofSamples);
+		}));
+	}
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+	for (int result : results)
+	{
+		EXPECT_EQ(ErrorCodes::Success, result);
+	}
+	statistics = inIqx.getStatistics();
+	EXPECT_EQ(nofThreads * bytesRead, statistics.getBytesRead());
+	EXPECT_GT(statistics.getSeconds(IoPhase::Io), 0);
+
+	inIqx.close();
+	remove(filename.c_str());
+}
+
+TEST_F(IqxTest, ReadAsync)
+{
+	const string filename = Common::TestOutputDir + "ReadAsync.iqx";
+	// frames of 10000 pairs, each read spans several frames
+	const size_t nofSamples = 100 * KB;
+	const size_t offset = 1234;
+	const size_t nofRead = nofSamples - 2 * offset;
+	writeWindowFile(filename, nofSamples, 10000);
+
+	Iqx inIqx(filename);
+	vector<string> arrayNames;
+	ASSERT_EQ(ErrorCodes::Success, inIqx.readOpen(arrayNames));
+	ASSERT_FALSE(arrayNames.empty());
+
+	vector<float> expectedQ;
+	ASSERT_EQ(ErrorCodes::Success, inIqx.readArray(arrayNames[0] + "_Q", expectedQ, nofRead, offset));
+	vector<double> expectedChannel;
+	ASSERT_EQ(ErrorCodes::Success, inIqx.readChannel(arrayNames[0], expectedChannel, nofRead, offset));
+
+	const AsyncReadBackend backends[] = { AsyncReadBackend::IoUring, AsyncReadBackend::ThreadPool };
+	for (auto backend : backends)
+	{
+		// io_uring is not available on all systems, the thread pool is used instead
+		int retCode = AsyncRead::setBackend(backend);
+		ASSERT_TRUE(retCode == ErrorCodes::Success || backend == AsyncReadBackend::IoUring);
+
+		inIqx.setStatisticsEnabled(true);
+		vector<float> valuesQ(nofRead);
+		vector<double> valuesChannel(2 * nofRead);
+		promise<int> arrayDone;
+		promise<int> channelDone;
+		retCode = inIqx.readArrayAsync(arrayNames[0] + "_Q", valuesQ.data(), nofRead, offset, [&](int errorCode) { arrayDone.set_value(errorCode); });
+		ASSERT_EQ(ErrorCodes::Success, retCode);
+		retCode = inIqx.readChannelAsync(arrayNames[0], valuesChannel.data(), nofRead, offset, [&](int errorCode) { channelDone.set_value(errorCode); });
+		ASSERT_EQ(ErrorCodes::Success, retCode);
+
+		EXPECT_EQ(ErrorCodes::Success, arrayDone.get_future().get());
+		EXPECT_EQ(ErrorCodes::Success, channelDone.get_future().get());
+		EXPECT_EQ(expectedQ, valuesQ);
+		EXPECT_EQ(expectedChannel, valuesChannel);
+
+		// the preambles are counted when the read is started, the IQ data before the callbacks are called
+		EXPECT_GE(inIqx.getStatistics().getBytesRead(), 3 * nofRead * sizeof(int16_t));
+	}
+
+	// errors are returned synchronously, the callback is not called
+	vector<float> values(2 * nofSamples + 2);
+	EXPECT_EQ(ErrorCodes::InvalidArrayName, inIqx.readArrayAsync("Unknown_I", values.data(), 1, 0, [](int) { FAIL(); }));
+	EXPECT_NE(ErrorCodes::Success, inIqx.readChannelAsync(arrayNames[0], values.data(), nofSamples + 1, 0, [](int) { FAIL(); }));
+	inIqx.close();
+	EXPECT_EQ(ErrorCodes::OpenFileHasNotBeenCalled, inIqx.readChannelAsync(arrayNames[0], values.data(), 1, 0, [](int) { FAIL(); }));
+	remove(filename.c_str());
+
+	// 12 bit values are packed and cannot be read asynchronously
+	const string filename12 = Common::TestOutputDir + "ReadAsync12.iqx";
+	{
+		vector<ChannelInfo> channelInfos;
+		channelInfos.push_back(ChannelInfo("Channel1", 1e6, 1000.0, 100));
+		map<string, string> metadata;
+		Iqx outIqx(filename12);
+		ASSERT_EQ(ErrorCodes::Success, outIqx.setResolution(12));
+		ASSERT_EQ(ErrorCodes::Success, outIqx.writeOpen(IqDataFormat::Complex, 2, "IQX Test", "ReadAsync", channelInfos, &metadata));
+		ASSERT_EQ(ErrorCodes::Success, outIqx.appendChannels(vector<vector<float>>(1, vector<float>(200, 0.25f))));
+		ASSERT_EQ(ErrorCodes::Success, outIqx.close());
+	}
+	Iqx inIqx12(filename12);
+	ASSERT_EQ(ErrorCodes::Success, inIqx12.readOpen(arrayNames));
+	EXPECT_EQ(ErrorCodes::InvalidDataFormat, inIqx12.readChannelAsync(arrayNames[0], values.data(), 10, 0, [](int) { FAIL(); }));
+	inIqx12.close();
+	remove(filename12.c_str());
+}
+
+namespace
+{
+	// interleaved IQ values of the pairs [first, first + nofPairs), including full scale and values beyond it
+	vector<float> resolutionTestValues(size_t first, size_t nofPairs)
+	{
+		const float extremes[] = { 1.0f, -1.0f, 1.5f, -1.5f, 0.0f, 1.0f / INT16_MAX, -1.0f / INT16_MAX };
+		const size_t nofExtremes = sizeof(extremes) / sizeof(extremes[0]);
+		vector<float> values(2 * nofPairs);
+		for (size_t n = 0; n < nofPairs; ++n)
+		{
+			const size_t pair = first + n;
+			values[2 * n] = (pair % 97 < nofExtremes) ? extremes[pair % 97] : static_cast<float>(sin(0.01 * pair));
+			values[2 * n + 1] = static_cast<float>((pair * 7919) % 65536) / 32768.0f - 1.0f;
+		}
+		return values;
+	}
+
+	// writes the pairs with one appendChannels() call per element of callPairs and reads them back as stored.
+	// Without closeWriter the file is completed by the destructor of the writer.
+	void writeAndReadInt16(const string& filename, int resolution, const vector<size_t>& callPairs, vector<int16_t>& values, bool closeWriter)
+	{
+		vector<ChannelInfo> channelInfos;
+		channelInfos.push_back(ChannelInfo("Channel1", 1e6, 1000.0, 0));
+		map<string, string> metadata;
+		{
+			Iqx outIqx(filename);
+			ASSERT_EQ(ErrorCodes::Success, outIqx.setResolution(resolution));
+			ASSERT_EQ(ErrorCodes::Success, outIqx.writeOpen(IqDataFormat::Complex, 2, "IQX Test", "Resolution", channelInfos, &metadata));
+			ASSERT_EQ(ErrorCodes::WriterAlreadyInitialized, outIqx.setCueIndexFile(true));
+			size_t written = 0;
+			for (size_t pairs : callPairs)
+			{
+				ASSERT_EQ(ErrorCodes::Success, outIqx.appendChannels(vector<vector<float>>(1, resolutionTestValues(written, pairs))));
+				written += pairs;
+			}
+			if (closeWriter)
+			{
+				ASSERT_EQ(ErrorCodes::Success, outIqx.close());
+			}
+		}
+
+		Iqx inIqx(filename);
+		vector<string> arrayNames;
+		ASSERT_EQ(ErrorCodes::Success, inIqx.readOpen(arrayNames));
+		ASSERT_EQ(1, arrayNames.size());
+		ASSERT_EQ(ErrorCodes::ReaderAlreadyInitialized, inIqx.setCueIndexFile(true));
+		const int64_t nofPairs = inIqx.getArraySize(arrayNames[0]);
+		ASSERT_GT(nofPairs, 0);
+		values.resize(2 * nofPairs);
+		double scale = 0;
+		ASSERT_EQ(ErrorCodes::Success, inIqx.readChannel(arrayNames[0], values.data(), nofPairs, scale));
+		inIqx.close();
+		remove(filename.c_str());
+	}
+
+	// the 12 bit file holds the upper 12 bits of the 16 bit values, the last DIGIQ word of 10 pairs is padded with 0
+	void expect12BitRoundTrip(const vector<size_t>& callPairs, bool closeWriter = true)
+	{
+		size_t nofPairs = 0;
+		for (size_t pairs : callPairs)
+		{
+			nofPairs += pairs;
+		}
+
+		vector<int16_t> values16;
+		writeAndReadInt16(Common::TestOutputDir + "Resolution16.iqx", 16, callPairs, values16, closeWriter);
+		ASSERT_EQ(2 * nofPairs, values16.size());
+		vector<int16_t> values12;
+		writeAndReadInt16(Common::TestOutputDir + "Resolution12.iqx", 12, callPairs, values12, closeWriter);
+		ASSERT_EQ(2 * ((nofPairs + 9) / 10 * 10), values12.size());
+
+		for (size_t n = 0; n < values16.size(); ++n)
+		{
+			ASSERT_EQ(static_cast<int16_t>(values16[n] & 0xfff0), values12[n]) << "value " << n;
+		}
+		for (size_t n = values16.size(); n < values12.size(); ++n)
+		{
+			ASSERT_EQ(0, values12[n]) << "padding value " << n;
+		}
+	}
+}
+
+TEST_F(IqxTest, Resolution12OddAppends)
+{
+	// the pairs of a partial DIGIQ word are carried over to the next call
+	expect12BitRoundTrip({ 1, 7, 13, 3, 26, 9, 1 });
+}
+
+TEST_F(IqxTest, Resolution12WholeWords)
+{
+	// every call ends within a DIGIQ word, but the total is a multiple of 10, so nothing is padded
+	expect12BitRoundTrip({ 3, 5, 7, 11, 14 });
+}
+
+TEST_F(IqxTest, Resolution12LastWordFlushedOnClose)
+{
+	// large calls ending with a partial DIGIQ word, which is written by close()
+	expect12BitRoundTrip({ 100003, 4097, 1 });
+	expect12BitRoundTrip({ 9 });
+}
+
+TEST_F(IqxTest, Resolution12WriterDestroyedWithoutClose)
+{
+	// the destructor writes the last partial DIGIQ word as close() does
+	expect12BitRoundTrip({ 1, 7, 13, 3, 26, 9, 1 }, false);
+	expect12BitRoundTrip({ 100003, 4097, 1 }, false);
+}
@@ -354,3 +354,171 @@ TEST_F(MatlabTests, UninitializedQueryDataFromSingle)
 
   file.close();
 }
+
+TEST_F(MatlabTests, WriteCompressedMat73)
+{
+  const string filename = Common::TestOutputDir + "WriteCompressedMat73.mat";
+
+  vector<ChannelInfo> channelInfos;
+  channelInfos.push_back(ChannelInfo("Channel1", 12, 12));
+  channelInfos.push_back(ChannelInfo("Channel2", 24, 24));
+
+  // several chunks of the data variables, the last one incomplete
+  const size_t nofSamples = 100003;
+  vector<vector<float>> iqValues(2, vector<float>(2 * nofSamples));
+  for (size_t i = 0; i < 2 * nofSamples; ++i)
+  {
+    iqValues[0][i] = static_cast<float>(i);
+    iqValues[1][i] = -static_cast<float>(i);
+  }
+
+  IqMatlab writeFile(filename);
+  auto ret = writeFile.setCompressionLevel(10);
+  ASSERT_EQ(ret, ErrorCodes::InvalidDataFormat);
+  ret = writeFile.setCompressionLevel(6);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+
+  ret = writeFile.writeOpen(IqDataFormat::Complex, 4, "app", "comment", channelInfos);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  ret = writeFile.setCompressionLevel(1);
+  ASSERT_EQ(ret, ErrorCodes::WriterAlreadyInitialized);
+
+  ret = writeFile.appendChannels(iqValues);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  ret = writeFile.appendChannels(iqValues);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  ret = writeFile.close();
+  ASSERT_EQ(ret, ErrorCodes::Success);
+
+  IqMatlab readFile(filename);
+  vector<string> arrayNames;
+  ret = readFile.readOpen(arrayNames);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  ASSERT_EQ(4, arrayNames.size());
+  ASSERT_EQ(2 * nofSamples, readFile.getArraySize(arrayNames[0]));
+
+  vector<float> values;
+  // I/Q pairs of the second append
+  ret = readFile.readChannel("Channel2", values, 2 * nofSamples, nofSamples);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  for (size_t i = 0; i < 2 * nofSamples; ++i)
+  {
+    ASSERT_EQ(iqValues[1][i], values[i]);
+  }
+
+  readFile.close();
+  remove(filename.c_str());
+}
+
+TYPED_TEST(MatlabFormatTests, WriteSingleStorage)
+{
+  typedef typename TypeParam::Dt T;
+  const string filename = Common::TestOutputDir + "WriteSingleStorage.mat";
+
+  vector<ChannelInfo> channelInfos;
+  channelInfos.push_back(ChannelInfo("Channel1", 12, 12));
+
+  const size_t nofValues = 1001;
+  vector<vector<T>> iqValues(1, vector<T>(2 * nofValues));
+  for (size_t i = 0; i < 2 * nofValues; ++i)
+  {
+    iqValues[0][i] = static_cast<T>(i) + static_cast<T>(0.25);
+  }
+
+  IqMatlab writeFile(filename);
+  auto ret = writeFile.setMatlabVersion(TypeParam::Mat);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  ret = writeFile.setStorageType(IqDataType::Float32);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  ret = writeFile.writeOpen(IqDataFormat::Complex, 2, "app", "comment", channelInfos);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  ret = writeFile.setStorageType(IqDataType::Float64);
+  ASSERT_EQ(ret, ErrorCodes::WriterAlreadyInitialized);
+  ret = writeFile.appendChannels(iqValues);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  ret = writeFile.close();
+  ASSERT_EQ(ret, ErrorCodes::Success);
+
+  IqMatlab readFile(filename);
+  vector<string> arrayNames;
+  ret = readFile.readOpen(arrayNames);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+
+  // data is stored as single, but must be readable with any precision
+  vector<T> values;
+  ret = readFile.readChannel("Channel1", values, 2 * nofValues);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  for (size_t i = 0; i < 2 * nofValues; ++i)
+  {
+    ASSERT_EQ(iqValues[0][i], values[i]);
+  }
+
+  readFile.close();
+  remove(filename.c_str());
+}
+
+TYPED_TEST(MatlabFormatTests, ReadWindowsAtOffset)
+{
+  typedef typename TypeParam::Dt T;
+  const string filename = Common::TestOutputDir + "ReadWindowsAtOffset.mat";
+
+  vector<ChannelInfo> channelInfos;
+  channelInfos.push_back(ChannelInfo("Channel1", 12, 12));
+  channelInfos.push_back(ChannelInfo("Channel2", 12, 12));
+
+  const size_t nofValues = 70001;
+  vector<vector<T>> iqValues(2, vector<T>(2 * nofValues));
+  for (size_t i = 0; i < 2 * nofValues; ++i)
+  {
+    iqValues[0][i] = static_cast<T>(i);
+    iqValues[1][i] = -static_cast<T>(i);
+  }
+
+  IqMatlab writeFile(filename);
+  auto ret = writeFile.setMatlabVersion(TypeParam::Mat);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  ret = writeFile.writeOpen(IqDataFormat::Complex, 4, "app", "comment", channelInfos);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  ret = writeFile.appendChannels(iqValues);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+  ret = writeFile.close();
+  ASSERT_EQ(ret, ErrorCodes::Success);
+
+  IqMatlab readFile(filename);
+  vector<string> arrayNames;
+  ret = readFile.readOpen(arrayNames);
+  ASSERT_EQ(ret, ErrorCodes::Success);
+
+  // windows are read repeatedly and across chunk boundaries of v7.3 files
+  const size_t offsets[] = { 0, 32767, 40000, 12, nofValues - 1000 };
+  const size_t nofPairs = 1000;
+  for (size_t offset : offsets)
+  {
+    vector<T> channel;
+    ret = readFile.readChannel("Channel2", channel, 2 * nofPairs, offset);
+    ASSERT_EQ(ret, ErrorCodes::Success);
+
+    vector<T> iValues;
+    ret = readFile.readArray("Channel2_I", iValues, nofPairs, offset);
+    ASSERT_EQ(ret, ErrorCodes::Success);
+
+    vector<T> qValues;
+    ret = readFile.readArray("Channel2_Q", qValues, nofPairs, offset);
+    ASSERT_EQ(ret, ErrorCodes::Success);
+
+    for (size_t i = 0; i < nofPairs; ++i)
+    {
+      ASSERT_EQ(iqValues[1][2 * (offset + i)], channel[2 * i]);
+      ASSERT_EQ(iqValues[1][2 * (offset + i) + 1], channel[2 * i + 1]);
+      ASSERT_EQ(channel[2 * i], iValues[i]);
+      ASSERT_EQ(channel[2 * i + 1], qValues[i]);
+    }
+  }
+
+  vector<T> values;
+  ret = readFile.readChannel("Channel1", values, 2 * nofPairs, nofValues - nofPairs + 1);
+  ASSERT_EQ(ret, ErrorCodes::InvalidDataInterval);
+
+  readFile.close();
+  remove(filename.c_str());
+}
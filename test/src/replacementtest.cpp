@@ -0,0 +1,194 @@
+#include "gtest/gtest.h"
+
+#include "replacement.h"
+
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+using namespace std;
+
+// The vectorized AID kernels have to return the same bits as the scalar loops for every instruction set.
+class ReplacementTest : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    // the best level supported by the cpu
+    SetSimdLevel(SimdAvx2);
+  }
+};
+
+namespace
+{
+  // lengths around the block sizes of the kernels: 4 complex values, 8 values (SSE2) and 16 values (AVX2)
+  const int Lengths[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 100 };
+  const int MaxLength = 100;
+  // source and destination are moved by up to 3 elements, so that they are not aligned to the vector size
+  const int MaxOffset = 3;
+  // the values around the destination must not be overwritten
+  const float Guard = -12345.0f;
+  const int GuardValues = 16;
+  // scale factors of the AID reader (16 and 31 bit full scale, gain) and one that overflows FLT_MAX
+  const float Scales[] = { 1.0f / INT16_MAX, 1.0f / 2147483648.0f, 3.16227766f, 2.0f };
+
+  // returns the destination buffer of a kernel call, including the guard values
+  typedef function<vector<float>(int len, int srcOffset, int dstOffset)> KernelCall;
+
+  vector<float> destination(int nofValues, int dstOffset)
+  {
+    return vector<float>(dstOffset + nofValues + GuardValues, Guard);
+  }
+
+  void expectSameAsScalar(const KernelCall& call)
+  {
+    for (int level = SimdSse2; level <= SimdAvx2; ++level)
+    {
+      if (SetSimdLevel(static_cast<SimdLevel>(level)) != level)
+      {
+        // not supported by the cpu
+        break;
+      }
+
+      for (int len : Lengths)
+      {
+        for (int srcOffset = 0; srcOffset <= MaxOffset; ++srcOffset)
+        {
+          for (int dstOffset = 0; dstOffset <= MaxOffset; ++dstOffset)
+          {
+            SetSimdLevel(SimdNone);
+            const vector<float> expected = call(len, srcOffset, dstOffset);
+            SetSimdLevel(static_cast<SimdLevel>(level));
+            const vector<float> actual = call(len, srcOffset, dstOffset);
+
+            ASSERT_EQ(expected.size(), actual.size());
+            ASSERT_EQ(0, memcmp(expected.data(), actual.data(), expected.size() * sizeof(float)))
+              << "level " << level << " length " << len << " source offset " << srcOffset << " destination offset " << dstOffset;
+          }
+        }
+      }
+    }
+  }
+
+  // full scale values are mixed into a pattern, so that they are processed by the vector loops and the scalar tails
+  template<typename T>
+  vector<T> sourceValues(const vector<T>& extremes, T step, size_t size = MaxLength + MaxOffset)
+  {
+    vector<T> values(size);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      values[i] = (i % 3 == 0) ? extremes[(i / 3) % extremes.size()] : static_cast<T>(static_cast<double>(step) * i);
+    }
+    return values;
+  }
+
+  const vector<int16_t> Int16Values = sourceValues<int16_t>({ INT16_MAX, INT16_MIN, -INT16_MAX, 0, 1, -1 }, 317);
+  // values beyond int16 and beyond the 24 bit mantissa of float, which are rounded by the conversion
+  const vector<int32_t> Int32Values = sourceValues<int32_t>({ INT32_MAX, INT32_MIN, -INT32_MAX, 16777217, -16777219, 32768, -32769, 0 }, 20000001);
+  const vector<float> FloatExtremes = { 1.0f, -1.0f, FLT_MAX, -FLT_MAX, FLT_MIN / 4, 32767.0f, -32768.0f, 0.0f };
+  const vector<float> FloatValues = sourceValues<float>(FloatExtremes, -0.0371f);
+  // interleaved real and imaginary parts
+  const vector<float> ComplexValues = sourceValues<float>(FloatExtremes, 0.0173f, 2 * (MaxLength + MaxOffset));
+}
+
+TEST_F(ReplacementTest, ConvertInt16)
+{
+  expectSameAsScalar([](int len, int srcOffset, int dstOffset)
+  {
+    vector<float> dst = destination(len, dstOffset);
+    EXPECT_EQ(StsNoErr, Convert_int16_t_float(Int16Values.data() + srcOffset, dst.data() + dstOffset, len));
+    return dst;
+  });
+}
+
+TEST_F(ReplacementTest, ConvertInt32)
+{
+  expectSameAsScalar([](int len, int srcOffset, int dstOffset)
+  {
+    vector<float> dst = destination(len, dstOffset);
+    EXPECT_EQ(StsNoErr, Convert_int32_t_float(Int32Values.data() + srcOffset, dst.data() + dstOffset, len));
+    return dst;
+  });
+}
+
+TEST_F(ReplacementTest, ConvertMulCInt16)
+{
+  for (float scale : Scales)
+  {
+    expectSameAsScalar([scale](int len, int srcOffset, int dstOffset)
+    {
+      vector<float> dst = destination(len, dstOffset);
+      EXPECT_EQ(StsNoErr, ConvertMulC_int16_t_float(Int16Values.data() + srcOffset, scale, dst.data() + dstOffset, len));
+      return dst;
+    });
+  }
+}
+
+TEST_F(ReplacementTest, ConvertMulCInt32)
+{
+  for (float scale : Scales)
+  {
+    expectSameAsScalar([scale](int len, int srcOffset, int dstOffset)
+    {
+      vector<float> dst = destination(len, dstOffset);
+      EXPECT_EQ(StsNoErr, ConvertMulC_int32_t_float(Int32Values.data() + srcOffset, scale, dst.data() + dstOffset, len));
+      return dst;
+    });
+  }
+}
+
+TEST_F(ReplacementTest, MulC)
+{
+  for (float scale : Scales)
+  {
+    expectSameAsScalar([scale](int len, int srcOffset, int dstOffset)
+    {
+      vector<float> dst = destination(len, dstOffset);
+      EXPECT_EQ(StsNoErr, MulC_float(FloatValues.data() + srcOffset, scale, dst.data() + dstOffset, len));
+      return dst;
+    });
+  }
+}
+
+TEST_F(ReplacementTest, MulCInPlace)
+{
+  for (float scale : Scales)
+  {
+    expectSameAsScalar([scale](int len, int srcOffset, int dstOffset)
+    {
+      vector<float> dst = destination(len, dstOffset);
+      copy(FloatValues.begin() + srcOffset, FloatValues.begin() + srcOffset + len, dst.begin() + dstOffset);
+      EXPECT_EQ(StsNoErr, MulC_float(scale, dst.data() + dstOffset, len));
+      return dst;
+    });
+  }
+}
+
+TEST_F(ReplacementTest, RealToCplx)
+{
+  expectSameAsScalar([](int len, int srcOffset, int dstOffset)
+  {
+    // the complex values start at any float, not only at a multiple of the complex size
+    vector<float> dst = destination(2 * len, dstOffset);
+    floatc* pDst = reinterpret_cast<floatc*>(dst.data() + dstOffset);
+    EXPECT_EQ(StsNoErr, RealToCplx_float(FloatValues.data() + srcOffset, FloatValues.data() + MaxOffset - srcOffset, pDst, len));
+    return dst;
+  });
+}
+
+TEST_F(ReplacementTest, CplxToReal)
+{
+  expectSameAsScalar([](int len, int srcOffset, int dstOffset)
+  {
+    const floatc* pSrc = reinterpret_cast<const floatc*>(ComplexValues.data() + srcOffset);
+
+    // real and imaginary parts follow each other in one buffer, separated by guard values
+    vector<float> dst = destination(2 * len + GuardValues, dstOffset);
+    float* pDstRe = dst.data() + dstOffset;
+    float* pDstIm = pDstRe + len + GuardValues;
+    EXPECT_EQ(StsNoErr, CplxToReal_floatc(pSrc, pDstRe, pDstIm, len));
+    return dst;
+  });
+}
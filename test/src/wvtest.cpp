@@ -9,6 +9,8 @@
 #include <cmath>
 #include <fstream>
 #include <memory>
+#include <algorithm>
+#include <future>
 #ifdef HAS_SCRAMBLER
 #include "d:/wvscrambler/WvScrambler.h"
 #endif
@@ -169,3 +171,105 @@ TEST_F(WvTest, TestArray)
 }
 
 
+
+TEST_F(WvTest, ReadInt16)
+{
+  const string inFile = Common::TestDataDir + "FG_Sine_0.35MHz.wv";
+  Wv wv(inFile);
+  vector<string> arrayNames;
+  vector<ChannelInfo> channelInfos;
+  map<string, string> metadata;
+  int ret = wv.readOpen(arrayNames);
+  ASSERT_EQ(ErrorCodes::Success, ret) << "file open failed";
+  ret = wv.getMetadata(channelInfos, metadata);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  const size_t samples = channelInfos[0].getSamples();
+  const size_t offset = 10;
+  const size_t nofValues = samples - offset;
+
+  vector<float> expected(nofValues);
+  vector<int16_t> values(nofValues);
+  double scale = 0;
+  for (size_t i = 0; i < arrayNames.size(); ++i)
+  {
+    ret = wv.readArray(arrayNames[i], expected.data(), nofValues, offset);
+    ASSERT_EQ(ErrorCodes::Success, ret);
+    ret = wv.readArray(arrayNames[i], values.data(), nofValues, scale, offset);
+    ASSERT_EQ(ErrorCodes::Success, ret);
+    ASSERT_GT(scale, 0);
+    for (size_t n = 0; n < nofValues; ++n)
+    {
+      ASSERT_FLOAT_EQ(expected[n], static_cast<float>(values[n] * scale)) << arrayNames[i] << " index " << n;
+    }
+  }
+
+  expected.resize(2 * nofValues);
+  values.resize(2 * nofValues);
+  ret = wv.readChannel(channelInfos[0].getChannelName(), expected.data(), nofValues, offset);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = wv.readChannel(channelInfos[0].getChannelName(), values.data(), nofValues, scale, offset);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  for (size_t n = 0; n < 2 * nofValues; ++n)
+  {
+    ASSERT_FLOAT_EQ(expected[n], static_cast<float>(values[n] * scale)) << "index " << n;
+  }
+
+  // the first value of a buffer that is not aligned for the samples stored in the file
+  vector<int16_t> unaligned(2 * nofValues + 1);
+  ret = wv.readChannel(channelInfos[0].getChannelName(), unaligned.data() + 1, nofValues, scale, offset);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  EXPECT_TRUE(equal(values.begin(), values.end(), unaligned.begin() + 1));
+
+  wv.close();
+}
+
+TEST_F(WvTest, ReadAsync)
+{
+  const string inFile = Common::TestDataDir + "FG_Sine_0.35MHz.wv";
+  Wv wv(inFile);
+  vector<string> arrayNames;
+  vector<ChannelInfo> channelInfos;
+  map<string, string> metadata;
+  int ret = wv.readOpen(arrayNames);
+  ASSERT_EQ(ErrorCodes::Success, ret) << "file open failed";
+  ret = wv.getMetadata(channelInfos, metadata);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  const size_t samples = channelInfos[0].getSamples();
+  const size_t offset = 10;
+  const size_t nofValues = samples - offset;
+  const string arrayNameQ = channelInfos[0].getChannelName() + "_Q";
+
+  vector<float> expectedQ(nofValues);
+  ret = wv.readArray(arrayNameQ, expectedQ.data(), nofValues, offset);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  vector<double> expectedChannel(2 * nofValues);
+  ret = wv.readChannel(channelInfos[0].getChannelName(), expectedChannel.data(), nofValues, offset);
+  ASSERT_EQ(ErrorCodes::Success, ret);
+
+  vector<float> valuesQ(nofValues);
+  vector<double> valuesChannel(2 * nofValues);
+  promise<int> arrayDone;
+  promise<int> channelDone;
+  ret = wv.readArrayAsync(arrayNameQ, valuesQ.data(), nofValues, offset, [&](int errorCode) { arrayDone.set_value(errorCode); });
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  ret = wv.readChannelAsync(channelInfos[0].getChannelName(), valuesChannel.data(), nofValues, offset, [&](int errorCode) { channelDone.set_value(errorCode); });
+  ASSERT_EQ(ErrorCodes::Success, ret);
+  EXPECT_EQ(ErrorCodes::Success, arrayDone.get_future().get());
+  EXPECT_EQ(ErrorCodes::Success, channelDone.get_future().get());
+
+  for (size_t n = 0; n < nofValues; ++n)
+  {
+    ASSERT_FLOAT_EQ(expectedQ[n], valuesQ[n]) << "index " << n;
+  }
+
+  for (size_t n = 0; n < 2 * nofValues; ++n)
+  {
+    ASSERT_FLOAT_EQ(expectedChannel[n], valuesChannel[n]) << "index " << n;
+  }
+
+  // reading beyond the end of the file fails synchronously
+  ret = wv.readChannelAsync(channelInfos[0].getChannelName(), valuesChannel.data(), nofValues + 1, offset, [](int) { FAIL(); });
+  EXPECT_NE(ErrorCodes::Success, ret);
+
+  wv.close();
+}